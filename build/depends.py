@@ -571,10 +571,23 @@ class SoundTouch(Dependence):
                     # them.
                     '%s/cpu_detect_x86.cpp' % self.SOUNDTOUCH_INTERNAL_PATH,
                     '%s/mmx_optimized.cpp' % self.SOUNDTOUCH_INTERNAL_PATH,
-                    '%s/sse_optimized.cpp' % self.SOUNDTOUCH_INTERNAL_PATH]
+                    self.sse_optimized_source(build)]
         else:
             return ['engine/enginebufferscalest.cpp']
 
+    def sse_optimized_source(self, build):
+        # SoundTouch detects the CPU at runtime and only uses the SSE routines
+        # if they are supported. The SSE intrinsics do not compile for 32 bit
+        # x86 targets without SSE though (optimize=legacy), so build just this
+        # file with SSE enabled. The rest stays compatible with the target.
+        source = '%s/sse_optimized.cpp' % self.SOUNDTOUCH_INTERNAL_PATH
+        if (not build.toolchain_is_gnu or not build.architecture_is_x86 or
+                build.machine_is_64bit):
+            return source
+        env = build.env.Clone()
+        env.Append(CCFLAGS='-msse')
+        return env.Object(source)
+
     def configure(self, build, conf, env=None):
         if env is None:
             env = build.env
@@ -718,6 +731,7 @@ class MixxxCore(Feature):
                    "control/controlobjectscript.cpp",
                    "control/controlpotmeter.cpp",
                    "control/controlproxy.cpp",
+                   "control/controlupdatecoalescer.cpp",
                    "control/controlpushbutton.cpp",
                    "control/controlttrotary.cpp",
                    "control/controlencoder.cpp",
@@ -792,6 +806,7 @@ class MixxxCore(Feature):
                    "effects/builtin/tremoloeffect.cpp",
 
                    "engine/effects/engineeffectsmanager.cpp",
+                   "engine/effects/engineeffectsrouting.cpp",
                    "engine/effects/engineeffectrack.cpp",
                    "engine/effects/engineeffectchain.cpp",
                    "engine/effects/engineeffect.cpp",
@@ -806,6 +821,7 @@ class MixxxCore(Feature):
                    "engine/enginebuffer.cpp",
                    "engine/enginebufferscale.cpp",
                    "engine/enginebufferscalelinear.cpp",
+                   "engine/enginebufferscalesinc.cpp",
                    "engine/enginefilterbiquad1.cpp",
                    "engine/enginefiltermoogladder4.cpp",
                    "engine/enginefilterbessel4.cpp",
@@ -830,6 +846,7 @@ class MixxxCore(Feature):
                    "engine/enginemicrophone.cpp",
                    "engine/enginedeck.cpp",
                    "engine/engineaux.cpp",
+                   "engine/enginecompactsampler.cpp",
                    "engine/channelmixer_autogen.cpp",
 
                    "engine/enginecontrol.cpp",
@@ -844,6 +861,7 @@ class MixxxCore(Feature):
                    "engine/readaheadmanager.cpp",
                    "engine/enginetalkoverducking.cpp",
                    "engine/cachingreader.cpp",
+                   "engine/callbackprofiler.cpp",
                    "engine/cachingreaderchunk.cpp",
                    "engine/cachingreaderworker.cpp",
 
@@ -886,9 +904,12 @@ class MixxxCore(Feature):
                    "errordialoghandler.cpp",
 
                    "sources/audiosource.cpp",
+                   "sources/audiosourcesplitdecoder.cpp",
                    "sources/audiosourcestereoproxy.cpp",
+                   "sources/decodedaudiocache.cpp",
                    "sources/metadatasourcetaglib.cpp",
                    "sources/soundsource.cpp",
+                   "sources/soundsourcemappedpcm.cpp",
                    "sources/soundsourceplugin.cpp",
                    "sources/soundsourcepluginlibrary.cpp",
                    "sources/soundsourceproviderregistry.cpp",
@@ -980,6 +1001,7 @@ class MixxxCore(Feature):
                    "library/proxytrackmodel.cpp",
                    "library/coverart.cpp",
                    "library/coverartcache.cpp",
+                   "library/coverartdiskcache.cpp",
                    "library/coverartutils.cpp",
 
                    "library/crate/cratestorage.cpp",
@@ -992,6 +1014,7 @@ class MixxxCore(Feature):
                    "library/analysisfeature.cpp",
                    "library/autodj/autodjfeature.cpp",
                    "library/autodj/autodjprocessor.cpp",
+                   "library/autodj/autodjtrackpreloader.cpp",
                    "library/dao/directorydao.cpp",
                    "library/mixxxlibraryfeature.cpp",
                    "library/baseplaylistfeature.cpp",
@@ -1041,6 +1064,8 @@ class MixxxCore(Feature):
                    "library/scanner/scannertask.cpp",
                    "library/scanner/importfilestask.cpp",
                    "library/scanner/recursivescandirectorytask.cpp",
+                   "library/scanner/directorystat.cpp",
+                   "library/scanner/librarywatcher.cpp",
 
                    "library/dao/cuedao.cpp",
                    "library/dao/cue.cpp",
@@ -1074,6 +1099,7 @@ class MixxxCore(Feature):
                    "waveform/sharedglcontext.cpp",
                    "waveform/waveform.cpp",
                    "waveform/waveformfactory.cpp",
+                   "waveform/overviewcache.cpp",
                    "waveform/waveformwidgetfactory.cpp",
                    "waveform/vsyncthread.cpp",
                    "waveform/guitick.cpp",
@@ -1132,6 +1158,7 @@ class MixxxCore(Feature):
                    "skin/svgparser.cpp",
                    "skin/pixmapsource.cpp",
                    "skin/launchimage.cpp",
+                   "skin/skinimagecache.cpp",
 
                    "track/beatfactory.cpp",
                    "track/beatgrid.cpp",
@@ -1157,6 +1184,7 @@ class MixxxCore(Feature):
                    "mixer/auxiliary.cpp",
                    "mixer/baseplayer.cpp",
                    "mixer/basetrackplayer.cpp",
+                   "mixer/compactsampler.cpp",
                    "mixer/deck.cpp",
                    "mixer/microphone.cpp",
                    "mixer/playerinfo.cpp",
@@ -1184,7 +1212,9 @@ class MixxxCore(Feature):
                    "encoder/encoderbroadcastsettings.cpp",
 
                    "util/sleepableqthread.cpp",
+                   "util/semaphore.cpp",
                    "util/statsmanager.cpp",
+                   "util/chrometrace.cpp",
                    "util/stat.cpp",
                    "util/statmodel.cpp",
                    "util/duration.cpp",
@@ -1192,6 +1222,8 @@ class MixxxCore(Feature):
                    "util/timer.cpp",
                    "util/performancetimer.cpp",
                    "util/threadcputimer.cpp",
+                   "util/startupprofiler.cpp",
+                   "util/realtimeguard.cpp",
                    "util/version.cpp",
                    "util/rlimit.cpp",
                    "util/battery/battery.cpp",
@@ -359,6 +359,7 @@ class VinylControl(Feature):
                    'vinylcontrol/vinylcontrolmanager.cpp',
                    'vinylcontrol/vinylcontrolprocessor.cpp',
                    'vinylcontrol/steadypitch.cpp',
+                   'vinylcontrol/timecodelutcache.cpp',
                    'engine/vinylcontrolcontrol.cpp', ]
         if build.platform_is_windows:
             sources.append("#lib/xwax/timecoder_win32.cpp")
@@ -589,6 +590,31 @@ class Sanitizers(Feature):
         build.env.Append(LINKFLAGS="-fsanitize=%s" % ','.join(sanitizers))
 
 
+class RealtimeSafety(Feature):
+    def description(self):
+        return "Detection of allocations and locks in the engine thread"
+
+    def enabled(self, build):
+        build.flags['rtsafety'] = util.get_flags(build.env, 'rtsafety', 0)
+        if int(build.flags['rtsafety']):
+            return True
+        return False
+
+    def add_options(self, build, vars):
+        vars.Add('rtsafety', 'Set to 1 to report allocations and blocking locks in the engine thread. For debugging and CI builds only.', 0)
+
+    def configure(self, build, conf):
+        if not self.enabled(build):
+            return
+        build.env.Append(CPPDEFINES='MIXXX_REALTIME_SAFETY_CHECKS')
+        if build.platform_is_linux:
+            # dlsym() for the pthread interceptors
+            build.env.Append(LIBS='dl')
+
+    def sources(self, build):
+        return ['util/realtimeguardhooks.cpp']
+
+
 class PerfTools(Feature):
     def description(self):
         return "Google PerfTools"
@@ -20,6 +20,11 @@
 #ifndef LUT_H
 #define LUT_H
 
+/* The number of bits to form the hash, which governs the overall size
+ * of the hash lookup table, and hence the amount of chaining */
+
+#define HASH_BITS 16
+
 typedef unsigned int slot_no_t;
 
 struct slot {
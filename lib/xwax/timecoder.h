@@ -46,6 +46,7 @@ struct timecode_def {
         safe; /* last 'safe' timecode number (for auto disconnect) */
     bool lookup; /* true if lut has been generated */
     struct lut lut;
+    bool lookup_external; /* lut memory is owned by the caller */
 };
 
 struct timecoder_channel {
@@ -85,6 +86,9 @@ struct timecoder {
 };
 
 struct timecode_def* timecoder_find_definition(const char *name);
+struct timecode_def* timecoder_find_definition_no_lookup(const char *name);
+void timecoder_use_lookup(struct timecode_def *def,
+                          struct slot *slot, slot_no_t *table);
 void timecoder_free_lookup(void);
 
 void timecoder_init(struct timecoder *tc, struct timecode_def *def,
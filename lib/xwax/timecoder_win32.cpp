@@ -235,12 +235,13 @@ static int build_lookup(struct timecode_def *def)
 }
 
 /*
- * Find a timecode definition by name
+ * Find a timecode definition by name, without building its lookup
+ * table
  *
  * Return: pointer to timecode definition, or NULL if not found
  */
 
-struct timecode_def* timecoder_find_definition(const char *name)
+struct timecode_def* timecoder_find_definition_no_lookup(const char *name)
 {
     struct timecode_def *def, *end;
 
@@ -257,12 +258,48 @@ struct timecode_def* timecoder_find_definition(const char *name)
             return NULL;
     }
 
+    return def;
+}
+
+/*
+ * Find a timecode definition by name
+ *
+ * Return: pointer to timecode definition, or NULL if not found
+ */
+
+struct timecode_def* timecoder_find_definition(const char *name)
+{
+    struct timecode_def *def;
+
+    def = timecoder_find_definition_no_lookup(name);
+    if (def == NULL)
+        return NULL;
+
     if (build_lookup(def) == -1)
         return NULL;
 
     return def;
 }
 
+/*
+ * Use a lookup table that was built earlier, e.g. mapped from a file,
+ * instead of building it. The memory must stay valid until
+ * timecoder_free_lookup() and is not freed by it.
+ */
+
+void timecoder_use_lookup(struct timecode_def *def,
+                          struct slot *slot, slot_no_t *table)
+{
+    if (def->lookup && !def->lookup_external)
+        lut_clear(&def->lut);
+
+    def->lut.slot = slot;
+    def->lut.table = table;
+    def->lut.avail = def->length;
+    def->lookup = true;
+    def->lookup_external = true;
+}
+
 /*
  * Free the timecoder lookup tables when they are no longer needed
  */
@@ -274,8 +311,10 @@ void timecoder_free_lookup(void) {
     end = def + ARRAY_SIZE(timecodes);
 
     while (def < end) {
-        if (def->lookup)
+        if (def->lookup && !def->lookup_external)
             lut_clear(&def->lut);
+        def->lookup = false;
+        def->lookup_external = false;
         def++;
     }
 }
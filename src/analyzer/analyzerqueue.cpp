@@ -20,6 +20,7 @@
 #include "util/timer.h"
 #include "util/trace.h"
 #include "util/logger.h"
+#include "util/math.h"
 
 // Measured in 0.1%,
 // 0 for no progress during finalize
@@ -40,6 +41,20 @@ const SINT kAnalysisFramesPerBlock = 4096;
 const SINT kAnalysisSamplesPerBlock =
         kAnalysisFramesPerBlock * kAnalysisChannels;
 
+// Decoding is often slower than the analyzers. Files that seek sample
+// accurately are split and decoded on multiple threads by the batch
+// analysis. At least half of the cores are left for the engine and the
+// GUI, because the batch analysis may run during a live set.
+const int kMaxAnalysisDecodingThreads = 3;
+
+int decodingThreadCount(AnalyzerQueue::Decoding decoding) {
+    if (decoding == AnalyzerQueue::Decoding::SingleThreaded) {
+        return 1;
+    }
+    return math_max(1, math_min(
+            QThread::idealThreadCount() / 2, kMaxAnalysisDecodingThreads));
+}
+
 QAtomicInt s_instanceCounter(0);
 
 } // anonymous namespace
@@ -47,8 +62,10 @@ QAtomicInt s_instanceCounter(0);
 AnalyzerQueue::AnalyzerQueue(
         mixxx::DbConnectionPoolPtr pDbConnectionPool,
         const UserSettingsPointer& pConfig,
-        Mode mode)
+        Mode mode,
+        Decoding decoding)
         : m_pDbConnectionPool(std::move(pDbConnectionPool)),
+          m_decodingThreadCount(decodingThreadCount(decoding)),
           m_exit(false),
           m_aiCheckPriorities(false),
           m_sampleBuffer(kAnalysisSamplesPerBlock),
@@ -345,7 +362,9 @@ void AnalyzerQueue::execThread() {
         // Get the audio
         mixxx::AudioSource::OpenParams openParams;
         openParams.setChannelCount(kAnalysisChannels);
-        auto pAudioSource = SoundSourceProxy(nextTrack).openAudioSource(openParams);
+        auto pAudioSource = SoundSourceProxy(nextTrack).openAudioSourceForSplitDecoding(
+                openParams,
+                m_decodingThreadCount);
         if (!pAudioSource) {
             kLogger.warning()
                     << "Failed to open file for analyzing:"
@@ -27,10 +27,20 @@ class AnalyzerQueue : public QThread {
         WithoutWaveform,
     };
 
+    // Tracks that are loaded into a deck are analyzed while playing live
+    // and are decoded on a single thread to leave the CPU to the engine.
+    // Only the batch analysis of the library decodes files on multiple
+    // threads.
+    enum class Decoding {
+        SingleThreaded,
+        MultiThreaded,
+    };
+
     AnalyzerQueue(
             mixxx::DbConnectionPoolPtr pDbConnectionPool,
             const UserSettingsPointer& pConfig,
-            Mode mode = Mode::Default);
+            Mode mode = Mode::Default,
+            Decoding decoding = Decoding::SingleThreaded);
     ~AnalyzerQueue() override;
 
     void stop();
@@ -75,6 +85,8 @@ class AnalyzerQueue : public QThread {
     void emptyCheck();
     void updateSize();
 
+    const int m_decodingThreadCount;
+
     bool m_exit;
     QAtomicInt m_aiCheckPriorities;
 
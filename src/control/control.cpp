@@ -3,6 +3,7 @@
 
 #include "control/control.h"
 
+#include "util/compatibility.h"
 #include "util/stat.h"
 
 // Static member variable definition
@@ -40,6 +41,7 @@ ControlDoublePrivate::ControlDoublePrivate(ConfigKey key,
           m_trackFlags(Stat::COUNT | Stat::SUM | Stat::AVERAGE |
                        Stat::SAMPLE_VARIANCE | Stat::MIN | Stat::MAX),
           m_confirmRequired(false),
+          m_changedFlag(0),
           m_pCreatorCO(pCreatorCO) {
     initialize(defaultValue);
 }
@@ -198,6 +200,9 @@ void ControlDoublePrivate::setInner(double value, QObject* pSender) {
         return;
     }
     m_value.setValue(value);
+    // A plain store, so that controls without coalesced subscribers don't
+    // pay for an atomic read-modify-write
+    store_atomic(m_changedFlag, 1);
     emit(valueChanged(value, pSender));
 
     if (m_bTrack) {
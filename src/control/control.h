@@ -4,6 +4,7 @@
 #include <QHash>
 #include <QString>
 #include <QObject>
+#include <QAtomicInt>
 #include <QAtomicPointer>
 
 #include "control/controlbehavior.h"
@@ -118,6 +119,12 @@ class ControlDoublePrivate : public QObject {
     bool connectValueChangeRequest(const QObject* receiver,
                                    const char* method, Qt::ConnectionType type);
 
+    // Returns whether the value has changed since the previous call. The
+    // ControlUpdateCoalescer is the only consumer of this flag.
+    bool fetchAndClearChangedFlag() {
+        return m_changedFlag.fetchAndStoreRelaxed(0) != 0;
+    }
+
   signals:
     // Emitted when the ControlDoublePrivate value changes. pSender is a
     // pointer to the setter of the value (potentially NULL).
@@ -158,6 +165,8 @@ class ControlDoublePrivate : public QObject {
     ControlValueAtomic<double> m_value;
     // The default control value.
     ControlValueAtomic<double> m_defaultValue;
+    // Raised on every value change, see fetchAndClearChangedFlag()
+    QAtomicInt m_changedFlag;
 
     QSharedPointer<ControlNumericBehavior> m_pBehavior;
 
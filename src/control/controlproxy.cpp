@@ -2,28 +2,35 @@
 
 #include "control/controlproxy.h"
 #include "control/control.h"
+#include "control/controlupdatecoalescer.h"
 
 ControlProxy::ControlProxy(QObject* pParent)
         : QObject(pParent),
-          m_pControl(NULL) {
+          m_pControl(NULL),
+          m_bCoalesced(false) {
 }
 
 ControlProxy::ControlProxy(const QString& g, const QString& i, QObject* pParent)
-        : QObject(pParent) {
+        : QObject(pParent),
+          m_bCoalesced(false) {
     initialize(ConfigKey(g, i));
 }
 
 ControlProxy::ControlProxy(const char* g, const char* i, QObject* pParent)
-        : QObject(pParent) {
+        : QObject(pParent),
+          m_bCoalesced(false) {
     initialize(ConfigKey(g, i));
 }
 
 ControlProxy::ControlProxy(const ConfigKey& key, QObject* pParent)
-        : QObject(pParent) {
+        : QObject(pParent),
+          m_bCoalesced(false) {
     initialize(key);
 }
 
 void ControlProxy::initialize(const ConfigKey& key, bool warn) {
+    // Coalesced subscriptions are bound to the initial control
+    DEBUG_ASSERT(!m_bCoalesced);
     m_key = key;
     // Don't bother looking up the control if key is NULL. Prevents log spew.
     if (!key.isNull()) {
@@ -33,6 +40,9 @@ void ControlProxy::initialize(const ConfigKey& key, bool warn) {
 
 ControlProxy::~ControlProxy() {
     //qDebug() << "ControlProxy::~ControlProxy()";
+    if (m_bCoalesced) {
+        ControlUpdateCoalescer::unsubscribe(this);
+    }
 }
 
 bool ControlProxy::connectValueChanged(const QObject* receiver,
@@ -104,3 +114,20 @@ bool ControlProxy::connectValueChanged(
     DEBUG_ASSERT(parent() != NULL);
     return connectValueChanged(parent(), method, type);
 }
+
+bool ControlProxy::connectValueChangedCoalesced(const QObject* receiver,
+        const char* method) {
+    if (!m_pControl) {
+        return false;
+    }
+    // Both live in the GUI thread, where the updates are delivered
+    if (!connect((QObject*)this, SIGNAL(valueChanged(double)),
+                      receiver, method, Qt::DirectConnection)) {
+        return false;
+    }
+    if (!m_bCoalesced) {
+        m_bCoalesced = true;
+        ControlUpdateCoalescer::subscribe(this);
+    }
+    return true;
+}
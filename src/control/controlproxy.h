@@ -35,6 +35,13 @@ class ControlProxy : public QObject {
     bool connectValueChanged(
             const char* method, Qt::ConnectionType type = Qt::AutoConnection);
 
+    // Instead of a queued signal for every single change the receiver gets
+    // at most one valueChanged() per GUI frame with the latest value. The
+    // updates are delivered by GuiTick on the GUI thread, so this must only
+    // be used by ControlProxys that live in the GUI thread.
+    bool connectValueChangedCoalesced(const QObject* receiver,
+            const char* method);
+
     // Called from update();
     virtual void emitValueChanged() {
         emit(valueChanged(get()));
@@ -130,6 +137,11 @@ class ControlProxy : public QObject {
     ConfigKey m_key;
     // Pointer to connected control.
     QSharedPointer<ControlDoublePrivate> m_pControl;
+
+  private:
+    friend class ControlUpdateCoalescer;
+
+    bool m_bCoalesced;
 };
 
 #endif // CONTROLPROXY_H
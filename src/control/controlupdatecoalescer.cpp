@@ -0,0 +1,57 @@
+#include "control/controlupdatecoalescer.h"
+
+#include <QPointer>
+
+#include "control/control.h"
+#include "control/controlproxy.h"
+#include "util/assert.h"
+
+// static
+QHash<ControlDoublePrivate*, QVector<ControlProxy*>>
+        ControlUpdateCoalescer::s_subscriptions;
+
+// static
+void ControlUpdateCoalescer::subscribe(ControlProxy* pProxy) {
+    ControlDoublePrivate* pControl = pProxy->m_pControl.data();
+    VERIFY_OR_DEBUG_ASSERT(pControl) {
+        return;
+    }
+    auto it = s_subscriptions.find(pControl);
+    if (it == s_subscriptions.end()) {
+        // Ignore changes that happened before the first subscription
+        pControl->fetchAndClearChangedFlag();
+        it = s_subscriptions.insert(pControl, QVector<ControlProxy*>());
+    }
+    it.value().append(pProxy);
+}
+
+// static
+void ControlUpdateCoalescer::unsubscribe(ControlProxy* pProxy) {
+    auto it = s_subscriptions.find(pProxy->m_pControl.data());
+    if (it == s_subscriptions.end()) {
+        return;
+    }
+    it.value().removeAll(pProxy);
+    if (it.value().isEmpty()) {
+        s_subscriptions.erase(it);
+    }
+}
+
+// static
+void ControlUpdateCoalescer::deliverUpdates() {
+    // Subscribers might be deleted or added while being notified
+    QVector<QPointer<ControlProxy>> dirtyProxies;
+    for (auto it = s_subscriptions.constBegin();
+            it != s_subscriptions.constEnd(); ++it) {
+        if (it.key()->fetchAndClearChangedFlag()) {
+            for (ControlProxy* pProxy : it.value()) {
+                dirtyProxies.append(pProxy);
+            }
+        }
+    }
+    for (const auto& pProxy : dirtyProxies) {
+        if (pProxy) {
+            pProxy->emitValueChanged();
+        }
+    }
+}
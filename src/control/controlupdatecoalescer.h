@@ -0,0 +1,29 @@
+#ifndef CONTROLUPDATECOALESCER_H
+#define CONTROLUPDATECOALESCER_H
+
+#include <QHash>
+#include <QVector>
+
+class ControlDoublePrivate;
+class ControlProxy;
+
+// Registry of the ControlProxys that receive coalesced value updates, see
+// ControlProxy::connectValueChangedCoalesced(). Once per GUI frame GuiTick
+// calls deliverUpdates() that notifies the subscribers of all controls that
+// have changed since the previous frame with their latest value. This
+// replaces the queued signal per change that is otherwise posted to the GUI
+// thread for every set from the engine or controllers.
+//
+// All functions must be called from the GUI thread.
+class ControlUpdateCoalescer {
+  public:
+    static void subscribe(ControlProxy* pProxy);
+    static void unsubscribe(ControlProxy* pProxy);
+
+    static void deliverUpdates();
+
+  private:
+    static QHash<ControlDoublePrivate*, QVector<ControlProxy*>> s_subscriptions;
+};
+
+#endif // CONTROLUPDATECOALESCER_H
@@ -11,7 +11,7 @@
 const QString MixxxDb::kDefaultSchemaFile(":/schema.xml");
 
 //static
-const int MixxxDb::kRequiredSchemaVersion = 28;
+const int MixxxDb::kRequiredSchemaVersion = 30;
 
 namespace {
 
@@ -24,7 +24,7 @@ mixxx::DbConnection::Params dbConnectionParams(
     mixxx::DbConnection::Params params;
     params.type = "QSQLITE";
     params.hostName = "localhost";
-    params.filePath = inMemoryConnection ? QString(":memory:") : QDir(pConfig->getSettingsPath()).filePath("mixxxdb.sqlite");
+    params.filePath = inMemoryConnection ? QString(":memory:") : MixxxDb::databaseFilePath(pConfig);
     params.userName = "mixxx";
     params.password = "mixxx";
     return params;
@@ -32,6 +32,12 @@ mixxx::DbConnection::Params dbConnectionParams(
 
 } // anonymous namespace
 
+//static
+QString MixxxDb::databaseFilePath(
+        const UserSettingsPointer& pConfig) {
+    return QDir(pConfig->getSettingsPath()).filePath("mixxxdb.sqlite");
+}
+
 MixxxDb::MixxxDb(
         const UserSettingsPointer& pConfig,
         bool inMemoryConnection)
@@ -17,6 +17,10 @@ class MixxxDb : public QObject {
 
     static const int kRequiredSchemaVersion;
 
+    // The SQLite file of the main Mixxx DB
+    static QString databaseFilePath(
+            const UserSettingsPointer& pConfig);
+
     static bool initDatabaseSchema(
             const QSqlDatabase& database,
             const QString& schemaFile = kDefaultSchemaFile,
@@ -1,5 +1,7 @@
 #include "database/schemamanager.h"
 
+#include <QRegExp>
+
 #include "util/db/fwdsqlquery.h"
 #include "util/db/sqltransaction.h"
 #include "util/xml.h"
@@ -29,6 +31,38 @@ namespace {
             return schemaVersion;
         }
     }
+
+    // Splits the SQL of a revision into single statements. The bodies of
+    // triggers contain semicolons and are kept together up to their
+    // terminating END.
+    QStringList splitSqlStatements(const QString& sql) {
+        const QRegExp triggerBegin(
+                "^CREATE\\s+(TEMP\\s+|TEMPORARY\\s+)?TRIGGER\\b",
+                Qt::CaseInsensitive);
+        const QRegExp triggerEnd("\\bEND$", Qt::CaseInsensitive);
+        QStringList statements;
+        QString pending;
+        for (const auto& fragment: sql.split(";")) {
+            if (pending.isEmpty()) {
+                pending = fragment.trimmed();
+            } else {
+                pending += ";" + fragment;
+                pending = pending.trimmed();
+            }
+            if (pending.contains(triggerBegin) && !pending.contains(triggerEnd)) {
+                // Incomplete trigger body
+                continue;
+            }
+            if (!pending.isEmpty()) {
+                statements.append(pending);
+            }
+            pending.clear();
+        }
+        if (!pending.isEmpty()) {
+            statements.append(pending);
+        }
+        return statements;
+    }
 }
 
 SchemaManager::SchemaManager(const QSqlDatabase& database)
@@ -174,9 +208,9 @@ SchemaManager::Result SchemaManager::upgradeToSchemaVersion(
 
         SqlTransaction transaction(m_database);
 
-        // TODO(XXX) We can't have semicolons in schema.xml for anything other
-        // than statement separators.
-        QStringList sqlStatements = sql.split(";");
+        // NOTE: Semicolons in schema.xml may only be used as statement
+        // separators, both outside and inside of trigger bodies.
+        QStringList sqlStatements = splitSqlStatements(sql);
 
         QStringListIterator it(sqlStatements);
 
@@ -425,6 +425,29 @@ bool EffectsManager::writeRequest(EffectsRequest* request) {
     // with responses when writing new requests.
     processEffectsResponses();
 
+    // The engine processes the effects according to an EngineEffectsRouting
+    // that is rebuilt here whenever a request changes it.
+    if (m_underDestruction) {
+        return writeRequestToPipe(request);
+    }
+    if (EngineEffectsRoutingBuilder::routingPrecedesRequest(*request)) {
+        // Removed objects are deleted as soon as the engine has responded to
+        // the request, so they must not be routed anymore at that point.
+        if (m_routingBuilder.requestWritten(*request)) {
+            writeRoutingRequest();
+        }
+        return writeRequestToPipe(request);
+    }
+    if (!writeRequestToPipe(request)) {
+        return false;
+    }
+    if (m_routingBuilder.requestWritten(*request)) {
+        writeRoutingRequest();
+    }
+    return true;
+}
+
+bool EffectsManager::writeRequestToPipe(EffectsRequest* request) {
     request->request_id = m_nextRequestId++;
     // TODO(XXX) use preallocated requests to avoid delete calls from engine
     if (m_pRequestPipe->writeMessages(&request, 1) == 1) {
@@ -435,11 +458,19 @@ bool EffectsManager::writeRequest(EffectsRequest* request) {
     return false;
 }
 
+void EffectsManager::writeRoutingRequest() {
+    EffectsRequest* request = new EffectsRequest();
+    request->type = EffectsRequest::SET_EFFECTS_ROUTING;
+    request->SetEffectsRouting.pRouting = m_routingBuilder.build();
+    writeRequestToPipe(request);
+}
+
 void EffectsManager::processEffectsResponses() {
     if (m_pRequestPipe.isNull()) {
         return;
     }
 
+    bool routingChanged = false;
     EffectsResponse response;
     while (m_pRequestPipe->readMessages(&response, 1) == 1) {
         QHash<qint64, EffectsRequest*>::iterator it =
@@ -460,11 +491,21 @@ void EffectsManager::processEffectsResponses() {
             // EngineEffectsManager and functions it calls to handle requests.
 
             collectGarbage(pRequest);
+            if (m_routingBuilder.responseReceived(*pRequest)) {
+                routingChanged = true;
+            }
 
             delete pRequest;
             it = m_activeRequests.erase(it);
         }
     }
+
+    // Chains that have been disabled for an input channel are only removed
+    // from the routing after the effects had a chance to process it for the
+    // last time.
+    if (routingChanged && !m_underDestruction) {
+        writeRoutingRequest();
+    }
 }
 
 void EffectsManager::collectGarbage(const EffectsRequest* pRequest) {
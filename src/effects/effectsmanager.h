@@ -119,6 +119,9 @@ class EffectsManager : public QObject {
 
     void processEffectsResponses();
     void collectGarbage(const EffectsRequest* pResponse);
+    // Sends a new EngineEffectsRouting built from m_routingBuilder
+    void writeRoutingRequest();
+    bool writeRequestToPipe(EffectsRequest* request);
 
     ChannelHandleFactory* m_pChannelHandleFactory;
 
@@ -132,6 +135,7 @@ class EffectsManager : public QObject {
     QScopedPointer<EffectsRequestPipe> m_pRequestPipe;
     qint64 m_nextRequestId;
     QHash<qint64, EffectsRequest*> m_activeRequests;
+    EngineEffectsRoutingBuilder m_routingBuilder;
 
     ControlObject* m_pNumEffectsAvailable;
     // We need to create Control Objects for Equalizers' frequencies
@@ -1,11 +1,17 @@
 #include "effects/lv2/lv2backend.h"
 #include "effects/lv2/lv2manifest.h"
 
-LV2Backend::LV2Backend(QObject* pParent)
-        : EffectsBackend(pParent, EffectBackendType::LV2) {
-    m_pWorld = lilv_world_new();
+// static
+LilvWorld* LV2Backend::loadWorld() {
+    LilvWorld* pWorld = lilv_world_new();
+    lilv_world_load_all(pWorld);
+    return pWorld;
+}
+
+LV2Backend::LV2Backend(QObject* pParent, LilvWorld* pWorld)
+        : EffectsBackend(pParent, EffectBackendType::LV2),
+          m_pWorld(pWorld ? pWorld : loadWorld()) {
     initializeProperties();
-    lilv_world_load_all(m_pWorld);
     enumeratePlugins();
 }
 
@@ -10,9 +10,15 @@
 class LV2Backend : public EffectsBackend {
     Q_OBJECT
   public:
-    LV2Backend(QObject* pParent);
+    // Takes ownership of the world. If none is passed, it is loaded here.
+    LV2Backend(QObject* pParent, LilvWorld* pWorld = nullptr);
     virtual ~LV2Backend();
 
+    // Scans the installed plugins. This takes a while with many plugins
+    // installed, but does not touch any Mixxx state, so it may run on
+    // another thread before the backend is created.
+    static LilvWorld* loadWorld();
+
     void enumeratePlugins();
     const QList<QString> getEffectIds() const;
     const QSet<QString> getDiscoveredPluginIds() const;
@@ -2,6 +2,7 @@
 #include <QFileInfo>
 
 #include "engine/cachingreader.h"
+#include "engine/callbackprofiler.h"
 #include "control/controlobject.h"
 #include "track/track.h"
 #include "util/assert.h"
@@ -64,8 +65,6 @@ CachingReader::CachingReader(QString group,
     connect(&m_worker, SIGNAL(trackLoadFailed(TrackPointer, QString)),
             this, SIGNAL(trackLoadFailed(TrackPointer, QString)),
             Qt::DirectConnection);
-
-    m_worker.start(QThread::HighPriority);
 }
 
 CachingReader::~CachingReader() {
@@ -182,6 +181,7 @@ void CachingReader::newTrack(TrackPointer pTrack) {
 }
 
 void CachingReader::process() {
+    CallbackProfiler::StageScope stage(CallbackProfiler::Stage::Reader);
     ReaderStatusUpdate status;
     while (m_readerStatusFIFO.read(&status, 1) == 1) {
         CachingReaderChunkForOwner* pChunk = static_cast<CachingReaderChunkForOwner*>(status.chunk);
@@ -221,6 +221,7 @@ void CachingReader::process() {
 }
 
 SINT CachingReader::read(SINT startSample, SINT numSamples, bool reverse, CSAMPLE* buffer) {
+    CallbackProfiler::StageScope stage(CallbackProfiler::Stage::Reader);
     VERIFY_OR_DEBUG_ASSERT(buffer) {
         return 0;
     }
@@ -102,6 +102,12 @@ class CachingReader : public QObject {
         m_worker.setScheduler(pScheduler);
     }
 
+    // Determines the order in which the worker pool serves the pending
+    // reads of this reader. Called from the engine callback.
+    void setWorkerPriority(EngineWorker::Priority priority) {
+        m_worker.setPriority(priority);
+    }
+
   signals:
     // Emitted once a new track is loaded and ready to be read from.
     void trackLoading();
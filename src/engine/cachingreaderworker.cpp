@@ -6,7 +6,6 @@
 
 #include "engine/cachingreaderworker.h"
 #include "sources/soundsourceproxy.h"
-#include "util/compatibility.h"
 #include "util/event.h"
 #include "util/logger.h"
 
@@ -25,8 +24,7 @@ CachingReaderWorker::CachingReaderWorker(
           m_tag(QString("CachingReaderWorker %1").arg(m_group)),
           m_pChunkReadRequestFIFO(pChunkReadRequestFIFO),
           m_pReaderStatusFIFO(pReaderStatusFIFO),
-          m_newTrackAvailable(false),
-          m_stop(0) {
+          m_newTrackAvailable(false) {
 }
 
 CachingReaderWorker::~CachingReaderWorker() {
@@ -91,39 +89,39 @@ void CachingReaderWorker::newTrack(TrackPointer pTrack) {
     m_newTrackAvailable = true;
 }
 
-void CachingReaderWorker::run() {
-    unsigned static id = 0; //the id of this thread, for debugging purposes
-    QThread::currentThread()->setObjectName(QString("CachingReaderWorker %1").arg(++id));
-
-    Event::start(m_tag);
-    while (!load_atomic(m_stop)) {
-        // Request is initialized by reading from FIFO
-        CachingReaderChunkReadRequest request;
-        if (m_newTrackAvailable) {
-            TrackPointer pLoadTrack;
-            { // locking scope
-                QMutexLocker locker(&m_newTrackMutex);
-                pLoadTrack = m_pNewTrack;
-                m_pNewTrack.reset();
-                m_newTrackAvailable = false;
-            } // implicitly unlocks the mutex
-            loadTrack(pLoadTrack);
-        } else if (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
-            // Read the requested chunk and send the result
-            const ReaderStatusUpdate update(processReadRequest(request));
-            m_pReaderStatusFIFO->writeBlocking(&update, 1);
-        } else {
-            Event::end(m_tag);
-            m_semaRun.acquire();
-            Event::start(m_tag);
-        }
+bool CachingReaderWorker::processWork() {
+    // Request is initialized by reading from FIFO
+    CachingReaderChunkReadRequest request;
+    if (m_newTrackAvailable) {
+        TrackPointer pLoadTrack;
+        { // locking scope
+            QMutexLocker locker(&m_newTrackMutex);
+            pLoadTrack = m_pNewTrack;
+            m_pNewTrack.reset();
+            m_newTrackAvailable = false;
+        } // implicitly unlocks the mutex
+        Event::start(m_tag);
+        loadTrack(pLoadTrack);
+        Event::end(m_tag);
+    } else if (m_pChunkReadRequestFIFO->read(&request, 1) == 1) {
+        // Read the requested chunk and send the result
+        Event::start(m_tag);
+        const ReaderStatusUpdate update(processReadRequest(request));
+        Event::end(m_tag);
+        m_pReaderStatusFIFO->writeBlocking(&update, 1);
     }
+    return m_newTrackAvailable ||
+            m_pChunkReadRequestFIFO->readAvailable() > 0;
 }
 
 namespace {
 
 mixxx::AudioSourcePointer openAudioSourceForReading(const TrackPointer& pTrack, const mixxx::AudioSource::OpenParams& params) {
-    auto pAudioSource = SoundSourceProxy(pTrack).openAudioSource(params);
+    SoundSourceProxy proxy(pTrack);
+    // Loading the track again will be cheaper for files that are
+    // expensive to decode
+    proxy.setStoreDecodedAudio(true);
+    auto pAudioSource = proxy.openAudioSource(params);
     if (!pAudioSource) {
         kLogger.warning() << "Failed to open file:" << pTrack->getLocation();
     }
@@ -203,9 +201,3 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
                     m_pAudioSource->frameLength());
     emit(trackLoaded(pTrack, m_pAudioSource->sampleRate(), sampleCount));
 }
-
-void CachingReaderWorker::quitWait() {
-    m_stop = 1;
-    m_semaRun.release();
-    wait();
-}
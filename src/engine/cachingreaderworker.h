@@ -3,8 +3,6 @@
 
 #include <QtDebug>
 #include <QMutex>
-#include <QSemaphore>
-#include <QThread>
 #include <QString>
 
 #include "engine/cachingreaderchunk.h"
@@ -68,14 +66,14 @@ class CachingReaderWorker : public EngineWorker {
             FIFO<ReaderStatusUpdate>* pReaderStatusFIFO);
     virtual ~CachingReaderWorker();
 
-    // Request to load a new track. wake() must be called afterwards.
+    // Request to load a new track. workReady() must be called afterwards.
     virtual void newTrack(TrackPointer pTrack);
 
     // Run upkeep operations like loading tracks and reading from file. Run by a
-    // thread pool via the EngineWorkerScheduler.
-    virtual void run();
-
-    void quitWait();
+    // thread pool via the EngineWorkerScheduler. Only a single track load or
+    // chunk read is done per invocation so that readers of decks with a higher
+    // priority get their turn in between.
+    bool processWork() override;
 
   signals:
     // Emitted once a new track is loaded and ready to be read from.
@@ -117,8 +115,6 @@ class CachingReaderWorker : public EngineWorker {
     // This frame index references the frame that follows the
     // last frame with readable sample data.
     mixxx::IndexRange m_readableFrameIndexRange;
-
-    QAtomicInt m_stop;
 };
 
 
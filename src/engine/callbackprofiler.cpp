@@ -0,0 +1,243 @@
+#include "engine/callbackprofiler.h"
+
+#include <cstring>
+
+#include "control/controlobject.h"
+#include "util/logger.h"
+#include "util/math.h"
+
+namespace {
+
+const mixxx::Logger kLogger("CallbackProfiler");
+
+// The budget controls are updated at about the display frame rate
+const int kControlUpdateRate = 30; // in 1/s
+
+// How often the main thread checks for a pending underflow report
+const int kLogIntervalMillis = 500;
+
+enum SnapshotState {
+    SNAPSHOT_FREE = 0,
+    SNAPSHOT_FILLING,
+    SNAPSHOT_READY,
+    SNAPSHOT_LOGGING,
+};
+
+const char* const kStageNames[CallbackProfiler::kStageCount] = {
+    "reader",
+    "scaler",
+    "effects",
+    "mixing",
+    "sidechain",
+};
+
+double nanosToMillis(qint64 nanos) {
+    return nanos / 1000000.0;
+}
+
+} // anonymous namespace
+
+constexpr int CallbackProfiler::kStageCount;
+constexpr int CallbackProfiler::kRecordedCallbacks;
+
+thread_local CallbackProfiler* CallbackProfiler::s_pActiveProfiler = nullptr;
+
+CallbackProfiler::CallbackProfiler(const QString& group, QObject* pParent)
+        : QObject(pParent),
+          m_pCurrentStage(nullptr),
+          m_sampleRate(0),
+          m_frames(0),
+          m_nextRecord(0),
+          m_callbackCount(0),
+          m_accumulatedBudgetNanos(0),
+          m_accumulatedFrames(0),
+          m_underflowPending(0),
+          m_snapshotState(SNAPSHOT_FREE),
+          m_snapshotSize(0) {
+    memset(&m_current, 0, sizeof(m_current));
+    memset(m_records, 0, sizeof(m_records));
+    memset(m_accumulatedNanos, 0, sizeof(m_accumulatedNanos));
+    for (int i = 0; i < kStageCount; ++i) {
+        m_pBudgetUsage[i] = new ControlObject(ConfigKey(group,
+                QString("audio_budget_%1").arg(kStageNames[i])));
+        m_pBudgetUsage[i]->setReadOnly();
+    }
+
+    m_logTimer.setInterval(kLogIntervalMillis);
+    connect(&m_logTimer, SIGNAL(timeout()),
+            this, SLOT(slotLogUnderflow()));
+    m_logTimer.start();
+}
+
+CallbackProfiler::~CallbackProfiler() {
+    for (int i = 0; i < kStageCount; ++i) {
+        delete m_pBudgetUsage[i];
+    }
+}
+
+// static
+QString CallbackProfiler::stageName(Stage stage) {
+    return kStageNames[static_cast<int>(stage)];
+}
+
+CallbackProfiler::CallbackScope::CallbackScope(
+        CallbackProfiler* pProfiler, int frames, int sampleRate)
+        : m_pProfiler(pProfiler) {
+    if (m_pProfiler) {
+        s_pActiveProfiler = m_pProfiler;
+        m_pProfiler->callbackStarted(frames, sampleRate);
+    }
+}
+
+CallbackProfiler::CallbackScope::~CallbackScope() {
+    if (m_pProfiler) {
+        m_pProfiler->callbackFinished();
+        s_pActiveProfiler = nullptr;
+    }
+}
+
+void CallbackProfiler::reportUnderflow() {
+    m_underflowPending.fetchAndStoreRelaxed(1);
+}
+
+void CallbackProfiler::callbackStarted(int frames, int sampleRate) {
+    m_frames = frames;
+    m_sampleRate = sampleRate;
+    memset(&m_current, 0, sizeof(m_current));
+    m_current.callbackNumber = m_callbackCount++;
+    if (sampleRate > 0) {
+        m_current.budgetNanos = static_cast<qint64>(frames) *
+                mixxx::Duration::kNanosPerSecond / sampleRate;
+    }
+    m_pCurrentStage = nullptr;
+    m_callbackTimer.start();
+}
+
+void CallbackProfiler::stageFinished(StageScope* pScope) {
+    const qint64 elapsedNanos = pScope->m_timer.elapsed().toIntegerNanos();
+    m_current.stageNanos[static_cast<int>(pScope->m_stage)] +=
+            elapsedNanos - pScope->m_childNanos;
+    if (pScope->m_pParent) {
+        pScope->m_pParent->m_childNanos += elapsedNanos;
+    }
+    m_pCurrentStage = pScope->m_pParent;
+}
+
+void CallbackProfiler::callbackFinished() {
+    m_current.totalNanos = m_callbackTimer.elapsed().toIntegerNanos();
+    // Whatever has not been attributed to another stage
+    qint64 attributedNanos = 0;
+    for (int i = 0; i < kStageCount; ++i) {
+        attributedNanos += m_current.stageNanos[i];
+    }
+    m_current.stageNanos[static_cast<int>(Stage::Mixing)] +=
+            math_max(m_current.totalNanos - attributedNanos, qint64(0));
+
+    m_records[m_nextRecord] = m_current;
+    m_nextRecord = (m_nextRecord + 1) % kRecordedCallbacks;
+
+    for (int i = 0; i < kStageCount; ++i) {
+        m_accumulatedNanos[i] += m_current.stageNanos[i];
+    }
+    m_accumulatedBudgetNanos += m_current.budgetNanos;
+    m_accumulatedFrames += m_frames;
+    if (m_sampleRate > 0 &&
+            m_accumulatedFrames >= m_sampleRate / kControlUpdateRate) {
+        updateControls();
+    }
+
+    if (m_underflowPending.fetchAndStoreRelaxed(0) != 0) {
+        takeSnapshot();
+    }
+}
+
+void CallbackProfiler::updateControls() {
+    for (int i = 0; i < kStageCount; ++i) {
+        if (m_accumulatedBudgetNanos > 0) {
+            m_pBudgetUsage[i]->forceSet(
+                    static_cast<double>(m_accumulatedNanos[i]) /
+                    m_accumulatedBudgetNanos);
+        }
+        m_accumulatedNanos[i] = 0;
+    }
+    m_accumulatedBudgetNanos = 0;
+    m_accumulatedFrames = 0;
+}
+
+void CallbackProfiler::takeSnapshot() {
+    if (!m_snapshotState.testAndSetAcquire(SNAPSHOT_FREE, SNAPSHOT_FILLING)) {
+        // The previous underflow has not been logged yet
+        return;
+    }
+    // Oldest callback first
+    const int recordCount = static_cast<int>(
+            math_min(m_callbackCount, static_cast<quint64>(kRecordedCallbacks)));
+    const int firstRecord = recordCount < kRecordedCallbacks ? 0 : m_nextRecord;
+    for (int i = 0; i < recordCount; ++i) {
+        m_snapshot[i] = m_records[(firstRecord + i) % kRecordedCallbacks];
+    }
+    m_snapshotSize = recordCount;
+    m_snapshotState.fetchAndStoreRelease(SNAPSHOT_READY);
+}
+
+void CallbackProfiler::slotLogUnderflow() {
+    if (!m_snapshotState.testAndSetAcquire(SNAPSHOT_READY, SNAPSHOT_LOGGING)) {
+        return;
+    }
+
+    int slowestRecord = -1;
+    bool budgetExceeded = false;
+    for (int i = 0; i < m_snapshotSize; ++i) {
+        if (slowestRecord < 0 ||
+                m_snapshot[i].totalNanos > m_snapshot[slowestRecord].totalNanos) {
+            slowestRecord = i;
+        }
+        if (m_snapshot[i].totalNanos > m_snapshot[i].budgetNanos) {
+            budgetExceeded = true;
+        }
+    }
+
+    kLogger.warning()
+            << "Buffer underflow, the last" << m_snapshotSize
+            << "engine callbacks took (ms):";
+    for (int i = 0; i < m_snapshotSize; ++i) {
+        const CallbackRecord& record = m_snapshot[i];
+        const bool highlight = budgetExceeded ?
+                record.totalNanos > record.budgetNanos : i == slowestRecord;
+        kLogger.warning() << formatRecord(record, highlight).toLocal8Bit().constData();
+    }
+    if (!budgetExceeded) {
+        kLogger.warning()
+                << "No engine callback exceeded its budget, the underflow"
+                << "was caused outside of the engine, e.g. by the audio"
+                << "driver or a competing process";
+    }
+
+    m_snapshotState.fetchAndStoreRelease(SNAPSHOT_FREE);
+}
+
+// static
+QString CallbackProfiler::formatRecord(const CallbackRecord& record,
+        bool highlight) {
+    int offendingStage = 0;
+    for (int i = 1; i < kStageCount; ++i) {
+        if (record.stageNanos[i] > record.stageNanos[offendingStage]) {
+            offendingStage = i;
+        }
+    }
+    QString line = QString("#%1 total %2 of %3")
+            .arg(record.callbackNumber)
+            .arg(nanosToMillis(record.totalNanos), 0, 'f', 3)
+            .arg(nanosToMillis(record.budgetNanos), 0, 'f', 3);
+    for (int i = 0; i < kStageCount; ++i) {
+        const QString stage = QString("%1 %2")
+                .arg(kStageNames[i])
+                .arg(nanosToMillis(record.stageNanos[i]), 0, 'f', 3);
+        if (highlight && i == offendingStage) {
+            line += QString(" >>%1<<").arg(stage);
+        } else {
+            line += " " + stage;
+        }
+    }
+    return line;
+}
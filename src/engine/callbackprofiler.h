@@ -0,0 +1,131 @@
+#ifndef ENGINE_CALLBACKPROFILER_H
+#define ENGINE_CALLBACKPROFILER_H
+
+#include <QAtomicInt>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include "util/performancetimer.h"
+
+class ControlObject;
+
+// Attributes the time spent in each engine callback to the stages of the
+// signal path. The most recent callbacks are kept in a ring that is dumped
+// to the log when a buffer underflow is reported, with the stage that blew
+// the budget of a callback highlighted. The average share of the callback
+// budget that each stage uses is published as a control, e.g.
+// [Master],audio_budget_scaler with 1.0 meaning the whole budget.
+//
+// EngineMaster::process() opens a CallbackScope. StageScopes opened within
+// it on the same thread are attributed to that callback, excluding the time
+// of nested StageScopes. Everything else counts as mixing. Outside of a
+// CallbackScope StageScopes do nothing.
+class CallbackProfiler : public QObject {
+    Q_OBJECT
+  public:
+    enum class Stage {
+        Reader,
+        Scaler,
+        Effects,
+        Mixing,
+        Sidechain,
+    };
+    static constexpr int kStageCount = 5;
+    // The number of callbacks that are dumped after an underflow
+    static constexpr int kRecordedCallbacks = 32;
+
+    CallbackProfiler(const QString& group, QObject* pParent = nullptr);
+    ~CallbackProfiler() override;
+
+    class CallbackScope {
+      public:
+        CallbackScope(CallbackProfiler* pProfiler, int frames, int sampleRate);
+        ~CallbackScope();
+
+      private:
+        CallbackProfiler* m_pProfiler;
+    };
+
+    class StageScope {
+      public:
+        explicit StageScope(Stage stage)
+                : m_pProfiler(s_pActiveProfiler),
+                  m_stage(stage),
+                  m_pParent(nullptr),
+                  m_childNanos(0) {
+            if (m_pProfiler) {
+                m_pParent = m_pProfiler->m_pCurrentStage;
+                m_pProfiler->m_pCurrentStage = this;
+                m_timer.start();
+            }
+        }
+        ~StageScope() {
+            if (m_pProfiler) {
+                m_pProfiler->stageFinished(this);
+            }
+        }
+
+      private:
+        CallbackProfiler* m_pProfiler;
+        const Stage m_stage;
+        StageScope* m_pParent;
+        qint64 m_childNanos;
+        PerformanceTimer m_timer;
+
+        friend class CallbackProfiler;
+    };
+
+    // Realtime safe, may be called from any thread. The recorded callbacks
+    // are logged from the main thread shortly after.
+    void reportUnderflow();
+
+    static QString stageName(Stage stage);
+
+  private slots:
+    void slotLogUnderflow();
+
+  private:
+    struct CallbackRecord {
+        quint64 callbackNumber;
+        qint64 budgetNanos;
+        qint64 totalNanos;
+        qint64 stageNanos[kStageCount];
+    };
+
+    // Engine thread only
+    void callbackStarted(int frames, int sampleRate);
+    void callbackFinished();
+    void stageFinished(StageScope* pScope);
+    void updateControls();
+    void takeSnapshot();
+
+    static QString formatRecord(const CallbackRecord& record, bool highlight);
+
+    static thread_local CallbackProfiler* s_pActiveProfiler;
+
+    ControlObject* m_pBudgetUsage[kStageCount];
+
+    // Only accessed by the engine thread
+    PerformanceTimer m_callbackTimer;
+    CallbackRecord m_current;
+    StageScope* m_pCurrentStage;
+    int m_sampleRate;
+    int m_frames;
+    CallbackRecord m_records[kRecordedCallbacks];
+    int m_nextRecord;
+    quint64 m_callbackCount;
+    qint64 m_accumulatedNanos[kStageCount];
+    qint64 m_accumulatedBudgetNanos;
+    int m_accumulatedFrames;
+
+    // Handed over from the engine to the main thread
+    QAtomicInt m_underflowPending;
+    QAtomicInt m_snapshotState;
+    CallbackRecord m_snapshot[kRecordedCallbacks];
+    int m_snapshotSize;
+
+    QTimer m_logTimer;
+};
+
+#endif /* ENGINE_CALLBACKPROFILER_H */
@@ -157,8 +157,10 @@ class ChannelHandleMap {
     typedef typename QVarLengthArray<T, kMaxExpectedGroups>::const_iterator const_iterator;
     typedef typename QVarLengthArray<T, kMaxExpectedGroups>::iterator iterator;
 
+    // Unlike operator[] this never expands the map. Handles without an
+    // entry yield a default constructed T.
     const T& at(const ChannelHandle& handle) const {
-        if (!handle.valid()) {
+        if (!handle.valid() || handle.handle() >= m_data.size()) {
             return m_dummy;
         }
         return m_data.at(handle.handle());
@@ -84,6 +84,24 @@ bool EngineEffectChain::updateParameters(const EffectsRequest& message) {
     } else if (m_enableState == EffectEnableState::Disabled && message.SetEffectParameters.enabled) {
         m_enableState = EffectEnableState::Enabling;
     }
+
+    // process() is only called for input channels the chain is routed for,
+    // so it cannot complete the transition if there are none.
+    bool routed = false;
+    for (const auto& outputMap : m_chainStatusForChannelMatrix) {
+        for (const auto& outputChannelStatus : outputMap) {
+            if (outputChannelStatus.enable_state != EffectEnableState::Disabled) {
+                routed = true;
+            }
+        }
+    }
+    if (!routed) {
+        if (m_enableState == EffectEnableState::Disabling) {
+            m_enableState = EffectEnableState::Disabled;
+        } else if (m_enableState == EffectEnableState::Enabling) {
+            m_enableState = EffectEnableState::Enabled;
+        }
+    }
     return true;
 }
 
@@ -162,6 +180,9 @@ bool EngineEffectChain::enableForInputChannel(const ChannelHandle* inputHandle,
             return false;
         }
         outputChannelStatus.enable_state = EffectEnableState::Enabling;
+        // The chain has not been processed for this channel while it was
+        // disabled, start ramping from the current mix.
+        outputChannelStatus.old_gain = m_dMix;
     }
     for (int i = 0; i < m_effects.size(); ++i) {
         if (m_effects[i] != nullptr) {
@@ -231,7 +252,8 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
                                 CSAMPLE* pIn, CSAMPLE* pOut,
                                 const unsigned int numSamples,
                                 const unsigned int sampleRate,
-                                const GroupFeatureState& groupFeatures) {
+                                const GroupFeatureState& groupFeatures,
+                                const QVector<EngineEffect*>& effects) {
     // Compute the effective enable state from the channel input routing switch and
     // the chain's enable state. When either of these are turned on/off, send the
     // effects the intermediate enabling/disabling signal.
@@ -264,24 +286,22 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
         CSAMPLE* pIntermediateInput = pIn;
         CSAMPLE* pIntermediateOutput;
 
-        for (EngineEffect* pEffect: m_effects) {
-            if (pEffect != nullptr) {
-                // Select an unused intermediate buffer for the next output
-                if (pIntermediateInput == m_buffer1.data()) {
-                    pIntermediateOutput = m_buffer2.data();
-                } else {
-                    pIntermediateOutput = m_buffer1.data();
-                }
+        for (EngineEffect* pEffect : effects) {
+            // Select an unused intermediate buffer for the next output
+            if (pIntermediateInput == m_buffer1.data()) {
+                pIntermediateOutput = m_buffer2.data();
+            } else {
+                pIntermediateOutput = m_buffer1.data();
+            }
 
-                if (pEffect->process(inputHandle, outputHandle,
-                                     pIntermediateInput, pIntermediateOutput,
-                                     numSamples, sampleRate,
-                                     effectiveChainEnableState, groupFeatures,
-                                     m_mixMode)) {
-                    processingOccured = true;
-                    // Output of this effect becomes the input of the next effect
-                    pIntermediateInput = pIntermediateOutput;
-                }
+            if (pEffect->process(inputHandle, outputHandle,
+                                 pIntermediateInput, pIntermediateOutput,
+                                 numSamples, sampleRate,
+                                 effectiveChainEnableState, groupFeatures,
+                                 m_mixMode)) {
+                processingOccured = true;
+                // Output of this effect becomes the input of the next effect
+                pIntermediateInput = pIntermediateOutput;
             }
         }
 
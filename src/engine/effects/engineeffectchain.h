@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QList>
+#include <QVector>
 #include <QLinkedList>
 
 #include "util/class.h"
@@ -27,12 +28,15 @@ class EngineEffectChain : public EffectsRequestHandler {
         EffectsRequest& message,
         EffectsResponsePipe* pResponsePipe);
 
+    // Processes the effects of this chain in the order given by effects,
+    // the non-empty effect slots from the EngineEffectsRouting.
     bool process(const ChannelHandle& inputHandle,
                  const ChannelHandle& outputHandle,
                  CSAMPLE* pIn, CSAMPLE* pOut,
                  const unsigned int numSamples,
                  const unsigned int sampleRate,
-                 const GroupFeatureState& groupFeatures);
+                 const GroupFeatureState& groupFeatures,
+                 const QVector<EngineEffect*>& effects);
 
     const QString& id() const {
         return m_id;
@@ -5,8 +5,7 @@
 
 #include "engine/channelhandle.h"
 #include "engine/effects/message.h"
-#include "engine/effects/groupfeaturestate.h"
-#include "util/samplebuffer.h"
+#include "util/class.h"
 
 class EngineEffectChain;
 
@@ -20,13 +19,6 @@ class EngineEffectRack : public EffectsRequestHandler {
         EffectsRequest& message,
         EffectsResponsePipe* pResponsePipe);
 
-    bool process(const ChannelHandle& inputHandle,
-                 const ChannelHandle& outputHandle,
-                 CSAMPLE* pIn, CSAMPLE* pOut,
-                 const unsigned int numSamples,
-                 const unsigned int sampleRate,
-                 const GroupFeatureState& groupFeatures);
-
     int number() const {
         return m_iRackNumber;
     }
@@ -42,9 +34,6 @@ class EngineEffectRack : public EffectsRequestHandler {
     int m_iRackNumber;
     QList<EngineEffectChain*> m_chains;
 
-    mixxx::SampleBuffer m_buffer1;
-    mixxx::SampleBuffer m_buffer2;
-
     DISALLOW_COPY_AND_ASSIGN(EngineEffectRack);
 };
 
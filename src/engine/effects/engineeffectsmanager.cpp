@@ -1,5 +1,8 @@
 #include "engine/effects/engineeffectsmanager.h"
 
+#include <utility>
+
+#include "engine/callbackprofiler.h"
 #include "engine/effects/engineeffectrack.h"
 #include "engine/effects/engineeffectchain.h"
 #include "engine/effects/engineeffect.h"
@@ -9,6 +12,7 @@
 
 EngineEffectsManager::EngineEffectsManager(EffectsResponsePipe* pResponsePipe)
         : m_pResponsePipe(pResponsePipe),
+          m_pRouting(new EngineEffectsRouting()),
           m_buffer1(MAX_BUFFER_LEN),
           m_buffer2(MAX_BUFFER_LEN) {
     // Try to prevent memory allocation.
@@ -17,9 +21,11 @@ EngineEffectsManager::EngineEffectsManager(EffectsResponsePipe* pResponsePipe)
 }
 
 EngineEffectsManager::~EngineEffectsManager() {
+    delete m_pRouting;
 }
 
 void EngineEffectsManager::onCallbackStart() {
+    CallbackProfiler::StageScope profilerStage(CallbackProfiler::Stage::Effects);
     EffectsRequest* request = NULL;
     while (m_pResponsePipe->readMessages(&request, 1) > 0) {
         EffectsResponse response(*request);
@@ -27,6 +33,7 @@ void EngineEffectsManager::onCallbackStart() {
         switch (request->type) {
             case EffectsRequest::ADD_EFFECT_RACK:
             case EffectsRequest::REMOVE_EFFECT_RACK:
+            case EffectsRequest::SET_EFFECTS_ROUTING:
                 if (processEffectsRequest(*request, m_pResponsePipe.data())) {
                     processed = true;
                 }
@@ -178,30 +185,33 @@ void EngineEffectsManager::processInner(
     const GroupFeatureState& groupFeatures,
     const CSAMPLE_GAIN oldGain,
     const CSAMPLE_GAIN newGain) {
+    CallbackProfiler::StageScope profilerStage(CallbackProfiler::Stage::Effects);
 
-    const QList<EngineEffectRack*>& racks = m_racksByStage.value(stage);
+    // The chains of all racks of this stage that are enabled for the input,
+    // in processing order.
+    const EngineEffectsRouting::ChainRoutes& routes =
+            m_pRouting->chainsForInput(stage, inputHandle);
     if (pIn == pOut) {
         // Gain and effects are applied to the buffer in place,
         // modifying the original input buffer
         SampleUtil::applyRampingGain(pIn, oldGain, newGain, numSamples);
-        for (EngineEffectRack* pRack : racks) {
-            if (pRack != nullptr) {
-                pRack->process(inputHandle, outputHandle,
-                               pIn, pIn,
-                               numSamples, sampleRate, groupFeatures);
-            }
+        for (const EngineEffectsRouting::ChainRoute& route : routes) {
+            route.pChain->process(inputHandle, outputHandle,
+                                  pIn, pIn,
+                                  numSamples, sampleRate, groupFeatures,
+                                  route.effects);
         }
     } else {
         // Do not modify the input buffer.
         // 1. Copy input buffer to a temporary buffer
         // 2. Apply gain to temporary buffer
-        // 2. Process temporary buffer with each effect rack in series
+        // 2. Process temporary buffer with each effect chain in series
         // 3. Mix the temporary buffer into pOut
         //    ChannelMixer::applyEffectsAndMixChannels use
         //    this to mix channels into pOut regardless of whether any effects were processed.
         CSAMPLE* pIntermediateInput = m_buffer1.data();
         if (oldGain == CSAMPLE_GAIN_ONE && newGain == CSAMPLE_GAIN_ONE) {
-            // Avoid an unnecessary copy. EngineEffectRack::process does not modify the
+            // Avoid an unnecessary copy. EngineEffectChain::process does not modify the
             // input buffer when its input & output buffers are different, so this is okay.
             pIntermediateInput = pIn;
         } else {
@@ -210,25 +220,24 @@ void EngineEffectsManager::processInner(
         }
 
         CSAMPLE* pIntermediateOutput;
-        for (EngineEffectRack* pRack : racks) {
-            if (pRack != nullptr) {
-                // Select an unused intermediate buffer for the next output
-                if (pIntermediateInput == m_buffer1.data()) {
-                    pIntermediateOutput = m_buffer2.data();
-                } else {
-                    pIntermediateOutput = m_buffer1.data();
-                }
+        for (const EngineEffectsRouting::ChainRoute& route : routes) {
+            // Select an unused intermediate buffer for the next output
+            if (pIntermediateInput == m_buffer1.data()) {
+                pIntermediateOutput = m_buffer2.data();
+            } else {
+                pIntermediateOutput = m_buffer1.data();
+            }
 
-                if (pRack->process(inputHandle, outputHandle,
-                                   pIntermediateInput, pIntermediateOutput,
-                                   numSamples, sampleRate, groupFeatures)) {
-                    // Output of this rack becomes the input of the next rack.
-                    pIntermediateInput = pIntermediateOutput;
-                }
+            if (route.pChain->process(inputHandle, outputHandle,
+                                      pIntermediateInput, pIntermediateOutput,
+                                      numSamples, sampleRate, groupFeatures,
+                                      route.effects)) {
+                // Output of this chain becomes the input of the next chain.
+                pIntermediateInput = pIntermediateOutput;
             }
         }
-        // pIntermediateInput is the output of the last processed rack. It would be the
-        // intermediate input of the next rack if there was one.
+        // pIntermediateInput is the output of the last processed chain. It would be the
+        // intermediate input of the next chain if there was one.
         SampleUtil::add(pOut, pIntermediateInput, numSamples);
     }
 }
@@ -272,6 +281,20 @@ bool EngineEffectsManager::processEffectsRequest(EffectsRequest& message,
             response.success = removeEffectRack(message.AddEffectRack.pRack,
                     message.AddEffectRack.signalProcessingStage);
             break;
+        case EffectsRequest::SET_EFFECTS_ROUTING:
+            if (kEffectDebugOutput) {
+                qDebug() << debugString() << "SET_EFFECTS_ROUTING"
+                         << message.SetEffectsRouting.pRouting;
+            }
+            VERIFY_OR_DEBUG_ASSERT(message.SetEffectsRouting.pRouting) {
+                response.success = false;
+                break;
+            }
+            // The replaced routing is deleted with the request in the main
+            // thread.
+            std::swap(m_pRouting, message.SetEffectsRouting.pRouting);
+            response.success = true;
+            break;
         default:
             return false;
     }
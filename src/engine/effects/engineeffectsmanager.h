@@ -8,6 +8,7 @@
 #include "util/fifo.h"
 #include "engine/effects/message.h"
 #include "engine/effects/groupfeaturestate.h"
+#include "engine/effects/engineeffectsrouting.h"
 #include "engine/channelhandle.h"
 
 class EngineEffectRack;
@@ -85,6 +86,8 @@ class EngineEffectsManager : public EffectsRequestHandler {
 
     QScopedPointer<EffectsResponsePipe> m_pResponsePipe;
     QHash<SignalProcessingStage, QList<EngineEffectRack*>> m_racksByStage;
+    // Built by EffectsManager, replaced with SET_EFFECTS_ROUTING
+    EngineEffectsRouting* m_pRouting;
     QList<EngineEffectChain*> m_chains;
     QList<EngineEffect*> m_effects;
 
@@ -0,0 +1,155 @@
+#include "engine/effects/engineeffectsrouting.h"
+
+#include "engine/effects/message.h"
+
+namespace {
+
+// Chains and effects are stored at the slot index of the request, the same
+// way as EngineEffectRack and EngineEffectChain do.
+template <typename T>
+void setAt(QList<T*>* pList, int iIndex, T* pItem) {
+    if (iIndex < 0) {
+        return;
+    }
+    while (iIndex >= pList->size()) {
+        pList->append(nullptr);
+    }
+    pList->replace(iIndex, pItem);
+}
+
+template <typename T>
+void clearAt(QList<T*>* pList, int iIndex, T* pItem) {
+    if (iIndex >= 0 && iIndex < pList->size() &&
+            pList->at(iIndex) == pItem) {
+        pList->replace(iIndex, nullptr);
+    }
+}
+
+} // anonymous namespace
+
+bool EngineEffectsRoutingBuilder::requestWritten(const EffectsRequest& request) {
+    switch (request.type) {
+        case EffectsRequest::ADD_EFFECT_RACK:
+            m_racksByStage[request.AddEffectRack.signalProcessingStage]
+                    .append(request.AddEffectRack.pRack);
+            return true;
+        case EffectsRequest::REMOVE_EFFECT_RACK:
+            m_racksByStage[request.RemoveEffectRack.signalProcessingStage]
+                    .removeAll(request.RemoveEffectRack.pRack);
+            for (EngineEffectChain* pChain :
+                    m_chainsByRack.take(request.RemoveEffectRack.pRack)) {
+                if (pChain != nullptr) {
+                    removeChain(pChain);
+                }
+            }
+            return true;
+        case EffectsRequest::ADD_CHAIN_TO_RACK:
+            setAt(&m_chainsByRack[request.pTargetRack],
+                    request.AddChainToRack.iIndex,
+                    request.AddChainToRack.pChain);
+            return true;
+        case EffectsRequest::REMOVE_CHAIN_FROM_RACK:
+            clearAt(&m_chainsByRack[request.pTargetRack],
+                    request.RemoveChainFromRack.iIndex,
+                    request.RemoveChainFromRack.pChain);
+            removeChain(request.RemoveChainFromRack.pChain);
+            return true;
+        case EffectsRequest::ADD_EFFECT_TO_CHAIN:
+            setAt(&m_effectsByChain[request.pTargetChain],
+                    request.AddEffectToChain.iIndex,
+                    request.AddEffectToChain.pEffect);
+            return true;
+        case EffectsRequest::REMOVE_EFFECT_FROM_CHAIN:
+            clearAt(&m_effectsByChain[request.pTargetChain],
+                    request.RemoveEffectFromChain.iIndex,
+                    request.RemoveEffectFromChain.pEffect);
+            return true;
+        case EffectsRequest::ENABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL: {
+            const ChannelHandle& inputHandle =
+                    *request.EnableInputChannelForChain.pChannelHandle;
+            m_disablingInputsByChain[request.pTargetChain].remove(inputHandle);
+            QSet<ChannelHandle>& inputs = m_inputsByChain[request.pTargetChain];
+            if (inputs.contains(inputHandle)) {
+                return false;
+            }
+            inputs.insert(inputHandle);
+            return true;
+        }
+        case EffectsRequest::DISABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL: {
+            // The chain stays routed until the engine has responded
+            const ChannelHandle& inputHandle =
+                    *request.DisableInputChannelForChain.pChannelHandle;
+            if (m_inputsByChain.value(request.pTargetChain).contains(inputHandle)) {
+                m_disablingInputsByChain[request.pTargetChain].insert(inputHandle);
+            }
+            return false;
+        }
+        default:
+            return false;
+    }
+}
+
+bool EngineEffectsRoutingBuilder::responseReceived(const EffectsRequest& request) {
+    if (request.type != EffectsRequest::DISABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL) {
+        return false;
+    }
+    const ChannelHandle& inputHandle =
+            *request.DisableInputChannelForChain.pChannelHandle;
+    auto it = m_disablingInputsByChain.find(request.pTargetChain);
+    if (it == m_disablingInputsByChain.end() || !it->remove(inputHandle)) {
+        // Enabled again in the meantime or the chain is gone
+        return false;
+    }
+    m_inputsByChain[request.pTargetChain].remove(inputHandle);
+    return true;
+}
+
+// static
+bool EngineEffectsRoutingBuilder::routingPrecedesRequest(
+        const EffectsRequest& request) {
+    switch (request.type) {
+        case EffectsRequest::REMOVE_EFFECT_RACK:
+        case EffectsRequest::REMOVE_CHAIN_FROM_RACK:
+        case EffectsRequest::REMOVE_EFFECT_FROM_CHAIN:
+            return true;
+        default:
+            return false;
+    }
+}
+
+EngineEffectsRouting* EngineEffectsRoutingBuilder::build() const {
+    EngineEffectsRouting* pRouting = new EngineEffectsRouting();
+    for (auto it = m_racksByStage.begin(); it != m_racksByStage.end(); ++it) {
+        ChannelHandleMap<EngineEffectsRouting::ChainRoutes>& routes =
+                it.key() == SignalProcessingStage::Prefader ?
+                        pRouting->m_prefaderRoutes : pRouting->m_postfaderRoutes;
+        for (EngineEffectRack* pRack : it.value()) {
+            for (EngineEffectChain* pChain : m_chainsByRack.value(pRack)) {
+                if (pChain == nullptr) {
+                    continue;
+                }
+                const QSet<ChannelHandle> inputs = m_inputsByChain.value(pChain);
+                if (inputs.isEmpty()) {
+                    continue;
+                }
+                EngineEffectsRouting::ChainRoute route;
+                route.pChain = pChain;
+                for (EngineEffect* pEffect : m_effectsByChain.value(pChain)) {
+                    if (pEffect != nullptr) {
+                        route.effects.append(pEffect);
+                    }
+                }
+                for (const ChannelHandle& inputHandle : inputs) {
+                    routes[inputHandle].append(route);
+                }
+            }
+        }
+    }
+    return pRouting;
+}
+
+void EngineEffectsRoutingBuilder::removeChain(EngineEffectChain* pChain) {
+    m_effectsByChain.remove(pChain);
+    m_inputsByChain.remove(pChain);
+    m_disablingInputsByChain.remove(pChain);
+}
@@ -0,0 +1,99 @@
+#ifndef ENGINEEFFECTSROUTING_H
+#define ENGINEEFFECTSROUTING_H
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QVector>
+
+#include "effects/defs.h"
+#include "engine/channelhandle.h"
+
+class EngineEffectRack;
+class EngineEffectChain;
+class EngineEffect;
+struct EffectsRequest;
+
+// A precompiled, immutable routing table for the effects of one stage of the
+// signal path. For every input channel it lists the chains that are enabled
+// for it, flattened over all racks of the stage in processing order, together
+// with the effects loaded into each chain. EngineEffectsManager only iterates
+// these arrays instead of walking racks, chains and empty effect slots.
+//
+// Tables are built by EngineEffectsRoutingBuilder in the main thread and
+// handed over to the engine with a SET_EFFECTS_ROUTING request. The engine
+// sends the replaced table back in the same request, which deletes it.
+class EngineEffectsRouting {
+  public:
+    struct ChainRoute {
+        ChainRoute()
+                : pChain(nullptr) {
+        }
+        EngineEffectChain* pChain;
+        QVector<EngineEffect*> effects;
+    };
+    typedef QVector<ChainRoute> ChainRoutes;
+
+    EngineEffectsRouting() {
+    }
+
+    // Lookups never allocate and are safe to do in the engine thread.
+    const ChainRoutes& chainsForInput(SignalProcessingStage stage,
+            const ChannelHandle& inputHandle) const {
+        return routesForStage(stage).at(inputHandle);
+    }
+
+  private:
+    const ChannelHandleMap<ChainRoutes>& routesForStage(
+            SignalProcessingStage stage) const {
+        return stage == SignalProcessingStage::Prefader ?
+                m_prefaderRoutes : m_postfaderRoutes;
+    }
+
+    ChannelHandleMap<ChainRoutes> m_prefaderRoutes;
+    ChannelHandleMap<ChainRoutes> m_postfaderRoutes;
+
+    friend class EngineEffectsRoutingBuilder;
+};
+
+// Mirrors the structure of the engine effects from the requests that are sent
+// to the EngineEffectsManager and builds EngineEffectsRouting tables from it.
+// Only used by EffectsManager in the main thread.
+class EngineEffectsRoutingBuilder {
+  public:
+    EngineEffectsRoutingBuilder() {
+    }
+
+    // Updates the mirrored structure for a request before it is written to
+    // the request pipe. Returns true if the routing has changed.
+    bool requestWritten(const EffectsRequest& request);
+
+    // Updates the mirrored structure after the engine has responded to a
+    // request. Returns true if the routing has changed.
+    bool responseReceived(const EffectsRequest& request);
+
+    // Returns true if the engine must stop routing audio through objects of
+    // the request before it is processed, because they are deleted once the
+    // engine has responded. Otherwise the new routing must follow the request.
+    static bool routingPrecedesRequest(const EffectsRequest& request);
+
+    // Creates a new table from the current structure. The caller takes
+    // ownership.
+    EngineEffectsRouting* build() const;
+
+  private:
+    void removeChain(EngineEffectChain* pChain);
+
+    QHash<SignalProcessingStage, QList<EngineEffectRack*>> m_racksByStage;
+    QHash<EngineEffectRack*, QList<EngineEffectChain*>> m_chainsByRack;
+    QHash<EngineEffectChain*, QList<EngineEffect*>> m_effectsByChain;
+    // Input channels a chain is routed for, including those that are still
+    // in the process of being disabled.
+    QHash<EngineEffectChain*, QSet<ChannelHandle>> m_inputsByChain;
+    // Input channels that stay routed until the engine has responded to
+    // DISABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL, because the effects need to
+    // process them one last time.
+    QHash<EngineEffectChain*, QSet<ChannelHandle>> m_disablingInputsByChain;
+};
+
+#endif /* ENGINEEFFECTSROUTING_H */
@@ -9,6 +9,7 @@
 #include "util/memory.h"
 #include "effects/defs.h"
 #include "engine/channelhandle.h"
+#include "engine/effects/engineeffectsrouting.h"
 
 class EngineEffectRack;
 class EngineEffectChain;
@@ -19,6 +20,7 @@ struct EffectsRequest {
         // Messages for EngineEffectsManager
         ADD_EFFECT_RACK = 0,
         REMOVE_EFFECT_RACK,
+        SET_EFFECTS_ROUTING,
 
         // Messages for EngineEffectRack
         ADD_CHAIN_TO_RACK,
@@ -54,6 +56,7 @@ struct EffectsRequest {
 #define CLEAR_STRUCT(x) memset(&x, 0, sizeof(x));
         CLEAR_STRUCT(AddEffectRack);
         CLEAR_STRUCT(RemoveEffectRack);
+        CLEAR_STRUCT(SetEffectsRouting);
         CLEAR_STRUCT(AddChainToRack);
         CLEAR_STRUCT(RemoveChainFromRack);
         CLEAR_STRUCT(EnableInputChannelForChain);
@@ -77,6 +80,10 @@ struct EffectsRequest {
             // to EffectProcessorImpl. The EffectStates are managed by
             // EffectProcessorImpl.
             delete EnableInputChannelForChain.pEffectStatesMapArray;
+        } else if (type == SET_EFFECTS_ROUTING) {
+            // Either the new routing that has never reached the engine or
+            // the replaced one that has been sent back.
+            delete SetEffectsRouting.pRouting;
         }
     }
 
@@ -111,6 +118,9 @@ struct EffectsRequest {
             EngineEffectRack* pRack;
             SignalProcessingStage signalProcessingStage;
         } RemoveEffectRack;
+        struct {
+            EngineEffectsRouting* pRouting;
+        } SetEffectsRouting;
         struct {
             EngineEffectChain* pChain;
             int iIndex;
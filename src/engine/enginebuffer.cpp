@@ -3,6 +3,7 @@
 #include <QtDebug>
 
 #include "engine/cachingreader.h"
+#include "engine/callbackprofiler.h"
 #include "preferences/usersettings.h"
 #include "control/controlindicator.h"
 #include "control/controllinpotmeter.h"
@@ -14,6 +15,7 @@
 #include "engine/cuecontrol.h"
 #include "engine/enginebufferscalelinear.h"
 #include "engine/enginebufferscalerubberband.h"
+#include "engine/enginebufferscalesinc.h"
 #include "engine/enginebufferscalest.h"
 #include "engine/enginechannel.h"
 #include "engine/enginecontrol.h"
@@ -26,6 +28,7 @@
 #include "engine/readaheadmanager.h"
 #include "engine/sync/enginesync.h"
 #include "engine/sync/synccontrol.h"
+#include "mixer/playermanager.h"
 #include "track/beatfactory.h"
 #include "track/keyutils.h"
 #include "track/track.h"
@@ -61,6 +64,7 @@ EngineBuffer::EngineBuffer(QString group, UserSettingsPointer pConfig,
           m_pKeyControl(NULL),
           m_pReadAheadManager(NULL),
           m_pReader(NULL),
+          m_idleWorkerPriority(EngineWorker::Priority::Cued),
           m_filepos_play(0.),
           m_speed_old(0),
           m_tempo_ratio_old(1.),
@@ -184,6 +188,11 @@ EngineBuffer::EngineBuffer(QString group, UserSettingsPointer pConfig,
     m_pKeylock = new ControlPushButton(ConfigKey(m_group, "keylock"), true);
     m_pKeylock->setButtonMode(ControlPushButton::TOGGLE);
 
+    m_pVinylResampler = new ControlPushButton(
+            ConfigKey(m_group, "vinyl_resampler"), true);
+    m_pVinylResampler->setButtonMode(ControlPushButton::TOGGLE);
+    m_pVinylResampler->setStates(VINYL_RESAMPLER_COUNT);
+
     m_pEject = new ControlPushButton(ConfigKey(m_group, "eject"));
     connect(m_pEject, SIGNAL(valueChanged(double)),
             this, SLOT(slotEjectTrack(double)),
@@ -249,6 +258,7 @@ EngineBuffer::EngineBuffer(QString group, UserSettingsPointer pConfig,
     m_pScaleLinear = new EngineBufferScaleLinear(m_pReadAheadManager);
     m_pScaleST = new EngineBufferScaleST(m_pReadAheadManager);
     m_pScaleRB = new EngineBufferScaleRubberBand(m_pReadAheadManager);
+    m_pScaleSinc = new EngineBufferScaleSinc(m_pReadAheadManager);
     if (m_pKeylockEngine->get() == SOUNDTOUCH) {
         m_pScaleKeylock = m_pScaleST;
     } else {
@@ -309,8 +319,10 @@ EngineBuffer::~EngineBuffer() {
     delete m_pScaleLinear;
     delete m_pScaleST;
     delete m_pScaleRB;
+    delete m_pScaleSinc;
 
     delete m_pKeylock;
+    delete m_pVinylResampler;
     delete m_pEject;
 
     SampleUtil::free(m_pCrossfadeBuffer);
@@ -362,6 +374,37 @@ void EngineBuffer::enableIndependentPitchTempoScaling(bool bEnable,
     }
 }
 
+void EngineBuffer::updateVinylScaler(bool bScratching,
+                                     const int iBufferSize) {
+    // MUST ACQUIRE THE PAUSE MUTEX BEFORE CALLING THIS METHOD
+
+    // The sinc scaler cannot ramp through zero and its latency is noticeable
+    // when scratching, so the linear scaler takes over.
+    const int iResampler = static_cast<int>(m_pVinylResampler->get());
+    if (bScratching || iResampler <= LINEAR ||
+            iResampler >= VINYL_RESAMPLER_COUNT) {
+        m_pScaleVinyl = m_pScaleLinear;
+        return;
+    }
+
+    EngineBufferScaleSinc::Quality quality =
+            EngineBufferScaleSinc::Quality::Medium;
+    if (iResampler == SINC_LOW) {
+        quality = EngineBufferScaleSinc::Quality::Low;
+    } else if (iResampler == SINC_HIGH) {
+        quality = EngineBufferScaleSinc::Quality::High;
+    }
+    if (quality != m_pScaleSinc->getQuality() && m_pScale == m_pScaleSinc) {
+        // Changing the quality clears the scaler
+        if (m_speed_old != 0.0) {
+            readToCrossfadeBuffer(iBufferSize);
+        }
+        m_bScalerChanged = true;
+    }
+    m_pScaleSinc->setQuality(quality);
+    m_pScaleVinyl = m_pScaleSinc;
+}
+
 double EngineBuffer::getBpm()
 {
     return m_pBpmControl->getBpm();
@@ -434,7 +477,10 @@ void EngineBuffer::readToCrossfadeBuffer(const int iBufferSize) {
     if (!m_bCrossfadeReady) {
         // Read buffer, as if there where no parameter change
         // (Must be called only once per callback)
-        m_pScale->scaleBuffer(m_pCrossfadeBuffer, iBufferSize);
+        {
+            CallbackProfiler::StageScope stage(CallbackProfiler::Stage::Scaler);
+            m_pScale->scaleBuffer(m_pCrossfadeBuffer, iBufferSize);
+        }
         // Restore the original position that was lost due to scaleBuffer() above
         m_pReadAheadManager->notifySeek(m_filepos_play);
         m_bCrossfadeReady = true;
@@ -754,6 +800,7 @@ void EngineBuffer::process(CSAMPLE* pOutput, const int iBufferSize) {
         m_pScaleLinear->setSampleRate(sample_rate);
         m_pScaleST->setSampleRate(sample_rate);
         m_pScaleRB->setSampleRate(sample_rate);
+        m_pScaleSinc->setSampleRate(sample_rate);
         m_iSampleRate = sample_rate;
     }
 
@@ -793,11 +840,20 @@ void EngineBuffer::process(CSAMPLE* pOutput, const int iBufferSize) {
         double speed = m_pRateControl->calculateSpeed(
                 baserate, tempoRatio, paused, iBufferSize, &is_scratching, &is_reverse);
 
+        // Chunks of moving tracks are needed first, no matter which kind
+        // of player they belong to.
+        m_pReader->setWorkerPriority(speed != 0.0 ?
+                EngineWorker::Priority::Playing : m_idleWorkerPriority);
+
         // The cue indicator may change when scratch state is changed
         if (is_scratching != m_scratching_old) {
             m_pCueControl->updateIndicators();
         }
 
+        if (!m_bScalerOverride) {
+            updateVinylScaler(is_scratching, iBufferSize);
+        }
+
         bool useIndependentPitchAndTempoScaling = false;
 
         // TODO(owen): Maybe change this so that rubberband doesn't disable
@@ -924,6 +980,7 @@ void EngineBuffer::process(CSAMPLE* pOutput, const int iBufferSize) {
             // For the other, crossfade forward and backward samples
             if ((m_speed_old * speed < 0) &&  // Direction has changed!
                     (m_pScale != m_pScaleVinyl || // only m_pScaleLinear supports going though 0
+                           m_pScale == m_pScaleSinc ||
                            m_reverse_old != is_reverse)) { // no pitch change when reversing
                 //XXX: Trying to force RAMAN to read from correct
                 //     playpos when rate changes direction - Albert
@@ -981,8 +1038,11 @@ void EngineBuffer::process(CSAMPLE* pOutput, const int iBufferSize) {
         // If the buffer is not paused, then scale the audio.
         if (!bCurBufferPaused) {
             // Perform scaling of Reader buffer into buffer.
-            double framesRead =
-                    m_pScale->scaleBuffer(pOutput, iBufferSize);
+            double framesRead;
+            {
+                CallbackProfiler::StageScope stage(CallbackProfiler::Stage::Scaler);
+                framesRead = m_pScale->scaleBuffer(pOutput, iBufferSize);
+            }
             // TODO(XXX): The result framesRead might not be an integer value.
             // Converting to samples here does not make sense. All positional
             // calculations should be done in frames instead of samples! Otherwise
@@ -1300,6 +1360,14 @@ void EngineBuffer::addControl(EngineControl* pControl) {
 }
 
 void EngineBuffer::bindWorkers(EngineWorkerScheduler* pWorkerScheduler) {
+    if (PlayerManager::isSamplerGroup(m_group)) {
+        m_idleWorkerPriority = EngineWorker::Priority::Sampler;
+    } else if (PlayerManager::isPreviewDeckGroup(m_group)) {
+        m_idleWorkerPriority = EngineWorker::Priority::Preview;
+    } else {
+        m_idleWorkerPriority = EngineWorker::Priority::Cued;
+    }
+    m_pReader->setWorkerPriority(m_idleWorkerPriority);
     m_pReader->setScheduler(pWorkerScheduler);
 }
 
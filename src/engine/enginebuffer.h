@@ -57,6 +57,7 @@ class ControlTTRotary;
 class ControlPotmeter;
 class EngineBufferScale;
 class EngineBufferScaleLinear;
+class EngineBufferScaleSinc;
 class EngineBufferScaleST;
 class EngineBufferScaleRubberBand;
 class EngineSync;
@@ -103,6 +104,15 @@ class EngineBuffer : public EngineObject {
         KEYLOCK_ENGINE_COUNT,
     };
 
+    // The scaler for playback without keylock
+    enum VinylResampler {
+        LINEAR,
+        SINC_LOW,
+        SINC_MEDIUM,
+        SINC_HIGH,
+        VINYL_RESAMPLER_COUNT,
+    };
+
     EngineBuffer(QString _group, UserSettingsPointer pConfig,
                  EngineChannel* pChannel, EngineMaster* pMixingEngine);
     virtual ~EngineBuffer();
@@ -160,6 +170,21 @@ class EngineBuffer : public EngineObject {
         }
     }
 
+    static QString getVinylResamplerName(VinylResampler resampler) {
+        switch (resampler) {
+        case LINEAR:
+            return tr("Linear (fastest)");
+        case SINC_LOW:
+            return tr("Sinc, low quality");
+        case SINC_MEDIUM:
+            return tr("Sinc, medium quality");
+        case SINC_HIGH:
+            return tr("Sinc, high quality");
+        default:
+            return tr("Unknown (bad value)");
+        }
+    }
+
     // Request that the EngineBuffer load a track. Since the process is
     // asynchronous, EngineBuffer will emit a trackLoaded signal when the load
     // has completed.
@@ -200,6 +225,8 @@ class EngineBuffer : public EngineObject {
 
     void enableIndependentPitchTempoScaling(bool bEnable,
                                             const int iBufferSize);
+    // Picks the scaler for playback without keylock
+    void updateVinylScaler(bool bScratching, const int iBufferSize);
 
     void updateIndicators(double rate, int iBufferSize);
 
@@ -258,6 +285,8 @@ class EngineBuffer : public EngineObject {
 
     // The reader used to read audio files
     CachingReader* m_pReader;
+    // Priority of the reader's worker while the track is not moving
+    EngineWorker::Priority m_idleWorkerPriority;
 
     // List of hints to provide to the CachingReader
     HintVector m_hintList;
@@ -333,6 +362,7 @@ class EngineBuffer : public EngineObject {
     ControlProxy* m_pSampleRate;
     ControlProxy* m_pKeylockEngine;
     ControlPushButton* m_pKeylock;
+    ControlPushButton* m_pVinylResampler;
 
     // This ControlProxys is created as parent to this and deleted by
     // the Qt object tree. This helps that they are deleted by the creating
@@ -363,6 +393,8 @@ class EngineBuffer : public EngineObject {
 
     // Object used for vinyl-style interpolation scaling of the audio
     EngineBufferScaleLinear* m_pScaleLinear;
+    // Optional band-limited vinyl scaler, not used for scratching
+    EngineBufferScaleSinc* m_pScaleSinc;
     // Objects used for pitch-indep time stretch (key lock) scaling of the audio
     EngineBufferScaleST* m_pScaleST;
     EngineBufferScaleRubberBand* m_pScaleRB;
@@ -7,6 +7,14 @@
 #include "util/math.h"
 #include "util/sample.h"
 
+namespace {
+
+// The number of frames that are interpolated at once if they are in the
+// internal buffer. The temporary positions are kept on the stack.
+const SINT kBlockFrames = 64;
+
+} // anonymous namespace
+
 EngineBufferScaleLinear::EngineBufferScaleLinear(ReadAheadManager *pReadAheadManager)
     : m_pReadAheadManager(pReadAheadManager),
       m_bufferInt(SampleUtil::alloc(kiLinearScaleReadAheadLength)),
@@ -238,6 +246,18 @@ SINT EngineBufferScaleLinear::do_scale(CSAMPLE* buf, SINT buf_size) {
 
     // Hot frame loop
     while (i < buf_size) {
+        const SINT blockFrames = interpolateBlock(&buf[i],
+                getAudioSignal().samples2frames(buf_size - i),
+                &rate_add, rate_delta_abs);
+        if (blockFrames > 0) {
+            // The frame loop below falls back to the floor sample of the
+            // previous frame if it is off the end of the buffer
+            floor_sample[0] = m_floorSampleOld[0];
+            floor_sample[1] = m_floorSampleOld[1];
+            i += getAudioSignal().frames2samples(blockFrames);
+            continue;
+        }
+
         // shift indices
         m_dCurrentFrame = m_dNextFrame;
 
@@ -346,3 +366,56 @@ SINT EngineBufferScaleLinear::do_scale(CSAMPLE* buf, SINT buf_size) {
 
     return frames_read;
 }
+
+// Interpolates the frames in one go as long as both surrounding frames are in
+// the internal buffer. Instead of advancing the position frame by frame, the
+// position of each frame is calculated from the start of the block, so the
+// loops do not depend on the previous frame and can be vectorized.
+SINT EngineBufferScaleLinear::interpolateBlock(CSAMPLE* buf, SINT frames,
+        double* pRateAdd, double rateDelta) {
+    const double startFrame = m_dNextFrame;
+    if (startFrame < 0) {
+        // The floor is still in the previous buffer
+        return 0;
+    }
+    const double rateAdd = *pRateAdd;
+    // The internal buffer is smaller than the range of int
+    const int bufferSize = static_cast<int>(m_bufferIntSize);
+    const int maxFrames = static_cast<int>(math_min(frames, kBlockFrames));
+
+    int floorSamples[kBlockFrames];
+    CSAMPLE fracs[kBlockFrames];
+    // The rate changes linearly, so the positions never decrease and the
+    // frames that are in the buffer are always at the start of the block
+    int blockFrames = 0;
+    for (int frame = 0; frame < maxFrames; ++frame) {
+        const double k = frame;
+        const double position =
+                startFrame + k * rateAdd + k * (k - 1) * 0.5 * rateDelta;
+        // Truncating is the same as flooring for positive positions
+        const int floorFrame = static_cast<int>(position);
+        floorSamples[frame] = floorFrame * 2;
+        fracs[frame] = static_cast<CSAMPLE>(position) - floorFrame;
+        blockFrames += floorFrame * 2 + 3 < bufferSize ? 1 : 0;
+    }
+    if (blockFrames == 0) {
+        return 0;
+    }
+
+    for (int frame = 0; frame < blockFrames; ++frame) {
+        const CSAMPLE* pFloor = &m_bufferInt[floorSamples[frame]];
+        const CSAMPLE frac = fracs[frame];
+        buf[frame * 2] = pFloor[0] + frac * (pFloor[2] - pFloor[0]);
+        buf[frame * 2 + 1] = pFloor[1] + frac * (pFloor[3] - pFloor[1]);
+    }
+
+    const CSAMPLE* pLastFloor = &m_bufferInt[floorSamples[blockFrames - 1]];
+    m_floorSampleOld[0] = pLastFloor[0];
+    m_floorSampleOld[1] = pLastFloor[1];
+    const double k = blockFrames;
+    m_dCurrentFrame = startFrame + (k - 1) * rateAdd +
+            (k - 1) * (k - 2) * 0.5 * rateDelta;
+    m_dNextFrame = startFrame + k * rateAdd + k * (k - 1) * 0.5 * rateDelta;
+    *pRateAdd = rateAdd + k * rateDelta;
+    return blockFrames;
+}
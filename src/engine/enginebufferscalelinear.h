@@ -26,6 +26,8 @@ class EngineBufferScaleLinear : public EngineBufferScale  {
   private:
     SINT do_scale(CSAMPLE* buf, SINT buf_size);
     SINT do_copy(CSAMPLE* buf, SINT buf_size);
+    SINT interpolateBlock(CSAMPLE* buf, SINT frames,
+                          double* pRateAdd, double rateDelta);
 
     // The read-ahead manager that we use to fetch samples
     ReadAheadManager* m_pReadAheadManager;
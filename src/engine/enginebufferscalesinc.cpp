@@ -0,0 +1,355 @@
+#include "engine/enginebufferscalesinc.h"
+
+#include <cstring>
+#include <vector>
+
+#include "util/assert.h"
+#include "util/math.h"
+#include "util/sample.h"
+
+// The filter of one quality level. The impulse response is a Kaiser windowed
+// sinc that reaches over halfTaps input frames on each side.
+struct EngineBufferScaleSinc::Table {
+    int halfTaps;
+    // One row of 2 * halfTaps coefficients per fractional position, with an
+    // extra row for the fractional position 1.0, so neighbouring rows can
+    // always be interpolated.
+    std::vector<CSAMPLE> polyphase;
+    // The impulse response from 0 to halfTaps, sampled at the same resolution,
+    // for filters with a lowered cutoff.
+    std::vector<CSAMPLE> prototype;
+};
+
+namespace {
+
+// The number of rows of the polyphase tables per input frame. The
+// coefficients in between are interpolated linearly.
+const int kPhases = 256;
+
+const int kMaxHalfTaps = 32;
+// The cutoff is lowered for playback up to this speed. Beyond that the
+// filter would become too expensive, and it aliases like the linear scaler.
+const int kMaxDecimation = 4;
+// The number of frames on each side of the position that may be needed
+const SINT kMaxReach = kMaxHalfTaps * kMaxDecimation + 1;
+
+// The lowered cutoff is rounded down to multiples of 1 / kScaleSteps of the
+// Nyquist frequency, so the filter is only rebuilt when the rate changes
+// noticeably.
+const int kScaleSteps = 64;
+// The number of rows of the filter with a lowered cutoff. Its impulse
+// response is wider, so fewer rows are needed than for kPhases.
+const int kScaledPhases = 64;
+
+// The maximum number of frames read from the read-ahead manager at once
+const SINT kReadFrames = 1024;
+const SINT kBufferFrames = kReadFrames + 2 * kMaxReach;
+
+struct TableParameters {
+    int halfTaps;
+    // The cutoff frequency relative to the Nyquist frequency, in the middle
+    // of the transition band
+    double cutoff;
+    // The Kaiser window shape, trading stop band attenuation for transition
+    // width
+    double beta;
+};
+
+const TableParameters kTableParameters[] = {
+    {8, 0.80, 5.0},   // Low
+    {16, 0.88, 7.0},  // Medium
+    {32, 0.92, 9.0},  // High
+};
+
+// The zeroth order modified Bessel function of the first kind
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = x / 2.0;
+    for (int k = 1; term > sum * 1e-12; ++k) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+    }
+    return sum;
+}
+
+double impulseResponse(const TableParameters& parameters, double x) {
+    const double relative = x / parameters.halfTaps;
+    if (relative <= -1.0 || relative >= 1.0) {
+        return 0.0;
+    }
+    const double window =
+            besselI0(parameters.beta * sqrt(1.0 - relative * relative)) /
+            besselI0(parameters.beta);
+    const double arg = M_PI * parameters.cutoff * x;
+    const double sinc = x == 0.0 ? 1.0 : sin(arg) / arg;
+    return parameters.cutoff * sinc * window;
+}
+
+EngineBufferScaleSinc::Table buildTable(const TableParameters& parameters) {
+    EngineBufferScaleSinc::Table table;
+    table.halfTaps = parameters.halfTaps;
+    const int taps = 2 * parameters.halfTaps;
+
+    table.polyphase.resize((kPhases + 1) * taps);
+    for (int phase = 0; phase <= kPhases; ++phase) {
+        const double frac = static_cast<double>(phase) / kPhases;
+        double coefficients[2 * kMaxHalfTaps];
+        double sum = 0.0;
+        for (int tap = 0; tap < taps; ++tap) {
+            coefficients[tap] = impulseResponse(parameters,
+                    tap - parameters.halfTaps + 1 - frac);
+            sum += coefficients[tap];
+        }
+        // Normalize every row, so there is no ripple at DC
+        for (int tap = 0; tap < taps; ++tap) {
+            table.polyphase[phase * taps + tap] =
+                    static_cast<CSAMPLE>(coefficients[tap] / sum);
+        }
+    }
+
+    // Two extra zeros, so the interpolation at the end needs no check
+    table.prototype.resize(parameters.halfTaps * kPhases + 2);
+    for (int i = 0; i < parameters.halfTaps * kPhases; ++i) {
+        table.prototype[i] = static_cast<CSAMPLE>(impulseResponse(
+                parameters, static_cast<double>(i) / kPhases));
+    }
+    return table;
+}
+
+const EngineBufferScaleSinc::Table& getTable(
+        EngineBufferScaleSinc::Quality quality) {
+    static const EngineBufferScaleSinc::Table tables[] = {
+        buildTable(kTableParameters[0]),
+        buildTable(kTableParameters[1]),
+        buildTable(kTableParameters[2]),
+    };
+    return tables[static_cast<int>(quality)];
+}
+
+} // anonymous namespace
+
+EngineBufferScaleSinc::EngineBufferScaleSinc(
+        ReadAheadManager* pReadAheadManager,
+        Quality quality)
+        : m_pReadAheadManager(pReadAheadManager),
+          m_quality(quality),
+          m_pTable(&getTable(quality)),
+          m_pLeft(SampleUtil::alloc(kBufferFrames)),
+          m_pRight(SampleUtil::alloc(kBufferFrames)),
+          m_bufferFrames(0),
+          m_pReadBuffer(SampleUtil::alloc(kReadFrames * 2)),
+          m_pScaledPolyphase(SampleUtil::alloc(
+                  (kScaledPhases + 1) * 2 * kMaxReach)),
+          m_scaledReach(0),
+          m_scaleStep(0),
+          m_dPosition(0.0),
+          m_bClear(false),
+          m_dRate(1.0),
+          m_dOldRate(1.0) {
+    // Build all tables now, and not in the engine thread when the quality
+    // is changed
+    getTable(Quality::High);
+    clear();
+}
+
+EngineBufferScaleSinc::~EngineBufferScaleSinc() {
+    SampleUtil::free(m_pLeft);
+    SampleUtil::free(m_pRight);
+    SampleUtil::free(m_pReadBuffer);
+    SampleUtil::free(m_pScaledPolyphase);
+}
+
+void EngineBufferScaleSinc::setQuality(Quality quality) {
+    if (quality == m_quality) {
+        return;
+    }
+    m_quality = quality;
+    m_pTable = &getTable(quality);
+    // Rebuilt from the new table when needed
+    m_scaleStep = 0;
+    clear();
+}
+
+void EngineBufferScaleSinc::setScaleParameters(double base_rate,
+                                               double* pTempoRatio,
+                                               double* pPitchRatio) {
+    Q_UNUSED(pPitchRatio);
+
+    m_dOldRate = m_dRate;
+    m_dRate = base_rate * *pTempoRatio;
+}
+
+void EngineBufferScaleSinc::clear() {
+    m_bClear = true;
+    // The frames before the first one that is read are silent
+    SampleUtil::clear(m_pLeft, kMaxReach);
+    SampleUtil::clear(m_pRight, kMaxReach);
+    m_bufferFrames = kMaxReach;
+    m_dPosition = kMaxReach;
+}
+
+bool EngineBufferScaleSinc::fillBuffer(SINT frames, SINT framesWanted,
+                                       double readRate) {
+    // Keep the frames that the filter may still reach before the position
+    const SINT shift = static_cast<SINT>(m_dPosition) - kMaxReach;
+    if (shift > 0) {
+        // The ranges overlap
+        memmove(m_pLeft, m_pLeft + shift,
+                sizeof(CSAMPLE) * (m_bufferFrames - shift));
+        memmove(m_pRight, m_pRight + shift,
+                sizeof(CSAMPLE) * (m_bufferFrames - shift));
+        m_bufferFrames -= shift;
+        m_dPosition -= shift;
+        frames -= shift;
+    }
+
+    int read_failed_count = 0;
+    while (m_bufferFrames < frames) {
+        const SINT framesToRead = math_min(kReadFrames,
+                math_min(kBufferFrames - m_bufferFrames,
+                        math_max(framesWanted, frames - m_bufferFrames)));
+        const SINT framesRead = getAudioSignal().samples2frames(
+                m_pReadAheadManager->getNextSamples(readRate, m_pReadBuffer,
+                        getAudioSignal().frames2samples(framesToRead)));
+        if (framesRead == 0) {
+            if (++read_failed_count > 1) {
+                return false;
+            }
+            continue;
+        }
+        SampleUtil::deinterleaveBuffer(m_pLeft + m_bufferFrames,
+                m_pRight + m_bufferFrames, m_pReadBuffer, framesRead);
+        m_bufferFrames += framesRead;
+    }
+    return true;
+}
+
+void EngineBufferScaleSinc::buildScaledPolyphase(int scaleStep) {
+    const double scale = static_cast<double>(scaleStep) / kScaleSteps;
+    const int halfTaps = m_pTable->halfTaps;
+    m_scaledReach = static_cast<SINT>(ceil(halfTaps / scale));
+    const SINT taps = 2 * m_scaledReach;
+    // The prototype is stretched by the inverse of the scale
+    const double step = scale * kPhases;
+    const CSAMPLE* pPrototype = &m_pTable->prototype[0];
+    const SINT prototypeSize = halfTaps * kPhases;
+    for (int phase = 0; phase <= kScaledPhases; ++phase) {
+        const double frac = static_cast<double>(phase) / kScaledPhases;
+        const double start = (m_scaledReach - 1 + frac) * step;
+        CSAMPLE* pRow = &m_pScaledPolyphase[phase * taps];
+        for (SINT tap = 0; tap < taps; ++tap) {
+            const double position = fabs(start - tap * step);
+            const SINT index = static_cast<SINT>(position);
+            if (index >= prototypeSize) {
+                pRow[tap] = 0.0f;
+                continue;
+            }
+            const CSAMPLE weight = static_cast<CSAMPLE>(position - index);
+            pRow[tap] = static_cast<CSAMPLE>(scale) *
+                    (pPrototype[index] + weight *
+                            (pPrototype[index + 1] - pPrototype[index]));
+        }
+    }
+    m_scaleStep = scaleStep;
+}
+
+double EngineBufferScaleSinc::scaleBuffer(
+        CSAMPLE* pOutputBuffer,
+        SINT iOutputBufferSize) {
+    if (iOutputBufferSize == 0) {
+        return 0.0;
+    }
+
+    if (m_bClear) {
+        m_dOldRate = m_dRate;  // If cleared, don't interpolate rate.
+        m_bClear = false;
+    }
+    const double rateOld = m_dOldRate;
+    const double rateNew = m_dRate;
+    m_dOldRate = m_dRate;
+
+    // The read-ahead manager only needs the direction
+    const double readRate = rateNew == 0 ? rateOld : rateNew;
+    VERIFY_OR_DEBUG_ASSERT(rateOld * rateNew >= 0) {
+        // EngineBuffer clears the scaler when the direction changes
+        SampleUtil::clear(pOutputBuffer, iOutputBufferSize);
+        return 0.0;
+    }
+
+    const SINT outputFrames = getAudioSignal().samples2frames(iOutputBufferSize);
+
+    // Lower the cutoff when playing faster. The lowest cutoff needed within
+    // the buffer is used for all frames, so the filter is only looked up
+    // once.
+    const double maxRate = math_max(fabs(rateOld), fabs(rateNew));
+    int scaleStep = kScaleSteps;
+    if (maxRate > 1.0) {
+        scaleStep = math_max(static_cast<int>(kScaleSteps / maxRate),
+                kScaleSteps / kMaxDecimation);
+    }
+    const CSAMPLE* pPolyphase;
+    int phases;
+    SINT reach;
+    if (scaleStep == kScaleSteps) {
+        pPolyphase = &m_pTable->polyphase[0];
+        phases = kPhases;
+        reach = m_pTable->halfTaps;
+    } else {
+        if (scaleStep != m_scaleStep) {
+            buildScaledPolyphase(scaleStep);
+        }
+        pPolyphase = m_pScaledPolyphase;
+        phases = kScaledPhases;
+        reach = m_scaledReach;
+    }
+    const SINT taps = 2 * reach;
+
+    // Smooth any changes in the playback rate over the buffer, like the
+    // linear scaler
+    double rate = fabs(rateOld);
+    const double rateDelta = (fabs(rateNew) - rate) / outputFrames;
+
+    double framesConsumed = 0.0;
+    SINT frame = 0;
+    for (; frame < outputFrames; ++frame) {
+        SINT center = static_cast<SINT>(m_dPosition);
+        if (center + reach >= m_bufferFrames) {
+            const SINT framesWanted = static_cast<SINT>(
+                    (outputFrames - frame) * rate) + 1;
+            if (!fillBuffer(center + reach + 1, framesWanted, readRate)) {
+                break;
+            }
+            center = static_cast<SINT>(m_dPosition);
+        }
+        const double frac = m_dPosition - center;
+
+        // Interpolate between the neighbouring rows of the filter
+        const double phasePosition = frac * phases;
+        const int phase = static_cast<int>(phasePosition);
+        const CSAMPLE weight = static_cast<CSAMPLE>(phasePosition - phase);
+        const CSAMPLE* pRow0 = &pPolyphase[phase * taps];
+        const CSAMPLE* pRow1 = pRow0 + taps;
+        const CSAMPLE* pLeft = &m_pLeft[center - reach + 1];
+        const CSAMPLE* pRight = &m_pRight[center - reach + 1];
+        CSAMPLE sumLeft = 0.0f;
+        CSAMPLE sumRight = 0.0f;
+        // note: LOOP VECTORIZED.
+        for (SINT tap = 0; tap < taps; ++tap) {
+            const CSAMPLE coefficient =
+                    pRow0[tap] + weight * (pRow1[tap] - pRow0[tap]);
+            sumLeft += coefficient * pLeft[tap];
+            sumRight += coefficient * pRight[tap];
+        }
+        pOutputBuffer[frame * 2] = sumLeft;
+        pOutputBuffer[frame * 2 + 1] = sumRight;
+
+        m_dPosition += rate;
+        framesConsumed += rate;
+        rate += rateDelta;
+    }
+
+    SampleUtil::clear(&pOutputBuffer[frame * 2], (outputFrames - frame) * 2);
+
+    return framesConsumed;
+}
@@ -0,0 +1,91 @@
+#ifndef ENGINEBUFFERSCALESINC_H
+#define ENGINEBUFFERSCALESINC_H
+
+#include "engine/enginebufferscale.h"
+#include "engine/readaheadmanager.h"
+
+// Band-limited resampling with a windowed sinc filter, for playback without
+// keylock. It sounds much cleaner than the linear interpolation of
+// EngineBufferScaleLinear, especially when the track and the sound card use
+// different sample rates, and is still far cheaper than the keylock scalers.
+//
+// The filters are precomputed as polyphase tables that are shared by all
+// instances. When the track is played faster than its sample rate, the cutoff
+// of the filter is lowered to avoid aliasing, up to a limit. The polyphase
+// table of the lowered filter is cached per instance and only rebuilt when
+// the rate changes noticeably.
+//
+// Unlike the linear scaler it cannot ramp through zero, so EngineBuffer
+// falls back to the linear scaler when scratching.
+class EngineBufferScaleSinc : public EngineBufferScale {
+  public:
+    enum class Quality {
+        // 16 taps
+        Low,
+        // 32 taps
+        Medium,
+        // 64 taps
+        High,
+    };
+
+    // Builds the filter tables on first use, so the first scaler should be
+    // created before the engine runs.
+    explicit EngineBufferScaleSinc(
+            ReadAheadManager* pReadAheadManager,
+            Quality quality = Quality::Medium);
+    ~EngineBufferScaleSinc() override;
+
+    // Clears the scaler if the quality changes
+    void setQuality(Quality quality);
+    Quality getQuality() const {
+        return m_quality;
+    }
+
+    double scaleBuffer(
+            CSAMPLE* pOutputBuffer,
+            SINT iOutputBufferSize) override;
+    void clear() override;
+
+    void setScaleParameters(double base_rate,
+                            double* pTempoRatio,
+                            double* pPitchRatio) override;
+
+    struct Table;
+
+  private:
+    // Reads until at least the given number of frames are in the buffer
+    bool fillBuffer(SINT frames, SINT framesWanted, double readRate);
+
+    // Builds the polyphase table of the filter with the cutoff lowered to
+    // scaleStep / kScaleSteps of the Nyquist frequency
+    void buildScaledPolyphase(int scaleStep);
+
+    // The read-ahead manager that we use to fetch samples
+    ReadAheadManager* m_pReadAheadManager;
+
+    Quality m_quality;
+    const Table* m_pTable;
+
+    // The input is kept deinterleaved, so the filter runs over continuous
+    // samples
+    CSAMPLE* m_pLeft;
+    CSAMPLE* m_pRight;
+    SINT m_bufferFrames;
+    // Interleaved samples from the read-ahead manager
+    CSAMPLE* m_pReadBuffer;
+    // The polyphase table of the filter with a lowered cutoff, with
+    // 2 * m_scaledReach coefficients per row. m_scaleStep is 0 if it has
+    // not been built for the current quality.
+    CSAMPLE* m_pScaledPolyphase;
+    SINT m_scaledReach;
+    int m_scaleStep;
+
+    // The position of the next frame in m_pLeft and m_pRight
+    double m_dPosition;
+
+    bool m_bClear;
+    double m_dRate;
+    double m_dOldRate;
+};
+
+#endif /* ENGINEBUFFERSCALESINC_H */
@@ -0,0 +1,177 @@
+#include "engine/enginecompactsampler.h"
+
+#include "control/controlaudiotaperpot.h"
+#include "control/controlobject.h"
+#include "control/controlpushbutton.h"
+#include "effects/effectsmanager.h"
+#include "engine/effects/engineeffectsmanager.h"
+#include "util/sample.h"
+
+namespace {
+
+// Enough room for a burst of loads while the engine is not running
+const int kSampleFifoSize = 8;
+
+} // anonymous namespace
+
+EngineCompactSampler::EngineCompactSampler(
+        const ChannelHandleAndGroup& handle_group,
+        EffectsManager* pEffectsManager,
+        EngineChannel::ChannelOrientation defaultOrientation)
+        : EngineChannel(handle_group, defaultOrientation, pEffectsManager),
+          m_newSamples(kSampleFifoSize),
+          m_retiredSamples(kSampleFifoSize),
+          m_pSample(nullptr),
+          m_framePosition(0.0),
+          m_wasActive(false),
+          m_rewind(0),
+          m_pPlay(new ControlPushButton(ConfigKey(getGroup(), "play"))),
+          m_pStartPlay(new ControlPushButton(ConfigKey(getGroup(), "start_play"))),
+          m_pStop(new ControlPushButton(ConfigKey(getGroup(), "stop"))),
+          m_pPlayPosition(new ControlObject(ConfigKey(getGroup(), "playposition"))),
+          m_pTrackLoaded(new ControlObject(ConfigKey(getGroup(), "track_loaded"))),
+          m_pPregain(new ControlAudioTaperPot(ConfigKey(getGroup(), "pregain"), -12, 12, 0.5)) {
+    m_pPlay->setButtonMode(ControlPushButton::TOGGLE);
+    m_pPlayPosition->setReadOnly();
+    m_pTrackLoaded->setReadOnly();
+    connect(m_pStartPlay, SIGNAL(valueChanged(double)),
+            this, SLOT(slotStartPlay(double)),
+            Qt::DirectConnection);
+    connect(m_pStop, SIGNAL(valueChanged(double)),
+            this, SLOT(slotStop(double)),
+            Qt::DirectConnection);
+}
+
+EngineCompactSampler::~EngineCompactSampler() {
+    collectGarbage();
+    SampleUpdate update;
+    while (m_newSamples.read(&update, 1) == 1) {
+        delete update.pSample;
+    }
+    delete m_pSample;
+
+    delete m_pPregain;
+    delete m_pTrackLoaded;
+    delete m_pPlayPosition;
+    delete m_pStop;
+    delete m_pStartPlay;
+    delete m_pPlay;
+}
+
+bool EngineCompactSampler::setSample(CompactSample* pSample, bool play) {
+    collectGarbage();
+    const SampleUpdate update = { pSample, play };
+    if (m_newSamples.write(&update, 1) != 1) {
+        delete pSample;
+        return false;
+    }
+    return true;
+}
+
+void EngineCompactSampler::collectGarbage() {
+    CompactSample* pSample;
+    while (m_retiredSamples.read(&pSample, 1) == 1) {
+        delete pSample;
+    }
+}
+
+void EngineCompactSampler::receiveSample() {
+    // The replaced sample is sent back for deletion. Keep it until
+    // there is room to do so, the engine must not free memory.
+    while (m_retiredSamples.writeAvailable() > 0) {
+        SampleUpdate update;
+        if (m_newSamples.read(&update, 1) != 1) {
+            return;
+        }
+        if (m_pSample) {
+            m_retiredSamples.write(&m_pSample, 1);
+        }
+        m_pSample = update.pSample;
+        m_framePosition = 0.0;
+        m_pPlay->set(update.play ? 1.0 : 0.0);
+        m_pPlayPosition->forceSet(0.0);
+        m_pTrackLoaded->forceSet(m_pSample ? 1.0 : 0.0);
+    }
+}
+
+bool EngineCompactSampler::isActive() {
+    receiveSample();
+    if (m_rewind.fetchAndStoreRelaxed(0) != 0) {
+        m_framePosition = 0.0;
+        m_pPlayPosition->forceSet(0.0);
+    }
+    const bool active = m_pSample && m_pPlay->toBool();
+    if (!active && m_wasActive) {
+        m_vuMeter.reset();
+    }
+    m_wasActive = active;
+    return active;
+}
+
+void EngineCompactSampler::process(CSAMPLE* pOut, const int iBufferSize) {
+    const CompactSample* pSample = m_pSample;
+    const double engineSampleRate = m_pSampleRate->get();
+    if (!pSample || pSample->frameCount < 2 || engineSampleRate <= 0 ||
+            !m_pPlay->toBool()) {
+        SampleUtil::clear(pOut, iBufferSize);
+        m_vuMeter.process(pOut, iBufferSize);
+        return;
+    }
+
+    // Linear interpolation between adjacent frames compensates
+    // a sample rate that differs from the engine.
+    const double step = pSample->sampleRate / engineSampleRate;
+    const CSAMPLE* pIn = pSample->sampleBuffer.data();
+    const SINT lastFrame = pSample->frameCount - 1;
+    const int frames = iBufferSize / 2;
+    int frame = 0;
+    for (; frame < frames; ++frame) {
+        const SINT index = static_cast<SINT>(m_framePosition);
+        if (index >= lastFrame) {
+            break;
+        }
+        const CSAMPLE frac = static_cast<CSAMPLE>(m_framePosition - index);
+        const CSAMPLE* pFrame = pIn + index * 2;
+        pOut[frame * 2] = pFrame[0] + (pFrame[2] - pFrame[0]) * frac;
+        pOut[frame * 2 + 1] = pFrame[1] + (pFrame[3] - pFrame[1]) * frac;
+        m_framePosition += step;
+    }
+    if (frame < frames) {
+        // The end of a one-shot rewinds and stops the sampler
+        SampleUtil::clear(pOut + frame * 2, (frames - frame) * 2);
+        m_framePosition = 0.0;
+        m_pPlay->set(0.0);
+    }
+    m_pPlayPosition->forceSet(m_framePosition / lastFrame);
+
+    SampleUtil::applyGain(pOut, static_cast<CSAMPLE>(m_pPregain->get()),
+            iBufferSize);
+
+    EngineEffectsManager* pEngineEffectsManager = m_pEffectsManager->getEngineEffectsManager();
+    if (pEngineEffectsManager != nullptr) {
+        pEngineEffectsManager->processPreFaderInPlace(
+            m_group.handle(), m_pEffectsManager->getMasterHandle(),
+            pOut, iBufferSize, engineSampleRate);
+    }
+
+    // Update VU meter
+    m_vuMeter.process(pOut, iBufferSize);
+}
+
+void EngineCompactSampler::collectFeatures(GroupFeatureState* pGroupFeatures) const {
+    m_vuMeter.collectFeatures(pGroupFeatures);
+}
+
+void EngineCompactSampler::slotStartPlay(double v) {
+    if (v > 0.0) {
+        m_rewind = 1;
+        m_pPlay->set(1.0);
+    }
+}
+
+void EngineCompactSampler::slotStop(double v) {
+    if (v > 0.0) {
+        m_pPlay->set(0.0);
+        m_rewind = 1;
+    }
+}
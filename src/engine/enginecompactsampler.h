@@ -0,0 +1,88 @@
+#ifndef ENGINECOMPACTSAMPLER_H
+#define ENGINECOMPACTSAMPLER_H
+
+#include <QAtomicInt>
+
+#include "engine/enginechannel.h"
+#include "util/fifo.h"
+#include "util/samplebuffer.h"
+#include "util/types.h"
+
+class ControlAudioTaperPot;
+class ControlObject;
+class ControlPushButton;
+
+// The fully decoded, interleaved stereo sample data of a short track.
+struct CompactSample {
+    CompactSample(SINT frameCount, int sampleRate)
+            : sampleBuffer(frameCount * 2),
+              frameCount(frameCount),
+              sampleRate(sampleRate) {
+    }
+
+    mixxx::SampleBuffer sampleBuffer;
+    const SINT frameCount;
+    const int sampleRate;
+};
+
+// EngineCompactSampler is a lightweight alternative to the EngineDeck of a
+// sampler. It plays a sample that has been decoded into memory completely
+// from start to end with a single linear interpolating voice. There is no
+// EngineBuffer, no reader worker and only a handful of controls.
+class EngineCompactSampler : public EngineChannel {
+    Q_OBJECT
+  public:
+    EngineCompactSampler(const ChannelHandleAndGroup& handle_group,
+                         EffectsManager* pEffectsManager,
+                         EngineChannel::ChannelOrientation defaultOrientation = CENTER);
+    ~EngineCompactSampler() override;
+
+    // Hands a decoded sample over to the engine that takes ownership
+    // of it. Passing nullptr ejects the current sample. Returns false
+    // if the engine has not yet picked up the previous samples. Must
+    // only be called from the main thread.
+    bool setSample(CompactSample* pSample, bool play = false);
+
+    // Deletes the samples that have been replaced in the engine. Must
+    // only be called from the main thread.
+    void collectGarbage();
+
+    bool isActive() override;
+
+    void process(CSAMPLE* pOutput, const int iBufferSize) override;
+    void collectFeatures(GroupFeatureState* pGroupFeatures) const override;
+    void postProcess(const int iBufferSize) override { Q_UNUSED(iBufferSize) }
+
+  private slots:
+    void slotStartPlay(double v);
+    void slotStop(double v);
+
+  private:
+    struct SampleUpdate {
+        CompactSample* pSample;
+        bool play;
+    };
+
+    // Engine thread only
+    void receiveSample();
+
+    // Samples in flight from the main thread to the engine and back
+    FIFO<SampleUpdate> m_newSamples;
+    FIFO<CompactSample*> m_retiredSamples;
+
+    // Only accessed by the engine thread
+    CompactSample* m_pSample;
+    double m_framePosition;
+    bool m_wasActive;
+
+    QAtomicInt m_rewind;
+
+    ControlPushButton* m_pPlay;
+    ControlPushButton* m_pStartPlay;
+    ControlPushButton* m_pStop;
+    ControlObject* m_pPlayPosition;
+    ControlObject* m_pTrackLoaded;
+    ControlAudioTaperPot* m_pPregain;
+};
+
+#endif // ENGINECOMPACTSAMPLER_H
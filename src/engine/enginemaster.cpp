@@ -10,6 +10,7 @@
 #include "control/controlpotmeter.h"
 #include "control/controlpushbutton.h"
 #include "effects/effectsmanager.h"
+#include "engine/callbackprofiler.h"
 #include "engine/channelmixer.h"
 #include "engine/effects/engineeffectsmanager.h"
 #include "engine/enginebuffer.h"
@@ -25,6 +26,7 @@
 #include "engine/sync/enginesync.h"
 #include "mixer/playermanager.h"
 #include "util/defs.h"
+#include "util/realtimeguard.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "util/trace.h"
@@ -76,6 +78,8 @@ EngineMaster::EngineMaster(UserSettingsPointer pConfig,
     m_pAudioLatencyOverloadCount = new ControlObject(ConfigKey(group, "audio_latency_overload_count"), true, true);
     m_pAudioLatencyUsage = new ControlPotmeter(ConfigKey(group, "audio_latency_usage"), 0.0, 0.25);
     m_pAudioLatencyOverload  = new ControlPotmeter(ConfigKey(group, "audio_latency_overload"), 0.0, 1.0);
+    // Time spent per stage of the signal path, explains underflows
+    m_pCallbackProfiler = new CallbackProfiler(group);
 
     // Master sync controller
     m_pMasterSync = new EngineSync(pConfig);
@@ -193,6 +197,9 @@ EngineMaster::EngineMaster(UserSettingsPointer pConfig,
 
 EngineMaster::~EngineMaster() {
     qDebug() << "in ~EngineMaster()";
+    if (RealtimeGuard::violationCount() > 0) {
+        qWarning() << RealtimeGuard::report();
+    }
     delete m_pKeylockEngine;
     delete m_pCrossfader;
     delete m_pBalance;
@@ -204,6 +211,7 @@ EngineMaster::~EngineMaster() {
     delete m_pTalkoverDucking;
     delete m_pVumeter;
     delete m_pEngineSideChain;
+    delete m_pCallbackProfiler;
     delete m_pMasterDelay;
     delete m_pHeadDelay;
     delete m_pBoothDelay;
@@ -238,8 +246,8 @@ EngineMaster::~EngineMaster() {
         SampleUtil::free(m_pOutputBusBuffers[o]);
     }
 
-    delete m_pWorkerScheduler;
-
+    // The readers of the channels detach from the worker scheduler
+    // when they are deleted
     for (int i = 0; i < m_channels.size(); ++i) {
         ChannelInfo* pChannelInfo = m_channels[i];
         SampleUtil::free(pChannelInfo->m_pBuffer);
@@ -248,6 +256,8 @@ EngineMaster::~EngineMaster() {
         delete pChannelInfo->m_pMuteControl;
         delete pChannelInfo;
     }
+
+    delete m_pWorkerScheduler;
 }
 
 const CSAMPLE* EngineMaster::getMasterBuffer() const {
@@ -376,17 +386,21 @@ void EngineMaster::process(const int iBufferSize) {
         QThread::currentThread()->setObjectName("Engine");
         haveSetName = true;
     }
+    // Allocations and locks below this point are reported by rtsafety builds
+    RealtimeGuard::Scope realtimeScope;
     Trace t("EngineMaster::process");
 
-    bool masterEnabled = m_pMasterEnabled->get();
-    bool boothEnabled = m_pBoothEnabled->get();
-    bool headphoneEnabled = m_pHeadphoneEnabled->get();
-
     m_iSampleRate = static_cast<int>(m_pMasterSampleRate->get());
     m_iBufferSize = iBufferSize;
     // TODO: remove assumption of stereo buffer
     const unsigned int kChannels = 2;
     const unsigned int iFrames = iBufferSize / kChannels;
+    CallbackProfiler::CallbackScope profilerScope(
+            m_pCallbackProfiler, iFrames, m_iSampleRate);
+
+    bool masterEnabled = m_pMasterEnabled->get();
+    bool boothEnabled = m_pBoothEnabled->get();
+    bool headphoneEnabled = m_pHeadphoneEnabled->get();
 
     if (m_pEngineEffectsManager) {
         m_pEngineEffectsManager->onCallbackStart();
@@ -675,6 +689,7 @@ void EngineMaster::process(const int iBufferSize) {
         // so skip sending a buffer to m_pSidechain here.
         if (!m_bExternalRecordBroadcastInputConnected
             && m_pEngineSideChain != nullptr) {
+            CallbackProfiler::StageScope stage(CallbackProfiler::Stage::Sidechain);
             m_pEngineSideChain->writeSamples(m_pSidechainMix, iFrames);
         }
 
@@ -47,6 +47,7 @@ class GuiTick;
 class EngineSync;
 class EngineTalkoverDucking;
 class EngineDelay;
+class CallbackProfiler;
 
 // The number of channels to pre-allocate in various structures in the
 // engine. Prevents memory allocation in EngineMaster::addChannel.
@@ -123,6 +124,10 @@ class EngineMaster : public QObject, public AudioSource {
         return m_pEngineSideChain;
     }
 
+    CallbackProfiler* getCallbackProfiler() const {
+        return m_pCallbackProfiler;
+    }
+
     struct ChannelInfo {
         ChannelInfo(int index)
                 : m_pChannel(NULL),
@@ -324,6 +329,7 @@ class EngineMaster : public QObject, public AudioSource {
 
     EngineVuMeter* m_pVumeter;
     EngineSideChain* m_pEngineSideChain;
+    CallbackProfiler* m_pCallbackProfiler;
 
     ControlPotmeter* m_pCrossfader;
     ControlPotmeter* m_pHeadMix;
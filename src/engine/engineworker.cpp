@@ -3,16 +3,18 @@
 
 #include "engine/engineworker.h"
 #include "engine/engineworkerscheduler.h"
+#include "util/time.h"
 
 EngineWorker::EngineWorker()
-    : m_pScheduler(nullptr) {
-    m_notReady.test_and_set();
+    : m_pScheduler(nullptr),
+      m_ready(false),
+      m_readySinceNanos(0),
+      m_priority(static_cast<int>(Priority::Cued)),
+      m_running(false) {
 }
 
 EngineWorker::~EngineWorker() {
-}
-
-void EngineWorker::run() {
+    DEBUG_ASSERT(m_pScheduler == nullptr);
 }
 
 void EngineWorker::setScheduler(EngineWorkerScheduler* pScheduler) {
@@ -21,16 +23,20 @@ void EngineWorker::setScheduler(EngineWorkerScheduler* pScheduler) {
     pScheduler->addWorker(this);
 }
 
-void EngineWorker::workReady() {
-    m_notReady.clear();
-    VERIFY_OR_DEBUG_ASSERT(m_pScheduler) {
-        return;     
+void EngineWorker::quitWait() {
+    if (m_pScheduler) {
+        m_pScheduler->removeWorker(this);
+        m_pScheduler = nullptr;
     }
-    m_pScheduler->workerReady();
 }
 
-void EngineWorker::wakeIfReady() {
-    if (!m_notReady.test_and_set()) {
-        m_semaRun.release();
+void EngineWorker::workReady() {
+    qint64 notReady = 0;
+    m_readySinceNanos.compare_exchange_strong(
+            notReady, mixxx::Time::elapsed().toIntegerNanos());
+    m_ready.store(true);
+    VERIFY_OR_DEBUG_ASSERT(m_pScheduler) {
+        return;
     }
+    m_pScheduler->workerReady();
 }
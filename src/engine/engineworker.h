@@ -6,34 +6,66 @@
 
 #include <atomic>
 #include <QObject>
-#include <QSemaphore>
-#include <QThread>
 
 // EngineWorker is an interface for running background processing work when the
 // audio callback is not active. While the audio callback is active, an
-// EngineWorker can emit its workReady signal, and an EngineWorkerManager will
+// EngineWorker can emit its workReady signal, and an EngineWorkerScheduler will
 // schedule it for running after the audio callback has completed.
+//
+// Workers do not own a thread. The pending work of all workers is processed
+// by the fixed pool of threads of the EngineWorkerScheduler in the order of
+// their priorities.
 
 class EngineWorkerScheduler;
 
-class EngineWorker : public QThread {
+class EngineWorker : public QObject {
     Q_OBJECT
   public:
+    // In descending order of precedence
+    enum class Priority {
+        Playing = 0,
+        Cued,
+        Sampler,
+        Preview,
+    };
+    static const int kPriorityCount = 4;
+
     EngineWorker();
-    virtual ~EngineWorker();
+    ~EngineWorker() override;
 
-    virtual void run();
+    // Performs a bounded amount of the pending work, e.g. reading a single
+    // chunk. Returns true if more work is pending. Invoked by one of the
+    // threads of the EngineWorkerScheduler, but never concurrently for the
+    // same worker.
+    virtual bool processWork() = 0;
 
     void setScheduler(EngineWorkerScheduler* pScheduler);
+    // Detaches the worker from the scheduler. Blocks while the worker is
+    // still processing work.
+    void quitWait();
+
+    // May be called from the engine callback
     void workReady();
-    void wakeIfReady();
 
-  protected:
-    QSemaphore m_semaRun;
+    // May be called from the engine callback
+    void setPriority(Priority priority) {
+        m_priority.store(static_cast<int>(priority));
+    }
+    Priority getPriority() const {
+        return static_cast<Priority>(m_priority.load());
+    }
 
   private:
+    friend class EngineWorkerScheduler;
+
     EngineWorkerScheduler* m_pScheduler;
-    std::atomic_flag m_notReady;
+    std::atomic<bool> m_ready;
+    // Time when the worker became ready in nanoseconds, 0 if not ready.
+    // Used for measuring the scheduling latency.
+    std::atomic<qint64> m_readySinceNanos;
+    std::atomic<int> m_priority;
+    // Guarded by the mutex of the scheduler
+    bool m_running;
 };
 
 #endif /* ENGINEWORKER_H */
@@ -3,20 +3,66 @@
 
 #include <QtDebug>
 
+#include <algorithm>
+
 #include "engine/engineworker.h"
 #include "engine/engineworkerscheduler.h"
 #include "util/event.h"
+#include "util/math.h"
+#include "util/stat.h"
+#include "util/time.h"
+#include "util/timer.h"
+
+namespace {
+
+const char* const kPriorityNames[EngineWorker::kPriorityCount] = {
+    "Playing",
+    "Cued",
+    "Sampler",
+    "Preview",
+};
+
+} // anonymous namespace
+
+// static
+const int EngineWorkerScheduler::kDefaultThreadCount =
+        math_clamp(QThread::idealThreadCount(), 2, 4);
 
-EngineWorkerScheduler::EngineWorkerScheduler(QObject* pParent)
-        : m_bWakeScheduler(false),
+EngineWorkerScheduler::EngineWorkerScheduler(QObject* pParent, int threadCount)
+        : QObject(pParent),
+          m_bWakeScheduler(false),
+          m_idleThreadCount(0),
           m_bQuit(false) {
-    Q_UNUSED(pParent);
+    for (int i = 0; i < EngineWorker::kPriorityCount; ++i) {
+        m_latencyStatKeys[i] = QString("EngineWorkerScheduler latency %1")
+                .arg(kPriorityNames[i]);
+    }
+    for (int i = 0; i < math_max(threadCount, 1); ++i) {
+        m_threads.push_back(new WorkerThread(this, i));
+    }
 }
 
 EngineWorkerScheduler::~EngineWorkerScheduler() {
-    m_bQuit = true;
-    m_waitCondition.wakeAll();
-    wait();
+    {
+        QMutexLocker locker(&m_mutex);
+        m_bQuit = true;
+    }
+    m_wakeSemaphore.release(static_cast<int>(m_threads.size()));
+    for (const auto& pThread: m_threads) {
+        pThread->wait();
+        delete pThread;
+    }
+    m_threads.clear();
+    // Workers that outlive the scheduler must not access it anymore
+    for (const auto& pWorker: m_workers) {
+        pWorker->m_pScheduler = nullptr;
+    }
+}
+
+void EngineWorkerScheduler::start(QThread::Priority priority) {
+    for (const auto& pThread: m_threads) {
+        pThread->start(priority);
+    }
 }
 
 void EngineWorkerScheduler::workerReady() {
@@ -27,6 +73,19 @@ void EngineWorkerScheduler::addWorker(EngineWorker* pWorker) {
     DEBUG_ASSERT(pWorker);
     QMutexLocker locker(&m_mutex);
     m_workers.push_back(pWorker);
+    // The worker might already have work pending
+    wakeIdleThread();
+}
+
+void EngineWorkerScheduler::removeWorker(EngineWorker* pWorker) {
+    DEBUG_ASSERT(pWorker);
+    QMutexLocker locker(&m_mutex);
+    while (pWorker->m_running) {
+        m_workerFinished.wait(&m_mutex);
+    }
+    m_workers.erase(
+            std::remove(m_workers.begin(), m_workers.end(), pWorker),
+            m_workers.end());
 }
 
 void EngineWorkerScheduler::runWorkers() {
@@ -35,26 +94,99 @@ void EngineWorkerScheduler::runWorkers() {
     // both workerReady and runWorkers are called from the callback thread.
     if (m_bWakeScheduler) {
         m_bWakeScheduler = false;
-        m_waitCondition.wakeAll();
+        wakeIdleThread();
+    }
+}
+
+void EngineWorkerScheduler::wakeIdleThread() {
+    // Busy threads look for the next ready worker before they become
+    // idle, so only idle threads need to be woken up. Releasing the
+    // semaphore neither locks nor allocates.
+    if (m_idleThreadCount.load() > 0) {
+        m_wakeSemaphore.release();
+    }
+}
+
+bool EngineWorkerScheduler::hasReadyWorker() const {
+    for (const auto& pWorker: m_workers) {
+        if (!pWorker->m_running && pWorker->m_ready.load()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+EngineWorker* EngineWorkerScheduler::takeNextReadyWorker() {
+    EngineWorker* pNextWorker = nullptr;
+    int nextPriority = EngineWorker::kPriorityCount;
+    for (const auto& pWorker: m_workers) {
+        if (pWorker->m_running || !pWorker->m_ready.load()) {
+            continue;
+        }
+        const int priority = static_cast<int>(pWorker->getPriority());
+        if (priority < nextPriority) {
+            pNextWorker = pWorker;
+            nextPriority = priority;
+        }
     }
+    if (pNextWorker == nullptr) {
+        return nullptr;
+    }
+    pNextWorker->m_running = true;
+    pNextWorker->m_ready.store(false);
+    const qint64 readySinceNanos = pNextWorker->m_readySinceNanos.exchange(0);
+    if (readySinceNanos > 0) {
+        Stat::track(m_latencyStatKeys[nextPriority],
+                Stat::DURATION_NANOSEC,
+                Stat::experimentFlags(kDefaultComputeFlags),
+                mixxx::Time::elapsed().toIntegerNanos() - readySinceNanos);
+    }
+    return pNextWorker;
 }
 
-void EngineWorkerScheduler::run() {
+void EngineWorkerScheduler::runThread() {
+    QMutexLocker locker(&m_mutex);
     while (!m_bQuit) {
-        Event::start("EngineWorkerScheduler");
-        {
-            QMutexLocker lock(&m_mutex);
-            for(const auto& pWorker: m_workers) {
-                pWorker->wakeIfReady();
+        EngineWorker* pWorker = takeNextReadyWorker();
+        if (pWorker == nullptr) {
+            // A worker that becomes ready after this thread has been
+            // counted as idle wakes it up. Workers that became ready
+            // before were not announced to it, so look once more.
+            m_idleThreadCount.fetch_add(1);
+            pWorker = takeNextReadyWorker();
+            if (pWorker == nullptr) {
+                locker.unlock();
+                m_wakeSemaphore.acquire();
+                locker.relock();
+            }
+            m_idleThreadCount.fetch_sub(1);
+            if (pWorker == nullptr) {
+                continue;
             }
         }
+        if (hasReadyWorker()) {
+            // The other ready workers go to the next idle thread
+            wakeIdleThread();
+        }
+        locker.unlock();
+        Event::start("EngineWorkerScheduler");
+        const bool morePending = pWorker->processWork();
         Event::end("EngineWorkerScheduler");
-        {
-            QMutexLocker lock(&m_mutex);
-            if (!m_bQuit) {
-                // Wait for next runWorkers() call
-                m_waitCondition.wait(&m_mutex); // unlock mutex and wait
-            }
+        locker.relock();
+        if (morePending) {
+            // Re-enter the competition with all other ready workers
+            qint64 notReady = 0;
+            pWorker->m_readySinceNanos.compare_exchange_strong(
+                    notReady, mixxx::Time::elapsed().toIntegerNanos());
+            pWorker->m_ready.store(true);
         }
+        pWorker->m_running = false;
+        m_workerFinished.wakeAll();
     }
 }
+
+void EngineWorkerScheduler::WorkerThread::run() {
+    QThread::currentThread()->setObjectName(
+            QString("EngineWorkerScheduler %1").arg(m_index + 1));
+    m_pScheduler->runThread();
+}
@@ -1,39 +1,88 @@
 #ifndef ENGINEWORKERSCHEDULER_H
 #define ENGINEWORKERSCHEDULER_H
 
+#include <atomic>
+#include <vector>
+
 #include <QMutex>
-#include <QThreadPool>
+#include <QString>
+#include <QThread>
 #include <QWaitCondition>
 
-#include "util/fifo.h"
+#include "engine/engineworker.h"
+#include "util/semaphore.h"
 
 // The max engine workers that can be expected to run within a callback
 // (e.g. the max that we will schedule). Must be a power of 2.
 #define MAX_ENGINE_WORKERS 32
 
-class EngineWorker;
-
-class EngineWorkerScheduler : public QThread {
+// Runs the pending work of all EngineWorkers on a fixed pool of threads.
+// Whenever a thread becomes idle it picks the ready worker with the highest
+// priority, i.e. reading chunks for playing decks always takes precedence
+// over cued decks, samplers and preview decks. The time between a worker
+// becoming ready and being picked up is reported per priority to the
+// StatsManager.
+//
+// Idle threads sleep on a LightweightSemaphore until runWorkers() or
+// addWorker() announces a ready worker, so the engine callback never
+// locks a mutex to wake them.
+class EngineWorkerScheduler : public QObject {
     Q_OBJECT
   public:
-    EngineWorkerScheduler(QObject* pParent=NULL);
-    virtual ~EngineWorkerScheduler();
+    static const int kDefaultThreadCount;
+
+    explicit EngineWorkerScheduler(
+            QObject* pParent = nullptr,
+            int threadCount = kDefaultThreadCount);
+    ~EngineWorkerScheduler() override;
+
+    void start(QThread::Priority priority);
 
     void addWorker(EngineWorker* pWorker);
+    // Blocks while the worker is being processed by one of the threads
+    void removeWorker(EngineWorker* pWorker);
+
+    // Called from the engine callback
     void runWorkers();
     void workerReady();
 
-  protected:
-    void run();
-
   private:
+    class WorkerThread : public QThread {
+      public:
+        WorkerThread(EngineWorkerScheduler* pScheduler, int index)
+                : m_pScheduler(pScheduler),
+                  m_index(index) {
+        }
+      protected:
+        void run() override;
+      private:
+        EngineWorkerScheduler* const m_pScheduler;
+        const int m_index;
+    };
+
+    void runThread();
+
+    // Must be called with m_mutex locked
+    EngineWorker* takeNextReadyWorker();
+    bool hasReadyWorker() const;
+
+    // Wakes up one idle thread, if any
+    void wakeIdleThread();
+
     // Indicates whether workerReady has been called since the last time
     // runWorkers was run. This should only be touched from the engine callback.
     bool m_bWakeScheduler;
 
     std::vector<EngineWorker*> m_workers;
+    std::vector<WorkerThread*> m_threads;
+
+    QString m_latencyStatKeys[EngineWorker::kPriorityCount];
+
+    LightweightSemaphore m_wakeSemaphore;
+    // Threads that are about to wait or are waiting for m_wakeSemaphore
+    std::atomic<int> m_idleThreadCount;
 
-    QWaitCondition m_waitCondition;
+    QWaitCondition m_workerFinished;
     QMutex m_mutex;
     volatile bool m_bQuit;
 };
@@ -28,6 +28,9 @@ class EngineRecord : public QObject, public EncoderCallback, public SideChainWor
 
     void process(const CSAMPLE* pBuffer, const int iBufferSize);
     void shutdown() {}
+    QString name() const override {
+        return "EngineRecord";
+    }
 
     // writes compressed audio to file
     void write(const unsigned char *header, const unsigned char *body, int headerLen, int bodyLen) override;
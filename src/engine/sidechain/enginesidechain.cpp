@@ -16,31 +16,41 @@
 
 // This class provides a way to do audio processing that does not need
 // to be executed in real-time. For example, broadcast encoding
-// and recording encoding can be done here. This class uses double-buffering
-// to increase the amount of time the CPU has to do whatever work needs to
-// be done, and that work is executed in a separate thread. (Threading
-// allows the next buffer to be filled while processing a buffer that's is
-// already full.)
+// and recording encoding can be done here. The engine copies its buffers
+// once into a FIFO and the workers, executed in a separate thread, read
+// them from there in place. (Threading allows the FIFO to be filled while
+// the workers are processing the samples that are already in it.)
 
 #include "engine/sidechain/enginesidechain.h"
 
 #include <QtDebug>
 #include <QMutexLocker>
 
+#include "control/controlproxy.h"
 #include "engine/sidechain/sidechainworker.h"
 #include "util/counter.h"
 #include "util/event.h"
+#include "util/gauge.h"
+#include "util/math.h"
+#include "util/performancetimer.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "util/trace.h"
 
 #define SIDECHAIN_BUFFER_SIZE 65536
+// Room for the samples that are being processed and for those that the
+// engine writes meanwhile
+#define SIDECHAIN_FIFO_SIZE (2 * SIDECHAIN_BUFFER_SIZE)
+// The workers process the FIFO in chunks of this many samples. A chunk is
+// released as soon as all workers are done with it, so a slow worker only
+// holds back a small part of the FIFO from the engine.
+#define SIDECHAIN_CHUNK_SIZE 4096
 
 EngineSideChain::EngineSideChain(UserSettingsPointer pConfig)
         : m_pConfig(pConfig),
           m_bStopThread(false),
-          m_sampleFifo(SIDECHAIN_BUFFER_SIZE),
-          m_pWorkBuffer(SampleUtil::alloc(SIDECHAIN_BUFFER_SIZE)) {
+          m_sampleFifo(SIDECHAIN_FIFO_SIZE),
+          m_pSampleRate(new ControlProxy("[Master]", "samplerate")) {
     // We use HighPriority to prevent starvation by lower-priority processes (Qt
     // main thread, analysis, etc.). This used to be LowPriority but that is not
     // a suitable choice since we do semi-realtime tasks
@@ -61,18 +71,21 @@ EngineSideChain::~EngineSideChain() {
 
     MMutexLocker locker(&m_workerLock);
     while (!m_workers.empty()) {
-        SideChainWorker* pWorker = m_workers.takeLast();
+        SideChainWorker* pWorker = m_workers.takeLast().pWorker;
         pWorker->shutdown();
         delete pWorker;
     }
     locker.unlock();
 
-    SampleUtil::free(m_pWorkBuffer);
+    delete m_pSampleRate;
 }
 
 void EngineSideChain::addSideChainWorker(SideChainWorker* pWorker) {
+    Worker worker;
+    worker.pWorker = pWorker;
+    worker.loadTag = QString("EngineSideChain %1 load").arg(pWorker->name());
     MMutexLocker locker(&m_workerLock);
-    m_workers.append(pWorker);
+    m_workers.append(worker);
 }
 
 void EngineSideChain::receiveBuffer(AudioInput input,
@@ -96,7 +109,10 @@ void EngineSideChain::writeSamples(const CSAMPLE* pBuffer, int iFrames) {
         Counter("EngineSideChain::writeSamples buffer overrun").increment();
     }
 
-    if (m_sampleFifo.writeAvailable() < SIDECHAIN_BUFFER_SIZE / 5) {
+    // The workers keep the samples in the FIFO until all of them have
+    // processed them, so wake them up early enough to leave room for the
+    // engine in the meantime.
+    if (m_sampleFifo.readAvailable() >= SIDECHAIN_BUFFER_SIZE / 5) {
         // Signal to the sidechain that samples are available.
         Trace wakeup("EngineSideChain::writeSamples wake up");
         m_waitForSamples.wakeAll();
@@ -119,14 +135,46 @@ void EngineSideChain::run() {
         m_waitLock.unlock();
         Event::start("EngineSideChain");
 
-        int samples_read;
-        while ((samples_read = m_sampleFifo.read(m_pWorkBuffer,
-                                                 SIDECHAIN_BUFFER_SIZE))) {
+        int readAvailable;
+        while ((readAvailable = m_sampleFifo.readAvailable()) > 0) {
             Trace process("EngineSideChain::process");
+            Gauge("EngineSideChain backlog").set(
+                    static_cast<double>(readAvailable) / SIDECHAIN_FIFO_SIZE);
+
+            // The workers read the samples in place. They are only released
+            // for the engine after the last worker has processed them.
+            CSAMPLE* dataPtr1;
+            ring_buffer_size_t size1;
+            CSAMPLE* dataPtr2;
+            ring_buffer_size_t size2;
+            (void)m_sampleFifo.aquireReadRegions(
+                    math_min(readAvailable, SIDECHAIN_CHUNK_SIZE),
+                    &dataPtr1, &size1, &dataPtr2, &size2);
+
+            // TODO: remove assumption of stereo buffer
+            const int kChannels = 2;
+            const double sampleRate = m_pSampleRate->get();
+            const double bufferSeconds = sampleRate > 0 ?
+                    (size1 + size2) / kChannels / sampleRate : 0;
+
             MMutexLocker locker(&m_workerLock);
-            foreach (SideChainWorker* pWorker, m_workers) {
-                pWorker->process(m_pWorkBuffer, samples_read);
+            for (const Worker& worker : m_workers) {
+                PerformanceTimer timer;
+                timer.start();
+                worker.pWorker->process(dataPtr1, size1);
+                if (size2 > 0) {
+                    worker.pWorker->process(dataPtr2, size2);
+                }
+                // A worker with a load above 1.0 cannot keep up and holds
+                // back the FIFO for all others
+                if (bufferSeconds > 0) {
+                    Gauge(worker.loadTag).set(
+                            timer.elapsed().toDoubleSeconds() / bufferSeconds);
+                }
             }
+            locker.unlock();
+
+            m_sampleFifo.releaseReadRegions(size1 + size2);
         }
 
         // Check to see if we're supposed to exit/stop this thread.
@@ -29,6 +29,8 @@
 #include "util/mutex.h"
 #include "util/types.h"
 
+class ControlProxy;
+
 class EngineSideChain : public QThread, public AudioDestination {
     Q_OBJECT
   public:
@@ -50,14 +52,22 @@ class EngineSideChain : public QThread, public AudioDestination {
     void addSideChainWorker(SideChainWorker* pWorker);
 
   private:
+    struct Worker {
+        SideChainWorker* pWorker;
+        // Statistics tag for the time the worker needs to process a buffer
+        // relative to the duration of its audio
+        QString loadTag;
+    };
+
     void run() override;
 
     UserSettingsPointer m_pConfig;
     // Indicates that the thread should exit.
     volatile bool m_bStopThread;
 
+    // Written once by the engine and read by all workers in place
     FIFO<CSAMPLE> m_sampleFifo;
-    CSAMPLE* m_pWorkBuffer;
+    ControlProxy* m_pSampleRate;
 
     // Provides thread safety around the wait condition below.
     QMutex m_waitLock;
@@ -66,7 +76,7 @@ class EngineSideChain : public QThread, public AudioDestination {
 
     // Sidechain workers registered with EngineSideChain.
     MMutex m_workerLock;
-    QList<SideChainWorker*> m_workers GUARDED_BY(m_workerLock);
+    QList<Worker> m_workers GUARDED_BY(m_workerLock);
 };
 
 #endif
@@ -1,14 +1,20 @@
 #ifndef SIDECHAINWORKER_H
 #define SIDECHAINWORKER_H
 
+#include <QString>
+
 #include "util/types.h"
 
 class SideChainWorker {
   public:
     SideChainWorker() { }
     virtual ~SideChainWorker() { }
+    // pBuffer points into the sample FIFO of EngineSideChain and is only
+    // valid for the duration of the call.
     virtual void process(const CSAMPLE* pBuffer, const int iBufferSize) = 0;
     virtual void shutdown() = 0;
+    // Identifies the worker in the backpressure statistics
+    virtual QString name() const = 0;
 };
 
 #endif /* SIDECHAINWORKER_H */
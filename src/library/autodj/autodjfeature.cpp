@@ -60,6 +60,7 @@ AutoDJFeature::AutoDJFeature(Library* pLibrary,
     connect(m_pAutoDJProcessor, SIGNAL(loadTrackToPlayer(TrackPointer, QString, bool)),
             this, SIGNAL(loadTrackToPlayer(TrackPointer, QString, bool)));
     m_playlistDao.setAutoDJProcessor(m_pAutoDJProcessor);
+    m_pAutoDJProcessor->enableTrackPreloading(pLibrary->dbConnectionPool());
 
     // Create the "Crates" tree-item under the root item.
     auto pRootItem = std::make_unique<TreeItem>(this);
@@ -1,5 +1,6 @@
 #include "library/autodj/autodjprocessor.h"
 
+#include "library/autodj/autodjtrackpreloader.h"
 #include "library/trackcollection.h"
 #include "control/controlpushbutton.h"
 #include "control/controlproxy.h"
@@ -72,6 +73,8 @@ AutoDJProcessor::AutoDJProcessor(QObject* pParent,
           m_pConfig(pConfig),
           m_pPlayerManager(pPlayerManager),
           m_pAutoDJTableModel(NULL),
+          m_pTrackPreloader(nullptr),
+          m_preloadNextTrackPending(false),
           m_eState(ADJ_DISABLED),
           m_transitionTime(kTransitionPreferenceDefault),
           m_nextTransitionTime(kTransitionPreferenceDefault) {
@@ -139,9 +142,63 @@ AutoDJProcessor::~AutoDJProcessor() {
     delete m_pEnabledAutoDJ;
     delete m_pFadeNow;
 
+    delete m_pTrackPreloader;
     delete m_pAutoDJTableModel;
 }
 
+void AutoDJProcessor::enableTrackPreloading(
+        mixxx::DbConnectionPoolPtr pDbConnectionPool) {
+    if (m_pTrackPreloader != nullptr ||
+            !m_pConfig->getValue(ConfigKey(kConfigKey, "PreloadNextTrack"), true)) {
+        return;
+    }
+    m_pTrackPreloader = new AutoDJTrackPreloader(
+            this, m_pConfig, pDbConnectionPool);
+    // The queue is modified by the processor itself, by the random track
+    // requests and by the user in the Auto DJ view
+    connect(m_pAutoDJTableModel, SIGNAL(rowsInserted(QModelIndex, int, int)),
+            this, SLOT(slotAutoDJQueueChanged()));
+    connect(m_pAutoDJTableModel, SIGNAL(rowsRemoved(QModelIndex, int, int)),
+            this, SLOT(slotAutoDJQueueChanged()));
+    connect(m_pAutoDJTableModel,
+            SIGNAL(rowsMoved(QModelIndex, int, int, QModelIndex, int)),
+            this, SLOT(slotAutoDJQueueChanged()));
+    connect(m_pAutoDJTableModel, SIGNAL(modelReset()),
+            this, SLOT(slotAutoDJQueueChanged()));
+    preloadNextTrack();
+}
+
+void AutoDJProcessor::slotAutoDJQueueChanged() {
+    // The model is refreshed by removing and inserting all rows. Only
+    // look at the queue after the refresh is complete.
+    if (m_preloadNextTrackPending) {
+        return;
+    }
+    m_preloadNextTrackPending = true;
+    QMetaObject::invokeMethod(this, "slotPreloadNextTrack",
+            Qt::QueuedConnection);
+}
+
+void AutoDJProcessor::slotPreloadNextTrack() {
+    m_preloadNextTrackPending = false;
+    preloadNextTrack();
+}
+
+void AutoDJProcessor::preloadNextTrack() {
+    if (m_pTrackPreloader == nullptr) {
+        return;
+    }
+    // Unlike getNextTrackFromQueue() this must not modify the queue
+    const QModelIndex topIndex = m_pAutoDJTableModel->index(0, 0);
+    const TrackId nextTrackId = m_pAutoDJTableModel->getTrackId(topIndex);
+    // Most changes of the queue don't affect its top
+    if (nextTrackId == m_preloadTrackId) {
+        return;
+    }
+    m_preloadTrackId = nextTrackId;
+    m_pTrackPreloader->preloadTrack(m_pAutoDJTableModel->getTrack(topIndex));
+}
+
 double AutoDJProcessor::getCrossfader() const {
     if (m_pCOCrossfaderReverse->toBool()) {
         return m_pCOCrossfader->get() * -1.0;
@@ -11,7 +11,9 @@
 #include "library/playlisttablemodel.h"
 #include "track/track.h"
 #include "util/class.h"
+#include "util/db/dbconnectionpool.h"
 
+class AutoDJTrackPreloader;
 class ControlPushButton;
 class TrackCollection;
 class PlayerManagerInterface;
@@ -133,6 +135,11 @@ class AutoDJProcessor : public QObject {
 
     bool nextTrackLoaded();
 
+    // Enables warming up the track at the top of the queue before it is
+    // loaded into a deck, see AutoDJTrackPreloader. Disabled by the
+    // preference [Auto DJ],PreloadNextTrack.
+    void enableTrackPreloading(mixxx::DbConnectionPoolPtr pDbConnectionPool);
+
   public slots:
     void setTransitionTime(int seconds);
 
@@ -169,6 +176,9 @@ class AutoDJProcessor : public QObject {
     void controlShuffle(double value);
     void controlSkipNext(double value);
 
+    void slotAutoDJQueueChanged();
+    void slotPreloadNextTrack();
+
   private:
     // Gets or sets the crossfader position while normalizing it so that -1 is
     // all the way mixed to the left side and 1 is all the way mixed to the
@@ -192,9 +202,16 @@ class AutoDJProcessor : public QObject {
     // present.
     bool removeTrackFromTopOfQueue(TrackPointer pTrack);
 
+    // Starts warming up the track at the top of the queue if preloading
+    // is enabled and the top has changed.
+    void preloadNextTrack();
+
     UserSettingsPointer m_pConfig;
     PlayerManagerInterface* m_pPlayerManager;
     PlaylistTableModel* m_pAutoDJTableModel;
+    AutoDJTrackPreloader* m_pTrackPreloader;
+    TrackId m_preloadTrackId;
+    bool m_preloadNextTrackPending;
 
     AutoDJState m_eState;
     double m_transitionTime; // the desired value set by the user
@@ -0,0 +1,207 @@
+#include "library/autodj/autodjtrackpreloader.h"
+
+#include <QtConcurrentRun>
+
+#include "engine/engine.h"
+#include "library/dao/analysisdao.h"
+#include "sources/audiosourcestereoproxy.h"
+#include "sources/soundsourceproxy.h"
+#include "util/db/dbconnectionpooled.h"
+#include "util/compatibility.h"
+#include "util/db/dbconnectionpooler.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/performancetimer.h"
+#include "waveform/waveformfactory.h"
+
+namespace {
+
+mixxx::Logger kLogger("AutoDJTrackPreloader");
+
+const ConfigKey kPreloadIntroSecondsKey("[Auto DJ]", "PreloadIntroSeconds");
+const int kPreloadIntroSecondsDefault = 20;
+
+const mixxx::AudioSignal::ChannelCount kPreloadChannels(mixxx::kEngineChannelCount);
+const SINT kPreloadFramesPerBlock = 4096;
+
+void loadStoredWaveforms(
+        mixxx::DbConnectionPoolPtr pDbConnectionPool,
+        UserSettingsPointer pConfig,
+        AutoDJTrackPreloader::Result* pResult) {
+    const TrackPointer& pTrack = pResult->pTrack;
+    if (pTrack->getWaveform() && pTrack->getWaveformSummary()) {
+        // Nothing to do
+        return;
+    }
+    // The thread-local connection must outlive the DAO that uses it
+    const mixxx::DbConnectionPooler dbConnectionPooler(pDbConnectionPool);
+    if (!dbConnectionPooler.isPooling()) {
+        kLogger.warning()
+                << "Failed to obtain database connection for preloading";
+        return;
+    }
+    AnalysisDao analysisDao(pConfig);
+    analysisDao.initialize(mixxx::DbConnectionPooled(pDbConnectionPool));
+    const auto analyses = analysisDao.getAnalysesForTrack(pTrack->getId());
+    for (const auto& analysis: analyses) {
+        if (analysis.type == AnalysisDao::TYPE_WAVEFORM) {
+            if (!pResult->pWaveform && !pTrack->getWaveform() &&
+                    WaveformFactory::waveformVersionToVersionClass(analysis.version) ==
+                            WaveformFactory::VC_USE) {
+                pResult->pWaveform = ConstWaveformPointer(
+                        WaveformFactory::loadWaveformFromAnalysis(analysis));
+            }
+        } else if (analysis.type == AnalysisDao::TYPE_WAVESUMMARY) {
+            if (!pResult->pWaveformSummary && !pTrack->getWaveformSummary() &&
+                    WaveformFactory::waveformSummaryVersionToVersionClass(analysis.version) ==
+                            WaveformFactory::VC_USE) {
+                pResult->pWaveformSummary = ConstWaveformPointer(
+                        WaveformFactory::loadWaveformFromAnalysis(analysis));
+            }
+        }
+    }
+    analysisDao.initialize(QSqlDatabase());
+}
+
+// Decodes the region where playback will start, i.e. at the main cue
+// point. The decoded samples are discarded.
+void decodeIntro(const TrackPointer& pTrack, int introSeconds,
+        const QAtomicInt* pCancel) {
+    mixxx::AudioSource::OpenParams openParams;
+    openParams.setChannelCount(kPreloadChannels);
+    auto pAudioSource = SoundSourceProxy(pTrack).openAudioSource(openParams);
+    if (!pAudioSource) {
+        kLogger.warning()
+                << "Failed to open file for preloading:"
+                << pTrack->getLocation();
+        return;
+    }
+    mixxx::AudioSourceStereoProxy audioSourceProxy(
+            pAudioSource,
+            kPreloadFramesPerBlock);
+    mixxx::SampleBuffer sampleBuffer(kPreloadFramesPerBlock * kPreloadChannels);
+
+    // The cue point is measured in stereo samples
+    const SINT cueFrame = static_cast<SINT>(
+            math_max(0.0, pTrack->getCuePoint()) / mixxx::kEngineChannelCount);
+    const SINT startFrame = math_clamp(cueFrame,
+            pAudioSource->frameIndexRange().start(),
+            pAudioSource->frameIndexRange().end());
+    const SINT endFrame = math_min(
+            startFrame + static_cast<SINT>(pAudioSource->sampleRate()) * introSeconds,
+            pAudioSource->frameIndexRange().end());
+    mixxx::IndexRange remainingFrames =
+            mixxx::IndexRange::between(startFrame, endFrame);
+    while (!remainingFrames.empty()) {
+        if (load_atomic(*pCancel)) {
+            return;
+        }
+        const auto readFrames =
+                audioSourceProxy.readSampleFrames(
+                        mixxx::WritableSampleFrames(
+                                remainingFrames.splitAndShrinkFront(
+                                        math_min(kPreloadFramesPerBlock,
+                                                remainingFrames.length())),
+                                mixxx::SampleBuffer::WritableSlice(sampleBuffer)));
+        if (readFrames.frameLength() < kPreloadFramesPerBlock &&
+                !remainingFrames.empty()) {
+            // Decoding error, the deck will report it
+            break;
+        }
+    }
+}
+
+AutoDJTrackPreloader::Result preloadTrackInBackground(
+        mixxx::DbConnectionPoolPtr pDbConnectionPool,
+        UserSettingsPointer pConfig,
+        TrackPointer pTrack,
+        const QAtomicInt* pCancel) {
+    PerformanceTimer timer;
+    timer.start();
+
+    AutoDJTrackPreloader::Result result;
+    result.pTrack = pTrack;
+    if (load_atomic(*pCancel)) {
+        return result;
+    }
+    loadStoredWaveforms(pDbConnectionPool, pConfig, &result);
+    const int introSeconds = pConfig->getValue(
+            kPreloadIntroSecondsKey, kPreloadIntroSecondsDefault);
+    if (introSeconds > 0) {
+        decodeIntro(pTrack, introSeconds, pCancel);
+    }
+
+    kLogger.debug()
+            << "Preloaded" << pTrack->getLocation()
+            << "in" << timer.elapsed().debugMillisWithUnit();
+    return result;
+}
+
+} // anonymous namespace
+
+AutoDJTrackPreloader::AutoDJTrackPreloader(
+        QObject* pParent,
+        UserSettingsPointer pConfig,
+        mixxx::DbConnectionPoolPtr pDbConnectionPool)
+        : QObject(pParent),
+          m_pConfig(pConfig),
+          m_pDbConnectionPool(pDbConnectionPool) {
+    connect(&m_preloadWatcher, SIGNAL(finished()),
+            this, SLOT(slotPreloadFinished()));
+}
+
+AutoDJTrackPreloader::~AutoDJTrackPreloader() {
+    m_cancelPreload = 1;
+    m_preloadWatcher.waitForFinished();
+}
+
+void AutoDJTrackPreloader::preloadTrack(TrackPointer pTrack) {
+    if (pTrack == m_pTrack) {
+        return;
+    }
+    m_pTrack = pTrack;
+    if (m_preloadWatcher.isRunning()) {
+        // The running preload is stopped early and its results are
+        // dropped by slotPreloadFinished()
+        m_cancelPreload = 1;
+        m_pPendingTrack = pTrack;
+        return;
+    }
+    startPreload();
+}
+
+void AutoDJTrackPreloader::startPreload() {
+    m_pPendingTrack.reset();
+    if (!m_pTrack || !m_pTrack->getId().isValid()) {
+        return;
+    }
+    m_cancelPreload = 0;
+    m_preloadWatcher.setFuture(QtConcurrent::run(
+            &preloadTrackInBackground,
+            m_pDbConnectionPool,
+            m_pConfig,
+            m_pTrack,
+            &m_cancelPreload));
+    emit(preloadStarted(m_pTrack->getId()));
+}
+
+void AutoDJTrackPreloader::slotPreloadFinished() {
+    const Result result = m_preloadWatcher.result();
+    // The track might have been replaced or ejected while the results
+    // were on their way
+    const bool cancelled = result.pTrack != m_pTrack;
+    if (!cancelled) {
+        // Waveforms are attached on the main thread and only if the track
+        // has not been analyzed by a deck in the meantime.
+        if (result.pWaveform && !result.pTrack->getWaveform()) {
+            result.pTrack->setWaveform(result.pWaveform);
+        }
+        if (result.pWaveformSummary && !result.pTrack->getWaveformSummary()) {
+            result.pTrack->setWaveformSummary(result.pWaveformSummary);
+        }
+    }
+    emit(preloadFinished(result.pTrack->getId(), cancelled));
+    if (m_pPendingTrack) {
+        startPreload();
+    }
+}
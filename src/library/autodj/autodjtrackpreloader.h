@@ -0,0 +1,67 @@
+#ifndef AUTODJTRACKPRELOADER_H
+#define AUTODJTRACKPRELOADER_H
+
+#include <QAtomicInt>
+#include <QFutureWatcher>
+#include <QObject>
+
+#include "preferences/usersettings.h"
+#include "track/track.h"
+#include "util/db/dbconnectionpool.h"
+#include "waveform/waveform.h"
+
+// Warms up the track at the top of the Auto DJ queue before it is loaded
+// into a deck. The track object is kept alive and thereby stays in the
+// global track cache together with its beats and cues, the stored
+// waveforms are attached to it and the intro region is decoded once so
+// that the file contents are already in the page cache of the OS when
+// the deck starts reading.
+//
+// Only a single track is kept preloaded. All work except attaching the
+// results to the track is done on a worker thread. Replacing or ejecting
+// the track cancels its preload.
+class AutoDJTrackPreloader : public QObject {
+    Q_OBJECT
+  public:
+    AutoDJTrackPreloader(
+            QObject* pParent,
+            UserSettingsPointer pConfig,
+            mixxx::DbConnectionPoolPtr pDbConnectionPool);
+    ~AutoDJTrackPreloader() override;
+
+    // Replaces the preloaded track. A null pointer ejects the preloaded
+    // track. If another track is still being warmed up it is cancelled and
+    // the new one is started after it has stopped.
+    void preloadTrack(TrackPointer pTrack);
+
+    const TrackPointer& getPreloadedTrack() const {
+        return m_pTrack;
+    }
+
+    struct Result {
+        TrackPointer pTrack;
+        ConstWaveformPointer pWaveform;
+        ConstWaveformPointer pWaveformSummary;
+    };
+
+  signals:
+    void preloadStarted(TrackId trackId);
+    // A cancelled preload has not attached any results to the track
+    void preloadFinished(TrackId trackId, bool cancelled);
+
+  private slots:
+    void slotPreloadFinished();
+
+  private:
+    void startPreload();
+
+    const UserSettingsPointer m_pConfig;
+    const mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+
+    TrackPointer m_pTrack;
+    TrackPointer m_pPendingTrack;
+    QFutureWatcher<Result> m_preloadWatcher;
+    QAtomicInt m_cancelPreload;
+};
+
+#endif // AUTODJTRACKPRELOADER_H
@@ -6,6 +6,7 @@
 
 #include "library/coverartcache.h"
 #include "library/coverartutils.h"
+#include "util/assert.h"
 #include "util/logger.h"
 
 
@@ -18,6 +19,9 @@ QString pixmapCacheKey(quint16 hash, int width) {
             .arg(QString::number(hash)).arg(width);
 }
 
+// Upper bound for the number of covers that are loaded concurrently
+const int kMaxConcurrentLoads = 2;
+
 // The transformation mode when scaling images
 const Qt::TransformationMode kTransformationMode = Qt::SmoothTransformation;
 
@@ -30,7 +34,8 @@ inline QImage resizeImageWidth(const QImage& image, int width) {
 
 const bool sDebug = false;
 
-CoverArtCache::CoverArtCache() {
+CoverArtCache::CoverArtCache()
+        : m_activeLoads(0) {
     // The initial QPixmapCache limit is 10MB.
     // But it is not used just by the coverArt stuff,
     // it is also used by Qt to handle other things behind the scenes.
@@ -43,6 +48,15 @@ CoverArtCache::CoverArtCache() {
 
 CoverArtCache::~CoverArtCache() {
     qDebug() << "~CoverArtCache()";
+    m_diskCachePruned.waitForFinished();
+}
+
+void CoverArtCache::enableDiskCache(const QString& directory,
+                                    qint64 maxSizeBytes) {
+    DEBUG_ASSERT(m_pDiskCache.isNull());
+    m_pDiskCache.reset(new CoverArtDiskCache(directory, maxSizeBytes));
+    m_diskCachePruned = QtConcurrent::run(
+            m_pDiskCache.data(), &CoverArtDiskCache::prune);
 }
 
 QPixmap CoverArtCache::requestCover(const CoverInfo& requestInfo,
@@ -94,16 +108,33 @@ QPixmap CoverArtCache::requestCover(const CoverInfo& requestInfo,
     }
 
     m_runningRequests.insert(requestId);
-    // The watcher will be deleted in coverLoaded()
-    QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
-    QFuture<FutureResult> future = QtConcurrent::run(
-            this, &CoverArtCache::loadCover, requestInfo, pRequestor,
-            desiredWidth, signalWhenDone);
-    connect(watcher, SIGNAL(finished()), this, SLOT(coverLoaded()));
-    watcher->setFuture(future);
+    PendingRequest request;
+    request.info = requestInfo;
+    request.pRequestor = pRequestor;
+    request.desiredWidth = desiredWidth;
+    request.signalWhenDone = signalWhenDone;
+    m_pendingRequests.append(request);
+    startPendingLoads();
     return QPixmap();
 }
 
+void CoverArtCache::startPendingLoads() {
+    while (m_activeLoads < kMaxConcurrentLoads && !m_pendingRequests.isEmpty()) {
+        // Serve the most recent request first. While scrolling through the
+        // library these are the rows that are currently visible.
+        const PendingRequest request = m_pendingRequests.takeLast();
+        ++m_activeLoads;
+        // The watcher will be deleted in coverLoaded()
+        QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
+        QFuture<FutureResult> future = QtConcurrent::run(
+                this, &CoverArtCache::loadCover, request.info,
+                request.pRequestor, request.desiredWidth,
+                request.signalWhenDone);
+        connect(watcher, SIGNAL(finished()), this, SLOT(coverLoaded()));
+        watcher->setFuture(future);
+    }
+}
+
 //static
 void CoverArtCache::requestCover(const Track& track,
                          const QObject* pRequestor) {
@@ -124,6 +155,20 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
                  << info << desiredWidth << signalWhenDone;
     }
 
+    // Scaled thumbnails that have been decoded before are read back from
+    // the persistent store instead of decoding the full-size image again.
+    const bool useDiskCache = !m_pDiskCache.isNull() && desiredWidth > 0;
+    if (useDiskCache) {
+        QImage thumbnail = m_pDiskCache->load(info.hash, desiredWidth);
+        if (!thumbnail.isNull()) {
+            FutureResult res;
+            res.pRequestor = pRequestor;
+            res.cover = CoverArt(info, thumbnail, desiredWidth);
+            res.signalWhenDone = signalWhenDone;
+            return res;
+        }
+    }
+
     QImage image = CoverArtUtils::loadCover(info);
 
     // TODO(XXX) Should we re-hash here? If the cover file (or track metadata)
@@ -135,6 +180,9 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
     // efficiency.
     if (!image.isNull() && desiredWidth > 0) {
         image = resizeImageWidth(image, desiredWidth);
+        if (useDiskCache) {
+            m_pDiskCache->save(info.hash, desiredWidth, image);
+        }
     }
 
     FutureResult res;
@@ -154,6 +202,8 @@ void CoverArtCache::coverLoaded() {
         res = watcher->result();
         watcher->deleteLater();
     }
+    --m_activeLoads;
+    startPendingLoads();
 
     if (sDebug) {
         kLogger.debug() << "coverLoaded" << res.cover;
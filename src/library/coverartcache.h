@@ -1,10 +1,14 @@
 #ifndef COVERARTCACHE_H
 #define COVERARTCACHE_H
 
+#include <QFuture>
+#include <QList>
 #include <QObject>
 #include <QPixmap>
+#include <QScopedPointer>
 
 #include "library/coverart.h"
+#include "library/coverartdiskcache.h"
 #include "util/singleton.h"
 #include "track/track.h"
 
@@ -32,6 +36,12 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
     static void requestCover(const Track& track,
                              const QObject* pRequestor);
 
+    // Enables the persistent thumbnail store in the given directory. Scaled
+    // covers are written to disk after they have been decoded once and are
+    // read back from there instead of decoding the full-size image again.
+    // Must be called before the first cover is requested.
+    void enableDiskCache(const QString& directory, qint64 maxSizeBytes);
+
     // Guesses the cover art for the provided tracks by searching the tracks'
     // metadata and folders for image files. All I/O is done in a separate
     // thread.
@@ -74,7 +84,26 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
     void guessCover(TrackPointer pTrack);
 
   private:
+    struct PendingRequest {
+        CoverInfo info;
+        const QObject* pRequestor;
+        int desiredWidth;
+        bool signalWhenDone;
+    };
+
+    // Starts queued requests until the limit of concurrent loads is reached.
+    void startPendingLoads();
+
     QSet<QPair<const QObject*, quint16> > m_runningRequests;
+
+    // Requests that have not been passed to a worker thread yet. Decoding is
+    // limited to a few concurrent loads to avoid that scrolling through the
+    // library occupies all threads of the global thread pool.
+    QList<PendingRequest> m_pendingRequests;
+    int m_activeLoads;
+
+    QScopedPointer<CoverArtDiskCache> m_pDiskCache;
+    QFuture<void> m_diskCachePruned;
 };
 
 #endif // COVERARTCACHE_H
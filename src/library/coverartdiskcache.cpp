@@ -0,0 +1,106 @@
+#include <QFile>
+#include <QFileInfo>
+#include <QtDebug>
+
+#include "library/coverartdiskcache.h"
+#include "util/logger.h"
+
+namespace {
+
+mixxx::Logger kLogger("CoverArtDiskCache");
+
+const char* const kThumbnailFormat = "PNG";
+const QString kThumbnailSuffix = ".png";
+const QString kTemporarySuffix = ".tmp";
+
+// Stop pruning at a lower watermark to avoid that every single new
+// thumbnail triggers another pruning pass.
+const double kPruneTargetRatio = 0.8;
+
+} // anonymous namespace
+
+CoverArtDiskCache::CoverArtDiskCache(const QString& directory,
+                                     qint64 maxSizeBytes)
+        : m_directory(directory),
+          m_maxSizeBytes(maxSizeBytes) {
+    if (!m_directory.exists() && !QDir().mkpath(m_directory.absolutePath())) {
+        kLogger.warning()
+                << "Failed to create cover art thumbnail directory"
+                << m_directory.absolutePath();
+    }
+}
+
+QString CoverArtDiskCache::filePath(quint16 hash, int width) const {
+    return m_directory.filePath(
+            QString("%1_%2").arg(QString::number(hash), QString::number(width))
+            + kThumbnailSuffix);
+}
+
+QImage CoverArtDiskCache::load(quint16 hash, int width) const {
+    const QString path = filePath(hash, width);
+    if (!QFile::exists(path)) {
+        return QImage();
+    }
+    QImage image(path, kThumbnailFormat);
+    if (image.isNull()) {
+        kLogger.warning()
+                << "Discarding unreadable cover art thumbnail"
+                << path;
+        QFile::remove(path);
+    }
+    return image;
+}
+
+bool CoverArtDiskCache::save(quint16 hash, int width, const QImage& image) const {
+    if (image.isNull() || width <= 0) {
+        return false;
+    }
+    const QString path = filePath(hash, width);
+    // Write into a temporary file first so that concurrent readers never
+    // see a partially written thumbnail.
+    const QString tempPath = path + kTemporarySuffix;
+    if (!image.save(tempPath, kThumbnailFormat)) {
+        kLogger.warning()
+                << "Failed to write cover art thumbnail"
+                << tempPath;
+        QFile::remove(tempPath);
+        return false;
+    }
+    // QFile::rename() does not overwrite existing files
+    QFile::remove(path);
+    if (!QFile::rename(tempPath, path)) {
+        QFile::remove(tempPath);
+        return false;
+    }
+    return true;
+}
+
+void CoverArtDiskCache::prune() const {
+    QFileInfoList thumbnails = m_directory.entryInfoList(
+            QStringList() << ("*" + kThumbnailSuffix),
+            QDir::Files, QDir::Time | QDir::Reversed);
+    qint64 totalSize = 0;
+    for (const auto& fileInfo: thumbnails) {
+        totalSize += fileInfo.size();
+    }
+    if (totalSize <= m_maxSizeBytes) {
+        return;
+    }
+    const qint64 targetSize = static_cast<qint64>(
+            m_maxSizeBytes * kPruneTargetRatio);
+    int removed = 0;
+    // Sorted by modification time, oldest first
+    for (const auto& fileInfo: thumbnails) {
+        if (totalSize <= targetSize) {
+            break;
+        }
+        if (QFile::remove(fileInfo.absoluteFilePath())) {
+            totalSize -= fileInfo.size();
+            ++removed;
+        }
+    }
+    kLogger.info()
+            << "Removed" << removed
+            << "cover art thumbnails, remaining size" << totalSize
+            << "bytes";
+}
@@ -0,0 +1,40 @@
+#ifndef COVERARTDISKCACHE_H
+#define COVERARTDISKCACHE_H
+
+#include <QDir>
+#include <QImage>
+#include <QString>
+
+// Persistent second-level store for scaled cover art thumbnails. Thumbnails
+// are stored as PNG files keyed by the cover hash and the width they have
+// been scaled to, so that the library table does not need to decode the
+// full-size cover from the audio file or the folder image again after a
+// restart.
+//
+// load() and save() only touch the file belonging to a single key and may
+// be called concurrently from multiple worker threads.
+class CoverArtDiskCache {
+  public:
+    CoverArtDiskCache(const QString& directory, qint64 maxSizeBytes);
+
+    const QDir& directory() const {
+        return m_directory;
+    }
+
+    // Returns a null image if no thumbnail has been stored for the key.
+    QImage load(quint16 hash, int width) const;
+    bool save(quint16 hash, int width, const QImage& image) const;
+
+    // Removes the least recently written thumbnails until the total size of
+    // the store is below the configured limit. This walks the whole store
+    // and should be run off the GUI thread.
+    void prune() const;
+
+  private:
+    QString filePath(quint16 hash, int width) const;
+
+    const QDir m_directory;
+    const qint64 m_maxSizeBytes;
+};
+
+#endif // COVERARTDISKCACHE_H
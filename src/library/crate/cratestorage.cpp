@@ -22,39 +22,48 @@ const QString CRATE_SUMMARY_VIEW = "crate_summary";
 const QString CRATESUMMARY_TRACK_COUNT = "track_count";
 const QString CRATESUMMARY_TRACK_DURATION = "track_duration";
 
-const QString kCrateTracksJoin = QString(
-        "LEFT JOIN %3 ON %3.%4=%1.%2").arg(
-                CRATE_TABLE,
-                CRATETABLE_ID,
-                CRATE_TRACKS_TABLE,
-                CRATETRACKSTABLE_CRATEID);
+// Track counts and durations are maintained incrementally by database
+// triggers, see schema revision 30.
+const QString CRATE_SUMMARIES_TABLE = "crate_summaries";
+const QString CRATESUMMARIES_CRATEID = "crate_id";
 
-const QString kLibraryTracksJoin = kCrateTracksJoin + QString(
-        " LEFT JOIN %3 ON %3.%4=%1.%2").arg(
-                CRATE_TRACKS_TABLE,
-                CRATETRACKSTABLE_TRACKID,
-                LIBRARY_TABLE,
-                LIBRARYTABLE_ID);
-
-const QString kCrateSummaryViewSelect = QString(
-        "SELECT %1.*,"
-            "COUNT(CASE %2.%4 WHEN 0 THEN 1 ELSE NULL END) AS %5,"
-            "SUM(CASE %2.%4 WHEN 0 THEN %2.%3 ELSE 0 END) AS %6 "
-            "FROM %1").arg(
+const QString kCrateSummaryViewQuery = QString(
+        "CREATE TEMPORARY VIEW IF NOT EXISTS %1 AS "
+            "SELECT %2.*,"
+            "IFNULL(%4.%6,0) AS %6,"
+            "IFNULL(%4.%7,0) AS %7 "
+            "FROM %2 LEFT JOIN %4 ON %4.%5=%2.%3").arg(
+                CRATE_SUMMARY_VIEW,
                 CRATE_TABLE,
-                LIBRARY_TABLE,
-                LIBRARYTABLE_DURATION,
-                LIBRARYTABLE_MIXXXDELETED,
+                CRATETABLE_ID,
+                CRATE_SUMMARIES_TABLE,
+                CRATESUMMARIES_CRATEID,
                 CRATESUMMARY_TRACK_COUNT,
                 CRATESUMMARY_TRACK_DURATION);
 
-const QString kCrateSummaryViewQuery = QString(
-            "CREATE TEMPORARY VIEW IF NOT EXISTS %1 AS %2 %3 GROUP BY %4.%5").arg(
-                    CRATE_SUMMARY_VIEW,
-                    kCrateSummaryViewSelect,
-                    kLibraryTracksJoin,
-                    CRATE_TABLE,
-                    CRATETABLE_ID);
+// Recalculates all crate summaries from scratch
+const QString kRebuildCrateSummariesQuery = QString(
+        "INSERT OR REPLACE INTO %1 (%2,%3,%4) "
+            "SELECT %5.%6,"
+            "COUNT(CASE %7.%10 WHEN 0 THEN 1 ELSE NULL END),"
+            "TOTAL(CASE %7.%10 WHEN 0 THEN %7.%9 ELSE 0 END) "
+            "FROM %5 "
+            "LEFT JOIN %11 ON %11.%12=%5.%6 "
+            "LEFT JOIN %7 ON %7.%8=%11.%13 "
+            "GROUP BY %5.%6").arg(
+                CRATE_SUMMARIES_TABLE,
+                CRATESUMMARIES_CRATEID,
+                CRATESUMMARY_TRACK_COUNT,
+                CRATESUMMARY_TRACK_DURATION,
+                CRATE_TABLE,
+                CRATETABLE_ID,
+                LIBRARY_TABLE,
+                LIBRARYTABLE_ID,
+                LIBRARYTABLE_DURATION)
+        .arg(LIBRARYTABLE_MIXXXDELETED,
+                CRATE_TRACKS_TABLE,
+                CRATETRACKSTABLE_CRATEID,
+                CRATETRACKSTABLE_TRACKID);
 
 
 class CrateQueryBinder {
@@ -227,6 +236,31 @@ void CrateStorage::repairDatabase(QSqlDatabase database) {
                     << "library purged tracks from crates";
         }
     }
+
+    // Crate summaries
+    {
+        // Remove summaries of non-existent crates
+        FwdSqlQuery query(database, QString(
+                "DELETE FROM %1 WHERE %2 NOT IN (SELECT %3 FROM %4)").arg(
+                        CRATE_SUMMARIES_TABLE,
+                        CRATESUMMARIES_CRATEID,
+                        CRATETABLE_ID,
+                        CRATE_TABLE));
+        if (query.execPrepared() && (query.numRowsAffected() > 0)) {
+            kLogger.warning()
+                    << "Removed" << query.numRowsAffected()
+                    << "summaries of non-existent crates";
+        }
+    }
+    {
+        // Recalculate the incrementally maintained summaries in case
+        // they have drifted apart from the actual contents of the crates
+        FwdSqlQuery query(database, kRebuildCrateSummariesQuery);
+        if (!query.execPrepared()) {
+            kLogger.warning()
+                    << "Failed to recalculate crate summaries";
+        }
+    }
 }
 
 
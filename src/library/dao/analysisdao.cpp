@@ -7,6 +7,7 @@
 #include "library/queryutil.h"
 #include "preferences/waveformsettings.h"
 #include "util/performancetimer.h"
+#include "waveform/overviewcache.h"
 #include "waveform/waveform.h"
 
 const QString AnalysisDao::s_analysisTableName = "track_analysis";
@@ -218,6 +219,7 @@ void AnalysisDao::deleteAnalyses(const QList<TrackId>& trackIds) {
     if (!query.exec()) {
         LOG_FAILED_QUERY(query) << "couldn't delete analysis";
     }
+    OverviewCache(m_pConfig).deleteImages(trackIds);
 }
 
 bool AnalysisDao::deleteAnalysesForTrack(TrackId trackId) {
@@ -243,6 +245,7 @@ bool AnalysisDao::deleteAnalysesForTrack(TrackId trackId) {
     foreach (int analysisId, analysesToDelete) {
         deleteAnalysis(analysisId);
     }
+    OverviewCache(m_pConfig).deleteImages(QList<TrackId>() << trackId);
     return true;
 }
 
@@ -403,6 +406,10 @@ bool AnalysisDao::deleteAnalysesByType(
     if (!query.exec()) {
         LOG_FAILED_QUERY(query) << "couldn't delete analysis";
     }
+    if (type == TYPE_WAVESUMMARY) {
+        // The overview images are rendered from the summaries
+        OverviewCache(m_pConfig).deleteAllImages();
+    }
 
     return true;
 }
@@ -172,3 +172,40 @@ QStringList LibraryHashDAO::getDeletedDirectories() {
     }
     return result;
 }
+
+QHash<QString, DirectoryStat> LibraryHashDAO::getDirectoryStats() {
+    QSqlQuery query(m_database);
+    query.prepare("SELECT directory_path, directory_mtime, directory_inode "
+                  "FROM LibraryHashes WHERE directory_mtime<>0");
+    QHash<QString, DirectoryStat> dirStats;
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+
+    const int directoryPathColumn = query.record().indexOf("directory_path");
+    const int mtimeColumn = query.record().indexOf("directory_mtime");
+    const int inodeColumn = query.record().indexOf("directory_inode");
+    while (query.next()) {
+        dirStats.insert(query.value(directoryPathColumn).toString(),
+                DirectoryStat(query.value(mtimeColumn).toLongLong(),
+                        query.value(inodeColumn).toLongLong()));
+    }
+    return dirStats;
+}
+
+void LibraryHashDAO::updateDirectoryStats(
+        const QHash<QString, DirectoryStat>& dirStats) {
+    QSqlQuery query(m_database);
+    query.prepare("UPDATE LibraryHashes "
+                  "SET directory_mtime=:directory_mtime, "
+                  "directory_inode=:directory_inode "
+                  "WHERE directory_path=:directory_path");
+    for (auto it = dirStats.constBegin(); it != dirStats.constEnd(); ++it) {
+        query.bindValue(":directory_mtime", it.value().modifiedMillis());
+        query.bindValue(":directory_inode", it.value().inode());
+        query.bindValue(":directory_path", it.key());
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query) << "Updating directory stat failed.";
+        }
+    }
+}
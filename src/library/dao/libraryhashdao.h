@@ -7,6 +7,7 @@
 #include <QSqlDatabase>
 
 #include "library/dao/dao.h"
+#include "library/scanner/directorystat.h"
 
 class LibraryHashDAO : public DAO {
   public:
@@ -29,6 +30,11 @@ class LibraryHashDAO : public DAO {
                                  const bool deleted, const bool verified);
     QStringList getDeletedDirectories();
 
+    // Modification time and inode of each directory recorded by the
+    // last scan. Directories without recorded metadata are omitted.
+    QHash<QString, DirectoryStat> getDirectoryStats();
+    void updateDirectoryStats(const QHash<QString, DirectoryStat>& dirStats);
+
   private:
     QSqlDatabase m_database;
 };
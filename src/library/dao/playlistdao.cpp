@@ -17,6 +17,35 @@ void PlaylistDAO::initialize(const QSqlDatabase& database) {
     populatePlaylistMembershipCache();
 }
 
+void PlaylistDAO::repairDatabase(QSqlDatabase database) {
+    // Remove summaries of non-existent playlists
+    QSqlQuery query(database);
+    query.prepare("DELETE FROM playlist_summaries "
+            "WHERE playlist_id NOT IN (SELECT id FROM " PLAYLIST_TABLE ")");
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    } else if (query.numRowsAffected() > 0) {
+        qWarning() << "Removed" << query.numRowsAffected()
+                   << "summaries of non-existent playlists";
+    }
+
+    // Recalculate the summaries in case they have drifted apart from the
+    // actual contents of the playlists
+    query.prepare("INSERT OR REPLACE INTO playlist_summaries "
+            "(playlist_id, track_count, track_duration) "
+            "SELECT " PLAYLIST_TABLE ".id, "
+            "COUNT(CASE library.mixxx_deleted WHEN 0 THEN 1 ELSE NULL END), "
+            "TOTAL(CASE library.mixxx_deleted WHEN 0 THEN library.duration ELSE 0 END) "
+            "FROM " PLAYLIST_TABLE " "
+            "LEFT JOIN " PLAYLIST_TRACKS_TABLE " ON "
+            PLAYLIST_TRACKS_TABLE ".playlist_id = " PLAYLIST_TABLE ".id "
+            "LEFT JOIN library ON library.id = " PLAYLIST_TRACKS_TABLE ".track_id "
+            "GROUP BY " PLAYLIST_TABLE ".id");
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+}
+
 void PlaylistDAO::populatePlaylistMembershipCache() {
     // Minor optimization: reserve space in m_playlistsTrackIsIn.
     QSqlQuery query(m_database);
@@ -53,6 +53,10 @@ class PlaylistDAO : public QObject, public virtual DAO {
 
     void initialize(const QSqlDatabase& database);
 
+    // Recalculates the track counts and durations of all playlists that
+    // are maintained incrementally by database triggers
+    void repairDatabase(QSqlDatabase database);
+
     // Create a playlist, fails with -1 if already exists
     int createPlaylist(const QString& name, const HiddenType type = PLHT_NOT_HIDDEN);
     // Create a playlist, appends "(n)" if already exists, name becomes the new name
@@ -616,6 +616,18 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
 }
 
 TrackPointer TrackDAO::addTracksAddFile(const QFileInfo& fileInfo, bool unremove) {
+    return addTracksAddFile(fileInfo, TrackPointer(), unremove);
+}
+
+TrackPointer TrackDAO::addTracksAddParsedFile(const TrackPointer& pParsedTrack, bool unremove) {
+    DEBUG_ASSERT(pParsedTrack);
+    return addTracksAddFile(pParsedTrack->getFileInfo(), pParsedTrack, unremove);
+}
+
+TrackPointer TrackDAO::addTracksAddFile(
+        const QFileInfo& fileInfo,
+        const TrackPointer& pParsedTrack,
+        bool unremove) {
     // Check that track is a supported extension.
     // TODO(uklotzde): The following check can be skipped if
     // the track is already in the library. A refactoring is
@@ -645,9 +657,22 @@ TrackPointer TrackDAO::addTracksAddFile(const QFileInfo& fileInfo, bool unremove
     // Keep the GlobalTrackCache locked until the id of the Track
     // object is known and has been updated in the cache.
 
-    // Initially (re-)import the metadata for the newly created track
-    // from the file.
-    SoundSourceProxy(pTrack).updateTrackFromSource();
+    if (pParsedTrack) {
+        // Take over the metadata that has already been imported from
+        // the file into the temporary track object.
+        pTrack->setType(pParsedTrack->getType());
+        mixxx::TrackMetadata trackMetadata;
+        bool metadataSynchronized = false;
+        pParsedTrack->getTrackMetadata(&trackMetadata, &metadataSynchronized);
+        pTrack->setTrackMetadata(
+                trackMetadata,
+                metadataSynchronized ? fileInfo.lastModified() : QDateTime());
+        pTrack->setCoverInfo(pParsedTrack->getCoverInfo());
+    } else {
+        // Initially (re-)import the metadata for the newly created track
+        // from the file.
+        SoundSourceProxy(pTrack).updateTrackFromSource();
+    }
     if (!pTrack->isMetadataSynchronized()) {
         qWarning() << "TrackDAO::addTracksAddFile:"
                 << "Failed to parse track metadata from file"
@@ -906,11 +931,12 @@ bool TrackDAO::onPurgingTracks(
     }
     {
         // mark LibraryHash with needs_verification and invalidate the hash
-        // in case the file was not deleted to detect it on a rescan
+        // and the directory metadata in case the file was not deleted to
+        // detect it on a rescan
         // TODO(XXX) delegate to libraryHashDAO
         FwdSqlQuery query(m_database, QString(
                 "UPDATE LibraryHashes SET needs_verification=1, "
-                "hash=-1 WHERE directory_path in (%1)").arg(
+                "hash=-1, directory_mtime=0 WHERE directory_path in (%1)").arg(
                         SqlStringFormatter::formatList(m_database, directories)));
         if (query.hasError() || !query.execPrepared()) {
             return false;
@@ -55,6 +55,9 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
 
     void addTracksPrepare();
     TrackPointer addTracksAddFile(const QFileInfo& fileInfo, bool unremove);
+    // Adds the file of a temporary track object whose metadata has already
+    // been parsed, e.g. by a worker thread of the library scanner.
+    TrackPointer addTracksAddParsedFile(const TrackPointer& pParsedTrack, bool unremove);
     TrackId addTracksAddTrack(const TrackPointer& pTrack, bool unremove);
     void addTracksFinish(bool rollback = false);
 
@@ -130,6 +133,11 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
 
     bool updateTrack(Track* pTrack);
 
+    TrackPointer addTracksAddFile(
+            const QFileInfo& fileInfo,
+            const TrackPointer& pParsedTrack,
+            bool unremove);
+
     // Callback for GlobalTrackCache
     QFileInfo relocateCachedTrack(
             TrackId trackId,
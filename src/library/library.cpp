@@ -28,6 +28,7 @@
 #include "library/traktor/traktorfeature.h"
 #include "library/librarycontrol.h"
 #include "library/setlogfeature.h"
+#include "library/scanner/librarywatcher.h"
 #include "util/db/dbconnectionpooled.h"
 #include "util/sandbox.h"
 #include "util/logger.h"
@@ -44,6 +45,11 @@ namespace {
 
 const mixxx::Logger kLogger("Library");
 
+// Automatically rescan the library when files are added to or removed
+// from the library directories.
+const ConfigKey kConfigKeyWatchLibraryDirectories(
+        "[Library]", "WatchLibraryDirectories");
+
 } // anonymous namespace
 
 //static
@@ -74,7 +80,8 @@ Library::Library(
       m_pPlaylistFeature(nullptr),
       m_pCrateFeature(nullptr),
       m_pAnalysisFeature(nullptr),
-      m_scanner(pDbConnectionPool, m_pTrackCollection, pConfig) {
+      m_scanner(pDbConnectionPool, m_pTrackCollection, pConfig),
+      m_pLibraryWatcher(nullptr) {
 
     QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_pDbConnectionPool);
 
@@ -102,6 +109,21 @@ Library::Library(
     connect(&m_scanner, SIGNAL(scanFinished()),
             this, SLOT(slotRefreshLibraryModels()));
 
+    if (pConfig->getValue(kConfigKeyWatchLibraryDirectories, false)) {
+        kLogger.info() << "Watching library directories for changes";
+        m_pLibraryWatcher = new LibraryWatcher(this);
+        connect(&m_scanner, SIGNAL(scanStarted()),
+                m_pLibraryWatcher, SLOT(slotScanStarted()));
+        connect(&m_scanner, SIGNAL(scanFinished()),
+                m_pLibraryWatcher, SLOT(slotScanFinished()));
+        connect(&m_scanner, SIGNAL(libraryDirectoriesScanned(QStringList)),
+                m_pLibraryWatcher, SLOT(slotSetDirectories(QStringList)));
+        connect(m_pLibraryWatcher, SIGNAL(scanRequested()),
+                &m_scanner, SLOT(scan()));
+        m_pLibraryWatcher->slotSetDirectories(
+                m_pTrackCollection->getLibraryHashDAO().getDirectoryHashes().keys());
+    }
+
     // TODO(rryan) -- turn this construction / adding of features into a static
     // method or something -- CreateDefaultLibrary
     m_pMixxxLibraryFeature = new MixxxLibraryFeature(this, m_pTrackCollection,m_pConfig);
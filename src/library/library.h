@@ -33,6 +33,7 @@ class MixxxLibraryFeature;
 class PlaylistFeature;
 class CrateFeature;
 class LibraryControl;
+class LibraryWatcher;
 class KeyboardEventFilter;
 class PlayerManagerInterface;
 
@@ -145,6 +146,7 @@ class Library: public QObject,
     CrateFeature* m_pCrateFeature;
     AnalysisFeature* m_pAnalysisFeature;
     LibraryScanner m_scanner;
+    LibraryWatcher* m_pLibraryWatcher;
     QFont m_trackTableFont;
     int m_iTrackTableRowHeight;
     bool m_editMetadataSelectedClick;
@@ -134,13 +134,12 @@ void PlaylistFeature::buildPlaylistList() {
         "  Playlists.id AS id, "
         "  Playlists.name AS name, "
         "  LOWER(Playlists.name) AS sort_name, "
-        "  COUNT(case library.mixxx_deleted when 0 then 1 else null end) AS count, "
-        "  SUM(case library.mixxx_deleted when 0 then library.duration else 0 end) AS durationSeconds "
+        "  IFNULL(playlist_summaries.track_count, 0) AS count, "
+        "  IFNULL(playlist_summaries.track_duration, 0) AS durationSeconds "
         "FROM Playlists "
-        "LEFT JOIN PlaylistTracks ON PlaylistTracks.playlist_id = Playlists.id "
-        "LEFT JOIN library ON PlaylistTracks.track_id = library.id "
-        "WHERE Playlists.hidden = 0 "
-        "GROUP BY Playlists.id");
+        // Maintained incrementally by database triggers
+        "LEFT JOIN playlist_summaries ON playlist_summaries.playlist_id = Playlists.id "
+        "WHERE Playlists.hidden = 0");
     queryString.append(mixxx::DbConnection::collateLexicographically(
             " ORDER BY sort_name"));
     QSqlQuery query(m_pTrackCollection->database());
@@ -0,0 +1,40 @@
+#if defined (__WINDOWS__)
+#include <QDateTime>
+#include <QFileInfo>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif
+
+#include <QFile>
+
+#include "library/scanner/directorystat.h"
+
+//static
+DirectoryStat DirectoryStat::fromPath(const QString& path) {
+#if defined (__WINDOWS__)
+    const QFileInfo fileInfo(path);
+    if (!fileInfo.isDir()) {
+        return DirectoryStat();
+    }
+    return DirectoryStat(fileInfo.lastModified().toMSecsSinceEpoch(), 0);
+#else
+    // A single stat() provides both the modification time and the inode
+    // and follows symbolic links like QFileInfo does.
+    struct stat statBuf;
+    if (stat(QFile::encodeName(path).constData(), &statBuf) != 0 ||
+            !S_ISDIR(statBuf.st_mode)) {
+        return DirectoryStat();
+    }
+#if defined (__APPLE__)
+    const qint64 modifiedMillis =
+            static_cast<qint64>(statBuf.st_mtimespec.tv_sec) * 1000 +
+            statBuf.st_mtimespec.tv_nsec / 1000000;
+#else
+    const qint64 modifiedMillis =
+            static_cast<qint64>(statBuf.st_mtim.tv_sec) * 1000 +
+            statBuf.st_mtim.tv_nsec / 1000000;
+#endif
+    return DirectoryStat(modifiedMillis, static_cast<qint64>(statBuf.st_ino));
+#endif
+}
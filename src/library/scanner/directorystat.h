@@ -0,0 +1,55 @@
+#ifndef DIRECTORYSTAT_H
+#define DIRECTORYSTAT_H
+
+#include <QString>
+#include <QtGlobal>
+
+// File system metadata of a directory that is recorded by the library
+// scanner. Adding, removing or renaming an entry of a directory updates
+// its modification time, and replacing a directory (e.g. by a sync tool)
+// changes its inode. If neither has changed since the last scan the
+// directory listing does not need to be read again.
+class DirectoryStat {
+  public:
+    DirectoryStat()
+            : m_modifiedMillis(0),
+              m_inode(0) {
+    }
+    DirectoryStat(qint64 modifiedMillis, qint64 inode)
+            : m_modifiedMillis(modifiedMillis),
+              m_inode(inode) {
+    }
+
+    // Reads the metadata of the directory at path. Returns an invalid
+    // DirectoryStat if the directory is not accessible.
+    static DirectoryStat fromPath(const QString& path);
+
+    // The modification time is 0 if it has never been recorded.
+    bool isValid() const {
+        return m_modifiedMillis != 0;
+    }
+
+    qint64 modifiedMillis() const {
+        return m_modifiedMillis;
+    }
+
+    // Always 0 on platforms without inodes.
+    qint64 inode() const {
+        return m_inode;
+    }
+
+  private:
+    qint64 m_modifiedMillis;
+    qint64 m_inode;
+};
+
+inline bool operator==(const DirectoryStat& lhs, const DirectoryStat& rhs) {
+    return lhs.modifiedMillis() == rhs.modifiedMillis() &&
+            lhs.inode() == rhs.inode();
+}
+
+inline bool operator!=(const DirectoryStat& lhs, const DirectoryStat& rhs) {
+    return !(lhs == rhs);
+}
+
+#endif /* DIRECTORYSTAT_H */
@@ -1,9 +1,19 @@
 #include "library/scanner/importfilestask.h"
 
 #include "library/scanner/libraryscanner.h"
+#include "sources/soundsourceproxy.h"
 #include "track/trackref.h"
+#include "util/performancetimer.h"
 #include "util/timer.h"
 
+namespace {
+
+// Parsed tracks are passed to the library scanner thread in batches
+// to reduce the number of queued signals.
+const int kParsedTracksBatchSize = 100;
+
+} // anonymous namespace
+
 ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
                                  const ScannerGlobalPointer scannerGlobal,
                                  const QString& dirPath,
@@ -23,6 +33,7 @@ ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
 
 void ImportFilesTask::run() {
     ScopedTimer timer("ImportFilesTask::run");
+    QList<TrackPointer> parsedTracks;
     for (const QFileInfo& fileInfo: m_filesToImport) {
         // If a flag was raised telling us to cancel the library scan then stop.
         if (m_scannerGlobal->shouldCancel()) {
@@ -50,10 +61,47 @@ void ImportFilesTask::run() {
             }
             qDebug() << "Importing track" << trackLocation;
 
-            emit(addNewTrack(trackLocation));
+            // Wait until the library scanner thread has caught up with
+            // inserting the tracks that have already been parsed. The
+            // slots of the pending batch are only released after it has
+            // been inserted, so it must be passed on before blocking.
+            // Otherwise all workers might wait for each other.
+            if (!m_scannerGlobal->tryAcquireParsedTrackSlot()) {
+                if (!parsedTracks.isEmpty()) {
+                    emit(addNewTracks(parsedTracks));
+                    parsedTracks.clear();
+                }
+                if (!m_scannerGlobal->acquireParsedTrackSlot()) {
+                    setSuccess(false);
+                    return;
+                }
+            }
+            parsedTracks.append(parseTrack(fileInfo));
+            if (parsedTracks.size() >= kParsedTracksBatchSize) {
+                emit(addNewTracks(parsedTracks));
+                parsedTracks.clear();
+            }
         }
     }
+    if (!parsedTracks.isEmpty()) {
+        emit(addNewTracks(parsedTracks));
+    }
     // Insert or update the hash in the database.
     emit(directoryHashedAndScanned(m_dirPath, !m_prevHashExists, m_newHash));
     setSuccess(true);
 }
+
+TrackPointer ImportFilesTask::parseTrack(const QFileInfo& fileInfo) {
+    PerformanceTimer timer;
+    timer.start();
+    // Parse the metadata into a temporary track object that is not
+    // managed by the GlobalTrackCache. Unlike SoundSourceProxy::
+    // importTemporaryTrack() the cache is not locked while parsing,
+    // otherwise all worker threads would be serialized. The file is not
+    // yet part of the library and so there is no track object whose
+    // metadata could be exported into this file at the same time.
+    TrackPointer pTrack = Track::newTemporary(fileInfo, m_pToken);
+    SoundSourceProxy(pTrack).updateTrackFromSource();
+    m_scannerGlobal->trackParsed(timer.elapsed());
+    return pTrack;
+}
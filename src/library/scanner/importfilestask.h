@@ -8,8 +8,11 @@
 #include "library/scanner/scannertask.h"
 #include "library/scanner/scannerglobal.h"
 
-// Import the provided files. Successful if the scan completed without being
-// cancelled. False if the scan was cancelled part-way through.
+// Import the provided files. The metadata of new files is parsed in the
+// worker thread and the resulting temporary track objects are passed in
+// batches to the library scanner thread for inserting them into the
+// database. Successful if the scan completed without being cancelled.
+// False if the scan was cancelled part-way through.
 class ImportFilesTask : public ScannerTask {
     Q_OBJECT
   public:
@@ -26,6 +29,8 @@ class ImportFilesTask : public ScannerTask {
     virtual void run();
 
   private:
+    TrackPointer parseTrack(const QFileInfo& fileInfo);
+
     const QString m_dirPath;
     const bool m_prevHashExists;
     const int m_newHash;
@@ -8,6 +8,8 @@
 #include "library/coverartutils.h"
 #include "library/trackcollection.h"
 #include "util/logger.h"
+#include "util/math.h"
+#include "util/performancetimer.h"
 #include "util/trace.h"
 #include "util/file.h"
 #include "util/timer.h"
@@ -17,8 +19,19 @@
 
 namespace {
 
-// TODO(rryan) make configurable
-const int kScannerThreadPoolSize = 1;
+// Directories are scanned in parallel. The scanner tasks are mostly waiting
+// for the file system, so more threads than cores don't help and only cause
+// excessive seeking on rotating disks.
+const int kMaxDefaultScannerThreadPoolSize = 4;
+
+const ConfigKey kConfigKeyScannerThreadPoolSize(
+        "[Library]", "ScannerThreadPoolSize");
+
+// Some file systems (e.g. FAT) don't update the modification time of a
+// directory when its entries change. Allow to fall back to reading the
+// listings of all directories.
+const ConfigKey kConfigKeySkipUnchangedDirectoryListings(
+        "[Library]", "SkipUnchangedDirectoryListings");
 
 mixxx::Logger kLogger("LibraryScanner");
 
@@ -30,7 +43,8 @@ LibraryScanner::LibraryScanner(
         mixxx::DbConnectionPoolPtr pDbConnectionPool,
         TrackCollection* pTrackCollection,
         const UserSettingsPointer& pConfig)
-        : m_pDbConnectionPool(std::move(pDbConnectionPool)),
+        : m_pConfig(pConfig),
+          m_pDbConnectionPool(std::move(pDbConnectionPool)),
           m_pTrackCollection(pTrackCollection),
           m_analysisDao(pConfig),
           m_trackDao(m_cueDao, m_playlistDao,
@@ -47,7 +61,14 @@ LibraryScanner::LibraryScanner(
     const int instanceId = s_instanceCounter.fetchAndAddAcquire(1) + 1;
     setObjectName(QString("LibraryScanner %1").arg(instanceId));
 
-    m_pool.setMaxThreadCount(kScannerThreadPoolSize);
+    const int threadPoolSize = m_pConfig->getValue(
+            kConfigKeyScannerThreadPoolSize,
+            math_clamp(QThread::idealThreadCount(),
+                    1, kMaxDefaultScannerThreadPoolSize));
+    kLogger.debug() << "Using" << threadPoolSize << "worker threads";
+    m_pool.setMaxThreadCount(math_max(1, threadPoolSize));
+
+    qRegisterMetaType<QList<TrackPointer>>("QList<TrackPointer>");
 
     // Listen to signals from our public methods (invoked by other threads) and
     // connect them to our slots to run the command on the scanner thread.
@@ -134,6 +155,8 @@ void LibraryScanner::slotStartScan() {
 
     QSet<QString> trackLocations = m_trackDao.getTrackLocations();
     QHash<QString, int> directoryHashes = m_libraryHashDao.getDirectoryHashes();
+    QHash<QString, DirectoryStat> directoryStats =
+            m_libraryHashDao.getDirectoryStats();
     QRegExp extensionFilter(SoundSourceProxy::getSupportedFileNamesRegex());
     QRegExp coverExtensionFilter =
             QRegExp(CoverArtUtils::supportedCoverArtExtensionsRegex(),
@@ -141,8 +164,12 @@ void LibraryScanner::slotStartScan() {
     QStringList directoryBlacklist = ScannerUtil::getDirectoryBlacklist();
 
     m_scannerGlobal = ScannerGlobalPointer(
-            new ScannerGlobal(trackLocations, directoryHashes, extensionFilter,
-                              coverExtensionFilter, directoryBlacklist));
+            new ScannerGlobal(trackLocations, directoryHashes, directoryStats,
+                              extensionFilter, coverExtensionFilter,
+                              directoryBlacklist,
+                              m_pConfig->getValue(
+                                      kConfigKeySkipUnchangedDirectoryListings,
+                                      true)));
 
     m_scannerGlobal->startTimer();
 
@@ -291,8 +318,18 @@ void LibraryScanner::cleanUpScan() {
     // A.
     m_libraryHashDao.removeDeletedDirectoryHashes();
 
+    // Store the metadata of all directories that have been listed. This is
+    // only done after the scan finished cleanly, otherwise the next scan
+    // could skip a directory whose tracks have not been imported yet.
+    kLogger.debug() << "Storing directory metadata";
+    m_libraryHashDao.updateDirectoryStats(
+            m_scannerGlobal->directoryStatsScanned());
+
     transaction.commit();
 
+    emit(libraryDirectoriesScanned(
+            m_libraryHashDao.getDirectoryHashes().keys()));
+
     kLogger.debug() << "Detecting cover art for unscanned files";
     QSet<TrackId> coverArtTracksChanged;
     m_trackDao.detectCoverArtForTracksWithoutCover(
@@ -337,15 +374,33 @@ void LibraryScanner::slotFinishUnhashedScan() {
 
     // TODO(XXX) doesn't take into account verifyRemainingTracks.
     qDebug("Scan took: %s. "
-           "%d unchanged directories. "
+           "%d unchanged directories (%d not listed). "
            "%d changed/added directories. "
            "%d tracks verified from changed/added directories. "
            "%d new tracks.",
            m_scannerGlobal->timerElapsed().formatNanosWithUnit().toLocal8Bit().constData(),
            m_scannerGlobal->verifiedDirectories().size(),
+           m_scannerGlobal->numSkippedDirectoryListings(),
            m_scannerGlobal->numScannedDirectories(),
            m_scannerGlobal->verifiedTracks().size(),
            m_scannerGlobal->addedTracks().size());
+    const int numParsedTracks = m_scannerGlobal->numParsedTracks();
+    if (numParsedTracks > 0) {
+        // Accumulated times of the import pipeline stages. Parsing is
+        // done in parallel by the worker threads, inserting is done
+        // sequentially by the library scanner thread.
+        const int numInsertedTracks = m_scannerGlobal->numInsertedTracks();
+        kLogger.info()
+                << "Parsed" << numParsedTracks << "tracks in"
+                << m_scannerGlobal->parseDuration().formatMillisWithUnit()
+                << "(" << m_scannerGlobal->parseDuration().toIntegerMicros() /
+                        numParsedTracks << "us per track )"
+                << "on" << m_pool.maxThreadCount() << "threads,"
+                << "inserted" << numInsertedTracks << "tracks in"
+                << m_scannerGlobal->insertDuration().formatMillisWithUnit()
+                << "(" << m_scannerGlobal->insertDuration().toIntegerMicros() /
+                        math_max(1, numInsertedTracks) << "us per track )";
+    }
 
     m_scannerGlobal.clear();
     changeScannerState(FINISHED);
@@ -415,8 +470,8 @@ void LibraryScanner::queueTask(ScannerTask* pTask) {
             this, SLOT(slotDirectoryUnchanged(QString)));
     connect(pTask, SIGNAL(trackExists(QString)),
             this, SLOT(slotTrackExists(QString)));
-    connect(pTask, SIGNAL(addNewTrack(QString)),
-            this, SLOT(slotAddNewTrack(QString)));
+    connect(pTask, SIGNAL(addNewTracks(QList<TrackPointer>)),
+            this, SLOT(slotAddNewTracks(QList<TrackPointer>)));
 
     // Progress signals.
     // Pass directly to the main thread
@@ -465,34 +520,42 @@ void LibraryScanner::slotTrackExists(const QString& trackPath) {
     }
 }
 
-void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
-    //kLogger.debug() << "slotAddNewTrack" << trackPath;
-    ScopedTimer timer("LibraryScanner::addNewTrack");
-    // For statistics tracking and to detect moved tracks
-    TrackPointer pTrack(m_trackDao.addTracksAddFile(trackPath, false));
-    if (pTrack) {
-        // The track's actual location might differ from the
-        // given trackPath
-        const QString trackLocation(pTrack->getLocation());
-        // Acknowledge successful track addition
-        if (m_scannerGlobal) {
+void LibraryScanner::slotAddNewTracks(QList<TrackPointer> parsedTracks) {
+    //kLogger.debug() << "slotAddNewTracks" << parsedTracks.size();
+    ScopedTimer timer("LibraryScanner::addNewTracks");
+    if (!m_scannerGlobal) {
+        // The scan has already been finished or cancelled
+        return;
+    }
+    PerformanceTimer insertTimer;
+    insertTimer.start();
+    for (const auto& pParsedTrack: parsedTracks) {
+        const QString trackPath(pParsedTrack->getLocation());
+        // For statistics tracking and to detect moved tracks
+        TrackPointer pTrack(m_trackDao.addTracksAddParsedFile(pParsedTrack, false));
+        if (pTrack) {
+            // The track's actual location might differ from the
+            // given trackPath
+            const QString trackLocation(pTrack->getLocation());
+            // Acknowledge successful track addition
             m_scannerGlobal->trackAdded(trackLocation);
-        }
-        // Signal the main instance of TrackDAO, that there is
-        // a new track in the database.
-        emit(trackAdded(pTrack));
-        emit(progressLoading(trackLocation));
-    } else {
-        // Acknowledge failed track addition
-        // TODO(XXX): Is it really intended to acknowledge a failed
-        // track addition with a trackAdded() signal??
-        if (m_scannerGlobal) {
+            // Signal the main instance of TrackDAO, that there is
+            // a new track in the database.
+            emit(trackAdded(pTrack));
+            emit(progressLoading(trackLocation));
+        } else {
+            // Acknowledge failed track addition
+            // TODO(XXX): Is it really intended to acknowledge a failed
+            // track addition with a trackAdded() signal??
             m_scannerGlobal->trackAdded(trackPath);
+            kLogger.warning()
+                    << "Failed to add track to library:"
+                    << trackPath;
         }
-        kLogger.warning()
-                << "Failed to add track to library:"
-                << trackPath;
     }
+    m_scannerGlobal->tracksInserted(parsedTracks.size(), insertTimer.elapsed());
+    // Allow the worker tasks to parse more tracks
+    m_scannerGlobal->releaseParsedTrackSlots(parsedTracks.size());
 }
 
 bool LibraryScanner::changeScannerState(ScannerState newState) {
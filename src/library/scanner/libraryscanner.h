@@ -51,6 +51,9 @@ class LibraryScanner : public QThread {
     void trackAdded(TrackPointer pTrack);
     void tracksMoved(QSet<TrackId> oldTrackIds, QSet<TrackId> newTrackIds);
     void tracksChanged(QSet<TrackId> changedTrackIds);
+    // Emitted after a scan finished cleanly with the paths of all
+    // directories that are part of the library.
+    void libraryDirectoriesScanned(QStringList directoryPaths);
 
     // Emitted by scan() to invoke slotStartScan in the scanner thread's event
     // loop.
@@ -72,7 +75,7 @@ class LibraryScanner : public QThread {
                                    bool newDirectory, int hash);
     void slotDirectoryUnchanged(const QString& directoryPath);
     void slotTrackExists(const QString& trackPath);
-    void slotAddNewTrack(const QString& trackPath);
+    void slotAddNewTracks(QList<TrackPointer> parsedTracks);
 
   private:
     enum ScannerState {
@@ -98,6 +101,8 @@ class LibraryScanner : public QThread {
 
     void cleanUpScan();
 
+    const UserSettingsPointer m_pConfig;
+
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
 
     // The library trackcollection. Do not touch this from the library scanner
@@ -0,0 +1,90 @@
+#include "library/scanner/librarywatcher.h"
+
+#include "util/logger.h"
+
+namespace {
+
+mixxx::Logger kLogger("LibraryWatcher");
+
+// Copying an album into the library produces many change notifications
+// within a short time. Wait until the file system has settled down.
+const int kRescanDelayMillis = 3000;
+
+} // anonymous namespace
+
+LibraryWatcher::LibraryWatcher(QObject* pParent)
+        : QObject(pParent),
+          m_scanning(false),
+          m_changedWhileScanning(false) {
+    m_rescanTimer.setSingleShot(true);
+    m_rescanTimer.setInterval(kRescanDelayMillis);
+    connect(&m_rescanTimer, SIGNAL(timeout()),
+            this, SLOT(slotRequestScan()));
+    connect(&m_fileSystemWatcher, SIGNAL(directoryChanged(const QString&)),
+            this, SLOT(slotDirectoryChanged(const QString&)));
+}
+
+LibraryWatcher::~LibraryWatcher() {
+}
+
+void LibraryWatcher::setRescanDelay(int millis) {
+    m_rescanTimer.setInterval(millis);
+}
+
+void LibraryWatcher::slotSetDirectories(QStringList directoryPaths) {
+    const QSet<QString> directories = directoryPaths.toSet();
+
+    QStringList removedDirectories = (m_directories - directories).toList();
+    if (!removedDirectories.isEmpty()) {
+        m_fileSystemWatcher.removePaths(removedDirectories);
+    }
+
+    QStringList addedDirectories = (directories - m_directories).toList();
+    if (!addedDirectories.isEmpty()) {
+        const QStringList failedDirectories =
+                m_fileSystemWatcher.addPaths(addedDirectories);
+        if (!failedDirectories.isEmpty()) {
+            // On Linux this usually means that the inotify watch limit
+            // (fs.inotify.max_user_watches) has been reached.
+            kLogger.warning()
+                    << "Failed to watch" << failedDirectories.size()
+                    << "of" << addedDirectories.size()
+                    << "library directories";
+        }
+    }
+
+    m_directories = directories;
+    kLogger.debug() << "Watching" << m_directories.size() << "directories";
+}
+
+void LibraryWatcher::slotScanStarted() {
+    m_scanning = true;
+    m_changedWhileScanning = false;
+    m_rescanTimer.stop();
+}
+
+void LibraryWatcher::slotScanFinished() {
+    m_scanning = false;
+    if (m_changedWhileScanning) {
+        // The running scan might have missed these changes
+        m_changedWhileScanning = false;
+        m_rescanTimer.start();
+    }
+}
+
+void LibraryWatcher::slotDirectoryChanged(const QString& directoryPath) {
+    if (kLogger.debugEnabled()) {
+        kLogger.debug() << "Directory changed" << directoryPath;
+    }
+    if (m_scanning) {
+        m_changedWhileScanning = true;
+    } else {
+        // (Re-)start the timer to wait for more changes
+        m_rescanTimer.start();
+    }
+}
+
+void LibraryWatcher::slotRequestScan() {
+    kLogger.info() << "Library directories changed, requesting rescan";
+    emit(scanRequested());
+}
@@ -0,0 +1,49 @@
+#ifndef LIBRARYWATCHER_H
+#define LIBRARYWATCHER_H
+
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+
+// Watches all library directories for added, removed and renamed entries
+// and requests a rescan shortly after the last change. QFileSystemWatcher
+// is backed by inotify on Linux and by the native notification APIs on the
+// other platforms. Together with skipping the listings of unchanged
+// directories such a rescan only needs to read the changed directories.
+class LibraryWatcher : public QObject {
+    Q_OBJECT
+  public:
+    explicit LibraryWatcher(QObject* pParent = nullptr);
+    ~LibraryWatcher() override;
+
+    // The time to wait after the last change before requesting a rescan.
+    void setRescanDelay(int millis);
+
+  public slots:
+    // Replaces the set of watched directories.
+    void slotSetDirectories(QStringList directoryPaths);
+
+    void slotScanStarted();
+    void slotScanFinished();
+
+  signals:
+    void scanRequested();
+
+  private slots:
+    void slotDirectoryChanged(const QString& directoryPath);
+    void slotRequestScan();
+
+  private:
+    QFileSystemWatcher m_fileSystemWatcher;
+    QSet<QString> m_directories;
+
+    // Collects a burst of changes into a single rescan
+    QTimer m_rescanTimer;
+
+    bool m_scanning;
+    bool m_changedWhileScanning;
+};
+
+#endif /* LIBRARYWATCHER_H */
@@ -26,6 +26,38 @@ void RecursiveScanDirectoryTask::run() {
     //qDebug() << "Burn CPU";
     //for (int i = 0;i < 1000000000; i++) asm("nop");
 
+    QString dirPath = m_dir.path();
+
+    // Try to retrieve a hash from the last time that directory was scanned.
+    int prevHash = m_scannerGlobal->directoryHashInDatabase(dirPath);
+    bool prevHashExists = prevHash != -1;
+
+    // Read the directory metadata before the listing so that any change
+    // that happens while we are scanning is detected by the next scan.
+    const DirectoryStat dirStat = DirectoryStat::fromPath(dirPath);
+    if (prevHashExists && m_scannerGlobal->skipUnchangedDirectoryListings() &&
+            dirStat.isValid() &&
+            dirStat == m_scannerGlobal->directoryStatInDatabase(dirPath)) {
+        // No entries have been added, removed or renamed since the last
+        // scan. Skip the listing and descend into the known sub-directories.
+        m_scannerGlobal->directoryListingSkipped();
+        emit(directoryUnchanged(dirPath));
+        foreach (const QString& childPath,
+                m_scannerGlobal->childDirectoriesInDatabase(dirPath)) {
+            if (m_scannerGlobal->directoryBlacklisted(childPath)) {
+                continue;
+            }
+            const QDir childDir(childPath);
+            if (!m_scannerGlobal->testAndMarkDirectoryScanned(childDir)) {
+                m_pScanner->queueTask(
+                        new RecursiveScanDirectoryTask(m_pScanner, m_scannerGlobal,
+                                                       childDir, m_pToken, m_scanUnhashed));
+            }
+        }
+        setSuccess(true);
+        return;
+    }
+
     // Note, we save on filesystem operations (and random work) by initializing
     // a QDirIterator with a QDir instead of a QString -- but it inherits its
     // Filter from the QDir so we have to set it first. If the QDir has not done
@@ -75,13 +107,10 @@ void RecursiveScanDirectoryTask::run() {
     // Calculate a hash of the directory's file list.
     int newHash = qHash(newHashStr.join(""));
 
-    QString dirPath = m_dir.path();
-
-    // Try to retrieve a hash from the last time that directory was scanned.
-    int prevHash = m_scannerGlobal->directoryHashInDatabase(dirPath);
-    bool prevHashExists = prevHash != -1;
-
     if (prevHashExists || m_scanUnhashed) {
+        if (dirStat.isValid()) {
+            m_scannerGlobal->directoryStatScanned(dirPath, dirStat);
+        }
         // Compare the hashes, and if they don't match, rescan the files in that
         // directory!
         if (prevHash != newHash) {
@@ -9,8 +9,10 @@
 // Recursively scan a music library. Doesn't import tracks for any directories
 // that have already been scanned and have not changed. Changes are tracked by
 // performing a hash of the directory's file list, and those hashes are stored
-// in the database. Successful if the scan completed without being
-// cancelled. False if the scan was cancelled part-way through.
+// in the database. The listing of a directory is not even read if its
+// modification time and inode are unchanged since the last scan. Successful
+// if the scan completed without being cancelled. False if the scan was
+// cancelled part-way through.
 class RecursiveScanDirectoryTask : public ScannerTask {
     Q_OBJECT
   public:
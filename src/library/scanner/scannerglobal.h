@@ -8,7 +8,11 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QSharedPointer>
+#include <QSemaphore>
+#include <QAtomicInt>
 
+#include "library/scanner/directorystat.h"
+#include "util/compatibility.h"
 #include "util/task.h"
 #include "util/performancetimer.h"
 
@@ -38,18 +42,38 @@ class ScannerGlobal {
   public:
     ScannerGlobal(const QSet<QString>& trackLocations,
                   const QHash<QString, int>& directoryHashes,
+                  const QHash<QString, DirectoryStat>& directoryStats,
                   const QRegExp& supportedExtensionsMatcher,
                   const QRegExp& supportedCoverExtensionsMatcher,
-                  const QStringList& directoriesBlacklist)
+                  const QStringList& directoriesBlacklist,
+                  bool skipUnchangedDirectoryListings)
             : m_trackLocations(trackLocations),
               m_directoryHashes(directoryHashes),
+              m_directoryStats(directoryStats),
               m_supportedExtensionsMatcher(supportedExtensionsMatcher),
               m_supportedCoverExtensionsMatcher(supportedCoverExtensionsMatcher),
               m_directoriesBlacklist(directoriesBlacklist),
+              m_skipUnchangedDirectoryListings(skipUnchangedDirectoryListings),
               // Unless marked un-clean, we assume it will finish cleanly.
               m_scanFinishedCleanly(true),
               m_shouldCancel(false),
-              m_numScannedDirectories(0) {
+              m_numScannedDirectories(0),
+              m_numSkippedDirectoryListings(0),
+              m_parsedTracksQueue(kParsedTracksQueueCapacity),
+              m_numParsedTracks(0),
+              m_numInsertedTracks(0) {
+        // Index the hashed directories by their parent directory. This
+        // allows to descend into the sub-directories of an unchanged
+        // directory without reading its listing.
+        for (auto it = m_directoryHashes.constBegin();
+                it != m_directoryHashes.constEnd(); ++it) {
+            const QString& directoryPath = it.key();
+            const int separatorIndex = directoryPath.lastIndexOf('/');
+            if (separatorIndex > 0) {
+                m_childDirectories[directoryPath.left(separatorIndex)]
+                        .append(directoryPath);
+            }
+        }
     }
 
     TaskWatcher& getTaskWatcher() {
@@ -66,6 +90,39 @@ class ScannerGlobal {
         return m_directoryHashes.value(directoryPath, -1);
     }
 
+    // Returns the directory metadata recorded by the last scan or an invalid
+    // DirectoryStat if the directory has not been scanned before.
+    inline DirectoryStat directoryStatInDatabase(const QString& directoryPath) const {
+        return m_directoryStats.value(directoryPath);
+    }
+
+    // Whether the recorded directory metadata can be trusted to detect
+    // changes. Disabled for file systems that do not update the modification
+    // time of directories.
+    inline bool skipUnchangedDirectoryListings() const {
+        return m_skipUnchangedDirectoryListings;
+    }
+
+    // Returns the paths of all hashed direct sub-directories.
+    inline QStringList childDirectoriesInDatabase(const QString& directoryPath) const {
+        return m_childDirectories.value(directoryPath);
+    }
+
+    // Records the metadata of a directory whose listing has been read
+    // during this scan. Stored in the database after the scan finished
+    // cleanly.
+    inline void directoryStatScanned(const QString& directoryPath,
+                                     const DirectoryStat& dirStat) {
+        QMutexLocker locker(&m_directoryStatsScannedMutex);
+        m_directoryStatsScanned.insert(directoryPath, dirStat);
+    }
+
+    inline const QHash<QString, DirectoryStat>& directoryStatsScanned() const {
+        // no need for locking here, because it is only used
+        // after all tasks have finished.
+        return m_directoryStatsScanned;
+    }
+
     inline bool directoryBlacklisted(const QString& directoryPath) const {
         return m_directoriesBlacklist.contains(directoryPath);
     }
@@ -172,12 +229,80 @@ class ScannerGlobal {
         m_numScannedDirectories++;
     }
 
+    int numSkippedDirectoryListings() const {
+        return load_atomic(m_numSkippedDirectoryListings);
+    }
+    void directoryListingSkipped() {
+        m_numSkippedDirectoryListings.fetchAndAddRelaxed(1);
+    }
+
+    // The metadata of new tracks is parsed by the worker tasks in parallel
+    // and then passed to the library scanner thread that inserts them into
+    // the database. Before parsing a track a worker needs to acquire a slot
+    // in the queue of parsed tracks, which is released after the track has
+    // been inserted. Returns false if the scan has been cancelled while
+    // waiting for a free slot.
+    bool acquireParsedTrackSlot() {
+        while (!m_parsedTracksQueue.tryAcquire(1, kParsedTracksQueueTimeoutMillis)) {
+            if (shouldCancel()) {
+                return false;
+            }
+        }
+        return true;
+    }
+    // Returns false immediately if the queue is full
+    bool tryAcquireParsedTrackSlot() {
+        return m_parsedTracksQueue.tryAcquire(1);
+    }
+    void releaseParsedTrackSlots(int count) {
+        m_parsedTracksQueue.release(count);
+    }
+
+    // Per-stage throughput counters of the import pipeline
+    void trackParsed(mixxx::Duration duration) {
+        QMutexLocker locker(&m_importStatsMutex);
+        ++m_numParsedTracks;
+        m_parseDuration += duration;
+    }
+    void tracksInserted(int count, mixxx::Duration duration) {
+        QMutexLocker locker(&m_importStatsMutex);
+        m_numInsertedTracks += count;
+        m_insertDuration += duration;
+    }
+    int numParsedTracks() const {
+        QMutexLocker locker(&m_importStatsMutex);
+        return m_numParsedTracks;
+    }
+    // Accumulated over all worker threads
+    mixxx::Duration parseDuration() const {
+        QMutexLocker locker(&m_importStatsMutex);
+        return m_parseDuration;
+    }
+    int numInsertedTracks() const {
+        QMutexLocker locker(&m_importStatsMutex);
+        return m_numInsertedTracks;
+    }
+    mixxx::Duration insertDuration() const {
+        QMutexLocker locker(&m_importStatsMutex);
+        return m_insertDuration;
+    }
+
 
   private:
+    // Upper bound for the number of parsed tracks that are waiting to
+    // be inserted into the database.
+    static const int kParsedTracksQueueCapacity = 512;
+    static const int kParsedTracksQueueTimeoutMillis = 100;
+
     TaskWatcher m_watcher;
 
     QSet<QString> m_trackLocations;
     QHash<QString, int> m_directoryHashes;
+    QHash<QString, DirectoryStat> m_directoryStats;
+    QHash<QString, QStringList> m_childDirectories;
+
+    mutable QMutex m_directoryStatsScannedMutex;
+    QHash<QString, DirectoryStat> m_directoryStatsScanned;
 
     mutable QMutex m_supportedExtensionsMatcherMutex;
     QRegExp m_supportedExtensionsMatcher;
@@ -202,6 +327,8 @@ class ScannerGlobal {
     // this has never been investigated.
     QStringList m_directoriesBlacklist;
 
+    const bool m_skipUnchangedDirectoryListings;
+
     // The list of directories verified by the scan.
     QStringList m_verifiedDirectories;
 
@@ -217,6 +344,16 @@ class ScannerGlobal {
     // Stats tracking.
     PerformanceTimer m_timer;
     int m_numScannedDirectories;
+    // Updated concurrently by the scanner tasks
+    QAtomicInt m_numSkippedDirectoryListings;
+
+    QSemaphore m_parsedTracksQueue;
+
+    mutable QMutex m_importStatsMutex;
+    int m_numParsedTracks;
+    mixxx::Duration m_parseDuration;
+    int m_numInsertedTracks;
+    mixxx::Duration m_insertDuration;
 };
 
 typedef QSharedPointer<ScannerGlobal> ScannerGlobalPointer;
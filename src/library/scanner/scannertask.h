@@ -25,7 +25,8 @@ class ScannerTask : public QObject, public QRunnable {
                                    bool newDirectory, int hash);
     void directoryUnchanged(const QString& directoryPath);
     void trackExists(const QString& filePath);
-    void addNewTrack(const QString& filePath);
+    // Temporary track objects with the metadata parsed from new files
+    void addNewTracks(QList<TrackPointer> parsedTracks);
 
     // Feedback to GUI
     void progressLoading(const QString& fileName);
@@ -34,6 +34,7 @@ TrackCollection::~TrackCollection() {
 void TrackCollection::repairDatabase(QSqlDatabase database) {
     DEBUG_ASSERT(QApplication::instance()->thread() == QThread::currentThread());
 
+    m_playlistDao.repairDatabase(database);
     m_crates.repairDatabase(database);
 }
 
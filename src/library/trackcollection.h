@@ -56,6 +56,9 @@ class TrackCollection : public QObject,
     AnalysisDao& getAnalysisDAO() {
         return m_analysisDao;
     }
+    LibraryHashDAO& getLibraryHashDAO() {
+        return m_libraryHashDao;
+    }
 
     QSharedPointer<BaseTrackCache> getTrackSource() const {
         return m_pTrackSource;
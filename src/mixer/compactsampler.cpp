@@ -0,0 +1,220 @@
+#include "mixer/compactsampler.h"
+
+#include <QMessageBox>
+#include <QtConcurrentRun>
+
+#include "control/controlobject.h"
+#include "control/controlpushbutton.h"
+#include "engine/engine.h"
+#include "engine/enginecompactsampler.h"
+#include "engine/enginemaster.h"
+#include "mixer/playerinfo.h"
+#include "sources/audiosourcestereoproxy.h"
+#include "sources/soundsourceproxy.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/sample.h"
+#include "util/sandbox.h"
+
+namespace {
+
+mixxx::Logger kLogger("CompactSampler");
+
+const ConfigKey kMaxSampleSecondsKey("[Sampler]", "CompactMaxSeconds");
+const int kMaxSampleSecondsDefault = 30;
+
+const SINT kDecodeFramesPerBlock = 8192;
+
+CompactSampler::DecodeResult decodeSample(TrackPointer pTrack, int maxSeconds) {
+    CompactSampler::DecodeResult result;
+    result.pTrack = pTrack;
+
+    mixxx::AudioSource::OpenParams openParams;
+    openParams.setChannelCount(mixxx::kEngineChannelCount);
+    auto pAudioSource = SoundSourceProxy(pTrack).openAudioSource(openParams);
+    if (!pAudioSource) {
+        result.errorMessage = QObject::tr("The file could not be loaded.");
+        return result;
+    }
+    if (pAudioSource->frameLength() >
+            static_cast<SINT>(pAudioSource->sampleRate()) * maxSeconds) {
+        result.errorMessage = QObject::tr(
+                "The track is longer than %1 seconds. Compact samplers only "
+                "play short samples.").arg(maxSeconds);
+        return result;
+    }
+
+    mixxx::AudioSourceStereoProxy audioSourceProxy(
+            pAudioSource,
+            kDecodeFramesPerBlock);
+    std::unique_ptr<CompactSample> pSample = std::make_unique<CompactSample>(
+            pAudioSource->frameLength(),
+            pAudioSource->sampleRate());
+    // Frames that fail to decode remain silent
+    pSample->sampleBuffer.clear();
+    const SINT firstFrame = pAudioSource->frameIndexRange().start();
+    mixxx::IndexRange remainingFrames = pAudioSource->frameIndexRange();
+    while (!remainingFrames.empty()) {
+        const mixxx::IndexRange blockFrames =
+                remainingFrames.splitAndShrinkFront(
+                        math_min(kDecodeFramesPerBlock, remainingFrames.length()));
+        mixxx::SampleBuffer::WritableSlice writableSlice(
+                pSample->sampleBuffer,
+                (blockFrames.start() - firstFrame) * mixxx::kEngineChannelCount,
+                blockFrames.length() * mixxx::kEngineChannelCount);
+        const auto readFrames =
+                audioSourceProxy.readSampleFrames(
+                        mixxx::WritableSampleFrames(blockFrames, writableSlice));
+        if (readFrames.readableLength() > 0 &&
+                readFrames.readableData() != writableSlice.data()) {
+            SampleUtil::copy(writableSlice.data(), readFrames.readableData(),
+                    readFrames.readableLength());
+        }
+        if (readFrames.frameLength() < blockFrames.length()) {
+            kLogger.warning()
+                    << "Failed to decode all sample frames of"
+                    << pTrack->getLocation();
+            break;
+        }
+    }
+    result.pSample = pSample.release();
+    return result;
+}
+
+} // anonymous namespace
+
+CompactSampler::CompactSampler(QObject* pParent,
+                               UserSettingsPointer pConfig,
+                               EngineMaster* pMixingEngine,
+                               EffectsManager* pEffectsManager,
+                               EngineChannel::ChannelOrientation defaultOrientation,
+                               const QString& group)
+        : BaseTrackPlayer(pParent, group),
+          m_pConfig(pConfig),
+          m_playAfterLoading(false) {
+    ChannelHandleAndGroup channelGroup =
+            pMixingEngine->registerChannelGroup(group);
+    m_pChannel = new EngineCompactSampler(channelGroup, pEffectsManager,
+                                          defaultOrientation);
+    pMixingEngine->addChannel(m_pChannel);
+
+    // Same routing defaults as a regular sampler
+    m_pChannel->setMaster(true);
+    m_pChannel->setPfl(false);
+
+    m_pDuration = std::make_unique<ControlObject>(
+            ConfigKey(getGroup(), "duration"));
+    m_pEject = std::make_unique<ControlPushButton>(
+            ConfigKey(getGroup(), "eject"));
+    connect(m_pEject.get(), SIGNAL(valueChanged(double)),
+            this, SLOT(slotEject(double)));
+
+    connect(&m_decodeWatcher, SIGNAL(finished()),
+            this, SLOT(slotDecodeFinished()));
+}
+
+CompactSampler::~CompactSampler() {
+    m_decodeWatcher.waitForFinished();
+    if (m_decodeWatcher.future().resultCount() > 0) {
+        // The result has not been received by slotDecodeFinished()
+        delete m_decodeWatcher.result().pSample;
+    }
+    // The EngineCompactSampler is owned by EngineMaster
+}
+
+TrackPointer CompactSampler::getLoadedTrack() const {
+    return m_pLoadedTrack;
+}
+
+void CompactSampler::slotLoadTrack(TrackPointer pTrack, bool bPlay) {
+    // Before loading the track, ensure we have access. This uses lazy
+    // evaluation to make sure track isn't NULL before we dereference it.
+    if (pTrack && !Sandbox::askForAccess(pTrack->getCanonicalLocation())) {
+        // We don't have access.
+        return;
+    }
+
+    TrackPointer pOldTrack = m_pLoadedTrack;
+    unloadTrack();
+    emit(loadingTrack(pTrack, pOldTrack));
+    if (!pTrack) {
+        emit(playerEmpty());
+        return;
+    }
+
+    m_pLoadingTrack = pTrack;
+    m_playAfterLoading = bPlay;
+    if (m_decodeWatcher.isRunning()) {
+        // Picked up by slotDecodeFinished()
+        return;
+    }
+    startDecoding();
+}
+
+void CompactSampler::startDecoding() {
+    const int maxSeconds = m_pConfig->getValue(
+            kMaxSampleSecondsKey, kMaxSampleSecondsDefault);
+    m_decodeWatcher.setFuture(QtConcurrent::run(
+            &decodeSample,
+            m_pLoadingTrack,
+            maxSeconds));
+}
+
+void CompactSampler::slotDecodeFinished() {
+    DecodeResult result = m_decodeWatcher.result();
+    // Prevent a second deletion of the sample in the destructor
+    m_decodeWatcher.setFuture(QFuture<DecodeResult>());
+
+    if (result.pTrack != m_pLoadingTrack) {
+        // Outdated, another track has been requested in the meantime
+        delete result.pSample;
+        if (m_pLoadingTrack) {
+            startDecoding();
+        }
+        return;
+    }
+    m_pLoadingTrack.reset();
+
+    if (!result.pSample) {
+        kLogger.warning()
+                << "Failed to load track"
+                << result.pTrack->getLocation()
+                << result.errorMessage;
+        emit(playerEmpty());
+        QMessageBox::warning(NULL, tr("Couldn't load track."),
+                result.errorMessage);
+        return;
+    }
+
+    if (!m_pChannel->setSample(result.pSample, m_playAfterLoading)) {
+        kLogger.warning()
+                << "Engine is not picking up samples, discarding"
+                << result.pTrack->getLocation();
+        emit(playerEmpty());
+        return;
+    }
+    m_pLoadedTrack = result.pTrack;
+    m_pDuration->set(m_pLoadedTrack->getDuration());
+    emit(newTrackLoaded(m_pLoadedTrack));
+
+    // Update the PlayerInfo class that is used in EngineBroadcast to replace
+    // the metadata of a stream
+    PlayerInfo::instance().setTrackInfo(getGroup(), m_pLoadedTrack);
+}
+
+void CompactSampler::slotEject(double v) {
+    if (v > 0.0 && m_pLoadedTrack) {
+        slotLoadTrack(TrackPointer());
+    }
+}
+
+void CompactSampler::unloadTrack() {
+    m_pLoadingTrack.reset();
+    if (!m_pLoadedTrack) {
+        return;
+    }
+    m_pChannel->setSample(nullptr);
+    m_pLoadedTrack.reset();
+    m_pDuration->set(0);
+    PlayerInfo::instance().setTrackInfo(getGroup(), m_pLoadedTrack);
+}
@@ -0,0 +1,68 @@
+#ifndef MIXER_COMPACTSAMPLER_H
+#define MIXER_COMPACTSAMPLER_H
+
+#include <QFutureWatcher>
+
+#include "engine/enginechannel.h"
+#include "mixer/basetrackplayer.h"
+#include "preferences/usersettings.h"
+#include "track/track.h"
+#include "util/memory.h"
+
+class ControlObject;
+class ControlPushButton;
+class EngineCompactSampler;
+class EngineMaster;
+struct CompactSample;
+
+// A sampler for short one-shots that decodes the whole track into memory
+// when loading it and plays it with an EngineCompactSampler. It costs a
+// fraction of a full Sampler, but only provides the play, start_play,
+// stop, eject, playposition, track_loaded, pregain and duration controls.
+class CompactSampler : public BaseTrackPlayer {
+    Q_OBJECT
+  public:
+    CompactSampler(QObject* pParent,
+                   UserSettingsPointer pConfig,
+                   EngineMaster* pMixingEngine,
+                   EffectsManager* pEffectsManager,
+                   EngineChannel::ChannelOrientation defaultOrientation,
+                   const QString& group);
+    ~CompactSampler() override;
+
+    TrackPointer getLoadedTrack() const override;
+
+    struct DecodeResult {
+        DecodeResult()
+                : pSample(nullptr) {
+        }
+        TrackPointer pTrack;
+        // Owned by the receiver of the result
+        CompactSample* pSample;
+        QString errorMessage;
+    };
+
+  public slots:
+    void slotLoadTrack(TrackPointer pTrack, bool bPlay = false) override;
+
+  private slots:
+    void slotDecodeFinished();
+    void slotEject(double v);
+
+  private:
+    void startDecoding();
+    void unloadTrack();
+
+    UserSettingsPointer m_pConfig;
+    EngineCompactSampler* m_pChannel;
+
+    TrackPointer m_pLoadedTrack;
+    TrackPointer m_pLoadingTrack;
+    bool m_playAfterLoading;
+    QFutureWatcher<DecodeResult> m_decodeWatcher;
+
+    std::unique_ptr<ControlObject> m_pDuration;
+    std::unique_ptr<ControlPushButton> m_pEject;
+};
+
+#endif /* MIXER_COMPACTSAMPLER_H */
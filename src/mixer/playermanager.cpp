@@ -13,6 +13,7 @@
 #include "engine/enginemaster.h"
 #include "library/library.h"
 #include "mixer/auxiliary.h"
+#include "mixer/compactsampler.h"
 #include "mixer/deck.h"
 #include "mixer/microphone.h"
 #include "mixer/previewdeck.h"
@@ -135,7 +136,7 @@ void PlayerManager::bindToLibrary(Library* pLibrary) {
 
     // Connect the player to the analyzer queue so that loaded tracks are
     // analysed.
-    foreach(Sampler* pSampler, m_samplers) {
+    foreach(BaseTrackPlayer* pSampler, m_samplers) {
         connect(pSampler, SIGNAL(newTrackLoaded(TrackPointer)),
                 m_pAnalyzerQueue, SLOT(slotAnalyseTrack(TrackPointer)));
     }
@@ -429,8 +430,15 @@ void PlayerManager::addSamplerInner() {
     // All samplers are in the center
     EngineChannel::ChannelOrientation orientation = EngineChannel::CENTER;
 
-    Sampler* pSampler = new Sampler(this, m_pConfig, m_pEngine,
-                                    m_pEffectsManager, orientation, group);
+    BaseTrackPlayer* pSampler;
+    if (m_pConfig->getValue(ConfigKey("[Sampler]", "CompactEngine"), false)) {
+        // Lightweight in-memory playback for short one-shots
+        pSampler = new CompactSampler(this, m_pConfig, m_pEngine,
+                                      m_pEffectsManager, orientation, group);
+    } else {
+        pSampler = new Sampler(this, m_pConfig, m_pEngine,
+                               m_pEffectsManager, orientation, group);
+    }
     if (m_pAnalyzerQueue) {
         connect(pSampler, SIGNAL(newTrackLoaded(TrackPointer)),
                 m_pAnalyzerQueue, SLOT(slotAnalyseTrack(TrackPointer)));
@@ -529,7 +537,7 @@ PreviewDeck* PlayerManager::getPreviewDeck(unsigned int libPreviewPlayer) const
     return m_preview_decks[libPreviewPlayer - 1];
 }
 
-Sampler* PlayerManager::getSampler(unsigned int sampler) const {
+BaseTrackPlayer* PlayerManager::getSampler(unsigned int sampler) const {
     QMutexLocker locker(&m_mutex);
     if (sampler < 1 || sampler > numSamplers()) {
         qWarning() << "Warning PlayerManager::getSampler() called with invalid index: "
@@ -611,9 +619,9 @@ void PlayerManager::slotLoadTrackIntoNextAvailableDeck(TrackPointer pTrack) {
 
 void PlayerManager::slotLoadTrackIntoNextAvailableSampler(TrackPointer pTrack) {
     QMutexLocker locker(&m_mutex);
-    QList<Sampler*>::iterator it = m_samplers.begin();
+    QList<BaseTrackPlayer*>::iterator it = m_samplers.begin();
     while (it != m_samplers.end()) {
-        Sampler* pSampler = *it;
+        BaseTrackPlayer* pSampler = *it;
         ControlObject* playControl =
                 ControlObject::getControl(ConfigKey(pSampler->getGroup(), "play"));
         if (playControl && playControl->get() != 1.) {
@@ -22,7 +22,6 @@ class EngineMaster;
 class Library;
 class Microphone;
 class PreviewDeck;
-class Sampler;
 class SamplerBank;
 class SoundManager;
 
@@ -48,7 +47,7 @@ class PlayerManagerInterface {
     virtual unsigned int numberOfPreviewDecks() const = 0;
 
     // Get the sampler by its number. Samplers are numbered starting with 1.
-    virtual Sampler* getSampler(unsigned int sampler) const = 0;
+    virtual BaseTrackPlayer* getSampler(unsigned int sampler) const = 0;
 
     // Returns the number of sampler decks.
     virtual unsigned int numberOfSamplers() const = 0;
@@ -127,7 +126,7 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
     PreviewDeck* getPreviewDeck(unsigned int libPreviewPlayer) const;
 
     // Get the sampler by its number. Samplers are numbered starting with 1.
-    Sampler* getSampler(unsigned int sampler) const;
+    BaseTrackPlayer* getSampler(unsigned int sampler) const;
 
     // Get the microphone by its number. Microphones are numbered starting with 1.
     Microphone* getMicrophone(unsigned int microphone) const;
@@ -250,7 +249,8 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
     ControlObject* m_pCONumAuxiliaries;
 
     QList<Deck*> m_decks;
-    QList<Sampler*> m_samplers;
+    // Either Samplers or CompactSamplers
+    QList<BaseTrackPlayer*> m_samplers;
     QList<PreviewDeck*> m_preview_decks;
     QList<Microphone*> m_microphones;
     QList<Auxiliary*> m_auxiliaries;
@@ -5,7 +5,7 @@
 
 #include "control/controlpushbutton.h"
 #include "mixer/playermanager.h"
-#include "mixer/sampler.h"
+#include "mixer/basetrackplayer.h"
 #include "track/track.h"
 #include "util/assert.h"
 
@@ -83,7 +83,7 @@ bool SamplerBank::saveSamplerBankToPath(const QString& samplerBankPath) {
     doc.appendChild(root);
 
     for (unsigned int i = 0; i < m_pPlayerManager->numSamplers(); ++i) {
-        Sampler* pSampler = m_pPlayerManager->getSampler(i + 1);
+        BaseTrackPlayer* pSampler = m_pPlayerManager->getSampler(i + 1);
         if (pSampler == NULL) {
             continue;
         }
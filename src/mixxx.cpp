@@ -22,6 +22,7 @@
 #include <QFileDialog>
 #include <QGLWidget>
 #include <QUrl>
+#include <QtConcurrentRun>
 #include <QtDebug>
 
 #include "analyzer/analyzerqueue.h"
@@ -51,6 +52,7 @@
 #include "track/track.h"
 #include "waveform/waveformwidgetfactory.h"
 #include "waveform/sharedglcontext.h"
+#include "waveform/overviewcache.h"
 #include "database/mixxxdb.h"
 #include "util/debug.h"
 #include "util/statsmanager.h"
@@ -72,6 +74,7 @@
 #include "util/screensaver.h"
 #include "util/logger.h"
 #include "util/db/dbconnectionpooled.h"
+#include "util/startupprofiler.h"
 
 #ifdef __VINYLCONTROL__
 #include "vinylcontrol/vinylcontrolmanager.h"
@@ -85,6 +88,44 @@ namespace {
 
 const mixxx::Logger kLogger("MixxxMainWindow");
 
+// Size limit of the persistent cover art thumbnail store
+const int kDefaultCoverArtDiskCacheSizeMB = 64;
+
+const int kPrefetchChunkSize = 1024 * 1024;
+
+// The following run on the thread pool during startup
+
+#ifdef __LILV__
+LilvWorld* loadLV2World(StartupProfiler* pProfiler) {
+    StartupProfiler::TaskScope task(pProfiler, "LV2 plugin discovery");
+    return LV2Backend::loadWorld();
+}
+#endif
+
+#ifndef __WINDOWS__
+// On Windows the WASAPI and ASIO host APIs initialize COM on the thread
+// that initializes PortAudio and expect to be terminated on the same
+// thread. There PortAudio is initialized by the SoundManager instead.
+void preinitializePortAudio(StartupProfiler* pProfiler) {
+    StartupProfiler::TaskScope task(pProfiler, "Sound device queries");
+    SoundManager::preinitializePortAudio();
+}
+#endif
+
+// Reads the file once, so its pages are in the file system cache when it is
+// needed. On a cold start the library database is otherwise read page by
+// page with random access while the library is set up.
+void prefetchFile(StartupProfiler* pProfiler, QString filePath) {
+    StartupProfiler::TaskScope task(pProfiler, "Library database prefetch");
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QByteArray buffer(kPrefetchChunkSize, '\0');
+    while (file.read(buffer.data(), buffer.size()) > 0) {
+    }
+}
+
 } // anonymous namespace
 
 // static
@@ -175,6 +216,30 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
 
     QString resourcePath = pConfig->getResourcePath();
 
+    // Times the phases below and writes them to a report at the end
+    StartupProfiler profiler;
+
+    // Start the work that does not depend on anything created below, so it
+    // overlaps with the subsystems that have to be set up on the main thread.
+    QFuture<void> databasePrefetch = QtConcurrent::run(prefetchFile,
+            &profiler, MixxxDb::databaseFilePath(pConfig));
+#ifndef __WINDOWS__
+    QFuture<void> portAudioInitialization = QtConcurrent::run(
+            preinitializePortAudio, &profiler);
+#endif
+#ifdef __LILV__
+    QFuture<LilvWorld*> lv2World = QtConcurrent::run(loadLV2World, &profiler);
+#endif
+
+    // The ControllerManager enumerates the controller presets and the MIDI
+    // and HID devices on its own thread as soon as it is created. It only
+    // needs the settings, so create it first.
+    // Controllers are not set up until the end of the application startup.
+    profiler.beginPhase("ControllerManager");
+    qDebug() << "Creating ControllerManager";
+    m_pControllerManager = new ControllerManager(pConfig);
+
+    profiler.beginPhase("Fonts");
     FontUtils::initializeFonts(resourcePath); // takes a long time
 
     launchProgress(2);
@@ -187,6 +252,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     setAttribute(Qt::WA_AcceptTouchEvents);
     m_pTouchShift = new ControlPushButton(ConfigKey("[Controls]", "touch_shift"));
 
+    profiler.beginPhase("EffectsManager and EngineMaster");
     m_pChannelHandleFactory = new ChannelHandleFactory();
 
     // Create the Effects subsystem.
@@ -198,22 +264,29 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
 
     // Create effect backends. We do this after creating EngineMaster to allow
     // effect backends to refer to controls that are produced by the engine.
+    profiler.beginPhase("Effect backends");
     BuiltInBackend* pBuiltInBackend = new BuiltInBackend(m_pEffectsManager);
     m_pEffectsManager->addEffectsBackend(pBuiltInBackend);
 #ifdef __LILV__
-    LV2Backend* pLV2Backend = new LV2Backend(m_pEffectsManager);
+    LV2Backend* pLV2Backend = new LV2Backend(m_pEffectsManager,
+                                             lv2World.result());
     m_pEffectsManager->addEffectsBackend(pLV2Backend);
 #else
     LV2Backend* pLV2Backend = nullptr;
 #endif
 
     // Sets up the EffectChains and EffectRacks (long)
+    profiler.beginPhase("Effect racks");
     m_pEffectsManager->setup();
 
     launchProgress(8);
 
     // Although m_pSoundManager is created here, m_pSoundManager->setupDevices()
     // needs to be called after m_pPlayerManager registers sound IO for each EngineChannel.
+    profiler.beginPhase("SoundManager");
+#ifndef __WINDOWS__
+    portAudioInitialization.waitForFinished();
+#endif
     m_pSoundManager = new SoundManager(pConfig, m_pEngine);
     m_pEngine->registerNonEngineChannelSoundIO(m_pSoundManager);
 
@@ -237,6 +310,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
 #endif
 
     // Create the player manager. (long)
+    profiler.beginPhase("PlayerManager");
     m_pPlayerManager = new PlayerManager(pConfig, m_pSoundManager,
                                          m_pEffectsManager, m_pEngine);
     connect(m_pPlayerManager, SIGNAL(noMicrophoneInputConfigured()),
@@ -263,6 +337,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
 
     launchProgress(30);
 
+    profiler.beginPhase("Effect chains and vinyl control");
     m_pEffectsManager->loadEffectChains();
 
 #ifdef __VINYLCONTROL__
@@ -277,8 +352,15 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     delete pModplugPrefs; // not needed anymore
 #endif
 
-    CoverArtCache::createInstance();
+    CoverArtCache::createInstance()->enableDiskCache(
+            QDir(pConfig->getSettingsPath()).filePath("coverart"),
+            pConfig->getValue<int>(
+                    ConfigKey("[Library]", "CoverArtDiskCacheSizeMB"),
+                    kDefaultCoverArtDiskCacheSizeMB) * qint64(1024 * 1024));
+    SoundSourceProxy::configureDecodedAudioCache(pConfig);
 
+    profiler.beginPhase("Library database");
+    databasePrefetch.waitForFinished();
     m_pDbConnectionPool = MixxxDb(pConfig).connectionPool();
     if (!m_pDbConnectionPool) {
         // TODO(XXX) something a little more elegant
@@ -293,6 +375,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
 
     launchProgress(35);
 
+    profiler.beginPhase("Library");
     m_pLibrary = new Library(
             this,
             pConfig,
@@ -334,16 +417,9 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
         }
     }
 
-    // Call inits to invoke all other construction parts
-
-    // Initialize controller sub-system,
-    // but do not set up controllers until the end of the application startup
-    // (long)
-    qDebug() << "Creating ControllerManager";
-    m_pControllerManager = new ControllerManager(pConfig);
-
     launchProgress(47);
 
+    profiler.beginPhase("WaveformWidgetFactory");
     WaveformWidgetFactory::createInstance(); // takes a long time
     WaveformWidgetFactory::instance()->startVSync(m_pGuiTick);
     WaveformWidgetFactory::instance()->setConfig(pConfig);
@@ -365,6 +441,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     }
 
     // Initialize preference dialog
+    profiler.beginPhase("DlgPreferences");
     m_pPrefDlg = new DlgPreferences(this, m_pSkinLoader, m_pSoundManager, m_pPlayerManager,
                                     m_pControllerManager, m_pVCManager, pLV2Backend, m_pEffectsManager,
                                     m_pSettingsManager, m_pLibrary);
@@ -385,6 +462,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
 
     launchProgress(63);
 
+    profiler.beginPhase("Skin");
     QWidget* oldWidget = m_pWidgetParent;
 
     // Load skin to a QWidget that we set as the central widget. Assignment
@@ -431,6 +509,7 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
 
     // Wait until all other ControlObjects are set up before initializing
     // controllers
+    profiler.beginPhase("Controller setup");
     m_pControllerManager->setUpDevices();
 
     // Scan the library for new files and directories
@@ -455,8 +534,11 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
 
     // This has to be done before m_pSoundManager->setupDevices()
     // https://bugs.launchpad.net/mixxx/+bug/1758189
+    profiler.beginPhase("Samplers");
     m_pPlayerManager->loadSamplers();
 
+    profiler.beginPhase("Sound device setup");
+
     // Try open player device If that fails, the preference panel is opened.
     bool retryClicked;
     do {
@@ -515,6 +597,9 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     // The launch image widget is automatically disposed, but we still have a
     // pointer to it.
     m_pLaunchImage = nullptr;
+
+    profiler.writeReport(
+            QDir(pConfig->getSettingsPath()).filePath("startup_report.txt"));
 }
 
 void MixxxMainWindow::finalize() {
@@ -549,6 +634,8 @@ void MixxxMainWindow::finalize() {
     VERIFY_OR_DEBUG_ASSERT(pSkin.isNull()) {
         qWarning() << "Central widget was not deleted by our sendPostedEvents trick.";
     }
+    // The overviews of the loaded tracks may still be written
+    OverviewCache::waitForPendingWrites();
 
     // TODO(rryan): WMainMenuBar holds references to controls so we need to delete it
     // before MixxxMainWindow is destroyed. QMainWindow calls deleteLater() in
@@ -585,6 +672,9 @@ void MixxxMainWindow::finalize() {
     // CoverArtCache is fairly independent of everything else.
     CoverArtCache::destroy();
 
+    // Cancels a pending decode of the last loaded track
+    SoundSourceProxy::disableDecodedAudioCache();
+
     // PlayerManager depends on Engine, SoundManager, VinylControlManager, and Config
     // The player manager has to be deleted before the library to ensure
     // that all modified track metadata of loaded tracks is saved.
@@ -144,6 +144,9 @@ void DlgPrefLibrary::slotResetToDefaults() {
     radioButton_dbclick_deck->setChecked(true);
     spinBoxRowHeight->setValue(Library::kDefaultRowHeightPx);
     setLibraryFont(QApplication::font());
+    checkBox_DecodedAudioCache->setChecked(false);
+    spinBox_DecodedAudioCacheSize->setValue(
+            SoundSourceProxy::kDefaultDecodedAudioCacheSizeMB);
 }
 
 void DlgPrefLibrary::slotUpdate() {
@@ -186,6 +189,12 @@ void DlgPrefLibrary::slotUpdate() {
     m_iOriginalTrackTableRowHeight = m_pLibrary->getTrackTableRowHeight();
     spinBoxRowHeight->setValue(m_iOriginalTrackTableRowHeight);
     setLibraryFont(m_originalTrackTableFont);
+
+    checkBox_DecodedAudioCache->setChecked(m_pConfig->getValue(
+            ConfigKey("[Library]","DecodedAudioCacheEnabled"), false));
+    spinBox_DecodedAudioCacheSize->setValue(m_pConfig->getValue(
+            ConfigKey("[Library]","DecodedAudioCacheSizeMB"),
+            SoundSourceProxy::kDefaultDecodedAudioCacheSizeMB));
 }
 
 void DlgPrefLibrary::slotCancel() {
@@ -329,6 +338,12 @@ void DlgPrefLibrary::slotApply() {
                        ConfigValue(rowHeight));
     }
 
+    m_pConfig->set(ConfigKey("[Library]","DecodedAudioCacheEnabled"),
+                ConfigValue((int)checkBox_DecodedAudioCache->isChecked()));
+    m_pConfig->set(ConfigKey("[Library]","DecodedAudioCacheSizeMB"),
+                ConfigValue(spinBox_DecodedAudioCacheSize->value()));
+    SoundSourceProxy::configureDecodedAudioCache(m_pConfig);
+
     // TODO(rryan): Don't save here.
     m_pConfig->save();
 }
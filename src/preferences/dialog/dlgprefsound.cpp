@@ -23,6 +23,7 @@
 #include "soundio/soundmanager.h"
 #include "util/rlimit.h"
 #include "util/scopedoverridecursor.h"
+#include "control/controlobject.h"
 #include "control/controlproxy.h"
 
 /**
@@ -87,6 +88,13 @@ DlgPrefSound::DlgPrefSound(QWidget* pParent, SoundManager* pSoundManager,
                         static_cast<EngineBuffer::KeylockEngine>(i)));
     }
 
+    vinylResamplerComboBox->clear();
+    for (int i = 0; i < EngineBuffer::VINYL_RESAMPLER_COUNT; ++i) {
+        vinylResamplerComboBox->addItem(
+                EngineBuffer::getVinylResamplerName(
+                        static_cast<EngineBuffer::VinylResampler>(i)));
+    }
+
     m_pLatencyCompensation = new ControlProxy("[Master]", "microphoneLatencyCompensation", this);
     m_pMasterDelay = new ControlProxy("[Master]", "delay", this);
     m_pHeadDelay = new ControlProxy("[Master]", "headDelay", this);
@@ -136,6 +144,8 @@ DlgPrefSound::DlgPrefSound(QWidget* pParent, SoundManager* pSoundManager,
             this, SLOT(settingChanged()));
     connect(keylockComboBox, SIGNAL(currentIndexChanged(int)),
             this, SLOT(settingChanged()));
+    connect(vinylResamplerComboBox, SIGNAL(currentIndexChanged(int)),
+            this, SLOT(settingChanged()));
 
     connect(queryButton, SIGNAL(clicked()),
             this, SLOT(queryClicked()));
@@ -229,6 +239,7 @@ void DlgPrefSound::slotApply() {
         m_pKeylockEngine->set(keylockComboBox->currentIndex());
         m_pConfig->set(ConfigKey("[Master]", "keylock_engine"),
                        ConfigValue(keylockComboBox->currentIndex()));
+        setVinylResampler(vinylResamplerComboBox->currentIndex());
 
         err = m_pSoundManager->setConfig(m_config);
     }
@@ -417,6 +428,10 @@ void DlgPrefSound::loadSettings(const SoundManagerConfig &config) {
             ConfigKey("[Master]", "keylock_engine"), 1);
     keylockComboBox->setCurrentIndex(keylock_engine);
 
+    // All players are set at once, so the first deck tells for all
+    vinylResamplerComboBox->setCurrentIndex(static_cast<int>(ControlObject::get(
+            ConfigKey(PlayerManager::groupForDeck(0), "vinyl_resampler"))));
+
     m_loading = false;
     // DlgPrefSoundItem has it's own inhibit flag 
     emit(loadPaths(m_config));
@@ -595,6 +610,8 @@ void DlgPrefSound::slotResetToDefaults() {
     loadSettings(newConfig);
     keylockComboBox->setCurrentIndex(EngineBuffer::RUBBERBAND);
     m_pKeylockEngine->set(EngineBuffer::RUBBERBAND);
+    vinylResamplerComboBox->setCurrentIndex(EngineBuffer::LINEAR);
+    setVinylResampler(EngineBuffer::LINEAR);
 
     masterMixComboBox->setCurrentIndex(1);
     m_pMasterEnabled->set(1.0);
@@ -674,6 +691,23 @@ void DlgPrefSound::micMonitorModeComboBoxChanged(int value) {
     checkLatencyCompensation();
 }
 
+void DlgPrefSound::setVinylResampler(int resampler) {
+    // The control is per player, so it can still be changed for single
+    // decks by controller mappings
+    for (unsigned int i = 0; i < PlayerManager::numDecks(); ++i) {
+        ControlObject::set(ConfigKey(PlayerManager::groupForDeck(i),
+                "vinyl_resampler"), resampler);
+    }
+    for (unsigned int i = 0; i < PlayerManager::numSamplers(); ++i) {
+        ControlObject::set(ConfigKey(PlayerManager::groupForSampler(i),
+                "vinyl_resampler"), resampler);
+    }
+    for (unsigned int i = 0; i < PlayerManager::numPreviewDecks(); ++i) {
+        ControlObject::set(ConfigKey(PlayerManager::groupForPreviewDeck(i),
+                "vinyl_resampler"), resampler);
+    }
+}
+
 void DlgPrefSound::checkLatencyCompensation() {
     EngineMaster::MicMonitorMode configuredMicMonitorMode =
         static_cast<EngineMaster::MicMonitorMode>(
@@ -93,6 +93,8 @@ class DlgPrefSound : public DlgPreferencePage, public Ui::DlgPrefSoundDlg  {
     void loadSettings(const SoundManagerConfig &config);
     void insertItem(DlgPrefSoundItem *pItem, QVBoxLayout *pLayout);
     void checkLatencyCompensation();
+    // Selects the scaler for playback without keylock in all players
+    void setVinylResampler(int resampler);
 
     SoundManager *m_pSoundManager;
     PlayerManager *m_pPlayerManager;
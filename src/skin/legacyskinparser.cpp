@@ -27,6 +27,7 @@
 #include "skin/colorschemeparser.h"
 #include "skin/skincontext.h"
 #include "skin/launchimage.h"
+#include "skin/skinimagecache.h"
 
 #include "effects/effectsmanager.h"
 
@@ -380,6 +381,15 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
 
     ColorSchemeParser::setupLegacyColorSchemes(skinDocument, m_pConfig, &m_style);
 
+    // Rasterize the images that the skin has used the last time in parallel,
+    // instead of one by one while creating the widgets.
+    SkinImageCache::beginSkin(
+            QDir(m_pConfig->getSettingsPath() + "/cache/skins/"),
+            skinPath,
+            m_pConfig->getValueString(ConfigKey("[Config]", "Scheme")),
+            m_pContext->getScaleFactor(),
+            WPixmapStore::getLoader());
+
     // don't parent till here so the first opengl waveform doesn't screw
     // up --bkgood
     // I'm disregarding this return value because I want to return the
@@ -387,6 +397,7 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
     // fullscreen mostly) --bkgood
     m_pParent = pParent;
     QList<QWidget*> widgets = parseNode(skinDocument);
+    SkinImageCache::endSkin();
 
     if (widgets.empty()) {
         SKIN_WARNING(skinDocument, *m_pContext) << "Skin produced no widgets!";
@@ -2031,13 +2042,19 @@ void LegacySkinParser::setupConnections(const QDomNode& node, WBaseWidget* pWidg
             pTransformer = ValueTransformer::parseFromXml(transform, *m_pContext);
         }
 
+        // Opt-in: Deliver only the latest value once per GUI frame. Useful
+        // for displays of controls that change with every audio callback.
+        bool coalesceUpdates = false;
+        m_pContext->hasNodeSelectBool(con, "CoalesceUpdates", &coalesceUpdates);
+
         QString property;
         if (m_pContext->hasNodeSelectString(con, "BindProperty", &property)) {
             //qDebug() << "Making property connection for" << property;
 
             ControlWidgetPropertyConnection* pConnection =
                     new ControlWidgetPropertyConnection(pWidget, control->getKey(),
-                                                        pTransformer, property);
+                                                        pTransformer, property,
+                                                        coalesceUpdates);
             pWidget->addPropertyConnection(pConnection);
 
             // If we created this control, bind it to the
@@ -2106,7 +2123,8 @@ void LegacySkinParser::setupConnections(const QDomNode& node, WBaseWidget* pWidg
             ControlParameterWidgetConnection* pConnection = new ControlParameterWidgetConnection(
                     pWidget, control->getKey(), pTransformer,
                     static_cast<ControlParameterWidgetConnection::DirectionOption>(directionOption),
-                    static_cast<ControlParameterWidgetConnection::EmitOption>(emitOption));
+                    static_cast<ControlParameterWidgetConnection::EmitOption>(emitOption),
+                    coalesceUpdates);
 
             // If we created this control, bind it to the
             // ControlWidgetConnection so that it is deleted when the connection
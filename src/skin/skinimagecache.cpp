@@ -0,0 +1,361 @@
+#include "skin/skinimagecache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QPainter>
+#include <QSet>
+#include <QSvgRenderer>
+#include <QTextStream>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+
+#include "util/logger.h"
+#include "util/timer.h"
+
+namespace {
+
+const mixxx::Logger kLogger("SkinImageCache");
+
+const char* const kManifestFileName = "manifest.txt";
+const char* const kImageFormat = "PNG";
+const QString kTemporarySuffix = ".tmp";
+
+// The number of cache directories that are kept for skins, scale factors or
+// color schemes that are not used at the moment, so switching between a few
+// of them stays fast
+const int kMaxUnusedSkinCacheDirs = 3;
+
+struct Request {
+    QString filePath;
+    SkinImageCache::Rendering rendering;
+};
+
+// Whether a skin is being loaded
+bool s_active = false;
+// The cache directory of the skin that is being loaded
+QDir s_skinCacheDir;
+double s_scaleFactor = 1.0;
+QSharedPointer<ImgSource> s_pLoader;
+// The images that have been rasterized in beginSkin()
+QHash<QString, QImage> s_prefetched;
+// The images that have been requested since beginSkin(), in order
+QList<Request> s_requests;
+QSet<QString> s_requestedKeys;
+
+QString requestKey(const QString& filePath,
+                   SkinImageCache::Rendering rendering) {
+    return QString("%1|%2").arg(static_cast<int>(rendering)).arg(filePath);
+}
+
+QString toHex(const QByteArray& data) {
+    return QString::fromLatin1(
+            QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+}
+
+// The name of the cached image changes whenever its file is modified
+QString imageFileName(const Request& request) {
+    const QFileInfo fileInfo(request.filePath);
+    return toHex(requestKey(request.filePath, request.rendering).toUtf8() +
+            QByteArray::number(fileInfo.lastModified().toMSecsSinceEpoch()) +
+            QByteArray::number(fileInfo.size())) + ".png";
+}
+
+QImage renderImage(const Request& request,
+                   double scaleFactor,
+                   const ImgSource& loader) {
+    if (request.rendering == SkinImageCache::Rendering::Loader) {
+        QScopedPointer<QImage> pImage(
+                loader.getImage(request.filePath, scaleFactor));
+        return pImage ? *pImage : QImage();
+    }
+
+    QSvgRenderer renderer;
+    if (!renderer.load(request.filePath)) {
+        // The above line already logs a warning
+        return QImage();
+    }
+    QImage image(renderer.defaultSize() * scaleFactor, QImage::Format_ARGB32);
+    image.fill(0x00000000);  // Transparent black.
+    QPainter painter(&image);
+    renderer.render(&painter);
+    painter.end();
+    if (request.rendering == SkinImageCache::Rendering::SvgColorCorrected) {
+        loader.correctImageColors(&image);
+    }
+    return image;
+}
+
+// Replaces the file with the temporary file, so no one ever reads a
+// partially written file
+bool replaceWithTemporaryFile(const QString& filePath) {
+    const QString tempPath = filePath + kTemporarySuffix;
+    // QFile::rename() does not overwrite existing files
+    QFile::remove(filePath);
+    if (!QFile::rename(tempPath, filePath)) {
+        QFile::remove(tempPath);
+        return false;
+    }
+    return true;
+}
+
+void saveImage(QImage image, QString filePath) {
+    const QString tempPath = filePath + kTemporarySuffix;
+    if (!image.save(tempPath, kImageFormat) ||
+            !replaceWithTemporaryFile(filePath)) {
+        kLogger.warning() << "Failed to save" << filePath;
+        QFile::remove(tempPath);
+    }
+}
+
+// Loads the image from the disk cache or renders and stores it. Runs on the
+// thread pool.
+class Rasterizer {
+  public:
+    typedef QImage result_type;
+
+    Rasterizer(const QDir& cacheDir, double scaleFactor,
+               QSharedPointer<ImgSource> pLoader)
+            : m_cacheDir(cacheDir),
+              m_scaleFactor(scaleFactor),
+              m_pLoader(pLoader) {
+    }
+
+    QImage operator()(const Request& request) const {
+        const QString cachedFilePath =
+                m_cacheDir.absoluteFilePath(imageFileName(request));
+        QImage image;
+        if (QFile::exists(cachedFilePath) &&
+                image.load(cachedFilePath, kImageFormat)) {
+            return image;
+        }
+        image = renderImage(request, m_scaleFactor, *m_pLoader);
+        if (!image.isNull()) {
+            saveImage(image, cachedFilePath);
+        }
+        return image;
+    }
+
+  private:
+    const QDir m_cacheDir;
+    const double m_scaleFactor;
+    const QSharedPointer<ImgSource> m_pLoader;
+};
+
+QList<Request> readManifest(const QString& manifestPath) {
+    QList<Request> requests;
+    QFile file(manifestPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return requests;
+    }
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    while (!stream.atEnd()) {
+        const QString line = stream.readLine();
+        const int separator = line.indexOf('\t');
+        if (separator < 0) {
+            continue;
+        }
+        bool ok = false;
+        const int rendering = line.left(separator).toInt(&ok);
+        if (!ok || rendering < 0 ||
+                rendering > static_cast<int>(
+                        SkinImageCache::Rendering::SvgColorCorrected)) {
+            continue;
+        }
+        Request request;
+        request.rendering = static_cast<SkinImageCache::Rendering>(rendering);
+        request.filePath = line.mid(separator + 1);
+        requests.append(request);
+    }
+    return requests;
+}
+
+void writeManifest(const QString& manifestPath, const QList<Request>& requests) {
+    QFile file(manifestPath + kTemporarySuffix);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        kLogger.warning() << "Failed to write" << manifestPath;
+        return;
+    }
+    {
+        QTextStream stream(&file);
+        stream.setCodec("UTF-8");
+        for (const Request& request : requests) {
+            stream << static_cast<int>(request.rendering) << '\t'
+                   << request.filePath << '\n';
+        }
+    }
+    file.close();
+    if (file.error() != QFile::NoError ||
+            !replaceWithTemporaryFile(manifestPath)) {
+        kLogger.warning() << "Failed to write" << manifestPath;
+    }
+}
+
+// The manifest is rewritten whenever the skin has been loaded
+QDateTime lastUsed(const QDir& skinCacheDir) {
+    return QFileInfo(skinCacheDir.absoluteFilePath(kManifestFileName))
+            .lastModified();
+}
+
+bool lastUsedBefore(const QFileInfo& lhs, const QFileInfo& rhs) {
+    return lastUsed(QDir(lhs.absoluteFilePath())) <
+            lastUsed(QDir(rhs.absoluteFilePath()));
+}
+
+// Deletes the cache directories of skins, scale factors or color schemes
+// that have not been used for the longest time. The directories only
+// contain files.
+void removeStaleSkinCacheDirs(const QDir& cacheDir, const QDir& skinCacheDir) {
+    QFileInfoList dirInfos = cacheDir.entryInfoList(
+            QDir::Dirs | QDir::NoDotAndDotDot);
+    std::sort(dirInfos.begin(), dirInfos.end(), lastUsedBefore);
+    int unusedDirCount = 0;
+    for (const QFileInfo& dirInfo : dirInfos) {
+        if (dirInfo.absoluteFilePath() != skinCacheDir.absolutePath()) {
+            ++unusedDirCount;
+        }
+    }
+    for (const QFileInfo& dirInfo : dirInfos) {
+        if (unusedDirCount <= kMaxUnusedSkinCacheDirs) {
+            break;
+        }
+        if (dirInfo.absoluteFilePath() == skinCacheDir.absolutePath()) {
+            continue;
+        }
+        QDir dir(dirInfo.absoluteFilePath());
+        for (const QString& fileName : dir.entryList(QDir::Files)) {
+            QFile::remove(dir.absoluteFilePath(fileName));
+        }
+        if (!dir.rmdir(dir.absolutePath())) {
+            kLogger.warning() << "Failed to remove" << dir.absolutePath();
+        }
+        --unusedDirCount;
+    }
+}
+
+} // anonymous namespace
+
+// static
+void SkinImageCache::beginSkin(const QDir& cacheDir,
+                               const QString& skinPath,
+                               const QString& colorScheme,
+                               double scaleFactor,
+                               QSharedPointer<ImgSource> pLoader) {
+    ScopedTimer timer("SkinImageCache::beginSkin");
+    s_prefetched.clear();
+    s_requests.clear();
+    s_requestedKeys.clear();
+    s_scaleFactor = scaleFactor;
+    s_pLoader = pLoader;
+
+    // The color scheme filters are defined in skin.xml
+    const QFileInfo skinXml(skinPath + "/skin.xml");
+    const QString skinKey = QString("%1|%2|%3|%4")
+            .arg(skinXml.absoluteFilePath(),
+                 QString::number(skinXml.lastModified().toMSecsSinceEpoch()),
+                 colorScheme,
+                 QString::number(scaleFactor));
+    s_skinCacheDir = QDir(cacheDir.absoluteFilePath(
+            QFileInfo(skinPath).fileName() + "-" + toHex(skinKey.toUtf8()).left(16)));
+    if (!QDir().mkpath(s_skinCacheDir.absolutePath())) {
+        kLogger.warning() << "Failed to create directory"
+                          << s_skinCacheDir.absolutePath();
+        return;
+    }
+    s_active = true;
+
+    // Only a few directories are listed, which is cheap compared to
+    // loading the skin
+    removeStaleSkinCacheDirs(cacheDir, s_skinCacheDir);
+    // Left behind if Mixxx quit while writing. Later on they may belong to
+    // images that are still being saved.
+    static bool s_temporaryFilesRemoved = false;
+    if (!s_temporaryFilesRemoved) {
+        s_temporaryFilesRemoved = true;
+        const QStringList tempFileNames = s_skinCacheDir.entryList(
+                QStringList() << ("*" + kTemporarySuffix), QDir::Files);
+        for (const QString& tempFileName : tempFileNames) {
+            QFile::remove(s_skinCacheDir.absoluteFilePath(tempFileName));
+        }
+    }
+
+    const QList<Request> requests = readManifest(
+            s_skinCacheDir.absoluteFilePath(kManifestFileName));
+    if (requests.isEmpty()) {
+        return;
+    }
+    const QList<QImage> images = QtConcurrent::blockingMapped<QList<QImage> >(
+            requests, Rasterizer(s_skinCacheDir, scaleFactor, pLoader));
+    for (int i = 0; i < requests.size(); ++i) {
+        s_prefetched.insert(
+                requestKey(requests[i].filePath, requests[i].rendering),
+                images[i]);
+    }
+    kLogger.debug() << "Prefetched" << images.size() << "images";
+}
+
+// static
+void SkinImageCache::endSkin() {
+    if (!s_active) {
+        return;
+    }
+    s_active = false;
+    writeManifest(s_skinCacheDir.absoluteFilePath(kManifestFileName),
+            s_requests);
+
+    // Remove the images of files that have changed or are no longer used
+    QSet<QString> imageFileNames;
+    for (const Request& request : s_requests) {
+        imageFileNames.insert(imageFileName(request));
+    }
+    const QStringList cachedFileNames = s_skinCacheDir.entryList(
+            QStringList() << "*.png", QDir::Files);
+    for (const QString& cachedFileName : cachedFileNames) {
+        if (!imageFileNames.contains(cachedFileName)) {
+            QFile::remove(s_skinCacheDir.absoluteFilePath(cachedFileName));
+        }
+    }
+
+    s_prefetched.clear();
+    s_requests.clear();
+    s_requestedKeys.clear();
+    s_pLoader.clear();
+}
+
+// static
+QImage SkinImageCache::getImage(const QString& filePath,
+                                double scaleFactor,
+                                Rendering rendering,
+                                QSharedPointer<ImgSource> pLoader) {
+    Request request;
+    request.filePath = filePath;
+    request.rendering = rendering;
+    if (!s_active || scaleFactor != s_scaleFactor || pLoader != s_pLoader) {
+        return renderImage(request, scaleFactor, *pLoader);
+    }
+
+    const QString key = requestKey(filePath, rendering);
+    if (!s_requestedKeys.contains(key)) {
+        s_requestedKeys.insert(key);
+        s_requests.append(request);
+    }
+    QHash<QString, QImage>::const_iterator it = s_prefetched.constFind(key);
+    if (it != s_prefetched.constEnd()) {
+        return it.value();
+    }
+
+    // Not known from the last load, keep it for the next one
+    QImage image = renderImage(request, scaleFactor, *pLoader);
+    if (!image.isNull()) {
+        s_prefetched.insert(key, image);
+        QtConcurrent::run(saveImage, image,
+                s_skinCacheDir.absoluteFilePath(imageFileName(request)));
+    }
+    return image;
+}
@@ -0,0 +1,59 @@
+#ifndef SKINIMAGECACHE_H
+#define SKINIMAGECACHE_H
+
+#include <QDir>
+#include <QImage>
+#include <QSharedPointer>
+#include <QString>
+
+#include "skin/imgsource.h"
+
+// Keeps the rasterized images of a skin, so loading the skin does not have to
+// render every SVG and run every bitmap through the color scheme on the GUI
+// thread.
+//
+// While a skin is parsed, all images that are requested from a file are
+// recorded. The next time the same skin is loaded with the same scale factor
+// and color scheme, these images are rasterized up front on the global thread
+// pool, and the parser only needs to pick them up. The rasterized images are
+// also stored on disk as PNG, keyed by the path and modification time of their
+// file, so later loads only need to decode them. Only the directories of the
+// few most recently loaded combinations of skin, scale factor and color scheme
+// are kept.
+//
+// All methods must be called from the GUI thread.
+class SkinImageCache {
+  public:
+    // How an image is produced from its file
+    enum class Rendering {
+        // Read by the image loader of the color scheme
+        Loader = 0,
+        // SVG rendered at its default size times the scale factor
+        Svg = 1,
+        // SVG rendered like above and then color corrected
+        SvgColorCorrected = 2,
+    };
+
+    // Called after the color scheme has been set up and before the widgets
+    // of the skin are created. Blocks until the images recorded during the
+    // last load of this skin are rasterized.
+    static void beginSkin(const QDir& cacheDir,
+                          const QString& skinPath,
+                          const QString& colorScheme,
+                          double scaleFactor,
+                          QSharedPointer<ImgSource> pLoader);
+    // Called after the widgets of the skin have been created. Records the
+    // images that were requested for the next load of the skin and drops the
+    // prefetched images.
+    static void endSkin();
+
+    // Returns the rasterized image or a null image if the file could not be
+    // read. Outside of beginSkin() and endSkin() the image is rendered right
+    // away.
+    static QImage getImage(const QString& filePath,
+                           double scaleFactor,
+                           Rendering rendering,
+                           QSharedPointer<ImgSource> pLoader);
+};
+
+#endif /* SKINIMAGECACHE_H */
@@ -33,6 +33,7 @@
 #include "soundio/soundmanager.h"
 #include "soundio/soundmanagerutil.h"
 #include "util/denormalsarezero.h"
+#include "util/gauge.h"
 #include "util/sample.h"
 #include "util/timer.h"
 #include "util/trace.h"
@@ -436,6 +437,10 @@ void SoundDevicePortAudio::readProcess() {
     PaStream* pStream = m_pStream;
     if (pStream && m_inputParams.channelCount && m_inputFifo) {
         int inChunkSize = m_framesPerBuffer * m_inputParams.channelCount;
+        if (CmdlineArgs::Instance().getDeveloper()) {
+            Gauge("SoundDevicePortAudio input FIFO fill").set(
+                    static_cast<double>(m_inputFifo->readAvailable()) / inChunkSize);
+        }
         if (m_syncBuffers == 0) { // "Experimental (no delay)"
 
             if (m_inputFifo->readAvailable() == 0) {
@@ -568,6 +573,10 @@ void SoundDevicePortAudio::writeProcess() {
 
     if (pStream && m_outputParams.channelCount && m_outputFifo) {
         int outChunkSize = m_framesPerBuffer * m_outputParams.channelCount;
+        if (CmdlineArgs::Instance().getDeveloper()) {
+            Gauge("SoundDevicePortAudio output FIFO fill").set(
+                    static_cast<double>(m_outputFifo->readAvailable()) / outChunkSize);
+        }
         int writeAvailable = m_outputFifo->writeAvailable();
         int writeCount = outChunkSize;
         if (outChunkSize > writeAvailable) {
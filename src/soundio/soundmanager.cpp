@@ -26,6 +26,7 @@
 
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
+#include "engine/callbackprofiler.h"
 #include "engine/enginebuffer.h"
 #include "engine/enginemaster.h"
 #include "engine/sidechain/enginenetworkstream.h"
@@ -35,6 +36,7 @@
 #include "soundio/sounddevicenotfound.h"
 #include "soundio/sounddeviceportaudio.h"
 #include "soundio/soundmanagerutil.h"
+#include "util/assert.h"
 #include "util/compatibility.h"
 #include "util/cmdlineargs.h"
 #include "util/defs.h"
@@ -60,8 +62,27 @@ struct DeviceMode {
 #ifdef __LINUX__
 const unsigned int kSleepSecondsAfterClosingDevice = 5;
 #endif
+
+#ifdef __PORTAUDIO__
+// Set by SoundManager::preinitializePortAudio() and consumed by the first
+// query for devices
+bool s_paPreinitialized = false;
+PaError s_paPreinitializeError = paNoError;
+#endif
 } // anonymous namespace
 
+// static
+void SoundManager::preinitializePortAudio() {
+#ifdef __PORTAUDIO__
+    DEBUG_ASSERT(!s_paPreinitialized);
+#ifdef Q_OS_LINUX
+    setJACKName();
+#endif
+    s_paPreinitializeError = Pa_Initialize();
+    s_paPreinitialized = true;
+#endif
+}
+
 SoundManager::SoundManager(UserSettingsPointer pConfig,
                            EngineMaster *pMaster)
         : m_pMaster(pMaster),
@@ -275,10 +296,15 @@ void SoundManager::queryDevicesPortaudio() {
 #ifdef __PORTAUDIO__
     PaError err = paNoError;
     if (!m_paInitialized) {
+        if (s_paPreinitialized) {
+            err = s_paPreinitializeError;
+            s_paPreinitialized = false;
+        } else {
 #ifdef Q_OS_LINUX
-        setJACKName();
+            setJACKName();
 #endif
-        err = Pa_Initialize();
+            err = Pa_Initialize();
+        }
         m_paInitialized = true;
     }
     if (err != paNoError) {
@@ -656,7 +682,8 @@ QList<AudioInput> SoundManager::registeredInputs() const {
     return m_registeredDestinations.keys();
 }
 
-void SoundManager::setJACKName() const {
+// static
+void SoundManager::setJACKName() {
 #ifdef __PORTAUDIO__
 #ifdef Q_OS_LINUX
     typedef PaError (*SetJackClientName)(const char *name);
@@ -691,6 +718,21 @@ int SoundManager::getConfiguredDeckCount() const {
     return m_config.getDeckCount();
 }
 
+void SoundManager::underflowHappened(int code) {
+    m_underflowHappened = 1;
+    // The engine callbacks before the underflow are logged from the main
+    // thread
+    if (m_pMaster) {
+        m_pMaster->getCallbackProfiler()->reportUnderflow();
+    }
+    // Disable the engine warnings by default, because printing a warning is a
+    // locking function that will make the problem worse
+    if (CmdlineArgs::Instance().getDeveloper()) {
+        Counter("SoundManager underflow")++;
+        qWarning() << "underflowHappened code:" << code;
+    }
+}
+
 void SoundManager::processUnderflowHappened() {
     if (m_underflowUpdateCount == 0) {
         if (load_atomic(m_underflowHappened)) {
@@ -31,6 +31,7 @@
 #include "soundio/sounddevice.h"
 #include "util/types.h"
 #include "util/cmdlineargs.h"
+#include "util/counter.h"
 
 
 class EngineMaster;
@@ -60,6 +61,16 @@ class SoundManager : public QObject {
     SoundManager(UserSettingsPointer pConfig, EngineMaster *_master);
     virtual ~SoundManager();
 
+    // Initializes PortAudio ahead of time. PortAudio probes every host API
+    // and its devices on initialization, which takes a while with some ALSA
+    // and JACK setups. It does not depend on the engine, so this may run on
+    // another thread while the engine is created, but it has to finish
+    // before the SoundManager is created. The SoundManager then uses the
+    // already initialized PortAudio when querying devices.
+    // Not used on Windows, where PortAudio must be initialized and
+    // terminated on the same thread.
+    static void preinitializePortAudio();
+
     // Returns a list of all devices we've enumerated that match the provided
     // filterApi, and have at least one output or input channel if the
     // bOutputDevices or bInputDevices are set, respectively.
@@ -116,14 +127,8 @@ class SoundManager : public QObject {
         return m_pNetworkStream;
     }
 
-    void underflowHappened(int code) {
-        m_underflowHappened = 1;
-        // Disable the engine warnings by default, because printing a warning is a
-        // locking function that will make the problem worse
-        if (CmdlineArgs::Instance().getDeveloper()) {
-            qWarning() << "underflowHappened code:" << code;
-        }
-    }
+    // Realtime safe, called from the audio callbacks
+    void underflowHappened(int code);
 
     void processUnderflowHappened();
 
@@ -143,7 +148,7 @@ class SoundManager : public QObject {
     // isn't open is safe.
     void closeDevices(bool sleepAfterClosing);
 
-    void setJACKName() const;
+    static void setJACKName();
 
     EngineMaster *m_pMaster;
     UserSettingsPointer m_pConfig;
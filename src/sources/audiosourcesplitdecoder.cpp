@@ -0,0 +1,258 @@
+#include "sources/audiosourcesplitdecoder.h"
+
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/sample.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("AudioSourceSplitDecoder");
+
+// The number of chunks per thread that may be decoded ahead of the reader,
+// so every thread can continue with the next chunk while the reader is
+// still busy with the current one
+const SINT kSlotsPerThread = 2;
+
+} // anonymous namespace
+
+/*static*/ constexpr SINT AudioSourceSplitDecoder::kDefaultChunkFrames;
+
+class AudioSourceSplitDecoder::DecodeTask: public QRunnable {
+  public:
+    DecodeTask(AudioSourceSplitDecoder* pDecoder, AudioSource* pAudioSource)
+            : m_pDecoder(pDecoder),
+              m_pAudioSource(pAudioSource) {
+    }
+
+    void run() override {
+        QThread::currentThread()->setPriority(QThread::LowPriority);
+        m_pDecoder->decodeChunks(m_pAudioSource);
+    }
+
+  private:
+    AudioSourceSplitDecoder* const m_pDecoder;
+    AudioSource* const m_pAudioSource;
+};
+
+AudioSourceSplitDecoder::AudioSourceSplitDecoder(
+        std::vector<AudioSourcePointer> audioSources,
+        SINT chunkFrames)
+        : AudioSource(*audioSources.front()),
+          m_audioSources(std::move(audioSources)),
+          m_chunkFrames(chunkFrames),
+          m_chunkCount((frameLength() + chunkFrames - 1) / chunkFrames),
+          m_closed(false),
+          m_readChunkIndex(0),
+          m_nextChunkIndex(0),
+          m_readFrameIndex(frameIndexMin()) {
+    DEBUG_ASSERT(m_chunkFrames > 0);
+    const SINT slotCount = kSlotsPerThread * m_audioSources.size();
+    m_slots.reserve(slotCount);
+    for (SINT i = 0; i < slotCount; ++i) {
+        m_slots.emplace_back(frames2samples(m_chunkFrames));
+    }
+    m_threadPool.setMaxThreadCount(m_audioSources.size());
+    for (const auto& pAudioSource: m_audioSources) {
+        DEBUG_ASSERT(pAudioSource->channelCount() == channelCount());
+        DEBUG_ASSERT(pAudioSource->frameIndexRange() == frameIndexRange());
+        // Deleted by the thread pool
+        m_threadPool.start(new DecodeTask(this, pAudioSource.get()));
+    }
+}
+
+AudioSourceSplitDecoder::~AudioSourceSplitDecoder() {
+    close();
+}
+
+void AudioSourceSplitDecoder::close() {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_closed = true;
+        m_slotChanged.wakeAll();
+    }
+    m_threadPool.waitForDone();
+    for (const auto& pAudioSource: m_audioSources) {
+        pAudioSource->close();
+    }
+}
+
+AudioSource::OpenResult AudioSourceSplitDecoder::tryOpen(
+        OpenMode mode,
+        const OpenParams& params) {
+    Q_UNUSED(mode);
+    Q_UNUSED(params);
+    // All sources have been opened before they are passed in and the
+    // threads can't be restarted
+    kLogger.warning() << "Reopening is not supported";
+    return OpenResult::Failed;
+}
+
+IndexRange AudioSourceSplitDecoder::chunkFrameIndexRange(SINT chunkIndex) const {
+    return intersect(
+            IndexRange::forward(
+                    frameIndexMin() + chunkIndex * m_chunkFrames,
+                    m_chunkFrames),
+            frameIndexRange());
+}
+
+SINT AudioSourceSplitDecoder::chunkIndexOf(SINT frameIndex) const {
+    return (frameIndex - frameIndexMin()) / m_chunkFrames;
+}
+
+void AudioSourceSplitDecoder::decodeChunks(AudioSource* pAudioSource) {
+    QMutexLocker locker(&m_mutex);
+    while (!m_closed) {
+        const SINT chunkIndex = m_nextChunkIndex;
+        if (chunkIndex >= m_chunkCount ||
+                chunkIndex >= m_readChunkIndex + SINT(m_slots.size())) {
+            // Wait for the reader
+            m_slotChanged.wait(&m_mutex);
+            continue;
+        }
+        Slot& slot = m_slots[chunkIndex % m_slots.size()];
+        if (slot.decoding || slot.chunkIndex >= 0) {
+            // Another thread still decodes a chunk that has been
+            // discarded by a restart into this slot
+            m_slotChanged.wait(&m_mutex);
+            continue;
+        }
+        ++m_nextChunkIndex;
+        slot.chunkIndex = chunkIndex;
+        slot.decoding = true;
+        slot.decodedFrames = IndexRange();
+
+        // The slot is not touched by anyone else while decoding
+        const IndexRange chunkFrames = chunkFrameIndexRange(chunkIndex);
+        locker.unlock();
+        const auto readableSampleFrames = pAudioSource->readSampleFrames(
+                WritableSampleFrames(
+                        chunkFrames,
+                        SampleBuffer::WritableSlice(
+                                slot.buffer.data(),
+                                frames2samples(chunkFrames.length()))));
+        IndexRange decodedFrames = readableSampleFrames.frameIndexRange();
+        if (decodedFrames.empty() ||
+                decodedFrames.start() != chunkFrames.start()) {
+            kLogger.warning()
+                    << "Failed to decode" << chunkFrames
+                    << ", actual frames =" << decodedFrames;
+            decodedFrames = IndexRange();
+        } else if (readableSampleFrames.readableData() != slot.buffer.data()) {
+            SampleUtil::copy(
+                    slot.buffer.data(),
+                    readableSampleFrames.readableData(),
+                    readableSampleFrames.readableLength());
+        }
+        locker.relock();
+
+        slot.decoding = false;
+        // Otherwise the chunk has been discarded in the meantime
+        if (slot.chunkIndex == chunkIndex) {
+            slot.decodedFrames = decodedFrames;
+        }
+        m_slotChanged.wakeAll();
+    }
+}
+
+void AudioSourceSplitDecoder::restartAt(SINT chunkIndex) {
+    kLogger.debug() << "Restarting decoding at chunk" << chunkIndex;
+    m_readChunkIndex = chunkIndex;
+    m_nextChunkIndex = chunkIndex;
+    for (auto& slot: m_slots) {
+        // Slots that are still being decoded into are freed when
+        // decoding has finished
+        slot.chunkIndex = -1;
+        slot.decodedFrames = IndexRange();
+    }
+    m_slotChanged.wakeAll();
+}
+
+void AudioSourceSplitDecoder::releaseChunksBefore(SINT chunkIndex) {
+    while (m_readChunkIndex < chunkIndex) {
+        Slot& slot = m_slots[m_readChunkIndex % m_slots.size()];
+        if (slot.chunkIndex == m_readChunkIndex) {
+            // A chunk that is skipped by a read ahead might still be
+            // decoded. Its slot is freed when decoding has finished.
+            slot.chunkIndex = -1;
+            slot.decodedFrames = IndexRange();
+        }
+        ++m_readChunkIndex;
+    }
+    // Chunks that have been skipped without being decoded are never
+    // needed
+    m_nextChunkIndex = math_max(m_nextChunkIndex, m_readChunkIndex);
+    m_slotChanged.wakeAll();
+}
+
+ReadableSampleFrames AudioSourceSplitDecoder::readSampleFramesClamped(
+        WritableSampleFrames sampleFrames) {
+    const IndexRange readFrames = sampleFrames.frameIndexRange();
+    QMutexLocker locker(&m_mutex);
+    if (m_closed) {
+        return ReadableSampleFrames();
+    }
+
+    const SINT firstChunkIndex = chunkIndexOf(readFrames.start());
+    if (readFrames.start() != m_readFrameIndex &&
+            (firstChunkIndex < m_readChunkIndex ||
+                    firstChunkIndex >= m_readChunkIndex + SINT(m_slots.size()))) {
+        // The chunk is neither available nor decoded ahead
+        restartAt(firstChunkIndex);
+    } else {
+        releaseChunksBefore(firstChunkIndex);
+    }
+
+    SINT frameIndex = readFrames.start();
+    while (frameIndex < readFrames.end()) {
+        const SINT chunkIndex = chunkIndexOf(frameIndex);
+        const Slot& slot = m_slots[chunkIndex % m_slots.size()];
+        while (!m_closed &&
+                (slot.chunkIndex != chunkIndex || slot.decoding)) {
+            m_slotChanged.wait(&m_mutex);
+        }
+        if (m_closed) {
+            break;
+        }
+        const IndexRange chunkFrames = chunkFrameIndexRange(chunkIndex);
+        const IndexRange copyFrames = intersect(
+                IndexRange::between(frameIndex, readFrames.end()),
+                slot.decodedFrames);
+        if (copyFrames.empty() || copyFrames.start() != frameIndex) {
+            // Decoding has failed
+            break;
+        }
+        if (sampleFrames.writableData()) {
+            SampleUtil::copy(
+                    sampleFrames.writableData(
+                            frames2samples(frameIndex - readFrames.start())),
+                    slot.buffer.data(
+                            frames2samples(frameIndex - chunkFrames.start())),
+                    frames2samples(copyFrames.length()));
+        }
+        frameIndex = copyFrames.end();
+        if (frameIndex >= chunkFrames.end()) {
+            releaseChunksBefore(chunkIndex + 1);
+        } else if (frameIndex < readFrames.end()) {
+            // The chunk has not been decoded completely
+            break;
+        }
+    }
+    m_readFrameIndex = frameIndex;
+
+    const IndexRange resultFrames =
+            IndexRange::between(readFrames.start(), frameIndex);
+    return ReadableSampleFrames(
+            resultFrames,
+            SampleBuffer::ReadableSlice(
+                    sampleFrames.writableData(),
+                    sampleFrames.writableData() ?
+                            frames2samples(resultFrames.length()) : 0));
+}
+
+} // namespace mixxx
@@ -0,0 +1,102 @@
+#ifndef MIXXX_AUDIOSOURCESPLITDECODER_H
+#define MIXXX_AUDIOSOURCESPLITDECODER_H
+
+#include <QMutex>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <vector>
+
+#include "sources/audiosource.h"
+#include "util/samplebuffer.h"
+
+namespace mixxx {
+
+// Decodes consecutive chunks of a file on multiple threads ahead of a
+// reader that reads the file from beginning to end, e.g. for analysis.
+// The chunks are returned in order, so the reader can't tell the
+// difference from reading the file directly.
+//
+// Each thread decodes with its own AudioSource of the same file and
+// seeks to the start of every chunk. The results are only identical if
+// all sources seek sample accurately.
+//
+// Skipping forward to a chunk that is already decoded ahead discards the
+// chunks in between. Reading at any other position than where the
+// previous read stopped discards all chunks that have been decoded ahead
+// and starts over at the new position.
+class AudioSourceSplitDecoder: public AudioSource {
+  public:
+    static constexpr SINT kDefaultChunkFrames = 256 * 1024;
+
+    // Takes ownership of the sources that must have all been opened for
+    // the same file with the same parameters. The properties are taken
+    // from the first source.
+    AudioSourceSplitDecoder(
+            std::vector<AudioSourcePointer> audioSources,
+            SINT chunkFrames = kDefaultChunkFrames);
+    ~AudioSourceSplitDecoder() override;
+
+    void close() override;
+
+  protected:
+    OpenResult tryOpen(
+            OpenMode mode,
+            const OpenParams& params) override;
+
+    ReadableSampleFrames readSampleFramesClamped(
+            WritableSampleFrames sampleFrames) override;
+
+  private:
+    class DecodeTask;
+
+    struct Slot {
+        explicit Slot(SINT size)
+                : buffer(size),
+                  chunkIndex(-1),
+                  decoding(false) {
+        }
+        SampleBuffer buffer;
+        // The chunk that has been decoded or is being decoded into the
+        // buffer, or -1
+        SINT chunkIndex;
+        bool decoding;
+        // The frames that have actually been decoded, shorter than the
+        // chunk if decoding failed
+        IndexRange decodedFrames;
+    };
+
+    IndexRange chunkFrameIndexRange(SINT chunkIndex) const;
+    SINT chunkIndexOf(SINT frameIndex) const;
+
+    // Run by the decoding threads until the decoder is closed
+    void decodeChunks(AudioSource* pAudioSource);
+
+    // All expect m_mutex to be locked
+    void restartAt(SINT chunkIndex);
+    void releaseChunksBefore(SINT chunkIndex);
+
+    const std::vector<AudioSourcePointer> m_audioSources;
+    const SINT m_chunkFrames;
+    const SINT m_chunkCount;
+
+    QMutex m_mutex;
+    // Signals both decoded and released chunks
+    QWaitCondition m_slotChanged;
+    bool m_closed;
+    // The first chunk that is still needed by the reader
+    SINT m_readChunkIndex;
+    // The next chunk that will be decoded by a thread
+    SINT m_nextChunkIndex;
+    // The frame index where the next read is expected
+    SINT m_readFrameIndex;
+    // Chunk i is decoded into slot (i % m_slots.size()), which limits how
+    // far the threads may decode ahead of the reader
+    std::vector<Slot> m_slots;
+
+    QThreadPool m_threadPool;
+};
+
+} // namespace mixxx
+
+#endif // MIXXX_AUDIOSOURCESPLITDECODER_H
@@ -0,0 +1,406 @@
+#include "sources/decodedaudiocache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QMap>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QTextStream>
+#include <QThread>
+#include <QtEndian>
+
+#include <cstring>
+#include <limits>
+
+#include "util/compatibility.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/samplebuffer.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("DecodedAudioCache");
+
+const QString kDecodedSuffix = ".wav";
+const QString kTemporarySuffix = ".tmp";
+const QString kIndexFileName = "index.txt";
+
+// The number of frames that are decoded and written at once
+const SINT kStoreChunkFrames = 65536;
+
+// WAVE_FORMAT_IEEE_FLOAT
+const quint16 kWavFormatFloat = 0x0003;
+const qint64 kWavHeaderSize = 44;
+
+// A single file must not evict most of the others
+const qint64 kMaxFileSizeRatio = 2;
+
+// The files are always decoded as stereo like the engine reads them. Files
+// opened with other parameters are decoded from the original file.
+const SINT kStoreChannelCount = 2;
+
+} // anonymous namespace
+
+class DecodedAudioCache::StoreTask: public QRunnable {
+  public:
+    StoreTask(DecodedAudioCache* pCache, const QString& key, const QUrl& url,
+              const SoundSourceProviderPointer& pProvider)
+            : m_pCache(pCache),
+              m_key(key),
+              m_url(url),
+              m_pProvider(pProvider) {
+    }
+
+    void run() override {
+        QThread::currentThread()->setPriority(QThread::LowestPriority);
+        // The source is created from the provider directly, because the
+        // proxy would serve it from the cache again
+        SoundSourcePointer pSoundSource = m_pProvider->newSoundSource(m_url);
+        AudioSource::OpenParams params;
+        params.setChannelCount(kStoreChannelCount);
+        if (pSoundSource &&
+                pSoundSource->open(AudioSource::OpenMode::Strict, params) ==
+                        AudioSource::OpenResult::Succeeded) {
+            m_pCache->store(m_key, pSoundSource);
+            pSoundSource->close();
+        }
+        QMutexLocker locker(&m_pCache->m_mutex);
+        m_pCache->m_pendingKeys.remove(m_key);
+    }
+
+  private:
+    DecodedAudioCache* const m_pCache;
+    const QString m_key;
+    const QUrl m_url;
+    const SoundSourceProviderPointer m_pProvider;
+};
+
+DecodedAudioCache::DecodedAudioCache(const QString& directory,
+                                     qint64 maxSizeBytes)
+        : m_directory(directory),
+          m_cancelled(0),
+          m_maxSizeBytes(maxSizeBytes),
+          m_totalSizeBytes(0),
+          m_lastUseTime(0) {
+    m_threadPool.setMaxThreadCount(1);
+    if (!m_directory.exists() && !QDir().mkpath(m_directory.absolutePath())) {
+        kLogger.warning()
+                << "Failed to create decoded audio directory"
+                << m_directory.absolutePath();
+    }
+    loadIndex();
+}
+
+DecodedAudioCache::~DecodedAudioCache() {
+    cancel();
+}
+
+void DecodedAudioCache::cancel() {
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_cancelled.fetchAndStoreOrdered(1)) {
+            return;
+        }
+    }
+    m_threadPool.waitForDone();
+    saveIndex();
+}
+
+QString DecodedAudioCache::filePath(const QString& key) const {
+    return m_directory.filePath(key + kDecodedSuffix);
+}
+
+void DecodedAudioCache::loadIndex() {
+    // Files that were in the middle of being written when Mixxx quit
+    const QStringList temporaryFiles = m_directory.entryList(
+            QStringList() << ("*" + kTemporarySuffix), QDir::Files);
+    for (const auto& fileName: temporaryFiles) {
+        QFile::remove(m_directory.filePath(fileName));
+    }
+
+    // The last use of each key. The modification time of the file is used
+    // for keys that are missing, e.g. after a crash.
+    QHash<QString, qint64> lastUsed;
+    QFile indexFile(m_directory.filePath(kIndexFileName));
+    if (indexFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QTextStream stream(&indexFile);
+        while (!stream.atEnd()) {
+            const QStringList fields = stream.readLine().split(' ');
+            if (fields.size() == 2) {
+                lastUsed.insert(fields[0], fields[1].toLongLong());
+            }
+        }
+    }
+
+    const QFileInfoList files = m_directory.entryInfoList(
+            QStringList() << ("*" + kDecodedSuffix), QDir::Files);
+    QMutexLocker locker(&m_mutex);
+    for (const auto& fileInfo: files) {
+        const QString key = fileInfo.completeBaseName();
+        Entry entry;
+        entry.sizeBytes = fileInfo.size();
+        entry.lastUsed = lastUsed.value(key,
+                fileInfo.lastModified().toMSecsSinceEpoch());
+        m_entries.insert(key, entry);
+        m_totalSizeBytes += entry.sizeBytes;
+        m_lastUseTime = math_max(m_lastUseTime, entry.lastUsed);
+    }
+}
+
+void DecodedAudioCache::saveIndex() const {
+    QFile indexFile(m_directory.filePath(kIndexFileName));
+    if (!indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate |
+            QIODevice::Text)) {
+        kLogger.warning()
+                << "Failed to write decoded audio index"
+                << indexFile.fileName();
+        return;
+    }
+    QTextStream stream(&indexFile);
+    QMutexLocker locker(&m_mutex);
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        stream << it.key() << ' ' << it.value().lastUsed << '\n';
+    }
+}
+
+void DecodedAudioCache::setMaxSizeBytes(qint64 maxSizeBytes) {
+    QMutexLocker locker(&m_mutex);
+    m_maxSizeBytes = maxSizeBytes;
+}
+
+qint64 DecodedAudioCache::totalSizeBytes() const {
+    QMutexLocker locker(&m_mutex);
+    return m_totalSizeBytes;
+}
+
+//static
+QString DecodedAudioCache::key(const QFileInfo& fileInfo,
+        const SoundSourceProviderPointer& pProvider) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(fileInfo.canonicalFilePath().toUtf8());
+    hash.addData(QByteArray::number(fileInfo.size()));
+    hash.addData(QByteArray::number(
+            fileInfo.lastModified().toMSecsSinceEpoch()));
+    hash.addData(pProvider->getName().toUtf8());
+    hash.addData(pProvider->getDecodingSettingsId().toUtf8());
+    return hash.result().toHex();
+}
+
+QString DecodedAudioCache::lookup(const QString& key) {
+    QMutexLocker locker(&m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return QString();
+    }
+    const QString path = filePath(key);
+    // The file may have been deleted or replaced by someone else
+    const QFileInfo fileInfo(path);
+    if (!fileInfo.exists() || fileInfo.size() != it.value().sizeBytes) {
+        kLogger.warning()
+                << "Removing modified decoded audio file"
+                << path;
+        removeEntry(key);
+        return QString();
+    }
+    it.value().lastUsed = nextUseTime();
+    return path;
+}
+
+void DecodedAudioCache::remove(const QString& key) {
+    QMutexLocker locker(&m_mutex);
+    removeEntry(key);
+}
+
+void DecodedAudioCache::scheduleStore(const QString& key, const QUrl& url,
+        const SoundSourceProviderPointer& pProvider) {
+    QMutexLocker locker(&m_mutex);
+    if (load_atomic(m_cancelled) ||
+            m_entries.contains(key) || m_pendingKeys.contains(key)) {
+        return;
+    }
+    m_pendingKeys.insert(key);
+    // Deleted by the thread pool
+    m_threadPool.start(new StoreTask(this, key, url, pProvider));
+}
+
+void DecodedAudioCache::waitForDone() {
+    m_threadPool.waitForDone();
+}
+
+bool DecodedAudioCache::store(const QString& key,
+        const AudioSourcePointer& pAudioSource) {
+    const IndexRange frameIndexRange = pAudioSource->frameIndexRange();
+    const SINT channelCount = pAudioSource->channelCount();
+    // The stored files always start at the first frame
+    if (frameIndexRange.start() != 0 || frameIndexRange.empty()) {
+        return false;
+    }
+    const qint64 dataSize =
+            qint64(frameIndexRange.length()) * channelCount * sizeof(float);
+    // The sizes in the WAV header are 32 bit
+    if (kWavHeaderSize + dataSize > std::numeric_limits<quint32>::max()) {
+        return false;
+    }
+    {
+        QMutexLocker locker(&m_mutex);
+        if (kWavHeaderSize + dataSize > m_maxSizeBytes / kMaxFileSizeRatio) {
+            return false;
+        }
+    }
+
+    const QString path = filePath(key);
+    // Write into a temporary file first so that concurrent readers never
+    // see a partially written file.
+    const QString tempPath = path + kTemporarySuffix;
+    QFile file(tempPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        kLogger.warning()
+                << "Failed to create decoded audio file"
+                << tempPath;
+        return false;
+    }
+    {
+        QDataStream stream(&file);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        const quint32 frameSize = channelCount * sizeof(float);
+        stream.writeRawData("RIFF", 4);
+        stream << quint32(kWavHeaderSize - 8 + dataSize);
+        stream.writeRawData("WAVE", 4);
+        stream.writeRawData("fmt ", 4);
+        stream << quint32(16) << kWavFormatFloat << quint16(channelCount)
+               << quint32(pAudioSource->sampleRate())
+               << quint32(pAudioSource->sampleRate() * frameSize)
+               << quint16(frameSize) << quint16(32);
+        stream.writeRawData("data", 4);
+        stream << quint32(dataSize);
+    }
+
+    SampleBuffer buffer(kStoreChunkFrames * channelCount);
+    bool complete = true;
+    for (SINT frameIndex = frameIndexRange.start();
+            frameIndex < frameIndexRange.end();
+            frameIndex += kStoreChunkFrames) {
+        if (load_atomic(m_cancelled)) {
+            complete = false;
+            break;
+        }
+        const auto chunkRange = IndexRange::forward(frameIndex,
+                math_min(kStoreChunkFrames, frameIndexRange.end() - frameIndex));
+        const auto readable = pAudioSource->readSampleFrames(
+                WritableSampleFrames(chunkRange,
+                        SampleBuffer::WritableSlice(buffer)));
+        if (readable.frameIndexRange() != chunkRange) {
+            kLogger.warning()
+                    << "Failed to decode" << chunkRange
+                    << "for the decoded audio file" << tempPath;
+            complete = false;
+            break;
+        }
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        // WAV files are little endian
+        for (SINT i = 0; i < readable.readableLength(); ++i) {
+            quint32 bits;
+            memcpy(&bits, readable.readableData(i), sizeof(bits));
+            qToLittleEndian(bits, reinterpret_cast<uchar*>(&buffer[i]));
+        }
+        const char* pData = reinterpret_cast<const char*>(buffer.data());
+#else
+        const char* pData =
+                reinterpret_cast<const char*>(readable.readableData());
+#endif
+        const qint64 length = readable.readableLength() * sizeof(float);
+        if (file.write(pData, length) != length) {
+            kLogger.warning()
+                    << "Failed to write decoded audio file"
+                    << tempPath;
+            complete = false;
+            break;
+        }
+    }
+    file.close();
+    if (!complete) {
+        QFile::remove(tempPath);
+        return false;
+    }
+    // QFile::rename() does not overwrite existing files
+    QFile::remove(path);
+    if (!QFile::rename(tempPath, path)) {
+        QFile::remove(tempPath);
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    insertEntry(key, kWavHeaderSize + dataSize);
+    pruneEntries();
+    return true;
+}
+
+void DecodedAudioCache::removeEntry(const QString& key) {
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return;
+    }
+    // Fails on Windows while the file is still opened for reading. The
+    // entry is dropped anyway, so the file is not served again.
+    QFile::remove(filePath(key));
+    m_totalSizeBytes -= it.value().sizeBytes;
+    m_entries.erase(it);
+}
+
+qint64 DecodedAudioCache::nextUseTime() {
+    // Strictly increasing, so the order of uses within the same
+    // millisecond is preserved
+    m_lastUseTime = math_max(m_lastUseTime + 1,
+            QDateTime::currentDateTime().toMSecsSinceEpoch());
+    return m_lastUseTime;
+}
+
+void DecodedAudioCache::insertEntry(const QString& key, qint64 sizeBytes) {
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_totalSizeBytes -= it.value().sizeBytes;
+    }
+    Entry entry;
+    entry.sizeBytes = sizeBytes;
+    entry.lastUsed = nextUseTime();
+    m_entries.insert(key, entry);
+    m_totalSizeBytes += sizeBytes;
+}
+
+void DecodedAudioCache::prune() {
+    QMutexLocker locker(&m_mutex);
+    pruneEntries();
+}
+
+void DecodedAudioCache::pruneEntries() {
+    if (m_totalSizeBytes <= m_maxSizeBytes) {
+        return;
+    }
+    // Oldest first
+    QMultiMap<qint64, QString> keysByLastUse;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        keysByLastUse.insert(it.value().lastUsed, it.key());
+    }
+    int removed = 0;
+    for (const auto& key: keysByLastUse) {
+        if (m_totalSizeBytes <= m_maxSizeBytes) {
+            break;
+        }
+        // Files that are still opened for reading can not be removed on
+        // Windows. They are kept until the next time.
+        if (QFile::remove(filePath(key))) {
+            m_totalSizeBytes -= m_entries.take(key).sizeBytes;
+            ++removed;
+        }
+    }
+    kLogger.debug()
+            << "Removed" << removed
+            << "decoded audio files, remaining size" << m_totalSizeBytes
+            << "bytes";
+}
+
+} // namespace mixxx
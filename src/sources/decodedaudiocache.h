@@ -0,0 +1,114 @@
+#ifndef MIXXX_DECODEDAUDIOCACHE_H
+#define MIXXX_DECODEDAUDIOCACHE_H
+
+#include <QAtomicInt>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+
+#include "sources/soundsourceprovider.h"
+
+namespace mixxx {
+
+// Persistent store of decoded audio for files of providers that are
+// expensive to decode, see SoundSourceProvider::isDecodingExpensive().
+// The decoded samples are stored as 32 bit float WAV files that are read
+// through SoundSourceMappedPcm instead of decoding the original file again.
+//
+// Files are decoded into the store in a background thread after they have
+// been opened once. The least recently used files are removed when the
+// total size exceeds the limit.
+//
+// All functions may be called concurrently from multiple threads.
+class DecodedAudioCache {
+  public:
+    DecodedAudioCache(const QString& directory, qint64 maxSizeBytes);
+    // Cancels all pending decodes and saves the index
+    ~DecodedAudioCache();
+
+    // Cancels all pending decodes, waits until they have finished, and
+    // saves the index. Nothing is stored afterwards, so the files may be
+    // deleted while the store is still in use.
+    void cancel();
+
+    const QDir& directory() const {
+        return m_directory;
+    }
+
+    void setMaxSizeBytes(qint64 maxSizeBytes);
+
+    qint64 totalSizeBytes() const;
+
+    // Identifies the decoded audio of a file. The key changes when the file
+    // is modified or when the provider would decode it differently.
+    static QString key(const QFileInfo& fileInfo,
+            const SoundSourceProviderPointer& pProvider);
+
+    // Returns the path of the decoded file for the key and marks it as
+    // recently used, or an empty string if the key is not stored. Keys
+    // of files that are missing or have been modified are removed.
+    QString lookup(const QString& key);
+
+    // Removes the decoded file of the key, e.g. if it could not be opened
+    void remove(const QString& key);
+
+    // Decodes the file with the provider and stores the result in a
+    // background thread, unless it is stored or being decoded already.
+    void scheduleStore(const QString& key, const QUrl& url,
+            const SoundSourceProviderPointer& pProvider);
+
+    // Waits until all scheduled decodes have finished
+    void waitForDone();
+
+    // Decodes all frames of the opened audio source into the store. Returns
+    // false if the source could not be decoded completely or if it does not
+    // fit.
+    bool store(const QString& key, const AudioSourcePointer& pAudioSource);
+
+    // Removes the least recently used files until the total size is below
+    // the limit.
+    void prune();
+
+  private:
+    class StoreTask;
+
+    struct Entry {
+        qint64 sizeBytes;
+        // Milliseconds since the epoch
+        qint64 lastUsed;
+    };
+
+    QString filePath(const QString& key) const;
+
+    void loadIndex();
+    void saveIndex() const;
+
+    // All expect m_mutex to be locked
+    qint64 nextUseTime();
+    void insertEntry(const QString& key, qint64 sizeBytes);
+    void removeEntry(const QString& key);
+    void pruneEntries();
+
+    const QDir m_directory;
+
+    // Checked between the chunks of a pending decode
+    QAtomicInt m_cancelled;
+    // Decodes files one after another with low priority, because they
+    // are not needed until the next time they are loaded
+    QThreadPool m_threadPool;
+
+    mutable QMutex m_mutex;
+    qint64 m_maxSizeBytes;
+    qint64 m_totalSizeBytes;
+    qint64 m_lastUseTime;
+    QHash<QString, Entry> m_entries;
+    QSet<QString> m_pendingKeys;
+};
+
+} // namespace mixxx
+
+#endif // MIXXX_DECODEDAUDIOCACHE_H
@@ -286,6 +286,10 @@ class SoundSourceProviderFFmpeg: public SoundSourceProvider {
         return SoundSourceProviderPriority::LOWEST;
     }
 
+    bool isDecodingExpensive() const override {
+        return true;
+    }
+
     QStringList getSupportedFileExtensions() const override;
 
     SoundSourcePointer newSoundSource(const QUrl& url) override {
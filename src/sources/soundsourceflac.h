@@ -62,6 +62,10 @@ class SoundSourceProviderFLAC: public SoundSourceProvider {
   public:
     QString getName() const override;
 
+    bool isSeekingSampleAccurate() const override {
+        return true;
+    }
+
     QStringList getSupportedFileExtensions() const override;
 
     SoundSourcePointer newSoundSource(const QUrl& url) override {
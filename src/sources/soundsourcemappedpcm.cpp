@@ -0,0 +1,498 @@
+#include "sources/soundsourcemappedpcm.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QtEndian>
+
+#include <cstring>
+
+#if defined(__WINDOWS__)
+#include <windows.h>
+#elif defined(__LINUX__)
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <sys/vfs.h>
+#elif defined(__APPLE__)
+#include <sys/mount.h>
+#include <sys/param.h>
+#endif
+
+#include "util/logger.h"
+#include "util/math.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("SoundSourceMappedPcm");
+
+// WAVE_FORMAT_PCM
+const quint16 kWavFormatPcm = 0x0001;
+// WAVE_FORMAT_IEEE_FLOAT
+const quint16 kWavFormatFloat = 0x0003;
+// WAVE_FORMAT_EXTENSIBLE, the actual format is the first field of the
+// sub format GUID
+const quint16 kWavFormatExtensible = 0xFFFE;
+
+#if defined(__LINUX__)
+// File systems from <linux/magic.h> and FUSE that are not backed by a
+// local disk
+const quint32 kNfsSuperMagic = 0x6969;
+const quint32 kSmbSuperMagic = 0x517B;
+const quint32 kCifsSuperMagic = 0xFF534D42;
+const quint32 kSmb2SuperMagic = 0xFE534D42;
+const quint32 kFuseSuperMagic = 0x65735546;
+
+bool isRemovableBlockDevice(const QString& sysfsPath) {
+    QFile file(sysfsPath + "/removable");
+    return file.open(QIODevice::ReadOnly) &&
+            file.read(1) == "1";
+}
+#endif
+
+// Reading a mapped file raises SIGBUS if the file is truncated or its
+// storage disappears, e.g. when a USB stick is pulled out, while reading
+// it with read() only fails. Files are only mapped if they are stored on a
+// local fixed disk as far as this can be told.
+bool isOnLocalFixedStorage(const QString& filePath) {
+#if defined(__WINDOWS__)
+    const QString rootPath = QDir::toNativeSeparators(
+            QFileInfo(filePath).absoluteFilePath()).left(3);
+    // UNC paths of network shares have no drive letter
+    if (!rootPath.endsWith(":\\")) {
+        return false;
+    }
+    return GetDriveTypeW(reinterpret_cast<LPCWSTR>(rootPath.utf16())) ==
+            DRIVE_FIXED;
+#elif defined(__LINUX__)
+    const QByteArray fileName = QFile::encodeName(filePath);
+    struct stat fileStat;
+    if (stat(fileName.constData(), &fileStat) != 0) {
+        return false;
+    }
+    if (major(fileStat.st_dev) == 0) {
+        // Not a block device, e.g. btrfs, tmpfs, or a network or FUSE
+        // file system
+        struct statfs fsStat;
+        if (statfs(fileName.constData(), &fsStat) != 0) {
+            return false;
+        }
+        switch (static_cast<quint32>(fsStat.f_type)) {
+        case kNfsSuperMagic:
+        case kSmbSuperMagic:
+        case kCifsSuperMagic:
+        case kSmb2SuperMagic:
+        case kFuseSuperMagic:
+            return false;
+        default:
+            return true;
+        }
+    }
+    const QString devicePath = QFileInfo(QString("/sys/dev/block/%1:%2").arg(
+            QString::number(major(fileStat.st_dev)),
+            QString::number(minor(fileStat.st_dev)))).canonicalFilePath();
+    if (devicePath.isEmpty()) {
+        return false;
+    }
+    // USB disks and SD cards are often not flagged as removable
+    if (devicePath.contains("/usb") || devicePath.contains("/mmc")) {
+        return false;
+    }
+    // Partitions are flagged by their disk
+    return !isRemovableBlockDevice(devicePath) &&
+            !isRemovableBlockDevice(devicePath + "/..");
+#elif defined(__APPLE__)
+    struct statfs fsStat;
+    if (statfs(QFile::encodeName(filePath).constData(), &fsStat) != 0) {
+        return false;
+    }
+    if (!(fsStat.f_flags & MNT_LOCAL)) {
+        return false;
+    }
+#ifdef MNT_REMOVABLE
+    if (fsStat.f_flags & MNT_REMOVABLE) {
+        return false;
+    }
+#endif
+    // External disks are mounted below /Volumes
+    return !QString::fromUtf8(fsStat.f_mntonname).startsWith("/Volumes/");
+#else
+    // The storage can't be told on other platforms. Assume the common
+    // case instead of never mapping any files there, which would also
+    // make the store of decoded audio useless.
+    Q_UNUSED(filePath);
+    return true;
+#endif
+}
+
+// The size of a chunk header in both WAV and AIFF files
+const qint64 kChunkHeaderSize = 8;
+
+bool hasChunkId(const uchar* pChunk, const char* id) {
+    return memcmp(pChunk, id, 4) == 0;
+}
+
+// Chunks are padded to an even size in both WAV and AIFF files
+qint64 nextChunkOffset(qint64 chunkOffset, quint32 chunkSize) {
+    return chunkOffset + kChunkHeaderSize + chunkSize + (chunkSize & 1);
+}
+
+// The sample rate in the COMM chunk of AIFF files is an 80 bit IEEE 754
+// extended precision number
+double readExtended(const uchar* pData) {
+    const int exponent = ((pData[0] & 0x7F) << 8) | pData[1];
+    const quint64 mantissa = qFromBigEndian<quint64>(pData + 2);
+    const double value = ldexp(static_cast<double>(mantissa),
+            exponent - 16383 - 63);
+    return (pData[0] & 0x80) ? -value : value;
+}
+
+// The int formats are normalized like libsndfile does
+const CSAMPLE kScale8 = 1.0f / 0x80;
+const CSAMPLE kScale16 = 1.0f / 0x8000;
+const CSAMPLE kScale24 = 1.0f / 0x800000;
+const CSAMPLE kScale32 = 1.0f / 0x80000000u;
+
+inline CSAMPLE readSigned8(const uchar* pSample) {
+    return static_cast<qint8>(pSample[0]) * kScale8;
+}
+
+inline CSAMPLE readUnsigned8(const uchar* pSample) {
+    return (static_cast<int>(pSample[0]) - 0x80) * kScale8;
+}
+
+inline CSAMPLE readSigned16LE(const uchar* pSample) {
+    return qFromLittleEndian<qint16>(pSample) * kScale16;
+}
+
+inline CSAMPLE readSigned16BE(const uchar* pSample) {
+    return qFromBigEndian<qint16>(pSample) * kScale16;
+}
+
+inline CSAMPLE readSigned24LE(const uchar* pSample) {
+    // Shift into the upper bytes, so the sign is extended
+    const qint32 value = static_cast<qint32>(
+            (static_cast<quint32>(pSample[0]) << 8) |
+            (static_cast<quint32>(pSample[1]) << 16) |
+            (static_cast<quint32>(pSample[2]) << 24)) >> 8;
+    return value * kScale24;
+}
+
+inline CSAMPLE readSigned24BE(const uchar* pSample) {
+    const qint32 value = static_cast<qint32>(
+            (static_cast<quint32>(pSample[2]) << 8) |
+            (static_cast<quint32>(pSample[1]) << 16) |
+            (static_cast<quint32>(pSample[0]) << 24)) >> 8;
+    return value * kScale24;
+}
+
+inline CSAMPLE readSigned32LE(const uchar* pSample) {
+    return qFromLittleEndian<qint32>(pSample) * kScale32;
+}
+
+inline CSAMPLE readSigned32BE(const uchar* pSample) {
+    return qFromBigEndian<qint32>(pSample) * kScale32;
+}
+
+inline CSAMPLE readFloat32LE(const uchar* pSample) {
+    const quint32 bits = qFromLittleEndian<quint32>(pSample);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline CSAMPLE readFloat32BE(const uchar* pSample) {
+    const quint32 bits = qFromBigEndian<quint32>(pSample);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template<CSAMPLE (*readSample)(const uchar*), SINT kSampleSize>
+void convertSamples(CSAMPLE* pDest, const uchar* pSrc, SINT sampleCount) {
+    for (SINT i = 0; i < sampleCount; ++i) {
+        pDest[i] = readSample(pSrc + i * kSampleSize);
+    }
+}
+
+} // anonymous namespace
+
+SoundSourceMappedPcm::SoundSourceMappedPcm(const QUrl& url)
+        : SoundSource(url),
+          m_pMappedData(nullptr) {
+    memset(&m_format, 0, sizeof(m_format));
+}
+
+SoundSourceMappedPcm::~SoundSourceMappedPcm() {
+    close();
+}
+
+// static
+bool SoundSourceMappedPcm::parseWav(const uchar* pData, qint64 size,
+                                    Format* pFormat) {
+    if (size < 12 || !hasChunkId(pData, "RIFF") ||
+            !hasChunkId(pData + 8, "WAVE")) {
+        return false;
+    }
+
+    bool hasFormatChunk = false;
+    quint16 formatTag = 0;
+    quint16 blockAlign = 0;
+    quint16 bitsPerSample = 0;
+    qint64 chunkOffset = 12;
+    while (chunkOffset + kChunkHeaderSize <= size) {
+        const uchar* pChunk = pData + chunkOffset;
+        const quint32 chunkSize = qFromLittleEndian<quint32>(pChunk + 4);
+        const uchar* pBody = pChunk + kChunkHeaderSize;
+        const qint64 bodyOffset = chunkOffset + kChunkHeaderSize;
+        if (hasChunkId(pChunk, "fmt ")) {
+            if (chunkSize < 16 || bodyOffset + 16 > size) {
+                return false;
+            }
+            formatTag = qFromLittleEndian<quint16>(pBody);
+            pFormat->channelCount = qFromLittleEndian<quint16>(pBody + 2);
+            pFormat->sampleRate = qFromLittleEndian<quint32>(pBody + 4);
+            blockAlign = qFromLittleEndian<quint16>(pBody + 12);
+            bitsPerSample = qFromLittleEndian<quint16>(pBody + 14);
+            if (formatTag == kWavFormatExtensible) {
+                if (chunkSize < 40 || bodyOffset + 40 > size) {
+                    return false;
+                }
+                formatTag = qFromLittleEndian<quint16>(pBody + 24);
+            }
+            hasFormatChunk = true;
+        } else if (hasChunkId(pChunk, "data")) {
+            if (!hasFormatChunk) {
+                return false;
+            }
+            pFormat->dataOffset = bodyOffset;
+            // The size may be wrong if the file was not closed properly
+            const qint64 dataSize = math_min<qint64>(chunkSize, size - bodyOffset);
+            pFormat->bigEndian = false;
+            if (formatTag == kWavFormatPcm && bitsPerSample == 8) {
+                pFormat->sampleFormat = SampleFormat::Unsigned8;
+            } else if (formatTag == kWavFormatPcm && bitsPerSample == 16) {
+                pFormat->sampleFormat = SampleFormat::Signed16;
+            } else if (formatTag == kWavFormatPcm && bitsPerSample == 24) {
+                pFormat->sampleFormat = SampleFormat::Signed24;
+            } else if (formatTag == kWavFormatPcm && bitsPerSample == 32) {
+                pFormat->sampleFormat = SampleFormat::Signed32;
+            } else if (formatTag == kWavFormatFloat && bitsPerSample == 32) {
+                pFormat->sampleFormat = SampleFormat::Float32;
+            } else {
+                return false;
+            }
+            pFormat->frameSize = pFormat->channelCount * (bitsPerSample / 8);
+            if (pFormat->frameSize == 0 || blockAlign != pFormat->frameSize) {
+                return false;
+            }
+            pFormat->frameCount = dataSize / pFormat->frameSize;
+            return true;
+        }
+        chunkOffset = nextChunkOffset(chunkOffset, chunkSize);
+    }
+    return false;
+}
+
+// static
+bool SoundSourceMappedPcm::parseAiff(const uchar* pData, qint64 size,
+                                     Format* pFormat) {
+    if (size < 12 || !hasChunkId(pData, "FORM")) {
+        return false;
+    }
+    const bool isAifc = hasChunkId(pData + 8, "AIFC");
+    if (!isAifc && !hasChunkId(pData + 8, "AIFF")) {
+        return false;
+    }
+
+    bool hasCommonChunk = false;
+    quint32 frameCount = 0;
+    quint16 bitsPerSample = 0;
+    bool isFloat = false;
+    qint64 chunkOffset = 12;
+    while (chunkOffset + kChunkHeaderSize <= size) {
+        const uchar* pChunk = pData + chunkOffset;
+        const quint32 chunkSize = qFromBigEndian<quint32>(pChunk + 4);
+        const uchar* pBody = pChunk + kChunkHeaderSize;
+        const qint64 bodyOffset = chunkOffset + kChunkHeaderSize;
+        if (hasChunkId(pChunk, "COMM")) {
+            const quint32 minSize = isAifc ? 22 : 18;
+            if (chunkSize < minSize || bodyOffset + minSize > size) {
+                return false;
+            }
+            pFormat->channelCount = qFromBigEndian<quint16>(pBody);
+            frameCount = qFromBigEndian<quint32>(pBody + 2);
+            bitsPerSample = qFromBigEndian<quint16>(pBody + 6);
+            pFormat->sampleRate = static_cast<SINT>(readExtended(pBody + 8));
+            pFormat->bigEndian = true;
+            if (isAifc) {
+                const uchar* pCompression = pBody + 18;
+                if (hasChunkId(pCompression, "sowt")) {
+                    pFormat->bigEndian = false;
+                } else if (hasChunkId(pCompression, "fl32") ||
+                        hasChunkId(pCompression, "FL32")) {
+                    isFloat = true;
+                } else if (!hasChunkId(pCompression, "NONE") &&
+                        !hasChunkId(pCompression, "twos")) {
+                    return false;
+                }
+            }
+            hasCommonChunk = true;
+        } else if (hasChunkId(pChunk, "SSND")) {
+            if (!hasCommonChunk || chunkSize < 8 || bodyOffset + 8 > size) {
+                return false;
+            }
+            const quint32 offset = qFromBigEndian<quint32>(pBody);
+            pFormat->dataOffset = bodyOffset + 8 + offset;
+            if (pFormat->dataOffset > size) {
+                return false;
+            }
+            const qint64 dataSize = math_min<qint64>(
+                    static_cast<qint64>(chunkSize) - 8 - offset,
+                    size - pFormat->dataOffset);
+            if (isFloat && bitsPerSample == 32) {
+                pFormat->sampleFormat = SampleFormat::Float32;
+            } else if (isFloat) {
+                return false;
+            } else if (bitsPerSample == 8) {
+                pFormat->sampleFormat = SampleFormat::Signed8;
+            } else if (bitsPerSample == 16) {
+                pFormat->sampleFormat = SampleFormat::Signed16;
+            } else if (bitsPerSample == 24) {
+                pFormat->sampleFormat = SampleFormat::Signed24;
+            } else if (bitsPerSample == 32) {
+                pFormat->sampleFormat = SampleFormat::Signed32;
+            } else {
+                return false;
+            }
+            pFormat->frameSize = pFormat->channelCount * (bitsPerSample / 8);
+            if (pFormat->frameSize == 0 || dataSize < 0) {
+                return false;
+            }
+            pFormat->frameCount = math_min<qint64>(
+                    frameCount, dataSize / pFormat->frameSize);
+            return true;
+        }
+        chunkOffset = nextChunkOffset(chunkOffset, chunkSize);
+    }
+    return false;
+}
+
+SoundSource::OpenResult SoundSourceMappedPcm::tryOpen(
+        OpenMode /*mode*/,
+        const OpenParams& /*params*/) {
+    DEBUG_ASSERT(!m_pMappedData);
+    if (!isOnLocalFixedStorage(getLocalFileName())) {
+        // Left to libsndfile
+        kLogger.debug()
+                << "Not mapping file on removable or network storage:"
+                << getUrlString();
+        return OpenResult::Aborted;
+    }
+    m_file.setFileName(getLocalFileName());
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        kLogger.warning() << "Failed to open file:" << getUrlString();
+        return OpenResult::Aborted;
+    }
+    const qint64 size = m_file.size();
+    m_pMappedData = m_file.map(0, size);
+    if (!m_pMappedData) {
+        // Files that do not fit into the address space are left to
+        // libsndfile
+        kLogger.debug() << "Failed to map file:" << getUrlString();
+        return OpenResult::Aborted;
+    }
+
+    if (!parseWav(m_pMappedData, size, &m_format) &&
+            !parseAiff(m_pMappedData, size, &m_format)) {
+        return OpenResult::Aborted;
+    }
+    if (m_format.channelCount <= 0 || m_format.sampleRate <= 0) {
+        return OpenResult::Aborted;
+    }
+
+    setChannelCount(m_format.channelCount);
+    setSampleRate(m_format.sampleRate);
+    initFrameIndexRangeOnce(IndexRange::forward(0, m_format.frameCount));
+    initBitrateOnce(m_format.frameSize * 8 * m_format.sampleRate / 1000);
+
+    return OpenResult::Succeeded;
+}
+
+void SoundSourceMappedPcm::close() {
+    if (m_pMappedData) {
+        m_file.unmap(const_cast<uchar*>(m_pMappedData));
+        m_pMappedData = nullptr;
+    }
+    m_file.close();
+}
+
+ReadableSampleFrames SoundSourceMappedPcm::readSampleFramesClamped(
+        WritableSampleFrames writableSampleFrames) {
+    const SINT firstFrameIndex = writableSampleFrames.frameIndexRange().start();
+    const SINT sampleCount = frames2samples(writableSampleFrames.frameLength());
+    const uchar* pSrc = m_pMappedData + m_format.dataOffset +
+            static_cast<qint64>(firstFrameIndex - frameIndexMin()) *
+                    m_format.frameSize;
+    CSAMPLE* pDest = writableSampleFrames.writableData();
+
+    switch (m_format.sampleFormat) {
+    case SampleFormat::Signed8:
+        convertSamples<readSigned8, 1>(pDest, pSrc, sampleCount);
+        break;
+    case SampleFormat::Unsigned8:
+        convertSamples<readUnsigned8, 1>(pDest, pSrc, sampleCount);
+        break;
+    case SampleFormat::Signed16:
+        if (m_format.bigEndian) {
+            convertSamples<readSigned16BE, 2>(pDest, pSrc, sampleCount);
+        } else {
+            convertSamples<readSigned16LE, 2>(pDest, pSrc, sampleCount);
+        }
+        break;
+    case SampleFormat::Signed24:
+        if (m_format.bigEndian) {
+            convertSamples<readSigned24BE, 3>(pDest, pSrc, sampleCount);
+        } else {
+            convertSamples<readSigned24LE, 3>(pDest, pSrc, sampleCount);
+        }
+        break;
+    case SampleFormat::Signed32:
+        if (m_format.bigEndian) {
+            convertSamples<readSigned32BE, 4>(pDest, pSrc, sampleCount);
+        } else {
+            convertSamples<readSigned32LE, 4>(pDest, pSrc, sampleCount);
+        }
+        break;
+    case SampleFormat::Float32:
+        if (m_format.bigEndian) {
+            convertSamples<readFloat32BE, 4>(pDest, pSrc, sampleCount);
+        } else {
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+            // The samples are already in the native format
+            memcpy(pDest, pSrc, sampleCount * sizeof(CSAMPLE));
+#else
+            convertSamples<readFloat32LE, 4>(pDest, pSrc, sampleCount);
+#endif
+        }
+        break;
+    }
+
+    return ReadableSampleFrames(
+            writableSampleFrames.frameIndexRange(),
+            SampleBuffer::ReadableSlice(pDest, sampleCount));
+}
+
+QString SoundSourceProviderMappedPcm::getName() const {
+    return "Memory-mapped PCM";
+}
+
+QStringList SoundSourceProviderMappedPcm::getSupportedFileExtensions() const {
+    QStringList supportedFileExtensions;
+    supportedFileExtensions.append("aiff");
+    supportedFileExtensions.append("aif");
+    supportedFileExtensions.append("wav");
+    return supportedFileExtensions;
+}
+
+} // namespace mixxx
@@ -0,0 +1,88 @@
+#ifndef MIXXX_SOUNDSOURCEMAPPEDPCM_H
+#define MIXXX_SOUNDSOURCEMAPPEDPCM_H
+
+#include <QFile>
+
+#include "sources/soundsourceprovider.h"
+
+namespace mixxx {
+
+// Reads uncompressed WAV and AIFF files by mapping them into memory.
+// Samples are converted straight from the mapped file into the buffer of
+// the caller, so reading needs no system calls, and seeking is free.
+//
+// Only plain integer PCM with 8, 16, 24 or 32 bits and 32 bit float are
+// supported. Anything else is left to the other providers.
+//
+// Accessing a mapped file whose storage has disappeared crashes with
+// SIGBUS instead of failing like read(). Files on removable or network
+// storage are therefore left to the other providers, too. Truncating a
+// file on a fixed disk while it is read still crashes.
+class SoundSourceMappedPcm: public SoundSource {
+  public:
+    explicit SoundSourceMappedPcm(const QUrl& url);
+    ~SoundSourceMappedPcm() override;
+
+    void close() override;
+
+  protected:
+    ReadableSampleFrames readSampleFramesClamped(
+            WritableSampleFrames sampleFrames) override;
+
+  private:
+    enum class SampleFormat {
+        Signed8,
+        Unsigned8,
+        Signed16,
+        Signed24,
+        Signed32,
+        Float32,
+    };
+
+    struct Format {
+        SampleFormat sampleFormat;
+        bool bigEndian;
+        SINT channelCount;
+        SINT sampleRate;
+        SINT frameCount;
+        // The location of the first frame in the file
+        qint64 dataOffset;
+        // The number of bytes per frame
+        SINT frameSize;
+    };
+
+    // Both return false if the file is not in the format or not supported
+    static bool parseWav(const uchar* pData, qint64 size, Format* pFormat);
+    static bool parseAiff(const uchar* pData, qint64 size, Format* pFormat);
+
+    OpenResult tryOpen(
+            OpenMode mode,
+            const OpenParams& params) override;
+
+    QFile m_file;
+    const uchar* m_pMappedData;
+    Format m_format;
+};
+
+class SoundSourceProviderMappedPcm: public SoundSourceProvider {
+  public:
+    QString getName() const override;
+
+    SoundSourceProviderPriority getPriorityHint(
+            const QString& supportedFileExtension) const override {
+        Q_UNUSED(supportedFileExtension);
+        // Preferred over libsndfile, which takes over for the formats
+        // that are not supported here
+        return SoundSourceProviderPriority::HIGHER;
+    }
+
+    QStringList getSupportedFileExtensions() const override;
+
+    SoundSourcePointer newSoundSource(const QUrl& url) override {
+        return newSoundSourceFromUrl<SoundSourceMappedPcm>(url);
+    }
+};
+
+} // namespace mixxx
+
+#endif // MIXXX_SOUNDSOURCEMAPPEDPCM_H
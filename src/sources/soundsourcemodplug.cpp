@@ -55,6 +55,17 @@ void SoundSourceModPlug::configure(unsigned int bufferSizeLimit,
     ModPlug::ModPlug_SetSettings(&settings);
 }
 
+QString SoundSourceModPlug::getSettingsId() {
+    ModPlug::ModPlug_Settings settings;
+    ModPlug::ModPlug_GetSettings(&settings);
+    // The settings only consist of int fields without padding
+    const QByteArray settingsData(
+            reinterpret_cast<const char*>(&settings), sizeof(settings));
+    return QString("%1-%2").arg(
+            QString(settingsData.toHex()),
+            QString::number(s_bufferSizeLimit));
+}
+
 SoundSourceModPlug::SoundSourceModPlug(const QUrl& url)
         : SoundSource(url, getModPlugTypeFromUrl(url)),
           m_pModFile(nullptr) {
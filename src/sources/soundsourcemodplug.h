@@ -23,6 +23,8 @@ class SoundSourceModPlug: public SoundSource {
     // apply settings for decoding
     static void configure(unsigned int bufferSizeLimit,
             const ModPlug::ModPlug_Settings &settings);
+    // identifies the settings applied by configure()
+    static QString getSettingsId();
 
     explicit SoundSourceModPlug(const QUrl& url);
     ~SoundSourceModPlug() override;
@@ -55,6 +57,15 @@ class SoundSourceProviderModPlug: public SoundSourceProvider {
 public:
     QString getName() const override;
 
+    // Modules are rendered completely when they are opened
+    bool isDecodingExpensive() const override {
+        return true;
+    }
+
+    QString getDecodingSettingsId() const override {
+        return SoundSourceModPlug::getSettingsId();
+    }
+
     QStringList getSupportedFileExtensions() const override;
 
     SoundSourcePointer newSoundSource(const QUrl& url) override {
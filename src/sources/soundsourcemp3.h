@@ -79,6 +79,10 @@ class SoundSourceProviderMp3: public SoundSourceProvider {
   public:
     QString getName() const override;
 
+    bool isSeekingSampleAccurate() const override {
+        return true;
+    }
+
     QStringList getSupportedFileExtensions() const override;
 
     SoundSourcePointer newSoundSource(const QUrl& url) override {
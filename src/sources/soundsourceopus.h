@@ -51,6 +51,10 @@ class SoundSourceProviderOpus: public SoundSourceProvider {
   public:
     QString getName() const override;
 
+    bool isDecodingExpensive() const override {
+        return true;
+    }
+
     QStringList getSupportedFileExtensions() const override;
 
     SoundSourcePointer newSoundSource(const QUrl& url) override {
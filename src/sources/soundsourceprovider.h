@@ -48,6 +48,27 @@ public:
         return SoundSourceProviderPriority::DEFAULT;
     }
 
+    // Decoding is so expensive compared to reading decoded samples from
+    // disk that it is worth storing the decoded audio of recently opened
+    // files, see DecodedAudioCache.
+    virtual bool isDecodingExpensive() const {
+        return false;
+    }
+
+    // Seeking to any frame and decoding from there produces exactly the
+    // same samples as decoding the file from the beginning. Disjoint
+    // ranges of the file may then be decoded concurrently, see
+    // AudioSourceSplitDecoder.
+    virtual bool isSeekingSampleAccurate() const {
+        return false;
+    }
+
+    // Identifies the current settings that affect the decoded audio. The
+    // decoded audio of files is only reused while this does not change.
+    virtual QString getDecodingSettingsId() const {
+        return QString();
+    }
+
     // Creates a new SoundSource for the file referenced by the URL.
     // This function should return a nullptr pointer if it is already
     // able to decide that the file is not supported even though it
@@ -3,6 +3,7 @@
 
 #include "sources/soundsourceproxy.h"
 
+#include "sources/audiosourcesplitdecoder.h"
 #include "sources/audiosourcetrackproxy.h"
 
 #ifdef __MAD__
@@ -25,6 +26,7 @@
 #include "sources/soundsourcemodplug.h"
 #endif
 #include "sources/soundsourceflac.h"
+#include "sources/soundsourcemappedpcm.h"
 
 #include "library/coverartutils.h"
 #include "library/coverartcache.h"
@@ -37,6 +39,10 @@
 /*static*/ mixxx::SoundSourceProviderRegistry SoundSourceProxy::s_soundSourceProviders;
 /*static*/ QStringList SoundSourceProxy::s_supportedFileNamePatterns;
 /*static*/ QRegExp SoundSourceProxy::s_supportedFileNamesRegex;
+/*static*/ QMutex SoundSourceProxy::s_decodedAudioCacheMutex;
+/*static*/ std::shared_ptr<mixxx::DecodedAudioCache> SoundSourceProxy::s_pDecodedAudioCache;
+
+/*static*/ const int SoundSourceProxy::kDefaultDecodedAudioCacheSizeMB = 4096;
 
 namespace {
 
@@ -162,6 +168,8 @@ void SoundSourceProxy::loadPlugins() {
 #endif
     s_soundSourceProviders.registerProvider(
             std::make_shared<mixxx::SoundSourceProviderFLAC>());
+    s_soundSourceProviders.registerProvider(
+            std::make_shared<mixxx::SoundSourceProviderMappedPcm>());
     s_soundSourceProviders.registerProvider(
             std::make_shared<mixxx::SoundSourceProviderOggVorbis>());
 #ifdef __OPUS__
@@ -275,6 +283,61 @@ bool SoundSourceProxy::isFileExtensionSupported(const QString& fileExtension) {
     return !s_soundSourceProviders.getRegistrationsForFileExtension(fileExtension).isEmpty();
 }
 
+// static
+void SoundSourceProxy::configureDecodedAudioCache(UserSettingsPointer pConfig) {
+    const QString directory =
+            QDir(pConfig->getSettingsPath()).filePath("decodedaudio");
+    if (!pConfig->getValue(
+            ConfigKey("[Library]", "DecodedAudioCacheEnabled"), false)) {
+        disableDecodedAudioCache();
+        // Don't keep up to the configured size on disk when disabled. The
+        // directory only contains files.
+        QDir dir(directory);
+        if (dir.exists()) {
+            for (const auto& fileName: dir.entryList(QDir::Files)) {
+                QFile::remove(dir.filePath(fileName));
+            }
+            if (!dir.rmdir(dir.absolutePath())) {
+                kLogger.warning()
+                        << "Failed to delete the decoded audio in"
+                        << directory;
+            }
+        }
+        return;
+    }
+    const qint64 maxSizeBytes = pConfig->getValue<int>(
+            ConfigKey("[Library]", "DecodedAudioCacheSizeMB"),
+            kDefaultDecodedAudioCacheSizeMB) * qint64(1024 * 1024);
+    QMutexLocker locker(&s_decodedAudioCacheMutex);
+    if (s_pDecodedAudioCache) {
+        s_pDecodedAudioCache->setMaxSizeBytes(maxSizeBytes);
+        s_pDecodedAudioCache->prune();
+    } else {
+        s_pDecodedAudioCache = std::make_shared<mixxx::DecodedAudioCache>(
+                directory, maxSizeBytes);
+    }
+}
+
+// static
+void SoundSourceProxy::disableDecodedAudioCache() {
+    std::shared_ptr<mixxx::DecodedAudioCache> pDecodedAudioCache;
+    {
+        QMutexLocker locker(&s_decodedAudioCacheMutex);
+        pDecodedAudioCache.swap(s_pDecodedAudioCache);
+    }
+    if (pDecodedAudioCache) {
+        // Proxies that still use the store may continue to read from it,
+        // but nothing is written anymore
+        pDecodedAudioCache->cancel();
+    }
+}
+
+// static
+std::shared_ptr<mixxx::DecodedAudioCache> SoundSourceProxy::getDecodedAudioCache() {
+    QMutexLocker locker(&s_decodedAudioCacheMutex);
+    return s_pDecodedAudioCache;
+}
+
 // static
 QList<mixxx::SoundSourceProviderRegistration>
 SoundSourceProxy::findSoundSourceProviderRegistrations(
@@ -348,7 +411,8 @@ SoundSourceProxy::SoundSourceProxy(
     : m_pTrack(std::move(pTrack)),
       m_url(getCanonicalUrlForTrack(m_pTrack.get())),
       m_soundSourceProviderRegistrations(findSoundSourceProviderRegistrations(m_url)),
-      m_soundSourceProviderRegistrationIndex(0) {
+      m_soundSourceProviderRegistrationIndex(0),
+      m_storeDecodedAudio(false) {
     initSoundSource();
 }
 
@@ -356,7 +420,8 @@ SoundSourceProxy::SoundSourceProxy(
         const QUrl& url)
     : m_url(url),
       m_soundSourceProviderRegistrations(findSoundSourceProviderRegistrations(m_url)),
-      m_soundSourceProviderRegistrationIndex(0) {
+      m_soundSourceProviderRegistrationIndex(0),
+      m_storeDecodedAudio(false) {
     initSoundSource();
 }
 
@@ -616,8 +681,77 @@ QImage SoundSourceProxy::importCoverImage() const {
     return QImage();
 }
 
+bool SoundSourceProxy::openDecodedAudioSource(
+        mixxx::DecodedAudioCache* pDecodedAudioCache,
+        const mixxx::AudioSource::OpenParams& params) {
+    DEBUG_ASSERT(!m_pAudioSource);
+    const QString key = mixxx::DecodedAudioCache::key(
+            QFileInfo(getUrl().toLocalFile()), getSoundSourceProvider());
+    const QString filePath = pDecodedAudioCache->lookup(key);
+    if (filePath.isEmpty()) {
+        return false;
+    }
+    auto pDecodedSoundSource = std::make_shared<mixxx::SoundSourceMappedPcm>(
+            QUrl::fromLocalFile(filePath));
+    if (pDecodedSoundSource->open(mixxx::SoundSource::OpenMode::Strict, params) !=
+            mixxx::SoundSource::OpenResult::Succeeded) {
+        kLogger.warning() << "Failed to open decoded audio"
+                << filePath
+                << "of file"
+                << getUrl().toString();
+        // Decode it again instead of failing every time
+        pDecodedAudioCache->remove(key);
+        return false;
+    }
+    // The decoded audio has been stored with the default properties and
+    // can't be converted
+    if ((params.channelCount().valid() &&
+                    params.channelCount() != pDecodedSoundSource->channelCount()) ||
+            (params.sampleRate().valid() &&
+                    params.sampleRate() != pDecodedSoundSource->sampleRate())) {
+        pDecodedSoundSource->close();
+        return false;
+    }
+    kLogger.debug() << "Opening decoded audio"
+            << filePath
+            << "of file"
+            << getUrl().toString();
+    m_pDecodedSoundSource = pDecodedSoundSource;
+    m_pAudioSource = mixxx::AudioSourceTrackProxy::create(m_pTrack, m_pDecodedSoundSource);
+    updateTrackFromAudioSource();
+    return true;
+}
+
+void SoundSourceProxy::updateTrackFromAudioSource() {
+    DEBUG_ASSERT(m_pAudioSource);
+    if (!m_pTrack) {
+        return;
+    }
+    DEBUG_ASSERT(m_pAudioSource->channelCount().valid());
+    m_pTrack->setChannels(m_pAudioSource->channelCount());
+    DEBUG_ASSERT(m_pAudioSource->sampleRate().valid());
+    m_pTrack->setSampleRate(m_pAudioSource->sampleRate());
+    if (m_pAudioSource->hasDuration()) {
+        // optional property
+        m_pTrack->setDuration(m_pAudioSource->getDuration());
+    }
+    // The bitrate of the decoded audio is not the one of the file
+    if (!m_pDecodedSoundSource &&
+            (m_pAudioSource->bitrate() != mixxx::AudioSource::Bitrate())) {
+        // optional property
+        m_pTrack->setBitrate(m_pAudioSource->bitrate());
+    }
+}
+
 mixxx::AudioSourcePointer SoundSourceProxy::openAudioSource(const mixxx::AudioSource::OpenParams& params) {
     DEBUG_ASSERT(m_pTrack);
+    const std::shared_ptr<mixxx::DecodedAudioCache> pDecodedAudioCache =
+            getDecodedAudioCache();
+    if (pDecodedAudioCache && m_pSoundSource && !m_pAudioSource &&
+            getSoundSourceProvider()->isDecodingExpensive() &&
+            openDecodedAudioSource(pDecodedAudioCache.get(), params)) {
+        return m_pAudioSource;
+    }
     auto openMode = mixxx::SoundSource::OpenMode::Strict;
     while (m_pSoundSource && !m_pAudioSource) {
         // NOTE(uklotzde): Log unconditionally (with debug level) to
@@ -659,19 +793,17 @@ mixxx::AudioSourcePointer SoundSourceProxy::openAudioSource(const mixxx::AudioSo
                            << getUrl().toString();
             }
             // Overwrite metadata with actual audio properties
-            if (m_pTrack) {
-                DEBUG_ASSERT(m_pAudioSource->channelCount().valid());
-                m_pTrack->setChannels(m_pAudioSource->channelCount());
-                DEBUG_ASSERT(m_pAudioSource->sampleRate().valid());
-                m_pTrack->setSampleRate(m_pAudioSource->sampleRate());
-                if (m_pAudioSource->hasDuration()) {
-                    // optional property
-                    m_pTrack->setDuration(m_pAudioSource->getDuration());
-                }
-                if (m_pAudioSource->bitrate() != mixxx::AudioSource::Bitrate()) {
-                    // optional property
-                    m_pTrack->setBitrate(m_pAudioSource->bitrate());
-                }
+            updateTrackFromAudioSource();
+            if (pDecodedAudioCache && m_storeDecodedAudio &&
+                    getSoundSourceProvider()->isDecodingExpensive()) {
+                // Decode the file again in the background, so the decoded
+                // audio can be opened instead the next time
+                pDecodedAudioCache->scheduleStore(
+                        mixxx::DecodedAudioCache::key(
+                                QFileInfo(getUrl().toLocalFile()),
+                                getSoundSourceProvider()),
+                        getUrl(),
+                        getSoundSourceProvider());
             }
         } else {
             kLogger.warning() << "Failed to open file"
@@ -695,11 +827,55 @@ mixxx::AudioSourcePointer SoundSourceProxy::openAudioSource(const mixxx::AudioSo
     return m_pAudioSource;
 }
 
+mixxx::AudioSourcePointer SoundSourceProxy::openAudioSourceForSplitDecoding(
+        const mixxx::AudioSource::OpenParams& params,
+        int threadCount) {
+    const mixxx::AudioSourcePointer pAudioSource = openAudioSource(params);
+    if (!pAudioSource || (threadCount < 2) || m_pDecodedSoundSource ||
+            !getSoundSourceProvider()->isSeekingSampleAccurate() ||
+            (pAudioSource->frameLength() <
+                    2 * mixxx::AudioSourceSplitDecoder::kDefaultChunkFrames)) {
+        return pAudioSource;
+    }
+    // Every thread decodes with its own SoundSource of the same file
+    std::vector<mixxx::AudioSourcePointer> audioSources;
+    audioSources.push_back(pAudioSource);
+    const mixxx::SoundSourceProviderPointer pProvider = getSoundSourceProvider();
+    while (audioSources.size() < static_cast<size_t>(threadCount)) {
+        const mixxx::SoundSourcePointer pSoundSource =
+                pProvider->newSoundSource(m_url);
+        if (!pSoundSource ||
+                (pSoundSource->open(mixxx::SoundSource::OpenMode::Strict, params) !=
+                        mixxx::SoundSource::OpenResult::Succeeded)) {
+            break;
+        }
+        if ((pSoundSource->channelCount() != pAudioSource->channelCount()) ||
+                (pSoundSource->frameIndexRange() != pAudioSource->frameIndexRange())) {
+            pSoundSource->close();
+            break;
+        }
+        audioSources.push_back(
+                mixxx::AudioSourceTrackProxy::create(m_pTrack, pSoundSource));
+    }
+    if (audioSources.size() < 2) {
+        return pAudioSource;
+    }
+    kLogger.debug() << "Decoding file"
+            << getUrl().toString()
+            << "on"
+            << audioSources.size()
+            << "threads";
+    m_pAudioSource = std::make_shared<mixxx::AudioSourceSplitDecoder>(
+            std::move(audioSources));
+    return m_pAudioSource;
+}
+
 void SoundSourceProxy::closeAudioSource() {
     if (m_pAudioSource) {
-        DEBUG_ASSERT(m_pSoundSource);
-        m_pSoundSource->close();
+        // Closes m_pSoundSource or the sources that have replaced it
+        m_pAudioSource->close();
         m_pAudioSource = mixxx::AudioSourcePointer();
+        m_pDecodedSoundSource = mixxx::SoundSourcePointer();
         if (kLogger.debugEnabled()) {
             kLogger.debug() << "Closed AudioSource for file"
                     << getUrl().toString();
@@ -1,8 +1,12 @@
 #ifndef MIXXX_SOURCES_SOUNDSOURCEPROXY_H
 #define MIXXX_SOURCES_SOUNDSOURCEPROXY_H
 
+#include <QMutex>
+
 #include "track/track.h"
 
+#include "preferences/usersettings.h"
+#include "sources/decodedaudiocache.h"
 #include "sources/soundsourceproviderregistry.h"
 
 
@@ -27,6 +31,22 @@ class SoundSourceProxy {
         return s_supportedFileNamesRegex;
     }
 
+    static const int kDefaultDecodedAudioCacheSizeMB;
+
+    // Enables, resizes, or disables the store of decoded audio for
+    // providers that are expensive to decode according to the
+    // [Library],DecodedAudioCacheEnabled and DecodedAudioCacheSizeMB
+    // settings. Files loaded into a deck while it is enabled are decoded
+    // into the store in the background and are read from there the next
+    // time. Disabling it deletes all stored files.
+    static void configureDecodedAudioCache(UserSettingsPointer pConfig);
+    // Cancels and waits for a pending decode into the store. Proxies
+    // that have obtained the store before may still read from it, but
+    // no files are written into its directory afterwards.
+    static void disableDecodedAudioCache();
+    // The store of decoded audio, or nullptr if it is disabled
+    static std::shared_ptr<mixxx::DecodedAudioCache> getDecodedAudioCache();
+
     static bool isUrlSupported(const QUrl& url);
     static bool isFileSupported(const QFileInfo& fileInfo);
     static bool isFileNameSupported(const QString& fileName);
@@ -103,6 +123,23 @@ class SoundSourceProxy {
     mixxx::AudioSourcePointer openAudioSource(
             const mixxx::AudioSource::OpenParams& params = mixxx::AudioSource::OpenParams());
 
+    // Requests that openAudioSource() decodes the file into the store of
+    // decoded audio in the background if it is not stored yet. Only set
+    // when loading a track into a deck, because the store is meant for
+    // tracks that are played again. Other readers, e.g. the analysis,
+    // would fill it with tracks that are never loaded.
+    void setStoreDecodedAudio(bool storeDecodedAudio) {
+        m_storeDecodedAudio = storeDecodedAudio;
+    }
+
+    // Like openAudioSource(), but decodes consecutive chunks of the file
+    // on the given number of threads ahead of the reader if the SoundSource
+    // seeks sample accurately. Intended for reading the whole file from
+    // beginning to end, e.g. for analysis.
+    mixxx::AudioSourcePointer openAudioSourceForSplitDecoding(
+            const mixxx::AudioSource::OpenParams& params,
+            int threadCount);
+
     void closeAudioSource();
 
   private:
@@ -110,6 +147,9 @@ class SoundSourceProxy {
     static QStringList s_supportedFileNamePatterns;
     static QRegExp s_supportedFileNamesRegex;
 
+    static QMutex s_decodedAudioCacheMutex;
+    static std::shared_ptr<mixxx::DecodedAudioCache> s_pDecodedAudioCache;
+
     friend class TrackCollection;
     static Track::ExportMetadataResult exportTrackMetadataBeforeSaving(Track* pTrack);
 
@@ -131,10 +171,21 @@ class SoundSourceProxy {
     const QList<mixxx::SoundSourceProviderRegistration> m_soundSourceProviderRegistrations;
     int m_soundSourceProviderRegistrationIndex;
 
+    bool m_storeDecodedAudio;
+
     void nextSoundSourceProvider();
 
     void initSoundSource();
 
+    // Opens the decoded audio of the file from the store instead of the
+    // actual SoundSource if available
+    bool openDecodedAudioSource(
+            mixxx::DecodedAudioCache* pDecodedAudioCache,
+            const mixxx::AudioSource::OpenParams& params);
+
+    // Overwrites the metadata of the track with the actual audio properties
+    void updateTrackFromAudioSource();
+
     // This pointer must stay in this class together with
     // the corresponding track pointer. Don't pass it around!!
     mixxx::SoundSourcePointer m_pSoundSource;
@@ -144,6 +195,10 @@ class SoundSourceProxy {
     // because internally it contains a reference to the TIO
     // that keeps it alive.
     mixxx::AudioSourcePointer m_pAudioSource;
+
+    // Replaces m_pSoundSource for reading if the decoded audio has
+    // been opened from the store
+    mixxx::SoundSourcePointer m_pDecodedSoundSource;
 };
 
 #endif // MIXXX_SOURCES_SOUNDSOURCEPROXY_H
@@ -98,7 +98,7 @@ class MockPlayerManager : public PlayerManagerInterface {
     MOCK_CONST_METHOD1(getPlayer, BaseTrackPlayer*(QString));
     MOCK_CONST_METHOD1(getDeck, Deck*(unsigned int));
     MOCK_CONST_METHOD1(getPreviewDeck, PreviewDeck*(unsigned int));
-    MOCK_CONST_METHOD1(getSampler, Sampler*(unsigned int));
+    MOCK_CONST_METHOD1(getSampler, BaseTrackPlayer*(unsigned int));
 
     unsigned int numberOfDecks() const {
         return static_cast<unsigned int>(numDecks.get());
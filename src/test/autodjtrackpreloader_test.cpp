@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "library/autodj/autodjtrackpreloader.h"
+#include "test/librarytest.h"
+
+namespace {
+
+const QString kTrackLocationTest(QDir::currentPath() +
+                                 "/src/test/id3-test-data/cover-test-png.mp3");
+const int kTimeoutMillis = 5000;
+
+class AutoDJTrackPreloaderTest : public LibraryTest {
+  protected:
+    AutoDJTrackPreloaderTest()
+            : m_preloader(nullptr, config(), dbConnectionPool()),
+              m_startedSpy(&m_preloader, SIGNAL(preloadStarted(TrackId))),
+              m_finishedSpy(&m_preloader,
+                      SIGNAL(preloadFinished(TrackId, bool))) {
+    }
+
+    TrackPointer addTrackToCollection(const QString& trackLocation) {
+        return collection()->getTrackDAO().addSingleTrack(trackLocation, false);
+    }
+
+    // Processes events until count preloads have finished
+    bool waitForFinishedPreloads(int count) {
+        for (int waitedMillis = 0; m_finishedSpy.count() < count &&
+                waitedMillis < kTimeoutMillis; waitedMillis += 10) {
+            QTest::qWait(10);
+        }
+        return m_finishedSpy.count() >= count;
+    }
+
+    TrackId startedTrackId(int index) const {
+        return m_startedSpy.at(index).at(0).value<TrackId>();
+    }
+
+    TrackId finishedTrackId(int index) const {
+        return m_finishedSpy.at(index).at(0).value<TrackId>();
+    }
+
+    bool finishedCancelled(int index) const {
+        return m_finishedSpy.at(index).at(1).toBool();
+    }
+
+    AutoDJTrackPreloader m_preloader;
+    QSignalSpy m_startedSpy;
+    QSignalSpy m_finishedSpy;
+};
+
+TEST_F(AutoDJTrackPreloaderTest, preloadTrack) {
+    TrackPointer pTrack = addTrackToCollection(kTrackLocationTest);
+    ASSERT_FALSE(!pTrack);
+
+    m_preloader.preloadTrack(pTrack);
+    ASSERT_EQ(1, m_startedSpy.count());
+    EXPECT_EQ(pTrack->getId(), startedTrackId(0));
+
+    ASSERT_TRUE(waitForFinishedPreloads(1));
+    EXPECT_EQ(pTrack->getId(), finishedTrackId(0));
+    EXPECT_FALSE(finishedCancelled(0));
+    EXPECT_EQ(pTrack, m_preloader.getPreloadedTrack());
+}
+
+TEST_F(AutoDJTrackPreloaderTest, cancelPreloadOfEjectedTrack) {
+    TrackPointer pTrack = addTrackToCollection(kTrackLocationTest);
+    ASSERT_FALSE(!pTrack);
+
+    m_preloader.preloadTrack(pTrack);
+    ASSERT_EQ(1, m_startedSpy.count());
+    EXPECT_EQ(pTrack->getId(), startedTrackId(0));
+
+    // Ejected before the results have been received
+    m_preloader.preloadTrack(TrackPointer());
+    EXPECT_FALSE(m_preloader.getPreloadedTrack());
+
+    ASSERT_TRUE(waitForFinishedPreloads(1));
+    EXPECT_EQ(pTrack->getId(), finishedTrackId(0));
+    EXPECT_TRUE(finishedCancelled(0));
+    // Nothing else has been started
+    EXPECT_EQ(1, m_startedSpy.count());
+}
+
+TEST_F(AutoDJTrackPreloaderTest, replaceTrackWhilePreloading) {
+    TrackPointer pTrack = addTrackToCollection(kTrackLocationTest);
+    ASSERT_FALSE(!pTrack);
+    TrackPointer pNextTrack = addTrackToCollection(QDir::currentPath() +
+            "/src/test/id3-test-data/cover-test-jpg.mp3");
+    ASSERT_FALSE(!pNextTrack);
+
+    m_preloader.preloadTrack(pTrack);
+    m_preloader.preloadTrack(pNextTrack);
+    // The next track waits until the first preload has stopped
+    EXPECT_EQ(1, m_startedSpy.count());
+
+    ASSERT_TRUE(waitForFinishedPreloads(2));
+    EXPECT_EQ(pTrack->getId(), finishedTrackId(0));
+    EXPECT_TRUE(finishedCancelled(0));
+    ASSERT_EQ(2, m_startedSpy.count());
+    EXPECT_EQ(pNextTrack->getId(), startedTrackId(1));
+    EXPECT_EQ(pNextTrack->getId(), finishedTrackId(1));
+    EXPECT_FALSE(finishedCancelled(1));
+    EXPECT_EQ(pNextTrack, m_preloader.getPreloadedTrack());
+}
+
+} // anonymous namespace
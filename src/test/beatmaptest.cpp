@@ -294,4 +294,31 @@ TEST_F(BeatMapTest, TestBpmAround) {
     EXPECT_DOUBLE_EQ(filebpm, pMap->getBpmAroundPosition(1 * approx_beat_length, 4));
 }
 
+TEST_F(BeatMapTest, IteratorKeepsSnapshotDuringEdits) {
+    const double bpm = 60.0;
+    m_pTrack->setBpm(bpm);
+    m_pTrack->setSampleRate(m_iSampleRate);
+    double beatLengthFrames = getBeatLengthFrames(bpm);
+    double beatLengthSamples = getBeatLengthSamples(bpm);
+    const int numBeats = 4;
+    QVector<double> beats = createBeatVector(0, numBeats, beatLengthFrames);
+    auto pMap = std::make_unique<BeatMap>(*m_pTrack, 0, beats);
+
+    auto pIterator = pMap->findBeats(0, (numBeats - 1) * beatLengthSamples);
+    ASSERT_TRUE(pIterator);
+    // Edits publish a new snapshot and leave the iterated one alone
+    pMap->translate(beatLengthSamples / 2);
+    pMap->removeBeat(beatLengthSamples / 2);
+
+    for (int i = 0; i < numBeats; ++i) {
+        ASSERT_TRUE(pIterator->hasNext());
+        EXPECT_DOUBLE_EQ(i * beatLengthSamples, pIterator->next());
+    }
+    EXPECT_FALSE(pIterator->hasNext());
+
+    // New queries see the edited beats
+    EXPECT_DOUBLE_EQ(beatLengthSamples * 3 / 2,
+                     pMap->findNextBeat(beatLengthSamples));
+}
+
 }  // namespace
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <QTest>
+
+#include "control/controlobject.h"
+#include "engine/callbackprofiler.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+const QString kGroup = "[CallbackProfilerTest]";
+
+class CallbackProfilerTest : public MixxxTest {
+  protected:
+    double budgetUsage(const char* stage) const {
+        return ControlObject::get(ConfigKey(kGroup,
+                QString("audio_budget_%1").arg(stage)));
+    }
+
+    CallbackProfiler m_profiler{kGroup};
+};
+
+TEST_F(CallbackProfilerTest, NestedStagesAreExclusive) {
+    {
+        // A budget of one second, the controls are updated right away
+        CallbackProfiler::CallbackScope callback(&m_profiler, 44100, 44100);
+        CallbackProfiler::StageScope scaler(CallbackProfiler::Stage::Scaler);
+        {
+            CallbackProfiler::StageScope reader(CallbackProfiler::Stage::Reader);
+            QTest::qSleep(20); // millis
+        }
+    }
+
+    EXPECT_GE(budgetUsage("reader"), 0.02);
+    EXPECT_LT(budgetUsage("scaler"), budgetUsage("reader"));
+    EXPECT_LT(budgetUsage("effects"), budgetUsage("reader"));
+}
+
+TEST_F(CallbackProfilerTest, UnattributedTimeIsMixing) {
+    {
+        CallbackProfiler::CallbackScope callback(&m_profiler, 44100, 44100);
+        QTest::qSleep(20); // millis
+    }
+
+    EXPECT_GE(budgetUsage("mixing"), 0.02);
+    EXPECT_EQ(0.0, budgetUsage("reader"));
+    EXPECT_EQ(0.0, budgetUsage("sidechain"));
+}
+
+TEST_F(CallbackProfilerTest, StagesOutsideOfCallbacksAreIgnored) {
+    {
+        CallbackProfiler::StageScope effects(CallbackProfiler::Stage::Effects);
+        QTest::qSleep(5); // millis
+    }
+    {
+        CallbackProfiler::CallbackScope callback(&m_profiler, 44100, 44100);
+    }
+
+    EXPECT_EQ(0.0, budgetUsage("effects"));
+}
+
+}  // namespace
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <QBuffer>
+
+#include "util/chrometrace.h"
+
+namespace {
+
+StatReport makeReport(Stat::StatType type, qint64 timeNanos, double value) {
+    StatReport report;
+    report.tag = nullptr;
+    report.type = type;
+    report.compute = Stat::NONE;
+    report.time = timeNanos;
+    report.value = value;
+    return report;
+}
+
+QString writeTrace(const ChromeTrace& trace) {
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    EXPECT_TRUE(trace.write(&buffer));
+    return QString::fromUtf8(buffer.data());
+}
+
+TEST(ChromeTraceTest, ThreadNamesAndNestedSlices) {
+    ChromeTrace trace;
+    trace.setThreadName(1, "Engine \"1\"");
+    trace.addReport(1, "outer", makeReport(Stat::EVENT_START, 1000, 0));
+    trace.addReport(1, "inner", makeReport(Stat::DURATION_NANOSEC, 3000, 1000));
+    trace.addReport(1, "outer", makeReport(Stat::EVENT_END, 4000, 0));
+    // Reported by Trace in addition to the start and end events
+    trace.addReport(1, "outer_duration", makeReport(Stat::DURATION_NANOSEC, 4000, 3000));
+
+    const QString json = writeTrace(trace);
+    EXPECT_TRUE(json.contains(
+            "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":1,"
+            "\"ts\":0.000,\"args\":{\"name\":\"Engine \\\"1\\\"\"}}"));
+    EXPECT_TRUE(json.contains(
+            "{\"ph\":\"B\",\"name\":\"outer\",\"pid\":1,\"tid\":1,\"ts\":1.000}"));
+    EXPECT_TRUE(json.contains(
+            "{\"ph\":\"X\",\"name\":\"inner\",\"pid\":1,\"tid\":1,\"ts\":2.000,"
+            "\"dur\":1.000}"));
+    EXPECT_TRUE(json.contains(
+            "{\"ph\":\"E\",\"name\":\"outer\",\"pid\":1,\"tid\":1,\"ts\":4.000}"));
+    EXPECT_FALSE(json.contains("outer_duration"));
+}
+
+TEST(ChromeTraceTest, CountersAccumulate) {
+    ChromeTrace trace;
+    trace.addReport(2, "underflow", makeReport(Stat::COUNTER, 1000, 1));
+    trace.addReport(2, "underflow", makeReport(Stat::COUNTER, 2000, 1));
+    trace.addReport(3, "fill", makeReport(Stat::GAUGE, 2000, 1.5));
+
+    const QString json = writeTrace(trace);
+    EXPECT_TRUE(json.contains(
+            "{\"ph\":\"C\",\"name\":\"underflow\",\"pid\":1,\"tid\":2,"
+            "\"ts\":2.000,\"args\":{\"value\":2}}"));
+    EXPECT_TRUE(json.contains(
+            "{\"ph\":\"C\",\"name\":\"fill\",\"pid\":1,\"tid\":3,"
+            "\"ts\":2.000,\"args\":{\"value\":1.5}}"));
+}
+
+} // anonymous namespace
@@ -84,4 +84,18 @@ TEST_F(ControlObjectTest, Persistence_ValidValue) {
     EXPECT_DOUBLE_EQ(5.0, co.get());
 }
 
+TEST_F(ControlObjectTest, ChangedFlagCoalescesSets) {
+    auto pControl = ControlDoublePrivate::getControl(ck1);
+    pControl->fetchAndClearChangedFlag();
+
+    co1->set(1.0);
+    co1->set(2.0);
+    EXPECT_TRUE(pControl->fetchAndClearChangedFlag());
+    EXPECT_FALSE(pControl->fetchAndClearChangedFlag());
+
+    // Ignored no-op
+    co1->set(2.0);
+    EXPECT_FALSE(pControl->fetchAndClearChangedFlag());
+}
+
 }
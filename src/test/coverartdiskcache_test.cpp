@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QImage>
+
+#include "library/coverartdiskcache.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+class CoverArtDiskCacheTest : public MixxxTest {
+  protected:
+    QImage makeImage(int width, QRgb color) const {
+        QImage image(width, width, QImage::Format_RGB32);
+        image.fill(color);
+        return image;
+    }
+};
+
+TEST_F(CoverArtDiskCacheTest, saveAndLoad) {
+    CoverArtDiskCache cache(
+            getTestDataDir().filePath("coverart"), 1024 * 1024);
+
+    const QImage image = makeImage(50, qRgb(255, 0, 0));
+    EXPECT_TRUE(cache.load(1234, 50).isNull());
+    EXPECT_TRUE(cache.save(1234, 50, image));
+
+    QImage loaded = cache.load(1234, 50);
+    ASSERT_FALSE(loaded.isNull());
+    EXPECT_EQ(image.size(), loaded.size());
+    EXPECT_EQ(image.pixel(10, 10), loaded.pixel(10, 10));
+
+    // Different widths of the same cover are stored separately
+    EXPECT_TRUE(cache.load(1234, 100).isNull());
+}
+
+TEST_F(CoverArtDiskCacheTest, rejectFullSizeCovers) {
+    CoverArtDiskCache cache(
+            getTestDataDir().filePath("coverart"), 1024 * 1024);
+    EXPECT_FALSE(cache.save(4321, 0, makeImage(50, qRgb(0, 255, 0))));
+    EXPECT_TRUE(cache.load(4321, 0).isNull());
+}
+
+TEST_F(CoverArtDiskCacheTest, prune) {
+    // Each thumbnail is a few hundred bytes, a limit of 1 byte
+    // forces the removal of all of them.
+    CoverArtDiskCache cache(getTestDataDir().filePath("coverart"), 1);
+    for (quint16 hash = 1; hash <= 4; ++hash) {
+        ASSERT_TRUE(cache.save(hash, 50, makeImage(50, qRgb(0, 0, 255))));
+    }
+    cache.prune();
+    for (quint16 hash = 1; hash <= 4; ++hash) {
+        EXPECT_TRUE(cache.load(hash, 50).isNull());
+    }
+}
+
+}  // namespace
@@ -1,3 +1,5 @@
+#include <QSqlQuery>
+
 #include "test/librarytest.h"
 
 #include "library/crate/cratestorage.h"
@@ -65,3 +67,37 @@ TEST_F(CrateStorageTest, persistentLifecycle) {
     EXPECT_FALSE(m_crateStorage.readCrateByName(kNewCrateName));
     EXPECT_EQ(kNumCrates - 1, m_crateStorage.countCrates());
 }
+
+TEST_F(CrateStorageTest, summaryFollowsCrateTracks) {
+    // Two visible tracks and one hidden track
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec(
+            "INSERT INTO library (id,duration,mixxx_deleted) VALUES "
+            "(1,60.0,0),(2,120.0,0),(3,240.0,1)"));
+
+    Crate crate;
+    crate.setName("Summary");
+    CrateId crateId;
+    ASSERT_TRUE(m_crateStorage.onInsertingCrate(crate, &crateId));
+    ASSERT_TRUE(m_crateStorage.onAddingCrateTracks(crateId,
+            QList<TrackId>() << TrackId(1) << TrackId(2) << TrackId(3)));
+
+    CrateSummary summary;
+    ASSERT_TRUE(m_crateStorage.readCrateSummaryById(crateId, &summary));
+    EXPECT_EQ(2u, summary.getTrackCount());
+    EXPECT_DOUBLE_EQ(180.0, summary.getTrackDuration());
+
+    // Hiding and unhiding tracks in the library
+    ASSERT_TRUE(query.exec("UPDATE library SET mixxx_deleted=1 WHERE id=1"));
+    ASSERT_TRUE(query.exec("UPDATE library SET mixxx_deleted=0 WHERE id=3"));
+    ASSERT_TRUE(m_crateStorage.readCrateSummaryById(crateId, &summary));
+    EXPECT_EQ(2u, summary.getTrackCount());
+    EXPECT_DOUBLE_EQ(360.0, summary.getTrackDuration());
+
+    // Removing tracks from the crate
+    ASSERT_TRUE(m_crateStorage.onRemovingCrateTracks(crateId,
+            QList<TrackId>() << TrackId(2)));
+    ASSERT_TRUE(m_crateStorage.readCrateSummaryById(crateId, &summary));
+    EXPECT_EQ(1u, summary.getTrackCount());
+    EXPECT_DOUBLE_EQ(240.0, summary.getTrackDuration());
+}
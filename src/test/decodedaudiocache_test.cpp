@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <QDir>
+
+#include "sources/decodedaudiocache.h"
+#include "sources/soundsourcemappedpcm.h"
+#include "test/mixxxtest.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+const QDir kTestDir(QDir::current().absoluteFilePath("src/test/id3-test-data"));
+
+class DecodedAudioCacheTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_pSource = std::make_shared<mixxx::SoundSourceMappedPcm>(
+                QUrl::fromLocalFile(kTestDir.absoluteFilePath("cover-test.wav")));
+        ASSERT_EQ(mixxx::AudioSource::OpenResult::Succeeded,
+                m_pSource->open(mixxx::AudioSource::OpenMode::Strict));
+        // The header and the samples as 32 bit float
+        m_fileSize = 44 + m_pSource->frames2samples(
+                m_pSource->frameLength()) * qint64(sizeof(float));
+    }
+
+    QString cacheDir() const {
+        return getTestDataDir().filePath("decodedaudio");
+    }
+
+    mixxx::SoundSourcePointer m_pSource;
+    qint64 m_fileSize;
+};
+
+TEST_F(DecodedAudioCacheTest, storeAndLookup) {
+    mixxx::DecodedAudioCache cache(cacheDir(), 4 * m_fileSize);
+    EXPECT_TRUE(cache.lookup("track").isEmpty());
+    ASSERT_TRUE(cache.store("track", m_pSource));
+    EXPECT_EQ(m_fileSize, cache.totalSizeBytes());
+
+    const QString filePath = cache.lookup("track");
+    ASSERT_FALSE(filePath.isEmpty());
+    mixxx::SoundSourceMappedPcm decoded(QUrl::fromLocalFile(filePath));
+    ASSERT_EQ(mixxx::AudioSource::OpenResult::Succeeded,
+            decoded.open(mixxx::AudioSource::OpenMode::Strict));
+    EXPECT_EQ(m_pSource->channelCount(), decoded.channelCount());
+    EXPECT_EQ(m_pSource->sampleRate(), decoded.sampleRate());
+    ASSERT_TRUE(m_pSource->frameIndexRange() == decoded.frameIndexRange());
+
+    const auto frameIndexRange = mixxx::IndexRange::forward(
+            decoded.frameLength() / 2, 1024);
+    mixxx::SampleBuffer expected(decoded.frames2samples(1024));
+    mixxx::SampleBuffer actual(decoded.frames2samples(1024));
+    m_pSource->readSampleFrames(mixxx::WritableSampleFrames(
+            frameIndexRange, mixxx::SampleBuffer::WritableSlice(expected)));
+    decoded.readSampleFrames(mixxx::WritableSampleFrames(
+            frameIndexRange, mixxx::SampleBuffer::WritableSlice(actual)));
+    for (SINT i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], actual[i]);
+    }
+}
+
+TEST_F(DecodedAudioCacheTest, evictLeastRecentlyUsed) {
+    mixxx::DecodedAudioCache cache(cacheDir(), 3 * m_fileSize);
+    ASSERT_TRUE(cache.store("a", m_pSource));
+    ASSERT_TRUE(cache.store("b", m_pSource));
+    ASSERT_TRUE(cache.store("c", m_pSource));
+    // Loading a makes b the least recently used one
+    EXPECT_FALSE(cache.lookup("a").isEmpty());
+    ASSERT_TRUE(cache.store("d", m_pSource));
+
+    EXPECT_EQ(3 * m_fileSize, cache.totalSizeBytes());
+    EXPECT_TRUE(cache.lookup("b").isEmpty());
+    EXPECT_FALSE(cache.lookup("a").isEmpty());
+    EXPECT_FALSE(cache.lookup("c").isEmpty());
+    EXPECT_FALSE(cache.lookup("d").isEmpty());
+}
+
+TEST_F(DecodedAudioCacheTest, rejectLargeFiles) {
+    // A single file may only take half of the limit
+    mixxx::DecodedAudioCache cache(cacheDir(), m_fileSize);
+    EXPECT_FALSE(cache.store("track", m_pSource));
+    EXPECT_TRUE(cache.lookup("track").isEmpty());
+    EXPECT_EQ(0, cache.totalSizeBytes());
+}
+
+TEST_F(DecodedAudioCacheTest, keepOrderAfterRestart) {
+    {
+        mixxx::DecodedAudioCache cache(cacheDir(), 3 * m_fileSize);
+        ASSERT_TRUE(cache.store("a", m_pSource));
+        ASSERT_TRUE(cache.store("b", m_pSource));
+        EXPECT_FALSE(cache.lookup("a").isEmpty());
+    }
+    mixxx::DecodedAudioCache cache(cacheDir(), 3 * m_fileSize);
+    EXPECT_EQ(2 * m_fileSize, cache.totalSizeBytes());
+    // Shrinking the limit removes b, which has been used before a
+    cache.setMaxSizeBytes(2 * m_fileSize - 1);
+    cache.prune();
+    EXPECT_TRUE(cache.lookup("b").isEmpty());
+    EXPECT_FALSE(cache.lookup("a").isEmpty());
+}
+
+}  // namespace
@@ -0,0 +1,167 @@
+#include <benchmark/benchmark.h>
+
+#include <QString>
+
+#include "engine/enginebufferscalelinear.h"
+#include "engine/enginebufferscalerubberband.h"
+#include "engine/enginebufferscalesinc.h"
+#include "engine/enginebufferscalest.h"
+#include "engine/readaheadmanager.h"
+#include "util/math.h"
+#include "util/threadcputimer.h"
+#include "util/samplebuffer.h"
+
+// Compares the scalers, so the keylock engine can be chosen based on the
+// machine it runs on. Run with
+//   mixxx-test --benchmark --benchmark_filter=BM_Scale
+//
+// Each benchmark scales a stereo 44.1 kHz signal like EngineBuffer does. The
+// first argument is the engine buffer size in frames, the second one the
+// tempo in percent. The label shows the CPU time one deck takes relative to
+// the duration of the scaled audio, and the latency in frames until the
+// scaled signal shows up after a seek. The latency of the buffer itself is
+// not included.
+
+namespace {
+
+const SINT kSampleRate = 44100;
+const SINT kChannelCount = 2;
+// Long enough to see the signal after a seek with every scaler
+const SINT kLatencyBufferFrames = 16384;
+
+// Feeds an endless signal to the scaler
+class SignalReadAheadManager : public ReadAheadManager {
+  public:
+    enum class Signal {
+        // A 440 Hz sine, the benchmarks need something to work on
+        Sine,
+        // A constant, to find where the output starts
+        Constant,
+    };
+
+    explicit SignalReadAheadManager(Signal signal)
+            : m_signal(signal),
+              m_phase(0.0) {
+    }
+
+    SINT getNextSamples(double dRate, CSAMPLE* buffer,
+                        SINT requested_samples) override {
+        Q_UNUSED(dRate);
+        for (SINT i = 0; i < requested_samples; i += kChannelCount) {
+            CSAMPLE value = 0.5f;
+            if (m_signal == Signal::Sine) {
+                value = static_cast<CSAMPLE>(0.5 * sin(m_phase));
+                m_phase += 2 * M_PI * 440.0 / kSampleRate;
+            }
+            for (SINT channel = 0; channel < kChannelCount; ++channel) {
+                buffer[i + channel] = value;
+            }
+        }
+        return requested_samples;
+    }
+
+  private:
+    const Signal m_signal;
+    double m_phase;
+};
+
+void setTempo(EngineBufferScale* pScaler, double tempo, bool keylock) {
+    double tempoRatio = tempo;
+    double pitchRatio = keylock ? 1.0 : tempo;
+    pScaler->setSampleRate(kSampleRate);
+    pScaler->setScaleParameters(1.0, &tempoRatio, &pitchRatio);
+    // Twice, so the linear scaler does not ramp from the previous rate
+    pScaler->setScaleParameters(1.0, &tempoRatio, &pitchRatio);
+}
+
+template<typename Scaler>
+SINT measureLatencyFrames(double tempo, bool keylock) {
+    SignalReadAheadManager readAheadManager(
+            SignalReadAheadManager::Signal::Constant);
+    Scaler scaler(&readAheadManager);
+    setTempo(&scaler, tempo, keylock);
+    scaler.clear();
+
+    mixxx::SampleBuffer output(kLatencyBufferFrames * kChannelCount);
+    scaler.scaleBuffer(output.data(), output.size());
+    for (SINT frame = 0; frame < kLatencyBufferFrames; ++frame) {
+        // Half of the constant input
+        if (output[frame * kChannelCount] > 0.25f) {
+            return frame;
+        }
+    }
+    return kLatencyBufferFrames;
+}
+
+template<typename Scaler>
+void benchmarkScaler(benchmark::State& state, bool keylock) {
+    const SINT frames = state.range_x();
+    const double tempo = state.range_y() / 100.0;
+
+    SignalReadAheadManager readAheadManager(
+            SignalReadAheadManager::Signal::Sine);
+    Scaler scaler(&readAheadManager);
+    setTempo(&scaler, tempo, keylock);
+    mixxx::SampleBuffer output(frames * kChannelCount);
+
+    ThreadCpuTimer timer;
+    timer.start();
+    while (state.KeepRunning()) {
+        scaler.scaleBuffer(output.data(), output.size());
+    }
+    const double seconds = timer.elapsed().toDoubleSeconds();
+    const double audioSeconds =
+            static_cast<double>(state.iterations()) * frames / kSampleRate;
+
+    state.SetItemsProcessed(state.iterations() * frames);
+    state.SetLabel(QString("deck load %1%, latency %2 frames")
+            .arg(100.0 * seconds / audioSeconds, 0, 'f', 2)
+            .arg(measureLatencyFrames<Scaler>(tempo, keylock))
+            .toStdString());
+}
+
+// Engine buffer sizes in frames at the usual latencies, and tempos from
+// -20% to +20% and double speed
+void scalerArguments(benchmark::internal::Benchmark* b) {
+    const int frames[] = {256, 512, 1024, 2048};
+    const int tempos[] = {80, 94, 100, 106, 110, 120, 200};
+    for (int frame : frames) {
+        for (int tempo : tempos) {
+            b->ArgPair(frame, tempo);
+        }
+    }
+}
+
+void BM_ScaleLinear(benchmark::State& state) {
+    benchmarkScaler<EngineBufferScaleLinear>(state, false);
+}
+BENCHMARK(BM_ScaleLinear)->Apply(scalerArguments);
+
+void BM_ScaleSinc(benchmark::State& state) {
+    benchmarkScaler<EngineBufferScaleSinc>(state, false);
+}
+BENCHMARK(BM_ScaleSinc)->Apply(scalerArguments);
+
+class EngineBufferScaleSincHigh : public EngineBufferScaleSinc {
+  public:
+    explicit EngineBufferScaleSincHigh(ReadAheadManager* pReadAheadManager)
+            : EngineBufferScaleSinc(pReadAheadManager, Quality::High) {
+    }
+};
+
+void BM_ScaleSincHigh(benchmark::State& state) {
+    benchmarkScaler<EngineBufferScaleSincHigh>(state, false);
+}
+BENCHMARK(BM_ScaleSincHigh)->Apply(scalerArguments);
+
+void BM_ScaleSoundTouch(benchmark::State& state) {
+    benchmarkScaler<EngineBufferScaleST>(state, true);
+}
+BENCHMARK(BM_ScaleSoundTouch)->Apply(scalerArguments);
+
+void BM_ScaleRubberBand(benchmark::State& state) {
+    benchmarkScaler<EngineBufferScaleRubberBand>(state, true);
+}
+BENCHMARK(BM_ScaleRubberBand)->Apply(scalerArguments);
+
+}  // namespace
@@ -263,6 +263,42 @@ TEST_F(EngineBufferScaleLinearTest, TestHalfSpeedSmoothlyDoublesSamples) {
     SampleUtil::free(pOutput);
 }
 
+TEST_F(EngineBufferScaleLinearTest, TestRampedRateFollowsPosition) {
+    // Ramp from 0.8 to 1.3 over the buffer
+    SetRateNoLerp(0.8);
+    SetRate(1.3);
+
+    // Each frame holds its own index, so the interpolated output is the
+    // position that was read
+    const int kRampFrames = 4096;
+    QVector<CSAMPLE> readBuffer(kRampFrames * 2);
+    for (int i = 0; i < readBuffer.size(); ++i) {
+        readBuffer[i] = i / 2;
+    }
+    m_pReadAheadMock->setReadBuffer(readBuffer.data(), readBuffer.size());
+
+    // Tell the RAMAN mock to invoke getNextSamplesFake
+    EXPECT_CALL(*m_pReadAheadMock, getNextSamples(_, _, _))
+            .WillRepeatedly(Invoke(m_pReadAheadMock, &ReadAheadManagerMock::getNextSamplesFake));
+
+    const int kOutputFrames = 1024;
+    CSAMPLE* pOutput = SampleUtil::alloc(kOutputFrames * 2);
+    m_pScaler->scaleBuffer(pOutput, kOutputFrames * 2);
+
+    // The position advances frame by frame by the ramped rate
+    double position = 0.0;
+    double rate = 0.8;
+    const double rateDelta = (1.3 - 0.8) / kOutputFrames;
+    for (int i = 0; i < kOutputFrames; ++i) {
+        EXPECT_NEAR(position, pOutput[i * 2], 0.001);
+        EXPECT_NEAR(position, pOutput[i * 2 + 1], 0.001);
+        position += rate;
+        rate += rateDelta;
+    }
+
+    SampleUtil::free(pOutput);
+}
+
 TEST_F(EngineBufferScaleLinearTest, TestRepeatedScaleCalls) {
     SetRateNoLerp(0.5);
 
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <QtDebug>
+
+#include "engine/enginebufferscalesinc.h"
+#include "engine/readaheadmanager.h"
+#include "test/mixxxtest.h"
+#include "util/math.h"
+#include "util/samplebuffer.h"
+#include "util/types.h"
+
+namespace {
+
+const SINT kSampleRate = 44100;
+const SINT kOutputFrames = 1024;
+
+// Feeds a sine with the same value on both channels
+class SineReadAheadManager : public ReadAheadManager {
+  public:
+    explicit SineReadAheadManager(double frequency)
+            : m_frequency(frequency),
+              m_frame(0) {
+    }
+
+    SINT getNextSamples(double dRate, CSAMPLE* buffer,
+                        SINT requested_samples) override {
+        Q_UNUSED(dRate);
+        // Return less than requested, like the real one does at chunk
+        // boundaries
+        const SINT samples = math_min<SINT>(requested_samples, 300);
+        for (SINT i = 0; i < samples; i += 2) {
+            buffer[i] = buffer[i + 1] = valueAt(m_frame++);
+        }
+        return samples;
+    }
+
+    CSAMPLE valueAt(double frame) const {
+        return static_cast<CSAMPLE>(
+                0.5 * sin(2 * M_PI * m_frequency * frame / kSampleRate));
+    }
+
+  private:
+    const double m_frequency;
+    SINT m_frame;
+};
+
+class EngineBufferScaleSincTest : public MixxxTest {
+  protected:
+    void setRate(EngineBufferScaleSinc* pScaler, double rate) {
+        double tempoRatio = rate;
+        double pitchRatio = rate;
+        pScaler->setSampleRate(kSampleRate);
+        pScaler->setScaleParameters(1.0, &tempoRatio, &pitchRatio);
+    }
+
+    // Returns the largest difference to the sine at the expected positions,
+    // after the first buffer where the filter fades in
+    CSAMPLE maxSineError(EngineBufferScaleSinc::Quality quality,
+                         double rate, double frequency) {
+        SineReadAheadManager readAheadManager(frequency);
+        EngineBufferScaleSinc scaler(&readAheadManager, quality);
+        setRate(&scaler, rate);
+        scaler.clear();
+
+        mixxx::SampleBuffer output(kOutputFrames * 2);
+        double position = 0.0;
+        CSAMPLE maxError = 0.0f;
+        for (int buffer = 0; buffer < 10; ++buffer) {
+            scaler.scaleBuffer(output.data(), output.size());
+            for (SINT frame = 0; frame < kOutputFrames; ++frame) {
+                if (buffer > 0) {
+                    const CSAMPLE expected = readAheadManager.valueAt(position);
+                    maxError = math_max<CSAMPLE>(maxError,
+                            fabs(output[frame * 2] - expected));
+                    maxError = math_max<CSAMPLE>(maxError,
+                            fabs(output[frame * 2 + 1] - expected));
+                }
+                position += rate;
+            }
+        }
+        return maxError;
+    }
+};
+
+TEST_F(EngineBufferScaleSincTest, FollowsSine) {
+    // From 44.1 kHz to 48 kHz, unity, slower, and faster with a lowered
+    // cutoff
+    const double rates[] = {44100.0 / 48000.0, 1.0, 0.5, 1.1, 1.2, 2.0};
+    for (double rate : rates) {
+        EXPECT_LT(maxSineError(
+                EngineBufferScaleSinc::Quality::Low, rate, 1000.0), 5e-3)
+                << "rate " << rate;
+        EXPECT_LT(maxSineError(
+                EngineBufferScaleSinc::Quality::Medium, rate, 1000.0), 1e-3)
+                << "rate " << rate;
+        EXPECT_LT(maxSineError(
+                EngineBufferScaleSinc::Quality::High, rate, 1000.0), 1e-3)
+                << "rate " << rate;
+    }
+}
+
+TEST_F(EngineBufferScaleSincTest, RemovesAliases) {
+    // 8 kHz at triple speed would alias to 20.1 kHz
+    SineReadAheadManager readAheadManager(8000.0);
+    EngineBufferScaleSinc scaler(&readAheadManager,
+            EngineBufferScaleSinc::Quality::Medium);
+    setRate(&scaler, 3.0);
+    scaler.clear();
+
+    mixxx::SampleBuffer output(kOutputFrames * 2);
+    scaler.scaleBuffer(output.data(), output.size());
+    scaler.scaleBuffer(output.data(), output.size());
+    for (SINT i = 0; i < output.size(); ++i) {
+        EXPECT_LT(fabs(output[i]), 0.01f);
+    }
+}
+
+TEST_F(EngineBufferScaleSincTest, ReturnsFramesConsumed) {
+    SineReadAheadManager readAheadManager(1000.0);
+    EngineBufferScaleSinc scaler(&readAheadManager);
+    setRate(&scaler, 0.8);
+    scaler.clear();
+    mixxx::SampleBuffer output(kOutputFrames * 2);
+    EXPECT_NEAR(0.8 * kOutputFrames,
+            scaler.scaleBuffer(output.data(), output.size()), 1e-6);
+
+    // The rate is ramped from 0.8 to 1.2 over the buffer
+    setRate(&scaler, 1.2);
+    const double rateDelta = 0.4 / kOutputFrames;
+    double expected = 0.0;
+    for (SINT frame = 0; frame < kOutputFrames; ++frame) {
+        expected += 0.8 + frame * rateDelta;
+    }
+    EXPECT_NEAR(expected, scaler.scaleBuffer(output.data(), output.size()),
+            1e-6);
+}
+
+}  // namespace
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "test/signalpathtest.h"
+#include "control/controlobject.h"
+#include "engine/enginecompactsampler.h"
+#include "util/sample.h"
+
+namespace {
+
+const int kFrameCount = 8;
+
+class EngineCompactSamplerTest : public SignalPathTest {
+  protected:
+    void SetUp() override {
+        ControlObject::set(ConfigKey("[Master]", "samplerate"), 44100);
+        // No need for a real handle in this test.
+        m_pSampler = new EngineCompactSampler(
+                ChannelHandleAndGroup(ChannelHandle(), "[CompactSampler]"),
+                m_pEffectsManager);
+        m_pOutput = SampleUtil::alloc(kFrameCount * 2);
+    }
+
+    void TearDown() override {
+        SampleUtil::free(m_pOutput);
+        delete m_pSampler;
+    }
+
+    // Left channel ascending, right channel descending
+    static CompactSample* newRampSample(int sampleRate) {
+        CompactSample* pSample = new CompactSample(kFrameCount, sampleRate);
+        for (int i = 0; i < kFrameCount; ++i) {
+            pSample->sampleBuffer.data()[i * 2] = i * 0.1f;
+            pSample->sampleBuffer.data()[i * 2 + 1] = -i * 0.1f;
+        }
+        return pSample;
+    }
+
+    bool isPlaying() const {
+        return ControlObject::get(ConfigKey("[CompactSampler]", "play")) > 0.0;
+    }
+
+    EngineCompactSampler* m_pSampler;
+    CSAMPLE* m_pOutput;
+};
+
+TEST_F(EngineCompactSamplerTest, PlaysOneShotAtEngineRate) {
+    ASSERT_TRUE(m_pSampler->setSample(newRampSample(44100), true));
+    ASSERT_TRUE(m_pSampler->isActive());
+    EXPECT_EQ(1.0, ControlObject::get(ConfigKey("[CompactSampler]", "track_loaded")));
+
+    m_pSampler->process(m_pOutput, kFrameCount * 2);
+    for (int i = 0; i < kFrameCount - 1; ++i) {
+        EXPECT_FLOAT_EQ(i * 0.1f, m_pOutput[i * 2]);
+        EXPECT_FLOAT_EQ(-i * 0.1f, m_pOutput[i * 2 + 1]);
+    }
+    // The end of the sample stops and rewinds the sampler
+    EXPECT_FLOAT_EQ(0.0f, m_pOutput[(kFrameCount - 1) * 2]);
+    EXPECT_FALSE(isPlaying());
+    EXPECT_FALSE(m_pSampler->isActive());
+}
+
+TEST_F(EngineCompactSamplerTest, InterpolatesLowerSampleRate) {
+    ASSERT_TRUE(m_pSampler->setSample(newRampSample(22050), true));
+    ASSERT_TRUE(m_pSampler->isActive());
+
+    m_pSampler->process(m_pOutput, kFrameCount * 2);
+    for (int i = 0; i < kFrameCount; ++i) {
+        EXPECT_FLOAT_EQ(i * 0.05f, m_pOutput[i * 2]);
+        EXPECT_FLOAT_EQ(-i * 0.05f, m_pOutput[i * 2 + 1]);
+    }
+    EXPECT_TRUE(isPlaying());
+}
+
+TEST_F(EngineCompactSamplerTest, StartPlayRewinds) {
+    ASSERT_TRUE(m_pSampler->setSample(newRampSample(44100), true));
+    ASSERT_TRUE(m_pSampler->isActive());
+    m_pSampler->process(m_pOutput, 4);
+
+    ControlObject::set(ConfigKey("[CompactSampler]", "start_play"), 1.0);
+    ASSERT_TRUE(m_pSampler->isActive());
+    m_pSampler->process(m_pOutput, 4);
+    EXPECT_FLOAT_EQ(0.0f, m_pOutput[0]);
+    EXPECT_FLOAT_EQ(0.1f, m_pOutput[2]);
+}
+
+TEST_F(EngineCompactSamplerTest, Eject) {
+    ASSERT_TRUE(m_pSampler->setSample(newRampSample(44100), true));
+    ASSERT_TRUE(m_pSampler->isActive());
+
+    ASSERT_TRUE(m_pSampler->setSample(nullptr));
+    EXPECT_FALSE(m_pSampler->isActive());
+    EXPECT_FALSE(isPlaying());
+    EXPECT_EQ(0.0, ControlObject::get(ConfigKey("[CompactSampler]", "track_loaded")));
+}
+
+}  // namespace
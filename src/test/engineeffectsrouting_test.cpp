@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include "engine/effects/engineeffectchain.h"
+#include "engine/effects/engineeffectrack.h"
+#include "engine/effects/engineeffectsrouting.h"
+#include "engine/effects/message.h"
+#include "test/mixxxtest.h"
+#include "util/memory.h"
+
+namespace {
+
+class EngineEffectsRoutingTest : public MixxxTest {
+  protected:
+    EngineEffectsRoutingTest()
+            : m_deck1(m_factory.getOrCreateHandle("[Channel1]"), "[Channel1]"),
+              m_deck2(m_factory.getOrCreateHandle("[Channel2]"), "[Channel2]"),
+              m_rack(0),
+              m_chain1("chain1", QSet<ChannelHandleAndGroup>(), QSet<ChannelHandleAndGroup>()),
+              m_chain2("chain2", QSet<ChannelHandleAndGroup>(), QSet<ChannelHandleAndGroup>()),
+              // The builder never dereferences effects
+              m_pEffect1(reinterpret_cast<EngineEffect*>(&m_effectDummies[0])),
+              m_pEffect2(reinterpret_cast<EngineEffect*>(&m_effectDummies[1])) {
+    }
+
+    void addRack(SignalProcessingStage stage) {
+        EffectsRequest request;
+        request.type = EffectsRequest::ADD_EFFECT_RACK;
+        request.AddEffectRack.pRack = &m_rack;
+        request.AddEffectRack.signalProcessingStage = stage;
+        EXPECT_TRUE(m_builder.requestWritten(request));
+    }
+
+    void addChain(EngineEffectChain* pChain, int iIndex) {
+        EffectsRequest request;
+        request.type = EffectsRequest::ADD_CHAIN_TO_RACK;
+        request.pTargetRack = &m_rack;
+        request.AddChainToRack.pChain = pChain;
+        request.AddChainToRack.iIndex = iIndex;
+        EXPECT_TRUE(m_builder.requestWritten(request));
+    }
+
+    void addEffect(EngineEffectChain* pChain, EngineEffect* pEffect, int iIndex) {
+        EffectsRequest request;
+        request.type = EffectsRequest::ADD_EFFECT_TO_CHAIN;
+        request.pTargetChain = pChain;
+        request.AddEffectToChain.pEffect = pEffect;
+        request.AddEffectToChain.iIndex = iIndex;
+        EXPECT_TRUE(m_builder.requestWritten(request));
+    }
+
+    void removeEffect(EngineEffectChain* pChain, EngineEffect* pEffect, int iIndex) {
+        EffectsRequest request;
+        request.type = EffectsRequest::REMOVE_EFFECT_FROM_CHAIN;
+        request.pTargetChain = pChain;
+        request.RemoveEffectFromChain.pEffect = pEffect;
+        request.RemoveEffectFromChain.iIndex = iIndex;
+        EXPECT_TRUE(EngineEffectsRoutingBuilder::routingPrecedesRequest(request));
+        EXPECT_TRUE(m_builder.requestWritten(request));
+    }
+
+    bool enable(EngineEffectChain* pChain, const ChannelHandleAndGroup& input) {
+        EffectsRequest request;
+        request.type = EffectsRequest::ENABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL;
+        request.pTargetChain = pChain;
+        request.EnableInputChannelForChain.pChannelHandle = &input.handle();
+        request.EnableInputChannelForChain.pEffectStatesMapArray =
+                new EffectStatesMapArray;
+        EXPECT_FALSE(EngineEffectsRoutingBuilder::routingPrecedesRequest(request));
+        return m_builder.requestWritten(request);
+    }
+
+    std::unique_ptr<EngineEffectsRouting> build() const {
+        return std::unique_ptr<EngineEffectsRouting>(m_builder.build());
+    }
+
+    ChannelHandleFactory m_factory;
+    ChannelHandleAndGroup m_deck1;
+    ChannelHandleAndGroup m_deck2;
+    EngineEffectRack m_rack;
+    EngineEffectChain m_chain1;
+    EngineEffectChain m_chain2;
+    int m_effectDummies[2];
+    EngineEffect* m_pEffect1;
+    EngineEffect* m_pEffect2;
+    EngineEffectsRoutingBuilder m_builder;
+};
+
+TEST_F(EngineEffectsRoutingTest, FlattensEnabledChainsInOrder) {
+    addRack(SignalProcessingStage::Postfader);
+    addChain(&m_chain2, 1);
+    addChain(&m_chain1, 0);
+    addEffect(&m_chain1, m_pEffect2, 2);
+    addEffect(&m_chain1, m_pEffect1, 0);
+    EXPECT_TRUE(enable(&m_chain2, m_deck1));
+    EXPECT_TRUE(enable(&m_chain1, m_deck1));
+    EXPECT_TRUE(enable(&m_chain2, m_deck2));
+
+    auto pRouting = build();
+    const auto& deck1Routes = pRouting->chainsForInput(
+            SignalProcessingStage::Postfader, m_deck1.handle());
+    ASSERT_EQ(2, deck1Routes.size());
+    EXPECT_EQ(&m_chain1, deck1Routes[0].pChain);
+    // Empty effect slots are skipped
+    ASSERT_EQ(2, deck1Routes[0].effects.size());
+    EXPECT_EQ(m_pEffect1, deck1Routes[0].effects[0]);
+    EXPECT_EQ(m_pEffect2, deck1Routes[0].effects[1]);
+    EXPECT_EQ(&m_chain2, deck1Routes[1].pChain);
+    EXPECT_TRUE(deck1Routes[1].effects.isEmpty());
+
+    const auto& deck2Routes = pRouting->chainsForInput(
+            SignalProcessingStage::Postfader, m_deck2.handle());
+    ASSERT_EQ(1, deck2Routes.size());
+    EXPECT_EQ(&m_chain2, deck2Routes[0].pChain);
+
+    EXPECT_TRUE(pRouting->chainsForInput(
+            SignalProcessingStage::Prefader, m_deck1.handle()).isEmpty());
+    // Lookups for unknown handles do not fail
+    EXPECT_TRUE(pRouting->chainsForInput(SignalProcessingStage::Postfader,
+            m_factory.getOrCreateHandle("[Channel3]")).isEmpty());
+}
+
+TEST_F(EngineEffectsRoutingTest, RemovedEffectIsNotRouted) {
+    addRack(SignalProcessingStage::Prefader);
+    addChain(&m_chain1, 0);
+    addEffect(&m_chain1, m_pEffect1, 0);
+    EXPECT_TRUE(enable(&m_chain1, m_deck1));
+    removeEffect(&m_chain1, m_pEffect1, 0);
+
+    auto pRouting = build();
+    const auto& routes = pRouting->chainsForInput(
+            SignalProcessingStage::Prefader, m_deck1.handle());
+    ASSERT_EQ(1, routes.size());
+    EXPECT_TRUE(routes[0].effects.isEmpty());
+}
+
+TEST_F(EngineEffectsRoutingTest, DisabledChainStaysRoutedUntilResponse) {
+    addRack(SignalProcessingStage::Postfader);
+    addChain(&m_chain1, 0);
+    EXPECT_TRUE(enable(&m_chain1, m_deck1));
+
+    EffectsRequest disable;
+    disable.type = EffectsRequest::DISABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL;
+    disable.pTargetChain = &m_chain1;
+    disable.DisableInputChannelForChain.pChannelHandle = &m_deck1.handle();
+    EXPECT_FALSE(m_builder.requestWritten(disable));
+    EXPECT_EQ(1, build()->chainsForInput(
+            SignalProcessingStage::Postfader, m_deck1.handle()).size());
+
+    EXPECT_TRUE(m_builder.responseReceived(disable));
+    EXPECT_TRUE(build()->chainsForInput(
+            SignalProcessingStage::Postfader, m_deck1.handle()).isEmpty());
+}
+
+TEST_F(EngineEffectsRoutingTest, EnabledAgainBeforeDisableResponse) {
+    addRack(SignalProcessingStage::Postfader);
+    addChain(&m_chain1, 0);
+    EXPECT_TRUE(enable(&m_chain1, m_deck1));
+
+    EffectsRequest disable;
+    disable.type = EffectsRequest::DISABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL;
+    disable.pTargetChain = &m_chain1;
+    disable.DisableInputChannelForChain.pChannelHandle = &m_deck1.handle();
+    EXPECT_FALSE(m_builder.requestWritten(disable));
+    // Still routed, nothing changes
+    EXPECT_FALSE(enable(&m_chain1, m_deck1));
+
+    EXPECT_FALSE(m_builder.responseReceived(disable));
+    EXPECT_EQ(1, build()->chainsForInput(
+            SignalProcessingStage::Postfader, m_deck1.handle()).size());
+}
+
+}  // namespace
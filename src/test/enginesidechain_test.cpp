@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <QSemaphore>
+#include <QVector>
+
+#include "engine/sidechain/enginesidechain.h"
+#include "engine/sidechain/sidechainworker.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+const int kTimeoutMillis = 5000;
+// About 46 ms of stereo audio, like a large engine callback
+const int kFramesPerCallback = 2048;
+
+// Blocks in its first call of process() until it is released
+class SlowWorker : public SideChainWorker {
+  public:
+    SlowWorker()
+            : m_firstCall(true) {
+    }
+
+    void process(const CSAMPLE* pBuffer, const int iBufferSize) override {
+        Q_UNUSED(pBuffer);
+        if (m_firstCall) {
+            m_firstCall = false;
+            m_busy.release();
+            m_continue.acquire();
+        }
+        m_processedSamples.release(iBufferSize);
+    }
+
+    void shutdown() override {
+    }
+
+    QString name() const override {
+        return "SlowWorker";
+    }
+
+    bool waitUntilBusy(int timeoutMillis) {
+        return m_busy.tryAcquire(1, timeoutMillis);
+    }
+
+    void finishEncoding() {
+        m_continue.release();
+    }
+
+    bool waitForProcessedSamples(int count) {
+        return m_processedSamples.tryAcquire(count, kTimeoutMillis);
+    }
+
+  private:
+    bool m_firstCall;
+    QSemaphore m_busy;
+    QSemaphore m_continue;
+    QSemaphore m_processedSamples;
+};
+
+class EngineSideChainTest : public MixxxTest {
+  protected:
+    // Writes a callback of samples like EngineMaster does and returns the
+    // number of samples written
+    int writeCallback(EngineSideChain* pSideChain) {
+        QVector<CSAMPLE> buffer(kFramesPerCallback * 2, 0.5f);
+        pSideChain->writeSamples(buffer.constData(), kFramesPerCallback);
+        return buffer.size();
+    }
+};
+
+TEST_F(EngineSideChainTest, engineWritesWhileSlowWorkerIsBusy) {
+    SlowWorker* pWorker = new SlowWorker;
+    EngineSideChain sideChain(config());
+    sideChain.addSideChainWorker(pWorker);
+
+    // Write until the worker has been woken up and blocks
+    int writtenSamples = 0;
+    do {
+        writtenSamples += writeCallback(&sideChain);
+        ASSERT_LT(writtenSamples, 65536);
+    } while (!pWorker->waitUntilBusy(10));
+
+    // Keep writing while the worker is busy, about a second of audio. The
+    // worker only holds back the chunk it is processing, so none of these
+    // samples may be dropped.
+    while (writtenSamples < 65536 + 32768) {
+        writtenSamples += writeCallback(&sideChain);
+    }
+
+    pWorker->finishEncoding();
+    EXPECT_TRUE(pWorker->waitForProcessedSamples(writtenSamples));
+}
+
+} // anonymous namespace
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSemaphore>
+#include <QStringList>
+
+#include "engine/engineworker.h"
+#include "engine/engineworkerscheduler.h"
+
+namespace {
+
+const int kTimeoutMillis = 5000;
+
+// Records the order in which the workers of a scheduler are processed
+class WorkLog {
+  public:
+    void append(const QString& name) {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_names.append(name);
+        }
+        m_processed.release();
+    }
+
+    // Waits until count work units have been processed
+    bool waitFor(int count) {
+        return m_processed.tryAcquire(count, kTimeoutMillis);
+    }
+
+    QStringList names() const {
+        QMutexLocker locker(&m_mutex);
+        return m_names;
+    }
+
+  private:
+    mutable QMutex m_mutex;
+    QStringList m_names;
+    QSemaphore m_processed;
+};
+
+class TestWorker : public EngineWorker {
+  public:
+    TestWorker(WorkLog* pLog, const QString& name, int workUnits)
+            : m_pLog(pLog),
+              m_name(name),
+              m_remainingUnits(workUnits) {
+    }
+
+    bool processWork() override {
+        m_pLog->append(m_name);
+        return --m_remainingUnits > 0;
+    }
+
+  private:
+    WorkLog* const m_pLog;
+    const QString m_name;
+    int m_remainingUnits;
+};
+
+class EngineWorkerSchedulerTest : public testing::Test {
+  protected:
+    void addWorker(EngineWorkerScheduler* pScheduler, TestWorker* pWorker,
+            EngineWorker::Priority priority) {
+        pWorker->setPriority(priority);
+        pWorker->setScheduler(pScheduler);
+        pWorker->workReady();
+    }
+
+    WorkLog m_log;
+};
+
+TEST_F(EngineWorkerSchedulerTest, processesReadyWorkersInPriorityOrder) {
+    TestWorker preview(&m_log, "Preview", 1);
+    TestWorker sampler(&m_log, "Sampler", 1);
+    TestWorker cued(&m_log, "Cued", 1);
+    TestWorker playing(&m_log, "Playing", 1);
+    {
+        // A single thread, so the processing order is the picking order
+        EngineWorkerScheduler scheduler(nullptr, 1);
+        addWorker(&scheduler, &preview, EngineWorker::Priority::Preview);
+        addWorker(&scheduler, &sampler, EngineWorker::Priority::Sampler);
+        addWorker(&scheduler, &cued, EngineWorker::Priority::Cued);
+        addWorker(&scheduler, &playing, EngineWorker::Priority::Playing);
+        scheduler.start(QThread::NormalPriority);
+        scheduler.runWorkers();
+
+        ASSERT_TRUE(m_log.waitFor(4));
+        EXPECT_EQ(QStringList() << "Playing" << "Cued" << "Sampler" << "Preview",
+                m_log.names());
+
+        preview.quitWait();
+        sampler.quitWait();
+        cued.quitWait();
+        playing.quitWait();
+    }
+}
+
+TEST_F(EngineWorkerSchedulerTest, pendingWorkReentersCompetition) {
+    TestWorker sampler(&m_log, "Sampler", 1);
+    TestWorker cued(&m_log, "Cued", 2);
+    TestWorker playing(&m_log, "Playing", 2);
+    {
+        EngineWorkerScheduler scheduler(nullptr, 1);
+        addWorker(&scheduler, &sampler, EngineWorker::Priority::Sampler);
+        addWorker(&scheduler, &cued, EngineWorker::Priority::Cued);
+        addWorker(&scheduler, &playing, EngineWorker::Priority::Playing);
+        scheduler.start(QThread::NormalPriority);
+        scheduler.runWorkers();
+
+        // A worker with more work pending is picked again before workers
+        // of lower priority, but never before those of higher priority.
+        ASSERT_TRUE(m_log.waitFor(5));
+        EXPECT_EQ(QStringList() << "Playing" << "Playing" << "Cued" << "Cued"
+                        << "Sampler",
+                m_log.names());
+
+        sampler.quitWait();
+        cued.quitWait();
+        playing.quitWait();
+    }
+}
+
+TEST_F(EngineWorkerSchedulerTest, priorityIsEvaluatedWhenPicking) {
+    TestWorker first(&m_log, "First", 1);
+    TestWorker second(&m_log, "Second", 1);
+    {
+        EngineWorkerScheduler scheduler(nullptr, 1);
+        addWorker(&scheduler, &first, EngineWorker::Priority::Playing);
+        addWorker(&scheduler, &second, EngineWorker::Priority::Preview);
+        // The engine updates the priorities in every callback
+        first.setPriority(EngineWorker::Priority::Sampler);
+        second.setPriority(EngineWorker::Priority::Playing);
+        scheduler.start(QThread::NormalPriority);
+        scheduler.runWorkers();
+
+        ASSERT_TRUE(m_log.waitFor(2));
+        EXPECT_EQ(QStringList() << "Second" << "First", m_log.names());
+
+        first.quitWait();
+        second.quitWait();
+    }
+}
+
+TEST_F(EngineWorkerSchedulerTest, runWorkersWakesIdleThreads) {
+    TestWorker cued(&m_log, "Cued", 1);
+    TestWorker playing(&m_log, "Playing", 1);
+    {
+        EngineWorkerScheduler scheduler(nullptr, 2);
+        cued.setScheduler(&scheduler);
+        playing.setScheduler(&scheduler);
+        scheduler.start(QThread::NormalPriority);
+
+        // Nothing is pending, so the threads go idle. Each callback wakes
+        // them up for the workers that became ready during the callback.
+        for (int callback = 0; callback < 10; ++callback) {
+            cued.workReady();
+            playing.workReady();
+            scheduler.runWorkers();
+            ASSERT_TRUE(m_log.waitFor(2));
+        }
+        EXPECT_EQ(20, m_log.names().size());
+
+        cued.quitWait();
+        playing.quitWait();
+    }
+}
+
+} // anonymous namespace
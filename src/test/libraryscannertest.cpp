@@ -1,15 +1,52 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <QFile>
+
 #include "test/librarytest.h"
 
 #include "library/scanner/libraryscanner.h"
+#include "library/scanner/recursivescandirectorytask.h"
+#include "util/sleepableqthread.h"
 
 class LibraryScannerTest : public LibraryTest {
   protected:
     LibraryScannerTest()
         : m_libraryScanner(dbConnectionPool(), collection(), config()) {
     }
+
+    QString makeDirectory(const QString& name) const {
+        const QString path = getTestDataDir().filePath(name);
+        getTestDataDir().mkpath(name);
+        return QDir(path).path();
+    }
+
+    void writeFile(const QString& path) const {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write("notes");
+    }
+
+    ScannerGlobalPointer makeScannerGlobal(
+            const QHash<QString, int>& directoryHashes,
+            const QHash<QString, DirectoryStat>& directoryStats,
+            bool skipUnchangedDirectoryListings) const {
+        return ScannerGlobalPointer(new ScannerGlobal(QSet<QString>(),
+                directoryHashes, directoryStats, QRegExp("\\.mp3$"),
+                QRegExp("\\.jpg$"), QStringList(),
+                skipUnchangedDirectoryListings));
+    }
+
+    // Scans a single directory without queueing any tasks, because the
+    // scanner itself is not running.
+    void scanDirectory(const ScannerGlobalPointer& scannerGlobal,
+            const QString& directoryPath) {
+        RecursiveScanDirectoryTask task(&m_libraryScanner, scannerGlobal,
+                QDir(directoryPath), SecurityTokenPointer(), false);
+        task.setAutoDelete(false);
+        task.run();
+    }
+
     LibraryScanner m_libraryScanner;
 };
 
@@ -52,3 +89,73 @@ TEST_F(LibraryScannerTest, ScannerRoundtrip) {
     m_libraryScanner.changeScannerState(LibraryScanner::IDLE);
     EXPECT_EQ(m_libraryScanner.m_state, LibraryScanner::IDLE);
 }
+
+TEST_F(LibraryScannerTest, skipUnchangedDirectoryListing) {
+    const QString albumPath = makeDirectory("library/album");
+    const QString discPath = makeDirectory("library/album/disc1");
+    const DirectoryStat albumStat = DirectoryStat::fromPath(albumPath);
+    ASSERT_TRUE(albumStat.isValid());
+
+    QHash<QString, int> directoryHashes;
+    directoryHashes.insert(albumPath, 0);
+    directoryHashes.insert(discPath, 0);
+    QHash<QString, DirectoryStat> directoryStats;
+    directoryStats.insert(albumPath, albumStat);
+    ScannerGlobalPointer scannerGlobal =
+            makeScannerGlobal(directoryHashes, directoryStats, true);
+
+    scanDirectory(scannerGlobal, albumPath);
+    EXPECT_EQ(1, scannerGlobal->numSkippedDirectoryListings());
+    // The listing was not read, so there is nothing new to record
+    EXPECT_TRUE(scannerGlobal->directoryStatsScanned().isEmpty());
+    // The known sub-directory has been visited anyway
+    EXPECT_TRUE(scannerGlobal->testAndMarkDirectoryScanned(QDir(discPath)));
+}
+
+TEST_F(LibraryScannerTest, rescanChangedDirectoryListing) {
+    const QString albumPath = makeDirectory("library/album");
+    const DirectoryStat albumStat = DirectoryStat::fromPath(albumPath);
+    ASSERT_TRUE(albumStat.isValid());
+
+    // Adding files updates the modification time of the directory. Keep
+    // adding until the change is visible with the timestamp resolution of
+    // the file system.
+    int fileCount = 0;
+    while (DirectoryStat::fromPath(albumPath) == albumStat) {
+        ASSERT_LT(fileCount, 200);
+        SleepableQThread::msleep(10);
+        writeFile(QString("%1/notes%2.txt").arg(albumPath).arg(++fileCount));
+    }
+    const DirectoryStat changedAlbumStat = DirectoryStat::fromPath(albumPath);
+
+    QHash<QString, int> directoryHashes;
+    directoryHashes.insert(albumPath, 0);
+    QHash<QString, DirectoryStat> directoryStats;
+    directoryStats.insert(albumPath, albumStat);
+    ScannerGlobalPointer scannerGlobal =
+            makeScannerGlobal(directoryHashes, directoryStats, true);
+
+    scanDirectory(scannerGlobal, albumPath);
+    EXPECT_EQ(0, scannerGlobal->numSkippedDirectoryListings());
+    // The new metadata is recorded for the next scan
+    ASSERT_TRUE(scannerGlobal->directoryStatsScanned().contains(albumPath));
+    EXPECT_TRUE(changedAlbumStat ==
+            scannerGlobal->directoryStatsScanned().value(albumPath));
+}
+
+TEST_F(LibraryScannerTest, readUnchangedDirectoryListingIfDisabled) {
+    const QString albumPath = makeDirectory("library/album");
+    const DirectoryStat albumStat = DirectoryStat::fromPath(albumPath);
+    ASSERT_TRUE(albumStat.isValid());
+
+    QHash<QString, int> directoryHashes;
+    directoryHashes.insert(albumPath, 0);
+    QHash<QString, DirectoryStat> directoryStats;
+    directoryStats.insert(albumPath, albumStat);
+    ScannerGlobalPointer scannerGlobal =
+            makeScannerGlobal(directoryHashes, directoryStats, false);
+
+    scanDirectory(scannerGlobal, albumPath);
+    EXPECT_EQ(0, scannerGlobal->numSkippedDirectoryListings());
+    EXPECT_TRUE(scannerGlobal->directoryStatsScanned().contains(albumPath));
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "library/scanner/librarywatcher.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+const int kRescanDelayMillis = 100;
+const int kTimeoutMillis = 5000;
+
+class LibraryWatcherTest : public MixxxTest {
+  protected:
+    LibraryWatcherTest()
+            : m_directoryPath(getTestDataDir().filePath("library")) {
+        getTestDataDir().mkpath("library");
+        m_watcher.setRescanDelay(kRescanDelayMillis);
+        m_watcher.slotSetDirectories(QStringList() << m_directoryPath);
+    }
+
+    void addFile(const QString& fileName) {
+        QFile file(m_directoryPath + "/" + fileName);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write("notes");
+    }
+
+    // Processes events until the spy has recorded count signals
+    bool waitForSignals(const QSignalSpy& spy, int count,
+            int timeoutMillis = kTimeoutMillis) {
+        for (int waitedMillis = 0; spy.count() < count &&
+                waitedMillis < timeoutMillis; waitedMillis += 10) {
+            QTest::qWait(10);
+        }
+        return spy.count() >= count;
+    }
+
+    const QString m_directoryPath;
+    LibraryWatcher m_watcher;
+};
+
+TEST_F(LibraryWatcherTest, changeRequestsRescan) {
+    QSignalSpy spy(&m_watcher, SIGNAL(scanRequested()));
+    addFile("notes1.txt");
+    ASSERT_TRUE(waitForSignals(spy, 1));
+
+    // A burst of changes only requests a single rescan
+    addFile("notes2.txt");
+    addFile("notes3.txt");
+    ASSERT_TRUE(waitForSignals(spy, 2));
+    QTest::qWait(kRescanDelayMillis * 3);
+    EXPECT_EQ(2, spy.count());
+}
+
+TEST_F(LibraryWatcherTest, changeWhileScanningRequestsRescanAfterScan) {
+    QSignalSpy spy(&m_watcher, SIGNAL(scanRequested()));
+    m_watcher.slotScanStarted();
+    addFile("notes1.txt");
+    EXPECT_FALSE(waitForSignals(spy, 1, kRescanDelayMillis * 5));
+
+    m_watcher.slotScanFinished();
+    EXPECT_TRUE(waitForSignals(spy, 1));
+}
+
+TEST_F(LibraryWatcherTest, noRescanAfterScanWithoutChanges) {
+    QSignalSpy spy(&m_watcher, SIGNAL(scanRequested()));
+    m_watcher.slotScanStarted();
+    m_watcher.slotScanFinished();
+    EXPECT_FALSE(waitForSignals(spy, 1, kRescanDelayMillis * 5));
+}
+
+} // anonymous namespace
@@ -1,7 +1,10 @@
 #include <benchmark/benchmark.h>
 
+#include <QtDebug>
+
 #include "mixxxtest.h"
 #include "util/console.h"
+#include "util/realtimeguard.h"
 #include "errordialoghandler.h"
 
 int main(int argc, char **argv) {
@@ -28,6 +31,11 @@ int main(int argc, char **argv) {
 
     if (run_benchmarks) {
         benchmark::RunSpecifiedBenchmarks();
+        // Benchmarked realtime code must neither allocate nor lock
+        if (RealtimeGuard::violationCount() > 0) {
+            qWarning() << RealtimeGuard::report();
+            return 1;
+        }
         return 0;
     } else {
         return RUN_ALL_TESTS();
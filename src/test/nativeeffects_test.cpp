@@ -19,6 +19,7 @@
 #include "engine/channelhandle.h"
 #include "engine/effects/groupfeaturestate.h"
 #include "test/baseeffecttest.h"
+#include "util/realtimeguard.h"
 #include "util/samplebuffer.h"
 
 namespace {
@@ -55,6 +56,7 @@ void benchmarkBuiltInEffectDefaultParameters(const mixxx::EngineParameters& buff
     mixxx::SampleBuffer output(bufferParameters.samplesPerBuffer());
 
     while (pState->KeepRunning()) {
+        RealtimeGuard::Scope realtimeScope;
         effect.process(channel1, channel1, input.data(), output.data(),
                        bufferParameters.samplesPerBuffer(),
                        bufferParameters.sampleRate(),
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <QFileInfo>
+#include <QImage>
+
+#include "test/mixxxtest.h"
+#include "waveform/overviewcache.h"
+
+namespace {
+
+const uint kColorsHash = 0x1234;
+
+class OverviewCacheTest : public MixxxTest {
+  protected:
+    OverviewCacheTest()
+            // About 2 visual samples per 1000 audio samples, like a summary
+            : m_waveformSummary(44100, 44100 * 2 * 60, -1, 2048),
+              m_image(64, 16, QImage::Format_ARGB32_Premultiplied) {
+        for (int i = 0; i < m_waveformSummary.getDataSize(); ++i) {
+            m_waveformSummary.data()[i] = WaveformData(i);
+        }
+        m_image.fill(qRgba(10, 20, 30, 255));
+    }
+
+    // Stores the image and waits until it has been written
+    void storeImage(const OverviewCache& cache, TrackId trackId,
+            const QString& overviewType) {
+        cache.storeImage(trackId, overviewType, kColorsHash,
+                m_waveformSummary, m_image, 0.5f);
+        OverviewCache::waitForPendingWrites();
+    }
+
+    QImage loadImage(const OverviewCache& cache, TrackId trackId,
+            const QString& overviewType, uint colorsHash = kColorsHash) {
+        float peak = -1.0f;
+        return cache.loadImage(trackId, overviewType, colorsHash,
+                m_waveformSummary, &peak);
+    }
+
+    int countImageFiles() const {
+        return QDir(config()->getSettingsPath() + "/analysis/overviews/")
+                .entryList(QDir::Files).size();
+    }
+
+    Waveform m_waveformSummary;
+    QImage m_image;
+};
+
+TEST_F(OverviewCacheTest, storeAndLoad) {
+    OverviewCache cache(config());
+    EXPECT_TRUE(loadImage(cache, TrackId(1), "rgb").isNull());
+
+    storeImage(cache, TrackId(1), "rgb");
+    float peak = -1.0f;
+    const QImage image = cache.loadImage(TrackId(1), "rgb", kColorsHash,
+            m_waveformSummary, &peak);
+    ASSERT_FALSE(image.isNull());
+    EXPECT_EQ(m_image.size(), image.size());
+    EXPECT_EQ(m_image.pixel(3, 3), image.pixel(3, 3));
+    EXPECT_FLOAT_EQ(0.5f, peak);
+
+    // Other tracks and types
+    EXPECT_TRUE(loadImage(cache, TrackId(2), "rgb").isNull());
+    EXPECT_TRUE(loadImage(cache, TrackId(1), "hsv").isNull());
+}
+
+TEST_F(OverviewCacheTest, missAfterChanges) {
+    OverviewCache cache(config());
+    storeImage(cache, TrackId(1), "rgb");
+    ASSERT_FALSE(loadImage(cache, TrackId(1), "rgb").isNull());
+
+    // Other colors
+    EXPECT_TRUE(loadImage(cache, TrackId(1), "rgb", kColorsHash + 1).isNull());
+
+    // Analyzed again
+    m_waveformSummary.data()[10] = WaveformData(-1);
+    EXPECT_TRUE(loadImage(cache, TrackId(1), "rgb").isNull());
+
+    // The stale image is replaced
+    storeImage(cache, TrackId(1), "rgb");
+    EXPECT_FALSE(loadImage(cache, TrackId(1), "rgb").isNull());
+    EXPECT_EQ(1, countImageFiles());
+}
+
+TEST_F(OverviewCacheTest, deleteImages) {
+    OverviewCache cache(config());
+    for (const auto& overviewType: OverviewCache::overviewTypes()) {
+        storeImage(cache, TrackId(1), overviewType);
+        storeImage(cache, TrackId(2), overviewType);
+    }
+    ASSERT_EQ(2 * OverviewCache::overviewTypes().size(), countImageFiles());
+
+    cache.deleteImages(QList<TrackId>() << TrackId(1));
+    EXPECT_EQ(OverviewCache::overviewTypes().size(), countImageFiles());
+    for (const auto& overviewType: OverviewCache::overviewTypes()) {
+        EXPECT_TRUE(loadImage(cache, TrackId(1), overviewType).isNull());
+        EXPECT_FALSE(loadImage(cache, TrackId(2), overviewType).isNull());
+    }
+
+    cache.deleteAllImages();
+    EXPECT_EQ(0, countImageFiles());
+}
+
+TEST_F(OverviewCacheTest, deleteImagesJoinsPendingWrites) {
+    OverviewCache cache(config());
+    // Not waited for, the deletion must not be undone by the write
+    cache.storeImage(TrackId(1), "lmh", kColorsHash,
+            m_waveformSummary, m_image, 0.5f);
+    cache.deleteImages(QList<TrackId>() << TrackId(1));
+    OverviewCache::waitForPendingWrites();
+    EXPECT_TRUE(loadImage(cache, TrackId(1), "lmh").isNull());
+    EXPECT_EQ(0, countImageFiles());
+}
+
+} // anonymous namespace
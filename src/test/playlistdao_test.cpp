@@ -0,0 +1,98 @@
+#include <QSqlQuery>
+
+#include "test/librarytest.h"
+
+#include "library/dao/playlistdao.h"
+
+class PlaylistDAOTest : public LibraryTest {
+  protected:
+    void readPlaylistSummary(int playlistId,
+            int* pTrackCount, double* pTrackDuration) {
+        QSqlQuery query(dbConnection());
+        query.prepare("SELECT track_count, track_duration "
+                "FROM playlist_summaries WHERE playlist_id=:id");
+        query.bindValue(":id", playlistId);
+        ASSERT_TRUE(query.exec());
+        ASSERT_TRUE(query.next());
+        *pTrackCount = query.value(0).toInt();
+        *pTrackDuration = query.value(1).toDouble();
+    }
+};
+
+TEST_F(PlaylistDAOTest, summaryFollowsPlaylistTracks) {
+    PlaylistDAO& playlistDAO = collection()->getPlaylistDAO();
+
+    // Two visible tracks and one hidden track
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec(
+            "INSERT INTO library (id,duration,mixxx_deleted) VALUES "
+            "(1,60.0,0),(2,120.0,0),(3,240.0,1)"));
+
+    const int playlistId = playlistDAO.createPlaylist("Summary");
+    ASSERT_NE(-1, playlistId);
+    int trackCount = -1;
+    double trackDuration = -1.0;
+    readPlaylistSummary(playlistId, &trackCount, &trackDuration);
+    EXPECT_EQ(0, trackCount);
+    EXPECT_DOUBLE_EQ(0.0, trackDuration);
+
+    // A track may appear multiple times in a playlist
+    ASSERT_TRUE(playlistDAO.appendTracksToPlaylist(
+            QList<TrackId>() << TrackId(1) << TrackId(2) << TrackId(3)
+                    << TrackId(1),
+            playlistId));
+    readPlaylistSummary(playlistId, &trackCount, &trackDuration);
+    EXPECT_EQ(3, trackCount);
+    EXPECT_DOUBLE_EQ(240.0, trackDuration);
+
+    // Hiding and unhiding tracks in the library
+    ASSERT_TRUE(query.exec("UPDATE library SET mixxx_deleted=1 WHERE id=2"));
+    ASSERT_TRUE(query.exec("UPDATE library SET mixxx_deleted=0 WHERE id=3"));
+    readPlaylistSummary(playlistId, &trackCount, &trackDuration);
+    EXPECT_EQ(3, trackCount);
+    EXPECT_DOUBLE_EQ(360.0, trackDuration);
+
+    // Removing the first occurrence of track 1
+    playlistDAO.removeTrackFromPlaylist(playlistId, 1);
+    readPlaylistSummary(playlistId, &trackCount, &trackDuration);
+    EXPECT_EQ(2, trackCount);
+    EXPECT_DOUBLE_EQ(300.0, trackDuration);
+
+    playlistDAO.deletePlaylist(playlistId);
+    ASSERT_TRUE(query.exec(QString(
+            "SELECT COUNT(*) FROM playlist_summaries WHERE playlist_id=%1")
+                    .arg(playlistId)));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(0, query.value(0).toInt());
+}
+
+TEST_F(PlaylistDAOTest, repairPlaylistSummaries) {
+    PlaylistDAO& playlistDAO = collection()->getPlaylistDAO();
+
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec(
+            "INSERT INTO library (id,duration,mixxx_deleted) VALUES "
+            "(1,60.0,0),(2,120.0,0)"));
+    const int playlistId = playlistDAO.createPlaylist("Repair");
+    ASSERT_NE(-1, playlistId);
+    ASSERT_TRUE(playlistDAO.appendTracksToPlaylist(
+            QList<TrackId>() << TrackId(1) << TrackId(2), playlistId));
+
+    // Summaries that have drifted apart and belong to no playlist
+    ASSERT_TRUE(query.exec(
+            "UPDATE playlist_summaries SET track_count=7, track_duration=1.0"));
+    ASSERT_TRUE(query.exec(
+            "INSERT INTO playlist_summaries (playlist_id) VALUES (12345)"));
+
+    collection()->repairDatabase(dbConnection());
+
+    int trackCount = -1;
+    double trackDuration = -1.0;
+    readPlaylistSummary(playlistId, &trackCount, &trackDuration);
+    EXPECT_EQ(2, trackCount);
+    EXPECT_DOUBLE_EQ(180.0, trackDuration);
+    ASSERT_TRUE(query.exec(
+            "SELECT COUNT(*) FROM playlist_summaries WHERE playlist_id=12345"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(0, query.value(0).toInt());
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include "engine/engineworker.h"
+#include "engine/engineworkerscheduler.h"
+#include "util/mutex.h"
+#include "util/realtimeguard.h"
+#include "util/sleepableqthread.h"
+
+namespace {
+
+class IdleWorker : public EngineWorker {
+  public:
+    bool processWork() override {
+        return false;
+    }
+};
+
+class RealtimeGuardTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        RealtimeGuard::resetViolations();
+    }
+
+    void TearDown() override {
+        RealtimeGuard::resetViolations();
+    }
+};
+
+TEST_F(RealtimeGuardTest, IgnoresViolationsOutsideOfScope) {
+    RealtimeGuard::check(RealtimeGuard::Violation::Allocation);
+    EXPECT_EQ(0, RealtimeGuard::violationCount());
+}
+
+TEST_F(RealtimeGuardTest, RecordsViolationsInNestedScopes) {
+    {
+        RealtimeGuard::Scope outerScope;
+        RealtimeGuard::check(RealtimeGuard::Violation::Lock);
+        {
+            RealtimeGuard::Scope innerScope;
+            RealtimeGuard::check(RealtimeGuard::Violation::Allocation);
+        }
+        RealtimeGuard::check(RealtimeGuard::Violation::Deallocation);
+    }
+    RealtimeGuard::check(RealtimeGuard::Violation::Lock);
+    EXPECT_EQ(3, RealtimeGuard::violationCount());
+
+    const QString report = RealtimeGuard::report();
+    EXPECT_TRUE(report.contains("#0 lock"));
+    EXPECT_TRUE(report.contains("#1 allocation"));
+    EXPECT_TRUE(report.contains("#2 deallocation"));
+}
+
+TEST_F(RealtimeGuardTest, DetectsMutexLock) {
+    MMutex mutex;
+    {
+        RealtimeGuard::Scope realtimeScope;
+        MMutexLocker locker(&mutex);
+    }
+    // Each MMutexLocker reports once
+    EXPECT_EQ(RealtimeGuard::isEnabled() ? 1 : 0,
+            RealtimeGuard::violationCount());
+}
+
+TEST_F(RealtimeGuardTest, EngineWorkerSchedulerWakeupIsRealtimeSafe) {
+    IdleWorker worker;
+    {
+        EngineWorkerScheduler scheduler(nullptr, 2);
+        worker.setScheduler(&scheduler);
+        scheduler.start(QThread::NormalPriority);
+        // Give the threads time to become idle, so that runWorkers()
+        // actually has to wake one of them
+        SleepableQThread::msleep(50);
+        {
+            // Like EngineMaster::process()
+            RealtimeGuard::Scope realtimeScope;
+            worker.workReady();
+            scheduler.runWorkers();
+        }
+        EXPECT_EQ(0, RealtimeGuard::violationCount())
+                << RealtimeGuard::report().toStdString();
+        worker.quitWait();
+    }
+}
+
+} // anonymous namespace
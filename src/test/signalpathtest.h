@@ -23,6 +23,7 @@
 #include "test/mixxxtest.h"
 #include "util/defs.h"
 #include "util/memory.h"
+#include "util/realtimeguard.h"
 #include "util/sample.h"
 #include "util/types.h"
 #include "waveform/guitick.h"
@@ -54,6 +55,7 @@ class TestEngineMaster : public EngineMaster {
 class BaseSignalPathTest : public MixxxTest {
   protected:
     BaseSignalPathTest() {
+        RealtimeGuard::resetViolations();
         m_pGuiTick = std::make_unique<GuiTick>();
         m_pChannelHandleFactory = new ChannelHandleFactory();
         m_pNumDecks = new ControlObject(ConfigKey("[Master]", "num_decks"));
@@ -97,6 +99,11 @@ class BaseSignalPathTest : public MixxxTest {
     }
 
     ~BaseSignalPathTest() override {
+        // Only builds with rtsafety=1 record violations
+        EXPECT_EQ(0, RealtimeGuard::violationCount())
+                << RealtimeGuard::report().toStdString();
+        RealtimeGuard::resetViolations();
+
         delete m_pMixerDeck1;
         delete m_pMixerDeck2;
         delete m_pMixerDeck3;
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <QAtomicInt>
+#include <QFile>
+#include <QThreadPool>
+
+#include "skin/skinimagecache.h"
+#include "test/mixxxtest.h"
+#include "util/compatibility.h"
+#include "util/sleepableqthread.h"
+
+namespace {
+
+const double kScaleFactor = 1.0;
+
+// Counts the images it renders, also on the threads of the pool
+class CountingImgSource : public ImgSource {
+  public:
+    CountingImgSource()
+            : m_renderCount(0) {
+    }
+
+    QImage* getImage(const QString& fileName, double scaleFactor) const override {
+        Q_UNUSED(fileName);
+        Q_UNUSED(scaleFactor);
+        m_renderCount.fetchAndAddOrdered(1);
+        QImage* pImage = new QImage(8, 8, QImage::Format_ARGB32);
+        pImage->fill(0xff102030);
+        return pImage;
+    }
+
+    int renderCount() const {
+        return load_atomic(m_renderCount);
+    }
+
+  private:
+    mutable QAtomicInt m_renderCount;
+};
+
+class SkinImageCacheTest : public MixxxTest {
+  protected:
+    SkinImageCacheTest()
+            : m_pLoader(new CountingImgSource),
+              m_cacheDir(getTestDataDir().filePath("cache")),
+              m_skinPath(getTestDataDir().filePath("TestSkin")) {
+        QDir().mkpath(m_skinPath);
+        writeFile(m_skinPath + "/skin.xml", "<skin/>");
+        writeFile(imagePath("a.png"), "a");
+        writeFile(imagePath("b.png"), "b");
+        writeFile(imagePath("c.png"), "c");
+    }
+
+    static void writeFile(const QString& filePath, const QByteArray& data) {
+        QFile file(filePath);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        ASSERT_EQ(data.size(), file.write(data));
+    }
+
+    QString imagePath(const QString& fileName) const {
+        return m_skinPath + "/" + fileName;
+    }
+
+    void beginSkin(const QString& colorScheme = "Default") {
+        SkinImageCache::beginSkin(m_cacheDir, m_skinPath, colorScheme,
+                kScaleFactor, m_pLoader);
+    }
+
+    void endSkin() {
+        SkinImageCache::endSkin();
+        // The images that were rendered while parsing are saved in the
+        // background
+        QThreadPool::globalInstance()->waitForDone();
+    }
+
+    QImage getImage(const QString& fileName) {
+        return SkinImageCache::getImage(imagePath(fileName), kScaleFactor,
+                SkinImageCache::Rendering::Loader, m_pLoader);
+    }
+
+    int renderCount() const {
+        return m_pLoader.staticCast<CountingImgSource>()->renderCount();
+    }
+
+    const QSharedPointer<ImgSource> m_pLoader;
+    const QDir m_cacheDir;
+    const QString m_skinPath;
+};
+
+TEST_F(SkinImageCacheTest, prefetchedImagesAreHits) {
+    beginSkin();
+    EXPECT_FALSE(getImage("a.png").isNull());
+    EXPECT_FALSE(getImage("b.png").isNull());
+    endSkin();
+    ASSERT_EQ(2, renderCount());
+
+    // Both are decoded from the disk cache up front, and picked up while
+    // parsing
+    beginSkin();
+    EXPECT_EQ(2, renderCount());
+    const QImage image = getImage("a.png");
+    ASSERT_FALSE(image.isNull());
+    EXPECT_EQ(QSize(8, 8), image.size());
+    EXPECT_FALSE(getImage("b.png").isNull());
+    EXPECT_EQ(2, renderCount());
+    endSkin();
+}
+
+TEST_F(SkinImageCacheTest, newAndModifiedImagesAreMisses) {
+    beginSkin();
+    getImage("a.png");
+    getImage("b.png");
+    endSkin();
+    ASSERT_EQ(2, renderCount());
+
+    // Not requested the last time
+    beginSkin();
+    getImage("a.png");
+    getImage("b.png");
+    EXPECT_EQ(2, renderCount());
+    getImage("c.png");
+    EXPECT_EQ(3, renderCount());
+    endSkin();
+
+    // The size is part of the key, like the modification time
+    writeFile(imagePath("b.png"), "modified");
+    beginSkin();
+    EXPECT_EQ(4, renderCount());
+    getImage("a.png");
+    getImage("b.png");
+    getImage("c.png");
+    EXPECT_EQ(4, renderCount());
+    endSkin();
+}
+
+TEST_F(SkinImageCacheTest, outsideOfSkinIsNotCached) {
+    getImage("a.png");
+    getImage("a.png");
+    EXPECT_EQ(2, renderCount());
+}
+
+TEST_F(SkinImageCacheTest, pruneLeastRecentlyUsedSkinCacheDirs) {
+    // Every color scheme has its own directory
+    const QStringList colorSchemes = QStringList()
+            << "Scheme1" << "Scheme2" << "Scheme3" << "Scheme4" << "Scheme5";
+    for (const auto& colorScheme: colorSchemes) {
+        beginSkin(colorScheme);
+        getImage("a.png");
+        endSkin();
+        // Distinct modification times of the manifests
+        SleepableQThread::msleep(20);
+    }
+    // The current one and the 3 most recently used ones
+    EXPECT_EQ(4, m_cacheDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot).size());
+
+    // The directory of the last one is still used
+    const int renderCountBefore = renderCount();
+    beginSkin(colorSchemes.last());
+    EXPECT_EQ(renderCountBefore, renderCount());
+    getImage("a.png");
+    EXPECT_EQ(renderCountBefore, renderCount());
+    endSkin();
+}
+
+} // anonymous namespace
@@ -4,9 +4,12 @@
 #include "test/mixxxtest.h"
 
 #include "sources/soundsourceproxy.h"
+#include "sources/audiosourcesplitdecoder.h"
 #include "sources/audiosourcestereoproxy.h"
 #include "track/trackmetadata.h"
+#include "util/math.h"
 #include "util/samplebuffer.h"
+#include "util/sleepableqthread.h"
 
 #ifdef __OPUS__
 #include "sources/soundsourceopus.h"
@@ -645,3 +648,290 @@ TEST_F(SoundSourceProxyTest, regressionTestCachingReaderChunkJumpForward) {
         }
     }
 }
+
+namespace {
+
+// Small chunks to test many chunk boundaries
+const SINT kSplitChunkFrameCount = 10000;
+const SINT kSplitThreadCount = 3;
+const SINT kSplitReadFrameCount = 4096;
+
+} // anonymous namespace
+
+class SoundSourceProxySplitDecodingTest : public SoundSourceProxyTest {
+  protected:
+    // Compares the split decoding of all test files with decoding them
+    // continuously, skipping the given number of frames after each read.
+    // Only files of providers that seek sample accurately are split.
+    void expectSplitDecodingEqual(SINT skipFrameCount) {
+        for (const auto& filePath: getFilePaths()) {
+            ASSERT_TRUE(SoundSourceProxy::isFileNameSupported(filePath));
+
+            SoundSourceProxy proxy(Track::newTemporary(filePath));
+            if (!proxy.getSoundSourceProvider() ||
+                    !proxy.getSoundSourceProvider()->isSeekingSampleAccurate()) {
+                continue;
+            }
+
+            qDebug() << "Split decoding test:" << filePath
+                    << "skipping" << skipFrameCount << "frames";
+
+            mixxx::AudioSourcePointer pContReadSource(openAudioSource(filePath));
+            // Obtaining an AudioSource may fail for unsupported file formats,
+            // even if the corresponding file extension is supported, e.g.
+            // AAC vs. ALAC in .m4a files
+            if (!pContReadSource) {
+                // skip test file
+                continue;
+            }
+            std::vector<mixxx::AudioSourcePointer> audioSources;
+            for (SINT i = 0; i < kSplitThreadCount; ++i) {
+                audioSources.push_back(openAudioSource(filePath));
+                ASSERT_FALSE(!audioSources.back());
+            }
+            mixxx::AudioSourceSplitDecoder splitDecoder(
+                    std::move(audioSources), kSplitChunkFrameCount);
+            ASSERT_EQ(pContReadSource->frameIndexRange(), splitDecoder.frameIndexRange());
+
+            mixxx::SampleBuffer contReadData(
+                    pContReadSource->frames2samples(kSplitReadFrameCount));
+            mixxx::SampleBuffer splitReadData(
+                    pContReadSource->frames2samples(kSplitReadFrameCount));
+            SINT frameIndex = pContReadSource->frameIndexMin();
+            while (pContReadSource->frameIndexRange().containsIndex(frameIndex)) {
+                const auto readFrameIndexRange =
+                        mixxx::IndexRange::forward(frameIndex, kSplitReadFrameCount);
+                const auto contSampleFrames =
+                        pContReadSource->readSampleFrames(
+                                mixxx::WritableSampleFrames(
+                                        readFrameIndexRange,
+                                        mixxx::SampleBuffer::WritableSlice(contReadData)));
+                const auto splitSampleFrames =
+                        splitDecoder.readSampleFrames(
+                                mixxx::WritableSampleFrames(
+                                        readFrameIndexRange,
+                                        mixxx::SampleBuffer::WritableSlice(splitReadData)));
+                ASSERT_FALSE(contSampleFrames.frameIndexRange().empty());
+                ASSERT_EQ(contSampleFrames.frameIndexRange(), splitSampleFrames.frameIndexRange());
+                expectDecodedSamplesEqual(
+                        pContReadSource->frames2samples(contSampleFrames.frameLength()),
+                        &contReadData[0],
+                        &splitReadData[0],
+                        "Decoding mismatch with split decoding");
+                frameIndex += contSampleFrames.frameLength() + skipFrameCount;
+            }
+        }
+    }
+};
+
+TEST_F(SoundSourceProxySplitDecodingTest, readContinuously) {
+    expectSplitDecodingEqual(0);
+}
+
+TEST_F(SoundSourceProxySplitDecodingTest, skipForward) {
+    // Skips more than one chunk, but stays within the chunks that are
+    // decoded ahead of the reader
+    expectSplitDecodingEqual(2 * kSplitChunkFrameCount + 1234);
+}
+
+class SoundSourceProxyDecodedAudioTest : public SoundSourceProxyTest {
+  protected:
+    void SetUp() override {
+        config()->setValue(
+                ConfigKey("[Library]", "DecodedAudioCacheEnabled"), true);
+        SoundSourceProxy::configureDecodedAudioCache(config());
+        m_pDecodedAudioCache = SoundSourceProxy::getDecodedAudioCache();
+        ASSERT_FALSE(!m_pDecodedAudioCache);
+    }
+
+    void TearDown() override {
+        m_pDecodedAudioCache.reset();
+        SoundSourceProxy::disableDecodedAudioCache();
+    }
+
+    // Copies the first test file of a provider that is expensive to
+    // decode, because only those are stored. Returns an empty string if
+    // none is available.
+    QString copyExpensiveTestFile() const {
+        for (const auto& filePath: getFilePaths()) {
+            SoundSourceProxy proxy(Track::newTemporary(filePath));
+            if (proxy.getSoundSourceProvider() &&
+                    proxy.getSoundSourceProvider()->isDecodingExpensive()) {
+                const QString copyPath = getTestDataDir().filePath(
+                        QFileInfo(filePath).fileName());
+                if (QFile::copy(filePath, copyPath)) {
+                    return copyPath;
+                }
+            }
+        }
+        qWarning() << "Disabling test, no provider is expensive to decode";
+        return QString();
+    }
+
+    static QString key(const QString& filePath) {
+        SoundSourceProxy proxy(Track::newTemporary(filePath));
+        return mixxx::DecodedAudioCache::key(
+                QFileInfo(filePath), proxy.getSoundSourceProvider());
+    }
+
+    // Opens the file through a proxy and waits until the decoded audio
+    // has been stored if requested
+    void openAndWait(const QString& filePath, bool storeDecodedAudio) {
+        SoundSourceProxy proxy(Track::newTemporary(filePath));
+        proxy.setStoreDecodedAudio(storeDecodedAudio);
+        EXPECT_FALSE(!proxy.openAudioSource());
+        m_pDecodedAudioCache->waitForDone();
+    }
+
+    // Returns true if any sample of the middle of the file is not silent
+    static bool readsSound(const QString& filePath) {
+        SoundSourceProxy proxy(Track::newTemporary(filePath));
+        auto pAudioSource = proxy.openAudioSource();
+        if (!pAudioSource) {
+            return false;
+        }
+        const auto frameIndexRange = mixxx::IndexRange::forward(
+                pAudioSource->frameIndexMin() +
+                        pAudioSource->frameLength() / 2,
+                math_min(SINT(4096), pAudioSource->frameLength() / 2));
+        mixxx::SampleBuffer buffer(
+                pAudioSource->frames2samples(frameIndexRange.length()));
+        const auto readable = pAudioSource->readSampleFrames(
+                mixxx::WritableSampleFrames(frameIndexRange,
+                        mixxx::SampleBuffer::WritableSlice(buffer)));
+        for (SINT i = 0; i < readable.readableLength(); ++i) {
+            if (readable.readableData()[i] != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Overwrites the samples of a stored file with silence, so that
+    // reading it can be distinguished from decoding the original file
+    static void silenceStoredFile(const QString& storedPath) {
+        QFile file(storedPath);
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        // Behind the WAV header
+        ASSERT_TRUE(file.seek(44));
+        const QByteArray silence(file.size() - 44, '\0');
+        ASSERT_EQ(silence.size(), file.write(silence));
+    }
+
+    std::shared_ptr<mixxx::DecodedAudioCache> m_pDecodedAudioCache;
+};
+
+TEST_F(SoundSourceProxyDecodedAudioTest, storeOnlyWhenRequested) {
+    const QString filePath = copyExpensiveTestFile();
+    if (filePath.isEmpty()) {
+        return;
+    }
+    // Like the analysis
+    openAndWait(filePath, false);
+    EXPECT_TRUE(m_pDecodedAudioCache->lookup(key(filePath)).isEmpty());
+    EXPECT_EQ(0, m_pDecodedAudioCache->totalSizeBytes());
+
+    // Like loading into a deck
+    openAndWait(filePath, true);
+    EXPECT_FALSE(m_pDecodedAudioCache->lookup(key(filePath)).isEmpty());
+    EXPECT_LT(0, m_pDecodedAudioCache->totalSizeBytes());
+}
+
+TEST_F(SoundSourceProxyDecodedAudioTest, serveFromStore) {
+    const QString filePath = copyExpensiveTestFile();
+    if (filePath.isEmpty()) {
+        return;
+    }
+    ASSERT_TRUE(readsSound(filePath));
+    openAndWait(filePath, true);
+    const QString storedPath = m_pDecodedAudioCache->lookup(key(filePath));
+    ASSERT_FALSE(storedPath.isEmpty());
+
+    silenceStoredFile(storedPath);
+    EXPECT_FALSE(readsSound(filePath));
+}
+
+TEST_F(SoundSourceProxyDecodedAudioTest, newKeyAfterModification) {
+    const QString filePath = copyExpensiveTestFile();
+    if (filePath.isEmpty()) {
+        return;
+    }
+    openAndWait(filePath, true);
+    const QString oldKey = key(filePath);
+    const QString storedPath = m_pDecodedAudioCache->lookup(oldKey);
+    ASSERT_FALSE(storedPath.isEmpty());
+    silenceStoredFile(storedPath);
+
+    // Rewrite the file with the same contents until the modification
+    // time has changed, depending on the resolution of the file system
+    QString newKey = oldKey;
+    for (int retry = 0; (newKey == oldKey) && (retry < 300); ++retry) {
+        SleepableQThread::msleep(10);
+        QFile file(filePath);
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        const QByteArray firstByte = file.read(1);
+        ASSERT_TRUE(file.seek(0));
+        ASSERT_EQ(1, file.write(firstByte));
+        file.close();
+        newKey = key(filePath);
+    }
+    ASSERT_NE(oldKey, newKey);
+
+    // The stale decoded audio is not served for the modified file
+    EXPECT_TRUE(m_pDecodedAudioCache->lookup(newKey).isEmpty());
+    EXPECT_TRUE(readsSound(filePath));
+    openAndWait(filePath, true);
+    EXPECT_FALSE(m_pDecodedAudioCache->lookup(newKey).isEmpty());
+}
+
+TEST_F(SoundSourceProxyDecodedAudioTest, removeStoredFileThatFailsToOpen) {
+    const QString filePath = copyExpensiveTestFile();
+    if (filePath.isEmpty()) {
+        return;
+    }
+    openAndWait(filePath, true);
+    const QString storedPath = m_pDecodedAudioCache->lookup(key(filePath));
+    ASSERT_FALSE(storedPath.isEmpty());
+    const qint64 totalSizeBytes = m_pDecodedAudioCache->totalSizeBytes();
+    const qint64 storedSizeBytes = QFileInfo(storedPath).size();
+
+    // A broken header with the same size
+    {
+        QFile file(storedPath);
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_EQ(4, file.write("XXXX", 4));
+    }
+    // Decoded from the original file and the entry is dropped
+    EXPECT_TRUE(readsSound(filePath));
+    EXPECT_TRUE(m_pDecodedAudioCache->lookup(key(filePath)).isEmpty());
+    EXPECT_EQ(totalSizeBytes - storedSizeBytes,
+            m_pDecodedAudioCache->totalSizeBytes());
+    EXPECT_FALSE(QFileInfo(storedPath).exists());
+}
+
+TEST_F(SoundSourceProxyDecodedAudioTest, disableWhileInUse) {
+    const QString filePath = copyExpensiveTestFile();
+    if (filePath.isEmpty()) {
+        return;
+    }
+    openAndWait(filePath, true);
+    const QString storedPath = m_pDecodedAudioCache->lookup(key(filePath));
+    ASSERT_FALSE(storedPath.isEmpty());
+
+    // The store is still referenced here like by a proxy that is
+    // reading from it
+    config()->setValue(
+            ConfigKey("[Library]", "DecodedAudioCacheEnabled"), false);
+    SoundSourceProxy::configureDecodedAudioCache(config());
+    EXPECT_TRUE(!SoundSourceProxy::getDecodedAudioCache());
+    EXPECT_FALSE(QFileInfo(storedPath).exists());
+
+    // Neither served nor stored again
+    EXPECT_TRUE(m_pDecodedAudioCache->lookup(key(filePath)).isEmpty());
+    m_pDecodedAudioCache->scheduleStore(key(filePath),
+            QUrl::fromLocalFile(filePath),
+            SoundSourceProxy(Track::newTemporary(filePath))
+                    .getSoundSourceProvider());
+    m_pDecodedAudioCache->waitForDone();
+    EXPECT_FALSE(m_pDecodedAudioCache->directory().exists());
+}
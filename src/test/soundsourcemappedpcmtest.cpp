@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <QDataStream>
+#include <QDir>
+#include <QTemporaryFile>
+#include <QVector>
+#include <QtDebug>
+
+#include "sources/soundsourcemappedpcm.h"
+#ifdef __SNDFILE__
+#include "sources/soundsourcesndfile.h"
+#endif
+#include "test/mixxxtest.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+const QDir kTestDir(QDir::current().absoluteFilePath("src/test/id3-test-data"));
+
+class SoundSourceMappedPcmTest : public MixxxTest {
+  protected:
+    // Writes a stereo 32 bit float WAV file with the given format tag
+    void writeWav(QTemporaryFile* pFile, quint16 formatTag,
+                  const QVector<float>& samples) {
+        ASSERT_TRUE(pFile->open());
+        QDataStream stream(pFile);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+        const quint32 dataSize = samples.size() * sizeof(float);
+        stream.writeRawData("RIFF", 4);
+        stream << quint32(4 + 24 + 8 + dataSize);
+        stream.writeRawData("WAVE", 4);
+        stream.writeRawData("fmt ", 4);
+        stream << quint32(16) << formatTag << quint16(2) << quint32(48000)
+               << quint32(48000 * 8) << quint16(8) << quint16(32);
+        stream.writeRawData("data", 4);
+        stream << dataSize;
+        for (float sample : samples) {
+            stream << sample;
+        }
+        pFile->close();
+    }
+};
+
+#ifdef __SNDFILE__
+TEST_F(SoundSourceMappedPcmTest, DecodesLikeSndFile) {
+    const QStringList fileNames = QStringList()
+            << "cover-test.wav" << "cover-test.aiff";
+    for (const QString& fileName : fileNames) {
+        const QUrl url = QUrl::fromLocalFile(kTestDir.absoluteFilePath(fileName));
+        mixxx::SoundSourceMappedPcm mappedSource(url);
+        mixxx::SoundSourceSndFile sndFileSource(url);
+        ASSERT_EQ(mixxx::AudioSource::OpenResult::Succeeded,
+                mappedSource.open(mixxx::AudioSource::OpenMode::Strict));
+        ASSERT_EQ(mixxx::AudioSource::OpenResult::Succeeded,
+                sndFileSource.open(mixxx::AudioSource::OpenMode::Strict));
+        ASSERT_EQ(sndFileSource.channelCount(), mappedSource.channelCount());
+        ASSERT_EQ(sndFileSource.sampleRate(), mappedSource.sampleRate());
+        ASSERT_TRUE(sndFileSource.frameIndexRange() == mappedSource.frameIndexRange());
+
+        // Starts in the middle, which requires a seek with libsndfile
+        const auto frameIndexRange = mixxx::IndexRange::forward(
+                mappedSource.frameLength() / 2, 4096);
+        mixxx::SampleBuffer expected(mappedSource.frames2samples(4096));
+        mixxx::SampleBuffer actual(mappedSource.frames2samples(4096));
+        sndFileSource.readSampleFrames(mixxx::WritableSampleFrames(
+                frameIndexRange, mixxx::SampleBuffer::WritableSlice(expected)));
+        const auto readable = mappedSource.readSampleFrames(
+                mixxx::WritableSampleFrames(frameIndexRange,
+                        mixxx::SampleBuffer::WritableSlice(actual)));
+        ASSERT_TRUE(frameIndexRange == readable.frameIndexRange());
+        for (SINT i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(expected[i], actual[i]) << fileName.toStdString();
+        }
+    }
+}
+#endif
+
+TEST_F(SoundSourceMappedPcmTest, ReadsFloatWav) {
+    QVector<float> samples;
+    for (int i = 0; i < 2000; ++i) {
+        samples.append((i % 200 - 100) / 100.0f);
+    }
+    QTemporaryFile file(QDir::tempPath() + "/XXXXXX.wav");
+    writeWav(&file, 0x0003, samples);
+
+    mixxx::SoundSourceMappedPcm source(QUrl::fromLocalFile(file.fileName()));
+    ASSERT_EQ(mixxx::AudioSource::OpenResult::Succeeded,
+            source.open(mixxx::AudioSource::OpenMode::Strict));
+    EXPECT_EQ(2, source.channelCount());
+    EXPECT_EQ(48000, source.sampleRate());
+    EXPECT_EQ(1000, source.frameLength());
+
+    // Read backwards in chunks, like a deck playing in reverse
+    mixxx::SampleBuffer buffer(2 * 100);
+    for (SINT frame = 900; frame >= 0; frame -= 100) {
+        const auto readable = source.readSampleFrames(
+                mixxx::WritableSampleFrames(
+                        mixxx::IndexRange::forward(frame, 100),
+                        mixxx::SampleBuffer::WritableSlice(buffer)));
+        ASSERT_EQ(100, readable.frameLength());
+        for (SINT i = 0; i < 2 * 100; ++i) {
+            EXPECT_EQ(samples[2 * frame + i], readable.readableData()[i]);
+        }
+    }
+}
+
+TEST_F(SoundSourceMappedPcmTest, AbortsUnsupportedFormat) {
+    QTemporaryFile file(QDir::tempPath() + "/XXXXXX.wav");
+    // WAVE_FORMAT_ADPCM is left to libsndfile
+    writeWav(&file, 0x0002, QVector<float>(16));
+
+    mixxx::SoundSourceMappedPcm source(QUrl::fromLocalFile(file.fileName()));
+    EXPECT_EQ(mixxx::AudioSource::OpenResult::Aborted,
+            source.open(mixxx::AudioSource::OpenMode::Strict));
+}
+
+}  // namespace
@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include "util/startupprofiler.h"
+
+namespace {
+
+TEST(StartupProfilerTest, ReportListsPhasesInOrderThenTasks) {
+    StartupProfiler profiler;
+    profiler.beginPhase("first");
+    {
+        StartupProfiler::TaskScope task(&profiler, "task");
+    }
+    profiler.beginPhase("second");
+
+    // The report ends the running phase
+    const QStringList lines = profiler.report();
+    ASSERT_EQ(5, lines.size());
+    EXPECT_TRUE(lines[1].startsWith("phase"));
+    EXPECT_TRUE(lines[1].contains("first"));
+    EXPECT_TRUE(lines[2].startsWith("phase"));
+    EXPECT_TRUE(lines[2].contains("second"));
+    EXPECT_TRUE(lines[3].startsWith("background"));
+    EXPECT_TRUE(lines[3].contains("task"));
+    EXPECT_TRUE(lines[4].startsWith("total"));
+}
+
+TEST(StartupProfilerTest, EndPhaseWithoutPhase) {
+    StartupProfiler profiler;
+    profiler.endPhase();
+    profiler.beginPhase("phase");
+    profiler.endPhase();
+    profiler.endPhase();
+
+    // Header, one phase and the total
+    EXPECT_EQ(3, profiler.report().size());
+}
+
+} // namespace
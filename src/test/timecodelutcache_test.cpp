@@ -0,0 +1,120 @@
+#ifdef __VINYLCONTROL__
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+#include <QFile>
+#include <QVector>
+
+#include "test/mixxxtest.h"
+#include "vinylcontrol/timecodelutcache.h"
+
+namespace {
+
+// The shortest timecode, so building its lookup table is fast
+const char* const kTimecode = "mixvibes_7inch";
+
+class TimecodeLutCacheTest : public MixxxTest {
+  protected:
+    TimecodeLutCacheTest()
+            : m_cacheDir(getTestDataDir().filePath("lut")) {
+    }
+
+    void TearDown() override {
+        TimecodeLutCache::freeLookupTables();
+    }
+
+    QString cacheFilePath() const {
+        return m_cacheDir.absoluteFilePath(QString("%1.lut").arg(kTimecode));
+    }
+
+    // Frees the lookup tables and returns the definition with the lookup
+    // table from the cache file, or built again if the file was rejected
+    timecode_def* reload() {
+        TimecodeLutCache::freeLookupTables();
+        return TimecodeLutCache::findDefinition(m_cacheDir, kTimecode);
+    }
+
+    // Overwrites the link to the next slot of a slot in the cache file
+    void writeNextSlot(const timecode_def& def, slot_no_t slotNo,
+            slot_no_t nextSlotNo) {
+        QFile file(cacheFilePath());
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        // The header is followed by the slots and the hash table
+        const qint64 headerSize = file.size() -
+                static_cast<qint64>(sizeof(struct slot)) * def.length -
+                static_cast<qint64>(sizeof(slot_no_t)) * (1 << HASH_BITS);
+        ASSERT_LT(0, headerSize);
+        ASSERT_TRUE(file.seek(headerSize + sizeof(struct slot) * slotNo +
+                offsetof(struct slot, next)));
+        ASSERT_EQ(static_cast<qint64>(sizeof(nextSlotNo)),
+                file.write(reinterpret_cast<const char*>(&nextSlotNo),
+                        sizeof(nextSlotNo)));
+    }
+
+    // Looks up the timecodes of every 1000th position
+    static QVector<unsigned int> lookupPositions(timecode_def* pDef) {
+        QVector<unsigned int> positions;
+        for (unsigned int slotNo = 0; slotNo < pDef->length; slotNo += 1000) {
+            positions.append(lut_lookup(&pDef->lut,
+                    pDef->lut.slot[slotNo].timecode));
+        }
+        return positions;
+    }
+
+    const QDir m_cacheDir;
+};
+
+TEST_F(TimecodeLutCacheTest, roundTrip) {
+    timecode_def* pDef = TimecodeLutCache::findDefinition(m_cacheDir, kTimecode);
+    ASSERT_TRUE(pDef != NULL);
+    EXPECT_TRUE(pDef->lookup);
+    EXPECT_FALSE(pDef->lookup_external);
+    ASSERT_TRUE(QFile::exists(cacheFilePath()));
+    const QVector<unsigned int> positions = lookupPositions(pDef);
+    for (int i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(static_cast<unsigned int>(i * 1000), positions[i]);
+    }
+
+    pDef = reload();
+    ASSERT_TRUE(pDef != NULL);
+    EXPECT_TRUE(pDef->lookup);
+    // Mapped from the file
+    EXPECT_TRUE(pDef->lookup_external);
+    EXPECT_EQ(positions, lookupPositions(pDef));
+}
+
+TEST_F(TimecodeLutCacheTest, rejectSlotOutOfBounds) {
+    timecode_def* pDef = TimecodeLutCache::findDefinition(m_cacheDir, kTimecode);
+    ASSERT_TRUE(pDef != NULL);
+    const QVector<unsigned int> positions = lookupPositions(pDef);
+    writeNextSlot(*pDef, 1000, pDef->length + 1000);
+
+    pDef = reload();
+    ASSERT_TRUE(pDef != NULL);
+    // Built again instead
+    EXPECT_FALSE(pDef->lookup_external);
+    EXPECT_EQ(positions, lookupPositions(pDef));
+
+    // The file has been replaced
+    pDef = reload();
+    ASSERT_TRUE(pDef != NULL);
+    EXPECT_TRUE(pDef->lookup_external);
+    EXPECT_EQ(positions, lookupPositions(pDef));
+}
+
+TEST_F(TimecodeLutCacheTest, rejectEndlessChain) {
+    timecode_def* pDef = TimecodeLutCache::findDefinition(m_cacheDir, kTimecode);
+    ASSERT_TRUE(pDef != NULL);
+    // Within bounds, but the chain would loop forever
+    writeNextSlot(*pDef, 1000, 1000);
+
+    pDef = reload();
+    ASSERT_TRUE(pDef != NULL);
+    EXPECT_FALSE(pDef->lookup_external);
+}
+
+} // anonymous namespace
+
+#endif // __VINYLCONTROL__
@@ -39,11 +39,12 @@ BeatGrid::BeatGrid(
         const Track& track,
         SINT iSampleRate)
         : m_mutex(QMutex::Recursive),
-          m_iSampleRate(iSampleRate > 0 ? iSampleRate : track.getSampleRate()),
-          m_dBeatLength(0.0) {
+          m_iSampleRate(iSampleRate > 0 ? iSampleRate : track.getSampleRate()) {
     // BeatGrid should live in the same thread as the track it is associated
     // with.
     moveToThread(track.thread());
+    // Publish an empty grid, so there always is a snapshot
+    updateSnapshot();
 }
 
 BeatGrid::BeatGrid(
@@ -59,9 +60,9 @@ BeatGrid::BeatGrid(const BeatGrid& other)
           m_mutex(QMutex::Recursive),
           m_subVersion(other.m_subVersion),
           m_iSampleRate(other.m_iSampleRate),
-          m_grid(other.m_grid),
-          m_dBeatLength(other.m_dBeatLength) {
+          m_grid(other.m_grid) {
     moveToThread(other.thread());
+    updateSnapshot();
 }
 
 void BeatGrid::setGrid(double dBpm, double dFirstBeatSample) {
@@ -72,8 +73,7 @@ void BeatGrid::setGrid(double dBpm, double dFirstBeatSample) {
     QMutexLocker lock(&m_mutex);
     m_grid.mutable_bpm()->set_bpm(dBpm);
     m_grid.mutable_first_beat()->set_frame_position(dFirstBeatSample / kFrameSize);
-    // Calculate beat length as sample offsets
-    m_dBeatLength = (60.0 * m_iSampleRate / dBpm) * kFrameSize;
+    updateSnapshot();
 }
 
 QByteArray BeatGrid::toByteArray() const {
@@ -93,7 +93,7 @@ void BeatGrid::readByteArray(const QByteArray& byteArray) {
     mixxx::track::io::BeatGrid grid;
     if (grid.ParseFromArray(byteArray.constData(), byteArray.length())) {
         m_grid = grid;
-        m_dBeatLength = (60.0 * m_iSampleRate / bpm()) * kFrameSize;
+        updateSnapshot();
         return;
     }
 
@@ -115,6 +115,15 @@ double BeatGrid::bpm() const {
     return m_grid.bpm().bpm();
 }
 
+void BeatGrid::updateSnapshot() {
+    Snapshot* pSnapshot = new Snapshot();
+    pSnapshot->firstBeatSample = firstBeatSample();
+    pSnapshot->bpm = bpm();
+    // Calculate beat length as sample offsets
+    pSnapshot->beatLength = (60.0 * m_iSampleRate / pSnapshot->bpm) * kFrameSize;
+    m_snapshot.publish(pSnapshot);
+}
+
 QString BeatGrid::getVersion() const {
     QMutexLocker locker(&m_mutex);
     return BEAT_GRID_2_VERSION;
@@ -134,6 +143,10 @@ bool BeatGrid::isValid() const {
     return m_iSampleRate > 0 && bpm() > 0;
 }
 
+bool BeatGrid::isValid(const Snapshot& snapshot) const {
+    return m_iSampleRate > 0 && snapshot.bpm > 0;
+}
+
 // This could be implemented in the Beats Class itself.
 // If necessary, the child class can redefine it.
 double BeatGrid::findNextBeat(double dSamples) const {
@@ -148,13 +161,13 @@ double BeatGrid::findPrevBeat(double dSamples) const {
 
 // This is an internal call. This could be implemented in the Beats Class itself.
 double BeatGrid::findClosestBeat(double dSamples) const {
-    QMutexLocker locker(&m_mutex);
-    if (!isValid()) {
+    SnapshotGuard snapshot = m_snapshot.read();
+    if (!isValid(*snapshot)) {
         return -1;
     }
     double prevBeat;
     double nextBeat;
-    findPrevNextBeats(dSamples, &prevBeat, &nextBeat);
+    findPrevNextBeats(*snapshot, dSamples, &prevBeat, &nextBeat);
     if (prevBeat == -1) {
         // If both values are -1, we correctly return -1.
         return nextBeat;
@@ -165,12 +178,18 @@ double BeatGrid::findClosestBeat(double dSamples) const {
 }
 
 double BeatGrid::findNthBeat(double dSamples, int n) const {
-    QMutexLocker locker(&m_mutex);
-    if (!isValid() || n == 0) {
+    SnapshotGuard snapshot = m_snapshot.read();
+    return findNthBeat(*snapshot, dSamples, n);
+}
+
+double BeatGrid::findNthBeat(const Snapshot& snapshot, double dSamples, int n) const {
+    if (!isValid(snapshot) || n == 0) {
         return -1;
     }
 
-    double beatFraction = (dSamples - firstBeatSample()) / m_dBeatLength;
+    const double dFirstBeatSample = snapshot.firstBeatSample;
+    const double dBeatLength = snapshot.beatLength;
+    double beatFraction = (dSamples - dFirstBeatSample) / dBeatLength;
     double prevBeat = floor(beatFraction);
     double nextBeat = ceil(beatFraction);
 
@@ -197,17 +216,17 @@ double BeatGrid::findNthBeat(double dSamples, int n) const {
     double dClosestBeat;
     if (n > 0) {
         // We're going forward, so use ceil to round up to the next multiple of
-        // m_dBeatLength
-        dClosestBeat = nextBeat * m_dBeatLength + firstBeatSample();
+        // dBeatLength
+        dClosestBeat = nextBeat * dBeatLength + dFirstBeatSample;
         n = n - 1;
     } else {
         // We're going backward, so use floor to round down to the next multiple
-        // of m_dBeatLength
-        dClosestBeat = prevBeat * m_dBeatLength + firstBeatSample();
+        // of dBeatLength
+        dClosestBeat = prevBeat * dBeatLength + dFirstBeatSample;
         n = n + 1;
     }
 
-    double dResult = floor(dClosestBeat + n * m_dBeatLength);
+    double dResult = floor(dClosestBeat + n * dBeatLength);
     if (!even(static_cast<int>(dResult))) {
         dResult--;
     }
@@ -217,18 +236,22 @@ double BeatGrid::findNthBeat(double dSamples, int n) const {
 bool BeatGrid::findPrevNextBeats(double dSamples,
                                  double* dpPrevBeatSamples,
                                  double* dpNextBeatSamples) const {
-    double dFirstBeatSample;
-    double dBeatLength;
-    {
-        QMutexLocker locker(&m_mutex);
-        if (!isValid()) {
-            *dpPrevBeatSamples = -1.0;
-            *dpNextBeatSamples = -1.0;
-            return false;
-        }
-        dFirstBeatSample = firstBeatSample();
-        dBeatLength = m_dBeatLength;
+    SnapshotGuard snapshot = m_snapshot.read();
+    return findPrevNextBeats(*snapshot, dSamples,
+            dpPrevBeatSamples, dpNextBeatSamples);
+}
+
+bool BeatGrid::findPrevNextBeats(const Snapshot& snapshot,
+                                 double dSamples,
+                                 double* dpPrevBeatSamples,
+                                 double* dpNextBeatSamples) const {
+    if (!isValid(snapshot)) {
+        *dpPrevBeatSamples = -1.0;
+        *dpNextBeatSamples = -1.0;
+        return false;
     }
+    const double dFirstBeatSample = snapshot.firstBeatSample;
+    const double dBeatLength = snapshot.beatLength;
 
     double beatFraction = (dSamples - dFirstBeatSample) / dBeatLength;
     double prevBeat = floor(beatFraction);
@@ -260,25 +283,25 @@ bool BeatGrid::findPrevNextBeats(double dSamples,
 
 
 std::unique_ptr<BeatIterator> BeatGrid::findBeats(double startSample, double stopSample) const {
-    QMutexLocker locker(&m_mutex);
-    if (!isValid() || startSample > stopSample) {
+    SnapshotGuard snapshot = m_snapshot.read();
+    if (!isValid(*snapshot) || startSample > stopSample) {
         return std::unique_ptr<BeatIterator>();
     }
     // qDebug() << "BeatGrid::findBeats startSample" << startSample << "stopSample"
-    //          << stopSample << "beatlength" << m_dBeatLength << "BPM" << bpm();
-    double curBeat = findNextBeat(startSample);
+    //          << stopSample << "beatlength" << snapshot->beatLength << "BPM" << snapshot->bpm;
+    double curBeat = findNthBeat(*snapshot, startSample, 1);
     if (curBeat == -1.0) {
         return std::unique_ptr<BeatIterator>();
     }
-    return std::make_unique<BeatGridIterator>(m_dBeatLength, curBeat, stopSample);
+    return std::make_unique<BeatGridIterator>(snapshot->beatLength, curBeat, stopSample);
 }
 
 bool BeatGrid::hasBeatInRange(double startSample, double stopSample) const {
-    QMutexLocker locker(&m_mutex);
-    if (!isValid() || startSample > stopSample) {
+    SnapshotGuard snapshot = m_snapshot.read();
+    if (!isValid(*snapshot) || startSample > stopSample) {
         return false;
     }
-    double curBeat = findNextBeat(startSample);
+    double curBeat = findNthBeat(*snapshot, startSample, 1);
     if (curBeat != -1.0 && curBeat <= stopSample) {
         return true;
     }
@@ -286,30 +309,30 @@ bool BeatGrid::hasBeatInRange(double startSample, double stopSample) const {
 }
 
 double BeatGrid::getBpm() const {
-    QMutexLocker locker(&m_mutex);
-    if (!isValid()) {
+    SnapshotGuard snapshot = m_snapshot.read();
+    if (!isValid(*snapshot)) {
         return 0;
     }
-    return bpm();
+    return snapshot->bpm;
 }
 
 double BeatGrid::getBpmRange(double startSample, double stopSample) const {
-    QMutexLocker locker(&m_mutex);
-    if (!isValid() || startSample > stopSample) {
+    SnapshotGuard snapshot = m_snapshot.read();
+    if (!isValid(*snapshot) || startSample > stopSample) {
         return -1;
     }
-    return bpm();
+    return snapshot->bpm;
 }
 
 double BeatGrid::getBpmAroundPosition(double curSample, int n) const {
     Q_UNUSED(curSample);
     Q_UNUSED(n);
 
-    QMutexLocker locker(&m_mutex);
-    if (!isValid()) {
+    SnapshotGuard snapshot = m_snapshot.read();
+    if (!isValid(*snapshot)) {
         return -1;
     }
-    return bpm();
+    return snapshot->bpm;
 }
 
 void BeatGrid::addBeat(double dBeatSample) {
@@ -338,6 +361,7 @@ void BeatGrid::translate(double dNumSamples) {
     }
     double newFirstBeatFrames = (firstBeatSample() + dNumSamples) / kFrameSize;
     m_grid.mutable_first_beat()->set_frame_position(newFirstBeatFrames);
+    updateSnapshot();
     locker.unlock();
     emit(updated());
 }
@@ -377,7 +401,7 @@ void BeatGrid::setBpm(double dBpm) {
         dBpm = getMaxBpm();
     }
     m_grid.mutable_bpm()->set_bpm(dBpm);
-    m_dBeatLength = (60.0 * m_iSampleRate / dBpm) * kFrameSize;
+    updateSnapshot();
     locker.unlock();
     emit(updated());
 }
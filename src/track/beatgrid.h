@@ -7,6 +7,7 @@
 #include "track/track.h"
 #include "track/beats.h"
 #include "proto/beats.pb.h"
+#include "util/rcupointer.h"
 
 #define BEAT_GRID_1_VERSION "BeatGrid-1.0"
 #define BEAT_GRID_2_VERSION "BeatGrid-2.0"
@@ -77,14 +78,32 @@ class BeatGrid : public QObject, public virtual Beats {
     void updated();
 
   private:
+    // The grid published for queries whenever it changes, so they never
+    // wait for an edit.
+    struct Snapshot {
+        double firstBeatSample;
+        double bpm;
+        // The length of a beat in samples
+        double beatLength;
+    };
+    typedef RcuPointer<Snapshot>::ReadGuard SnapshotGuard;
+
     BeatGrid(const BeatGrid& other);
     double firstBeatSample() const;
     double bpm() const;
+    void updateSnapshot();
 
     void readByteArray(const QByteArray& byteArray);
+    double findNthBeat(const Snapshot& snapshot, double dSamples, int n) const;
+    bool findPrevNextBeats(const Snapshot& snapshot,
+                           double dSamples,
+                           double* dpPrevBeatSamples,
+                           double* dpNextBeatSamples) const;
     // For internal use only.
     bool isValid() const;
+    bool isValid(const Snapshot& snapshot) const;
 
+    // Serializes the edits of m_grid, queries do not take it
     mutable QMutex m_mutex;
     // The sub-version of this beatgrid.
     QString m_subVersion;
@@ -92,8 +111,7 @@ class BeatGrid : public QObject, public virtual Beats {
     SINT m_iSampleRate;
     // Data storage for BeatGrid
     mixxx::track::io::BeatGrid m_grid;
-    // The length of a beat in samples
-    double m_dBeatLength;
+    RcuPointer<Snapshot> m_snapshot;
 };
 
 
@@ -9,6 +9,8 @@
 #include <QtGlobal>
 #include <QMutexLocker>
 
+#include <algorithm>
+
 #include "track/beatmap.h"
 #include "track/beatutils.h"
 #include "util/math.h"
@@ -29,13 +31,16 @@ bool BeatLessThan(const Beat& beat1, const Beat& beat2) {
     return beat1.frame_position() < beat2.frame_position();
 }
 
+// Iterates the snapshot that was current when it was created, even if the
+// beats are edited in the meantime.
 class BeatMapIterator : public BeatIterator {
   public:
-    BeatMapIterator(BeatList::const_iterator start, BeatList::const_iterator end)
-            : m_currentBeat(start),
+    BeatMapIterator(BeatMap::SnapshotGuard&& snapshot, int start, int end)
+            : m_snapshot(std::move(snapshot)),
+              m_currentBeat(start),
               m_endBeat(end) {
         // Advance to the first enabled beat.
-        while (m_currentBeat != m_endBeat && !m_currentBeat->enabled()) {
+        while (m_currentBeat != m_endBeat && !m_snapshot->enabled[m_currentBeat]) {
             ++m_currentBeat;
         }
     }
@@ -45,27 +50,28 @@ class BeatMapIterator : public BeatIterator {
     }
 
     virtual double next() {
-        double beat = framesToSamples(m_currentBeat->frame_position());
+        double beat = framesToSamples(m_snapshot->frames[m_currentBeat]);
         ++m_currentBeat;
-        while (m_currentBeat != m_endBeat && !m_currentBeat->enabled()) {
+        while (m_currentBeat != m_endBeat && !m_snapshot->enabled[m_currentBeat]) {
             ++m_currentBeat;
         }
         return beat;
     }
 
   private:
-    BeatList::const_iterator m_currentBeat;
-    BeatList::const_iterator m_endBeat;
+    const BeatMap::SnapshotGuard m_snapshot;
+    int m_currentBeat;
+    const int m_endBeat;
 };
 
 BeatMap::BeatMap(const Track& track, SINT iSampleRate)
         : m_mutex(QMutex::Recursive),
-          m_iSampleRate(iSampleRate > 0 ? iSampleRate : track.getSampleRate()),
-          m_dCachedBpm(0),
-          m_dLastFrame(0) {
+          m_iSampleRate(iSampleRate > 0 ? iSampleRate : track.getSampleRate()) {
     // BeatMap should live in the same thread as the track it is associated
     // with.
     moveToThread(track.thread());
+    // Publish an empty snapshot, so there always is one
+    onBeatlistChanged();
 }
 
 BeatMap::BeatMap(const Track& track, SINT iSampleRate,
@@ -87,10 +93,9 @@ BeatMap::BeatMap (const BeatMap& other)
           m_mutex(QMutex::Recursive),
           m_subVersion(other.m_subVersion),
           m_iSampleRate(other.m_iSampleRate),
-          m_dCachedBpm(other.m_dCachedBpm),
-          m_dLastFrame(other.m_dLastFrame),
           m_beats(other.m_beats) {
     moveToThread(other.thread());
+    onBeatlistChanged();
 }
 
 QByteArray BeatMap::toByteArray() const {
@@ -169,6 +174,10 @@ bool BeatMap::isValid() const {
     return m_iSampleRate > 0 && m_beats.size() > 0;
 }
 
+bool BeatMap::isValid(const Snapshot& snapshot) const {
+    return m_iSampleRate > 0 && !snapshot.frames.empty();
+}
+
 double BeatMap::findNextBeat(double dSamples) const {
     return findNthBeat(dSamples, 1);
 }
@@ -178,13 +187,13 @@ double BeatMap::findPrevBeat(double dSamples) const {
 }
 
 double BeatMap::findClosestBeat(double dSamples) const {
-    QMutexLocker locker(&m_mutex);
-    if (!isValid()) {
+    SnapshotGuard snapshot = m_snapshot.read();
+    if (!isValid(*snapshot)) {
         return -1;
     }
     double prevBeat;
     double nextBeat;
-    findPrevNextBeats(dSamples, &prevBeat, &nextBeat);
+    findPrevNextBeats(*snapshot, dSamples, &prevBeat, &nextBeat);
     if (prevBeat == -1) {
         // If both values are -1, we correctly return -1.
         return nextBeat;
@@ -195,50 +204,53 @@ double BeatMap::findClosestBeat(double dSamples) const {
 }
 
 double BeatMap::findNthBeat(double dSamples, int n) const {
-    QMutexLocker locker(&m_mutex);
+    SnapshotGuard snapshot = m_snapshot.read();
+    return findNthBeat(*snapshot, dSamples, n);
+}
 
-    if (!isValid() || n == 0) {
+double BeatMap::findNthBeat(const Snapshot& snapshot, double dSamples, int n) const {
+    if (!isValid(snapshot) || n == 0) {
         return -1;
     }
 
-    Beat beat;
+    const std::vector<qint32>& frames = snapshot.frames;
+    const int beatCount = static_cast<int>(frames.size());
     // Reduce sample offset to a frame offset.
-    beat.set_frame_position(samplesToFrames(dSamples));
+    const qint32 frame = static_cast<qint32>(samplesToFrames(dSamples));
 
-    // it points at the first occurrence of beat or the next largest beat
-    BeatList::const_iterator it =
-            qLowerBound(m_beats.begin(), m_beats.end(), beat, BeatLessThan);
+    // i points at the first occurrence of frame or the next largest beat
+    int i = std::lower_bound(frames.begin(), frames.end(), frame) - frames.begin();
 
     // If the position is within 1/10th of a second of the next or previous
     // beat, pretend we are on that beat.
     const double kFrameEpsilon = 0.1 * m_iSampleRate;
 
     // Back-up by one.
-    if (it != m_beats.begin()) {
-        --it;
+    if (i > 0) {
+        --i;
     }
 
     // Scan forward to find whether we are on a beat.
-    BeatList::const_iterator on_beat = m_beats.end();
-    BeatList::const_iterator previous_beat = m_beats.end();
-    BeatList::const_iterator next_beat = m_beats.end();
-    for (; it != m_beats.end(); ++it) {
-        qint32 delta = it->frame_position() - beat.frame_position();
+    int onBeat = -1;
+    int previousBeat = -1;
+    int nextBeat = beatCount;
+    for (; i < beatCount; ++i) {
+        qint32 delta = frames[i] - frame;
 
         // We are "on" this beat.
         if (abs(delta) < kFrameEpsilon) {
-            on_beat = it;
+            onBeat = i;
             break;
         }
 
         if (delta < 0) {
             // If we are not on the beat and delta < 0 then this beat comes
             // before our current position.
-            previous_beat = it;
+            previousBeat = i;
         } else {
             // If we are past the beat and we aren't on it then this beat comes
             // after our current position.
-            next_beat = it;
+            nextBeat = i;
             // Stop because we have everything we need now.
             break;
         }
@@ -246,36 +258,32 @@ double BeatMap::findNthBeat(double dSamples, int n) const {
 
     // If we are within epsilon samples of a beat then the immediately next and
     // previous beats are the beat we are on.
-    if (on_beat != m_beats.end()) {
-        next_beat = on_beat;
-        previous_beat = on_beat;
+    if (onBeat != -1) {
+        nextBeat = onBeat;
+        previousBeat = onBeat;
     }
 
     if (n > 0) {
-        for (; next_beat != m_beats.end(); ++next_beat) {
-            if (!next_beat->enabled()) {
+        for (; nextBeat < beatCount; ++nextBeat) {
+            if (!snapshot.enabled[nextBeat]) {
                 continue;
             }
             if (n == 1) {
                 // Return a sample offset
-                return framesToSamples(next_beat->frame_position());
+                return framesToSamples(frames[nextBeat]);
             }
             --n;
         }
-    } else if (n < 0 && previous_beat != m_beats.end()) {
-        for (; true; --previous_beat) {
-            if (previous_beat->enabled()) {
+    } else if (n < 0) {
+        // Don't step before the start of the list.
+        for (; previousBeat >= 0; --previousBeat) {
+            if (snapshot.enabled[previousBeat]) {
                 if (n == -1) {
                     // Return a sample offset
-                    return framesToSamples(previous_beat->frame_position());
+                    return framesToSamples(frames[previousBeat]);
                 }
                 ++n;
             }
-
-            // Don't step before the start of the list.
-            if (previous_beat == m_beats.begin()) {
-                break;
-            }
         }
     }
     return -1;
@@ -284,52 +292,59 @@ double BeatMap::findNthBeat(double dSamples, int n) const {
 bool BeatMap::findPrevNextBeats(double dSamples,
                                 double* dpPrevBeatSamples,
                                 double* dpNextBeatSamples) const {
-    QMutexLocker locker(&m_mutex);
+    SnapshotGuard snapshot = m_snapshot.read();
+    return findPrevNextBeats(*snapshot, dSamples,
+            dpPrevBeatSamples, dpNextBeatSamples);
+}
 
-    if (!isValid()) {
+bool BeatMap::findPrevNextBeats(const Snapshot& snapshot,
+                                double dSamples,
+                                double* dpPrevBeatSamples,
+                                double* dpNextBeatSamples) const {
+    if (!isValid(snapshot)) {
         *dpPrevBeatSamples = -1;
         *dpNextBeatSamples = -1;
         return false;
     }
 
-    Beat beat;
+    const std::vector<qint32>& frames = snapshot.frames;
+    const int beatCount = static_cast<int>(frames.size());
     // Reduce sample offset to a frame offset.
-    beat.set_frame_position(samplesToFrames(dSamples));
+    const qint32 frame = static_cast<qint32>(samplesToFrames(dSamples));
 
-    // it points at the first occurrence of beat or the next largest beat
-    BeatList::const_iterator it =
-            qLowerBound(m_beats.begin(), m_beats.end(), beat, BeatLessThan);
+    // i points at the first occurrence of frame or the next largest beat
+    int i = std::lower_bound(frames.begin(), frames.end(), frame) - frames.begin();
 
     // If the position is within 1/10th of a second of the next or previous
     // beat, pretend we are on that beat.
     const double kFrameEpsilon = 0.1 * m_iSampleRate;
 
     // Back-up by one.
-    if (it != m_beats.begin()) {
-        --it;
+    if (i > 0) {
+        --i;
     }
 
     // Scan forward to find whether we are on a beat.
-    BeatList::const_iterator on_beat = m_beats.end();
-    BeatList::const_iterator previous_beat = m_beats.end();
-    BeatList::const_iterator next_beat = m_beats.end();
-    for (; it != m_beats.end(); ++it) {
-        qint32 delta = it->frame_position() - beat.frame_position();
+    int onBeat = -1;
+    int previousBeat = -1;
+    int nextBeat = beatCount;
+    for (; i < beatCount; ++i) {
+        qint32 delta = frames[i] - frame;
 
         // We are "on" this beat.
         if (abs(delta) < kFrameEpsilon) {
-            on_beat = it;
+            onBeat = i;
             break;
         }
 
         if (delta < 0) {
             // If we are not on the beat and delta < 0 then this beat comes
             // before our current position.
-            previous_beat = it;
+            previousBeat = i;
         } else {
             // If we are past the beat and we aren't on it then this beat comes
             // after our current position.
-            next_beat = it;
+            nextBeat = i;
             // Stop because we have everything we need now.
             break;
         }
@@ -337,69 +352,58 @@ bool BeatMap::findPrevNextBeats(double dSamples,
 
     // If we are within epsilon samples of a beat then the immediately next and
     // previous beats are the beat we are on.
-    if (on_beat != m_beats.end()) {
-        previous_beat = on_beat;
-        next_beat = on_beat + 1;
+    if (onBeat != -1) {
+        previousBeat = onBeat;
+        nextBeat = onBeat + 1;
     }
 
     *dpPrevBeatSamples = -1;
     *dpNextBeatSamples = -1;
 
-    for (; next_beat != m_beats.end(); ++next_beat) {
-        if (!next_beat->enabled()) {
+    for (; nextBeat < beatCount; ++nextBeat) {
+        if (!snapshot.enabled[nextBeat]) {
             continue;
         }
-        *dpNextBeatSamples = framesToSamples(next_beat->frame_position());
+        *dpNextBeatSamples = framesToSamples(frames[nextBeat]);
         break;
     }
-    if (previous_beat != m_beats.end()) {
-        for (; true; --previous_beat) {
-            if (previous_beat->enabled()) {
-                *dpPrevBeatSamples = framesToSamples(previous_beat->frame_position());
-                break;
-            }
-
-            // Don't step before the start of the list.
-            if (previous_beat == m_beats.begin()) {
-                break;
-            }
+    // Don't step before the start of the list.
+    for (; previousBeat >= 0; --previousBeat) {
+        if (snapshot.enabled[previousBeat]) {
+            *dpPrevBeatSamples = framesToSamples(frames[previousBeat]);
+            break;
         }
     }
     return *dpPrevBeatSamples != -1 && *dpNextBeatSamples != -1;
 }
 
 std::unique_ptr<BeatIterator> BeatMap::findBeats(double startSample, double stopSample) const {
-    QMutexLocker locker(&m_mutex);
+    SnapshotGuard snapshot = m_snapshot.read();
     //startSample and stopSample are sample offsets, converting them to
     //frames
-    if (!isValid() || startSample > stopSample) {
+    if (!isValid(*snapshot) || startSample > stopSample) {
         return std::unique_ptr<BeatIterator>();
     }
 
-    Beat startBeat, stopBeat;
-    startBeat.set_frame_position(samplesToFrames(startSample));
-    stopBeat.set_frame_position(samplesToFrames(stopSample));
-
-    BeatList::const_iterator curBeat =
-            qLowerBound(m_beats.begin(), m_beats.end(),
-                        startBeat, BeatLessThan);
-
-    BeatList::const_iterator lastBeat =
-            qUpperBound(m_beats.begin(), m_beats.end(),
-                        stopBeat, BeatLessThan);
+    const std::vector<qint32>& frames = snapshot->frames;
+    const int curBeat = std::lower_bound(frames.begin(), frames.end(),
+            static_cast<qint32>(samplesToFrames(startSample))) - frames.begin();
+    const int lastBeat = std::upper_bound(frames.begin(), frames.end(),
+            static_cast<qint32>(samplesToFrames(stopSample))) - frames.begin();
 
     if (curBeat >= lastBeat) {
         return std::unique_ptr<BeatIterator>();
     }
-    return std::make_unique<BeatMapIterator>(curBeat, lastBeat);
+    return std::make_unique<BeatMapIterator>(
+            std::move(snapshot), curBeat, lastBeat);
 }
 
 bool BeatMap::hasBeatInRange(double startSample, double stopSample) const {
-    QMutexLocker locker(&m_mutex);
-    if (!isValid() || startSample > stopSample) {
+    SnapshotGuard snapshot = m_snapshot.read();
+    if (!isValid(*snapshot) || startSample > stopSample) {
         return false;
     }
-    double curBeat = findNextBeat(startSample);
+    double curBeat = findNthBeat(*snapshot, startSample, 1);
     if (curBeat <= stopSample) {
         return true;
     }
@@ -407,51 +411,52 @@ bool BeatMap::hasBeatInRange(double startSample, double stopSample) const {
 }
 
 double BeatMap::getBpm() const {
-    QMutexLocker locker(&m_mutex);
-    if (!isValid())
+    SnapshotGuard snapshot = m_snapshot.read();
+    if (!isValid(*snapshot))
         return -1;
-    return m_dCachedBpm;
+    return snapshot->bpm;
 }
 
 double BeatMap::getBpmRange(double startSample, double stopSample) const {
-    QMutexLocker locker(&m_mutex);
-    if (!isValid())
+    SnapshotGuard snapshot = m_snapshot.read();
+    if (!isValid(*snapshot))
         return -1;
-    Beat startBeat, stopBeat;
-    startBeat.set_frame_position(samplesToFrames(startSample));
-    stopBeat.set_frame_position(samplesToFrames(stopSample));
-    return calculateBpm(startBeat, stopBeat);
+    return calculateBpm(*snapshot,
+            static_cast<qint32>(samplesToFrames(startSample)),
+            static_cast<qint32>(samplesToFrames(stopSample)));
 }
 
 double BeatMap::getBpmAroundPosition(double curSample, int n) const {
-    QMutexLocker locker(&m_mutex);
-    if (!isValid())
+    SnapshotGuard snapshot = m_snapshot.read();
+    if (!isValid(*snapshot))
         return -1;
 
+    const double firstBeatSample = framesToSamples(snapshot->frames.front());
+    const double lastBeatSample = framesToSamples(snapshot->frames.back());
+
     // To make sure we are always counting n beats, iterate backward to the
     // lower bound, then iterate forward from there to the upper bound.
     // a value of -1 indicates we went off the map -- count from the beginning.
-    double lower_bound = findNthBeat(curSample, -n);
+    double lower_bound = findNthBeat(*snapshot, curSample, -n);
     if (lower_bound == -1) {
-        lower_bound = framesToSamples(m_beats.first().frame_position());
+        lower_bound = firstBeatSample;
     }
 
     // If we hit the end of the beat map, recalculate the lower bound.
-    double upper_bound = findNthBeat(lower_bound, n * 2);
+    double upper_bound = findNthBeat(*snapshot, lower_bound, n * 2);
     if (upper_bound == -1) {
-        upper_bound = framesToSamples(m_beats.last().frame_position());
-        lower_bound = findNthBeat(upper_bound, n * -2);
+        upper_bound = lastBeatSample;
+        lower_bound = findNthBeat(*snapshot, upper_bound, n * -2);
         // Super edge-case -- the track doesn't have n beats!  Do the best
         // we can.
         if (lower_bound == -1) {
-            lower_bound = framesToSamples(m_beats.first().frame_position());
+            lower_bound = firstBeatSample;
         }
     }
 
-    Beat startBeat, stopBeat;
-    startBeat.set_frame_position(samplesToFrames(lower_bound));
-    stopBeat.set_frame_position(samplesToFrames(upper_bound));
-    return calculateBpm(startBeat, stopBeat);
+    return calculateBpm(*snapshot,
+            static_cast<qint32>(samplesToFrames(lower_bound)),
+            static_cast<qint32>(samplesToFrames(upper_bound)));
 }
 
 void BeatMap::addBeat(double dBeatSample) {
@@ -716,33 +721,37 @@ void BeatMap::setBpm(double dBpm) {
 }
 
 void BeatMap::onBeatlistChanged() {
-    if (!isValid()) {
-        m_dLastFrame = 0;
-        m_dCachedBpm = 0;
-        return;
+    Snapshot* pSnapshot = new Snapshot();
+    pSnapshot->frames.reserve(m_beats.size());
+    pSnapshot->enabled.reserve(m_beats.size());
+    for (const Beat& beat : m_beats) {
+        pSnapshot->frames.push_back(beat.frame_position());
+        pSnapshot->enabled.push_back(beat.enabled());
     }
-    m_dLastFrame = m_beats.last().frame_position();
-    Beat startBeat = m_beats.first();
-    Beat stopBeat =  m_beats.last();
-    m_dCachedBpm = calculateBpm(startBeat, stopBeat);
+    pSnapshot->bpm = 0;
+    if (isValid(*pSnapshot)) {
+        pSnapshot->bpm = calculateBpm(*pSnapshot,
+                pSnapshot->frames.front(), pSnapshot->frames.back());
+    }
+    m_snapshot.publish(pSnapshot);
 }
 
-double BeatMap::calculateBpm(const Beat& startBeat, const Beat& stopBeat) const {
-    if (startBeat.frame_position() > stopBeat.frame_position()) {
+double BeatMap::calculateBpm(const Snapshot& snapshot,
+                             qint32 startFrame, qint32 stopFrame) const {
+    if (startFrame > stopFrame) {
         return -1;
     }
 
-    BeatList::const_iterator curBeat =
-            qLowerBound(m_beats.begin(), m_beats.end(), startBeat, BeatLessThan);
-
-    BeatList::const_iterator lastBeat =
-            qUpperBound(m_beats.begin(), m_beats.end(), stopBeat, BeatLessThan);
+    const std::vector<qint32>& frames = snapshot.frames;
+    const int firstBeat = std::lower_bound(frames.begin(), frames.end(),
+            startFrame) - frames.begin();
+    const int lastBeat = std::upper_bound(frames.begin(), frames.end(),
+            stopFrame) - frames.begin();
 
     QVector<double> beatvect;
-    for (; curBeat != lastBeat; ++curBeat) {
-        const Beat& beat = *curBeat;
-        if (beat.enabled()) {
-            beatvect.append(beat.frame_position());
+    for (int i = firstBeat; i < lastBeat; ++i) {
+        if (snapshot.enabled[i]) {
+            beatvect.append(frames[i]);
         }
     }
 
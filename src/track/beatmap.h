@@ -11,9 +11,12 @@
 #include <QObject>
 #include <QMutex>
 
+#include <vector>
+
 #include "track/track.h"
 #include "track/beats.h"
 #include "proto/beats.pb.h"
+#include "util/rcupointer.h"
 
 #define BEAT_MAP_VERSION "BeatMap-1.0"
 
@@ -86,15 +89,33 @@ class BeatMap : public QObject, public Beats {
     void updated();
 
   private:
+    // The beats as plain arrays, published whenever the beat list changes.
+    // All queries run on a snapshot and never wait for an edit, which keeps
+    // them safe to call from the engine thread.
+    struct Snapshot {
+        // The frame positions of all beats in ascending order
+        std::vector<qint32> frames;
+        // Whether the beat at the same index is enabled
+        std::vector<bool> enabled;
+        double bpm;
+    };
+    typedef RcuPointer<Snapshot>::ReadGuard SnapshotGuard;
+
     BeatMap(const BeatMap& other);
     bool readByteArray(const QByteArray& byteArray);
     void createFromBeatVector(const QVector<double>& beats);
     void onBeatlistChanged();
 
-    double calculateBpm(const mixxx::track::io::Beat& startBeat,
-                        const mixxx::track::io::Beat& stopBeat) const;
+    double findNthBeat(const Snapshot& snapshot, double dSamples, int n) const;
+    bool findPrevNextBeats(const Snapshot& snapshot,
+                           double dSamples,
+                           double* dpPrevBeatSamples,
+                           double* dpNextBeatSamples) const;
+    double calculateBpm(const Snapshot& snapshot,
+                        qint32 startFrame, qint32 stopFrame) const;
     // For internal use only.
     bool isValid() const;
+    bool isValid(const Snapshot& snapshot) const;
 
     void scaleDouble();
     void scaleTriple();
@@ -103,12 +124,14 @@ class BeatMap : public QObject, public Beats {
     void scaleThird();
     void scaleFourth();
 
+    // Serializes the edits of m_beats, queries do not take it
     mutable QMutex m_mutex;
     QString m_subVersion;
     SINT m_iSampleRate;
-    double m_dCachedBpm;
-    double m_dLastFrame;
     BeatList m_beats;
+    RcuPointer<Snapshot> m_snapshot;
+
+    friend class BeatMapIterator;
 };
 
 #endif /* BEATMAP_H_ */
@@ -0,0 +1,166 @@
+#include "util/chrometrace.h"
+
+#include <QFile>
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QTextStream>
+#include <QtDebug>
+
+namespace {
+
+// All threads belong to the Mixxx process
+const int kProcessId = 1;
+
+const QString kTraceDurationSuffix = "_duration";
+
+QString escapeJson(const QString& string) {
+    QString result;
+    result.reserve(string.size());
+    for (const QChar c: string) {
+        switch (c.unicode()) {
+        case '"':
+            result += "\\\"";
+            break;
+        case '\\':
+            result += "\\\\";
+            break;
+        case '\n':
+            result += "\\n";
+            break;
+        case '\t':
+            result += "\\t";
+            break;
+        default:
+            if (c.unicode() < 0x20) {
+                result += QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+            } else {
+                result += c;
+            }
+        }
+    }
+    return result;
+}
+
+// The trace event format counts in microseconds
+QString micros(double nanos) {
+    return QString::number(nanos / 1000.0, 'f', 3);
+}
+
+double durationNanos(Stat::StatType type, double value) {
+    switch (type) {
+    case Stat::DURATION_SEC:
+        return value * 1e9;
+    case Stat::DURATION_MSEC:
+        return value * 1e6;
+    default:
+        return value;
+    }
+}
+
+} // anonymous namespace
+
+void ChromeTrace::setThreadName(int threadId, const QString& name) {
+    m_threadNames[threadId] = name;
+}
+
+void ChromeTrace::addReport(int threadId, const QString& tag,
+                            const StatReport& report) {
+    Entry entry;
+    entry.tag = tag;
+    entry.type = report.type;
+    entry.timeNanos = report.time;
+    entry.value = report.value;
+    entry.threadId = threadId;
+    m_entries.append(entry);
+}
+
+void ChromeTrace::clear() {
+    m_entries.clear();
+}
+
+bool ChromeTrace::write(QIODevice* pDevice) const {
+    QTextStream out(pDevice);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto beginEvent = [&out, &first](
+            const char* phase, const QString& name, int threadId,
+            double timeNanos) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"ph\":\"" << phase << "\""
+            << ",\"name\":\"" << escapeJson(name) << "\""
+            << ",\"pid\":" << kProcessId
+            << ",\"tid\":" << threadId
+            << ",\"ts\":" << micros(timeNanos);
+    };
+
+    for (auto it = m_threadNames.constBegin();
+            it != m_threadNames.constEnd(); ++it) {
+        beginEvent("M", "thread_name", it.key(), 0);
+        out << ",\"args\":{\"name\":\"" << escapeJson(it.value()) << "\"}}";
+    }
+
+    // A Trace reports its duration in addition to its start and end
+    QSet<QPair<int, QString>> startedTags;
+    QHash<QString, double> counterSums;
+    for (const auto& entry: m_entries) {
+        switch (entry.type) {
+        case Stat::EVENT_START:
+            startedTags.insert(qMakePair(entry.threadId, entry.tag));
+            beginEvent("B", entry.tag, entry.threadId, entry.timeNanos);
+            out << "}";
+            break;
+        case Stat::EVENT_END:
+            beginEvent("E", entry.tag, entry.threadId, entry.timeNanos);
+            out << "}";
+            break;
+        case Stat::EVENT:
+            beginEvent("i", entry.tag, entry.threadId, entry.timeNanos);
+            out << ",\"s\":\"t\"}";
+            break;
+        case Stat::DURATION_NANOSEC:
+        case Stat::DURATION_MSEC:
+        case Stat::DURATION_SEC: {
+            if (entry.tag.endsWith(kTraceDurationSuffix) &&
+                    startedTags.contains(qMakePair(entry.threadId,
+                            entry.tag.left(entry.tag.size() -
+                                    kTraceDurationSuffix.size())))) {
+                break;
+            }
+            const double duration = durationNanos(entry.type, entry.value);
+            beginEvent("X", entry.tag, entry.threadId,
+                    entry.timeNanos - duration);
+            out << ",\"dur\":" << micros(duration) << "}";
+            break;
+        }
+        case Stat::COUNTER: {
+            // Counters report increments, the track shows the total
+            double& sum = counterSums[entry.tag];
+            sum += entry.value;
+            beginEvent("C", entry.tag, entry.threadId, entry.timeNanos);
+            out << ",\"args\":{\"value\":" << sum << "}}";
+            break;
+        }
+        case Stat::GAUGE:
+            beginEvent("C", entry.tag, entry.threadId, entry.timeNanos);
+            out << ",\"args\":{\"value\":" << entry.value << "}}";
+            break;
+        default:
+            break;
+        }
+    }
+    out << "\n]}\n";
+    out.flush();
+    return out.status() == QTextStream::Ok;
+}
+
+bool ChromeTrace::writeFile(const QString& fileName) const {
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "Could not open trace file for writing:"
+                   << file.fileName();
+        return false;
+    }
+    return write(&file);
+}
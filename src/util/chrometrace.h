@@ -0,0 +1,44 @@
+#ifndef CHROMETRACE_H
+#define CHROMETRACE_H
+
+#include <QIODevice>
+#include <QList>
+#include <QMap>
+#include <QString>
+
+#include "util/stat.h"
+
+// Collects the stat reports of all threads and writes them in the Chrome
+// trace event format, which can be opened with chrome://tracing or the
+// Perfetto UI (https://ui.perfetto.dev).
+//
+// Trace start/end events become nested slices of their thread, timer
+// durations complete slices ending at the time of the report, events
+// instant markers and counters and gauges counter tracks.
+class ChromeTrace {
+  public:
+    void setThreadName(int threadId, const QString& name);
+    void addReport(int threadId, const QString& tag, const StatReport& report);
+
+    bool isEmpty() const {
+        return m_entries.isEmpty();
+    }
+    void clear();
+
+    bool write(QIODevice* pDevice) const;
+    bool writeFile(const QString& fileName) const;
+
+  private:
+    struct Entry {
+        QString tag;
+        Stat::StatType type;
+        qint64 timeNanos;
+        double value;
+        int threadId;
+    };
+
+    QList<Entry> m_entries;
+    QMap<int, QString> m_threadNames;
+};
+
+#endif /* CHROMETRACE_H */
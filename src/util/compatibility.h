@@ -22,6 +22,16 @@ inline int load_atomic(const QAtomicInt& value) {
 #endif
 }
 
+// Relaxed store without a read-modify-write, i.e. without a locked
+// instruction on x86
+inline void store_atomic(QAtomicInt& value, int newValue) {
+#if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
+    value = newValue;
+#else
+    value.store(newValue);
+#endif
+}
+
 template <typename T>
 inline T* load_atomic_pointer(const QAtomicPointer<T>& value) {
 #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
@@ -0,0 +1,21 @@
+#ifndef GAUGE_H
+#define GAUGE_H
+
+#include "util/stat.h"
+
+class Gauge {
+  public:
+    Gauge(const QString& tag)
+    : m_tag(tag) {
+    }
+    void set(double value) {
+        Stat::ComputeFlags flags = Stat::experimentFlags(
+            Stat::COUNT | Stat::AVERAGE | Stat::SAMPLE_VARIANCE |
+            Stat::MIN | Stat::MAX);
+        Stat::track(m_tag, Stat::GAUGE, flags, value);
+    }
+  private:
+    QString m_tag;
+};
+
+#endif /* GAUGE_H */
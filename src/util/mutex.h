@@ -9,6 +9,7 @@
 #include <QReadWriteLock>
 #include <QMutexLocker>
 
+#include "util/realtimeguard.h"
 #include "util/thread_annotations.h"
 
 class CAPABILITY("mutex") MMutex {
@@ -17,7 +18,10 @@ class CAPABILITY("mutex") MMutex {
             : m_mutex(mode) {
     }
 
-    inline void lock() ACQUIRE() { m_mutex.lock(); }
+    inline void lock() ACQUIRE() {
+        REALTIME_GUARD_CHECK(Lock);
+        m_mutex.lock();
+    }
     inline void unlock() RELEASE() { m_mutex.unlock(); }
     inline bool tryLock() TRY_ACQUIRE(true) {
         return m_mutex.tryLock();
@@ -34,12 +38,18 @@ class CAPABILITY("mutex") MReadWriteLock {
             : m_lock(mode) {
     }
 
-    void lockForRead() ACQUIRE_SHARED() { m_lock.lockForRead(); }
+    void lockForRead() ACQUIRE_SHARED() {
+        REALTIME_GUARD_CHECK(Lock);
+        m_lock.lockForRead();
+    }
     bool tryLockForRead() TRY_ACQUIRE_SHARED(true) {
         return m_lock.tryLockForRead();
     }
 
-    void lockForWrite() ACQUIRE() { m_lock.lockForWrite(); }
+    void lockForWrite() ACQUIRE() {
+        REALTIME_GUARD_CHECK(Lock);
+        m_lock.lockForWrite();
+    }
     bool tryLockForWrite() TRY_ACQUIRE(true) {
         return m_lock.tryLockForWrite();
     }
@@ -54,7 +64,9 @@ class CAPABILITY("mutex") MReadWriteLock {
 
 class SCOPED_CAPABILITY MMutexLocker {
   public:
-    MMutexLocker(MMutex* mu) ACQUIRE(mu) : m_locker(&mu->m_mutex) {}
+    MMutexLocker(MMutex* mu) ACQUIRE(mu) : m_locker(&mu->m_mutex) {
+        REALTIME_GUARD_CHECK(Lock);
+    }
     ~MMutexLocker() RELEASE() {}
 
     inline void unlock() RELEASE() { m_locker.unlock(); }
@@ -65,7 +77,9 @@ class SCOPED_CAPABILITY MMutexLocker {
 
 class SCOPED_CAPABILITY MWriteLocker {
   public:
-    MWriteLocker(MReadWriteLock* mu) ACQUIRE(mu) : m_locker(&mu->m_lock) {}
+    MWriteLocker(MReadWriteLock* mu) ACQUIRE(mu) : m_locker(&mu->m_lock) {
+        REALTIME_GUARD_CHECK(Lock);
+    }
     ~MWriteLocker() RELEASE() {}
 
     inline void unlock() RELEASE() { m_locker.unlock(); }
@@ -77,7 +91,9 @@ class SCOPED_CAPABILITY MWriteLocker {
 class SCOPED_CAPABILITY MReadLocker {
   public:
     MReadLocker(MReadWriteLock* mu) ACQUIRE_SHARED(mu)
-            : m_locker(&mu->m_lock) {}
+            : m_locker(&mu->m_lock) {
+        REALTIME_GUARD_CHECK(Lock);
+    }
     ~MReadLocker() RELEASE() {}
 
     inline void unlock() RELEASE() { m_locker.unlock(); }
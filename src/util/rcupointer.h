@@ -0,0 +1,104 @@
+#ifndef RCUPOINTER_H
+#define RCUPOINTER_H
+
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QList>
+
+#include "util/class.h"
+#include "util/compatibility.h"
+
+// Publishes immutable snapshots of T to readers on other threads without
+// locking them (read-copy-update). Readers access the current snapshot
+// through a ReadGuard, which never blocks and never allocates. A writer
+// builds a new snapshot and publishes it with a single pointer swap.
+//
+// A replaced snapshot is retired and only deleted by a later publish() or
+// the destructor once no ReadGuard is alive, so a reader can keep using the
+// snapshot it started with while an edit happens.
+//
+// Writers must be serialized by the owner, e.g. by a mutex that only the
+// writing side takes.
+template <typename T>
+class RcuPointer {
+  public:
+    class ReadGuard {
+      public:
+        explicit ReadGuard(const RcuPointer<T>* pOwner)
+                : m_pOwner(pOwner) {
+            // Both ref() and the pointer swap in publish() are full
+            // barriers, so either this reader is seen by publish() or it
+            // sees the published snapshot.
+            m_pOwner->m_readers.ref();
+#if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
+            m_pSnapshot = m_pOwner->m_pCurrent;
+#else
+            m_pSnapshot = m_pOwner->m_pCurrent.loadAcquire();
+#endif
+        }
+        ReadGuard(ReadGuard&& other)
+                : m_pOwner(other.m_pOwner),
+                  m_pSnapshot(other.m_pSnapshot) {
+            other.m_pOwner = nullptr;
+        }
+        ~ReadGuard() {
+            if (m_pOwner) {
+                m_pOwner->m_readers.deref();
+            }
+        }
+
+        // May be null if nothing has been published yet
+        const T* get() const {
+            return m_pSnapshot;
+        }
+        const T* operator->() const {
+            return m_pSnapshot;
+        }
+        const T& operator*() const {
+            return *m_pSnapshot;
+        }
+
+      private:
+        const RcuPointer<T>* m_pOwner;
+        const T* m_pSnapshot;
+
+        DISALLOW_COPY_AND_ASSIGN(ReadGuard);
+    };
+
+    RcuPointer()
+            : m_readers(0),
+              m_pCurrent(nullptr) {
+    }
+    ~RcuPointer() {
+        delete load_atomic_pointer(m_pCurrent);
+        qDeleteAll(m_retired);
+    }
+
+    ReadGuard read() const {
+        return ReadGuard(this);
+    }
+
+    // Takes ownership of pSnapshot. Writer side only.
+    void publish(T* pSnapshot) {
+        T* pReplaced = m_pCurrent.fetchAndStoreOrdered(pSnapshot);
+        if (pReplaced) {
+            m_retired.append(pReplaced);
+        }
+        // Every reader that arrives from now on gets pSnapshot, so if
+        // there is none in flight nobody can hold a retired snapshot.
+        if (load_atomic(m_readers) == 0) {
+            qDeleteAll(m_retired);
+            m_retired.clear();
+        }
+    }
+
+  private:
+    mutable QAtomicInt m_readers;
+    QAtomicPointer<T> m_pCurrent;
+    // Only accessed by the writer
+    QList<T*> m_retired;
+
+    DISALLOW_COPY_AND_ASSIGN(RcuPointer);
+};
+
+#endif /* RCUPOINTER_H */
@@ -0,0 +1,130 @@
+#include "util/realtimeguard.h"
+
+#include <QAtomicInt>
+#include <QTextStream>
+
+// Only builds that intercept allocations and locks take stack traces, so
+// other builds don't load the unwinder during static initialization
+#if defined(MIXXX_REALTIME_SAFETY_CHECKS) && \
+        (defined(__GLIBC__) || defined(__APPLE__))
+#include <execinfo.h>
+#include <stdlib.h>
+#define REALTIME_GUARD_BACKTRACE
+#endif
+
+#include "util/compatibility.h"
+#include "util/math.h"
+
+namespace {
+
+// The records are preallocated, recording a violation must not allocate
+const int kMaxRecords = 32;
+const int kMaxStackFrames = 24;
+
+struct ViolationRecord {
+    RealtimeGuard::Violation violation;
+    int frameCount;
+    void* frames[kMaxStackFrames];
+};
+
+ViolationRecord s_records[kMaxRecords];
+// Number of claimed records, may exceed kMaxRecords
+QAtomicInt s_recordCount;
+QAtomicInt s_violationCount;
+
+// Prevents recursion when taking the stack trace allocates or locks
+thread_local bool s_recording = false;
+
+const char* violationName(RealtimeGuard::Violation violation) {
+    switch (violation) {
+    case RealtimeGuard::Violation::Allocation:
+        return "allocation";
+    case RealtimeGuard::Violation::Deallocation:
+        return "deallocation";
+    case RealtimeGuard::Violation::Lock:
+        return "lock";
+    }
+    return "unknown";
+}
+
+#ifdef REALTIME_GUARD_BACKTRACE
+// The first call of backtrace() loads the unwinder, which allocates. Do
+// that now instead of in the first violation.
+bool initBacktrace() {
+    void* frame;
+    backtrace(&frame, 1);
+    return true;
+}
+const bool s_backtraceInitialized = initBacktrace();
+#endif
+
+} // anonymous namespace
+
+thread_local int RealtimeGuard::s_scopeDepth = 0;
+
+#ifndef MIXXX_REALTIME_SAFETY_CHECKS
+// Defined next to the interceptors otherwise
+// static
+bool RealtimeGuard::isEnabled() {
+    return false;
+}
+#endif
+
+// static
+void RealtimeGuard::recordViolation(Violation violation) {
+    if (s_recording) {
+        return;
+    }
+    s_recording = true;
+    s_violationCount.fetchAndAddRelaxed(1);
+    const int index = s_recordCount.fetchAndAddRelaxed(1);
+    if (index < kMaxRecords) {
+        ViolationRecord& record = s_records[index];
+        record.violation = violation;
+#ifdef REALTIME_GUARD_BACKTRACE
+        record.frameCount = backtrace(record.frames, kMaxStackFrames);
+#else
+        record.frameCount = 0;
+#endif
+    }
+    s_recording = false;
+}
+
+// static
+int RealtimeGuard::violationCount() {
+    return load_atomic(s_violationCount);
+}
+
+// static
+void RealtimeGuard::resetViolations() {
+    s_recordCount.fetchAndStoreRelaxed(0);
+    s_violationCount.fetchAndStoreRelaxed(0);
+}
+
+// static
+QString RealtimeGuard::report() {
+    QString result;
+    QTextStream out(&result);
+    out << violationCount() << " allocation(s) or lock(s) in realtime code";
+    const int recordCount = math_min(load_atomic(s_recordCount), kMaxRecords);
+    for (int i = 0; i < recordCount; ++i) {
+        const ViolationRecord& record = s_records[i];
+        out << "\n#" << i << " " << violationName(record.violation);
+#ifdef REALTIME_GUARD_BACKTRACE
+        char** symbols = backtrace_symbols(record.frames, record.frameCount);
+        if (symbols) {
+            // Skip recordViolation() itself
+            for (int frame = 1; frame < record.frameCount; ++frame) {
+                out << "\n    " << symbols[frame];
+            }
+            free(symbols);
+        }
+#endif
+    }
+    if (recordCount < violationCount()) {
+        out << "\n(stack traces of the first " << recordCount
+            << " violations only)";
+    }
+    out.flush();
+    return result;
+}
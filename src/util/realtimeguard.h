@@ -0,0 +1,63 @@
+#ifndef UTIL_REALTIMEGUARD_H
+#define UTIL_REALTIMEGUARD_H
+
+#include <QString>
+
+// Detects memory allocations and blocking locks in realtime code, i.e. in
+// EngineMaster::process() and everything below it.
+//
+// When building with rtsafety=1 the allocation functions, pthread mutexes
+// and the locks from util/mutex.h report to RealtimeGuard::check(). A call
+// from a thread that is inside a RealtimeGuard::Scope is recorded as a
+// violation together with its stack trace. In all other builds the checks
+// are compiled out and no violations are ever recorded.
+class RealtimeGuard {
+  public:
+    enum class Violation {
+        Allocation,
+        Deallocation,
+        Lock,
+    };
+
+    // Marks the current thread as running realtime code for the lifetime
+    // of the scope. Scopes may be nested.
+    class Scope {
+      public:
+        Scope() {
+            ++s_scopeDepth;
+        }
+        ~Scope() {
+            --s_scopeDepth;
+        }
+    };
+
+    // True if allocations and locks are intercepted by this build
+    static bool isEnabled();
+
+    // Neither allocates nor locks, even when recording a violation.
+    static inline void check(Violation violation) {
+        if (s_scopeDepth > 0) {
+            recordViolation(violation);
+        }
+    }
+
+    static int violationCount();
+    static void resetViolations();
+
+    // A summary of the recorded violations with symbolized stack traces.
+    // Only call this while no realtime code is running.
+    static QString report();
+
+  private:
+    static void recordViolation(Violation violation);
+
+    static thread_local int s_scopeDepth;
+};
+
+#ifdef MIXXX_REALTIME_SAFETY_CHECKS
+#define REALTIME_GUARD_CHECK(violation) RealtimeGuard::check(RealtimeGuard::Violation::violation)
+#else
+#define REALTIME_GUARD_CHECK(violation)
+#endif
+
+#endif /* UTIL_REALTIMEGUARD_H */
@@ -0,0 +1,150 @@
+// Interceptors for RealtimeGuard, only built with rtsafety=1.
+//
+// With glibc the C allocation functions are replaced and forward to the
+// glibc implementation, which covers operator new as well. On other
+// platforms only the global operators new and delete are replaced.
+// Blocking pthread mutex locks are intercepted on Linux. QMutex does not
+// use pthreads there, so Qt locks are only detected when using the
+// wrappers from util/mutex.h.
+
+#include "util/realtimeguard.h"
+
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <dlfcn.h>
+#include <errno.h>
+#include <pthread.h>
+#endif
+
+#ifndef MIXXX_REALTIME_SAFETY_CHECKS
+#error "realtimeguardhooks.cpp requires MIXXX_REALTIME_SAFETY_CHECKS"
+#endif
+
+// static
+bool RealtimeGuard::isEnabled() {
+    return true;
+}
+
+#if defined(__GLIBC__)
+
+namespace {
+
+typedef int (*PthreadMutexLockFunction)(pthread_mutex_t*);
+
+PthreadMutexLockFunction resolvePthreadMutexLock() {
+    return reinterpret_cast<PthreadMutexLockFunction>(
+            dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+}
+
+// Resolved before main() while there is only a single thread
+PthreadMutexLockFunction s_pthreadMutexLock = resolvePthreadMutexLock();
+
+} // anonymous namespace
+
+extern "C" {
+
+// The glibc implementations
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) __THROW {
+    REALTIME_GUARD_CHECK(Allocation);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) __THROW {
+    REALTIME_GUARD_CHECK(Allocation);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) __THROW {
+    REALTIME_GUARD_CHECK(Allocation);
+    return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) __THROW {
+    REALTIME_GUARD_CHECK(Allocation);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** pPtr, size_t alignment, size_t size) __THROW {
+    REALTIME_GUARD_CHECK(Allocation);
+    if (alignment % sizeof(void*) != 0 ||
+            (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    void* ptr = __libc_memalign(alignment, size);
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *pPtr = ptr;
+    return 0;
+}
+
+void free(void* ptr) __THROW {
+    if (ptr) {
+        REALTIME_GUARD_CHECK(Deallocation);
+    }
+    __libc_free(ptr);
+}
+
+int pthread_mutex_lock(pthread_mutex_t* pMutex) __THROWNL {
+    REALTIME_GUARD_CHECK(Lock);
+    if (!s_pthreadMutexLock) {
+        // Called by another static initializer
+        s_pthreadMutexLock = resolvePthreadMutexLock();
+    }
+    return s_pthreadMutexLock(pMutex);
+}
+
+} // extern "C"
+
+#else
+
+void* operator new(std::size_t size) {
+    REALTIME_GUARD_CHECK(Allocation);
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    REALTIME_GUARD_CHECK(Allocation);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr) {
+        REALTIME_GUARD_CHECK(Deallocation);
+    }
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    operator delete(ptr);
+}
+
+#endif
@@ -0,0 +1,85 @@
+#include "util/semaphore.h"
+
+#include <errno.h>
+
+#if defined(__WINDOWS__)
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach/mach_init.h>
+#include <mach/task.h>
+#endif
+
+#include "util/assert.h"
+
+#if defined(__WINDOWS__)
+
+LightweightSemaphore::LightweightSemaphore(int initialCount)
+        : m_count(initialCount),
+          m_handle(CreateSemaphore(nullptr, 0, MAXLONG, nullptr)) {
+    DEBUG_ASSERT(m_handle);
+}
+
+LightweightSemaphore::~LightweightSemaphore() {
+    CloseHandle(m_handle);
+}
+
+void LightweightSemaphore::waitForRelease() {
+    WaitForSingleObject(m_handle, INFINITE);
+}
+
+void LightweightSemaphore::wakeUp(int n) {
+    ReleaseSemaphore(m_handle, n, nullptr);
+}
+
+#elif defined(__APPLE__)
+
+LightweightSemaphore::LightweightSemaphore(int initialCount)
+        : m_count(initialCount) {
+    kern_return_t result = semaphore_create(
+            mach_task_self(), &m_semaphore, SYNC_POLICY_FIFO, 0);
+    DEBUG_ASSERT(result == KERN_SUCCESS);
+    Q_UNUSED(result);
+}
+
+LightweightSemaphore::~LightweightSemaphore() {
+    semaphore_destroy(mach_task_self(), m_semaphore);
+}
+
+void LightweightSemaphore::waitForRelease() {
+    while (semaphore_wait(m_semaphore) == KERN_ABORTED) {
+        // Interrupted, wait again
+    }
+}
+
+void LightweightSemaphore::wakeUp(int n) {
+    while (n-- > 0) {
+        semaphore_signal(m_semaphore);
+    }
+}
+
+#else
+
+LightweightSemaphore::LightweightSemaphore(int initialCount)
+        : m_count(initialCount) {
+    int result = sem_init(&m_semaphore, 0, 0);
+    DEBUG_ASSERT(result == 0);
+    Q_UNUSED(result);
+}
+
+LightweightSemaphore::~LightweightSemaphore() {
+    sem_destroy(&m_semaphore);
+}
+
+void LightweightSemaphore::waitForRelease() {
+    while (sem_wait(&m_semaphore) != 0 && errno == EINTR) {
+        // Interrupted by a signal, wait again
+    }
+}
+
+void LightweightSemaphore::wakeUp(int n) {
+    while (n-- > 0) {
+        sem_post(&m_semaphore);
+    }
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef UTIL_SEMAPHORE_H
+#define UTIL_SEMAPHORE_H
+
+#include <atomic>
+
+#if defined(__WINDOWS__)
+// HANDLE is void*, avoid including windows.h
+#elif defined(__APPLE__)
+#include <mach/semaphore.h>
+#else
+#include <semaphore.h>
+#endif
+
+#include "util/class.h"
+
+// A counting semaphore that may be released from the engine callback.
+//
+// The count is kept in an atomic. release() only calls into the operating
+// system if a thread is actually blocked in acquire(), and even then it
+// posts a kernel semaphore instead of locking a mutex like QWaitCondition
+// and QSemaphore do. A release() that happens before the matching
+// acquire() is never lost.
+class LightweightSemaphore {
+  public:
+    explicit LightweightSemaphore(int initialCount = 0);
+    ~LightweightSemaphore();
+
+    // Blocks until the count is positive and decrements it
+    void acquire() {
+        if (m_count.fetch_sub(1, std::memory_order_acquire) <= 0) {
+            waitForRelease();
+        }
+    }
+
+    // Increments the count and wakes up at most n blocked threads. Never
+    // allocates and never locks.
+    void release(int n = 1) {
+        const int oldCount = m_count.fetch_add(n, std::memory_order_release);
+        // A negative count is the number of blocked threads
+        const int wakeCount = -oldCount < n ? -oldCount : n;
+        if (wakeCount > 0) {
+            wakeUp(wakeCount);
+        }
+    }
+
+  private:
+    void waitForRelease();
+    void wakeUp(int n);
+
+    std::atomic<int> m_count;
+
+#if defined(__WINDOWS__)
+    void* m_handle;
+#elif defined(__APPLE__)
+    semaphore_t m_semaphore;
+#else
+    sem_t m_semaphore;
+#endif
+
+    DISALLOW_COPY_AND_ASSIGN(LightweightSemaphore);
+};
+
+#endif /* UTIL_SEMAPHORE_H */
@@ -0,0 +1,103 @@
+#include "util/startupprofiler.h"
+
+#include <QFile>
+#include <QMutexLocker>
+#include <QTextStream>
+
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("StartupProfiler");
+
+QString formatEntry(const QString& kind, const QString& name,
+                    mixxx::Duration start, mixxx::Duration duration) {
+    return QString("%1 %2 %3 %4")
+            .arg(kind, -10)
+            .arg(name, -40)
+            .arg(start.toDoubleMillis(), 10, 'f', 1)
+            .arg(duration.toDoubleMillis(), 10, 'f', 1);
+}
+
+} // anonymous namespace
+
+StartupProfiler::StartupProfiler()
+        : m_phaseRunning(false) {
+    m_timer.start();
+}
+
+void StartupProfiler::beginPhase(const QString& name) {
+    endPhase();
+    Entry phase;
+    phase.name = name;
+    phase.start = m_timer.elapsed();
+    m_phases.append(phase);
+    m_phaseRunning = true;
+}
+
+void StartupProfiler::endPhase() {
+    if (!m_phaseRunning) {
+        return;
+    }
+    Entry& phase = m_phases.last();
+    phase.duration = m_timer.elapsed() - phase.start;
+    m_phaseRunning = false;
+}
+
+void StartupProfiler::addTask(const QString& name, mixxx::Duration start) {
+    Entry task;
+    task.name = name;
+    task.start = start;
+    task.duration = m_timer.elapsed() - start;
+    QMutexLocker locker(&m_taskMutex);
+    m_tasks.append(task);
+}
+
+StartupProfiler::TaskScope::TaskScope(StartupProfiler* pProfiler,
+                                      const QString& name)
+        : m_pProfiler(pProfiler),
+          m_name(name),
+          m_start(pProfiler->m_timer.elapsed()) {
+}
+
+StartupProfiler::TaskScope::~TaskScope() {
+    m_pProfiler->addTask(m_name, m_start);
+}
+
+QStringList StartupProfiler::report() {
+    endPhase();
+    QStringList lines;
+    lines << QString("%1 %2 %3 %4")
+            .arg("", -10)
+            .arg("", -40)
+            .arg("start ms", 10)
+            .arg("took ms", 10);
+    for (const Entry& phase : m_phases) {
+        lines << formatEntry("phase", phase.name, phase.start, phase.duration);
+    }
+    QMutexLocker locker(&m_taskMutex);
+    for (const Entry& task : m_tasks) {
+        lines << formatEntry("background", task.name, task.start, task.duration);
+    }
+    locker.unlock();
+    lines << formatEntry("total", QString(), mixxx::Duration::empty(),
+            m_timer.elapsed());
+    return lines;
+}
+
+void StartupProfiler::writeReport(const QString& filePath) {
+    const QStringList lines = report();
+    for (const QString& line : lines) {
+        kLogger.info() << line.toLocal8Bit().constData();
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        kLogger.warning() << "Failed to write" << filePath;
+        return;
+    }
+    QTextStream stream(&file);
+    for (const QString& line : lines) {
+        stream << line << '\n';
+    }
+}
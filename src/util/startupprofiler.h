@@ -0,0 +1,67 @@
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include "util/class.h"
+#include "util/duration.h"
+#include "util/performancetimer.h"
+
+// Times the phases of the application startup and writes them out as a
+// report. Phases run one after another on the main thread. Tasks that run
+// concurrently on the thread pool are recorded with the time they started,
+// so the report shows how they overlap with the phases.
+class StartupProfiler {
+  public:
+    StartupProfiler();
+
+    // Ends the current phase, if any, and starts the next one. Must be
+    // called from the thread that created the profiler.
+    void beginPhase(const QString& name);
+    // Ends the current phase
+    void endPhase();
+
+    // Records the time from its construction to its destruction as a
+    // background task. May be used from any thread.
+    class TaskScope {
+      public:
+        TaskScope(StartupProfiler* pProfiler, const QString& name);
+        ~TaskScope();
+
+      private:
+        StartupProfiler* m_pProfiler;
+        const QString m_name;
+        const mixxx::Duration m_start;
+
+        DISALLOW_COPY_AND_ASSIGN(TaskScope);
+    };
+
+    // One line per phase and task with its start and duration in
+    // milliseconds. Ends the current phase.
+    QStringList report();
+    // Logs the report and writes it to the file
+    void writeReport(const QString& filePath);
+
+  private:
+    struct Entry {
+        QString name;
+        mixxx::Duration start;
+        mixxx::Duration duration;
+    };
+
+    void addTask(const QString& name, mixxx::Duration start);
+
+    PerformanceTimer m_timer;
+
+    QList<Entry> m_phases;
+    bool m_phaseRunning;
+
+    // Guards m_tasks, which are added from the thread pool
+    QMutex m_taskMutex;
+    QList<Entry> m_tasks;
+};
+
+#endif /* STARTUPPROFILER_H */
@@ -30,6 +30,7 @@ QString Stat::valueUnits() const {
         case EVENT:
         case EVENT_START:
         case EVENT_END:
+        case GAUGE:
         case UNSPECIFIED:
         default:
             return "";
@@ -20,6 +20,8 @@ class Stat {
         EVENT,
         EVENT_START,
         EVENT_END,
+        // A level like a FIFO fill, reported whenever it is sampled.
+        GAUGE,
     };
 
     static QString statTypeToString(StatType type) {
@@ -40,6 +42,8 @@ class Stat {
                 return "START";
             case EVENT_END:
                 return "END";
+            case GAUGE:
+                return "GAUGE";
             default:
                 return "UNKNOWN";
         }
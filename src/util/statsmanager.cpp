@@ -15,9 +15,11 @@ const int kProcessLength = kStatsPipeSize * 4 / 5;
 // static
 bool StatsManager::s_bStatsManagerEnabled = false;
 
-StatsPipe::StatsPipe(StatsManager* pManager)
+StatsPipe::StatsPipe(StatsManager* pManager, int threadId)
         : FIFO<StatReport>(kStatsPipeSize),
-          m_pManager(pManager) {
+          m_pManager(pManager),
+          m_threadId(threadId),
+          m_threadNamed(false) {
     qRegisterMetaType<Stat>("Stat");
 }
 
@@ -27,9 +29,30 @@ StatsPipe::~StatsPipe() {
     }
 }
 
+void StatsPipe::updateThreadName() {
+    if (m_threadNamed) {
+        return;
+    }
+    const QString name = QThread::currentThread()->objectName();
+    if (name.isEmpty() || !m_threadNameMutex.tryLock()) {
+        // Try again with the next report
+        return;
+    }
+    m_threadName = name;
+    m_threadNameMutex.unlock();
+    m_threadNamed = true;
+}
+
+QString StatsPipe::threadName() {
+    QMutexLocker locker(&m_threadNameMutex);
+    return m_threadName;
+}
+
 StatsManager::StatsManager()
         : QThread(),
-          m_quit(0) {
+          m_quit(0),
+          m_traceRecording(0),
+          m_nextThreadId(1) {
     s_bStatsManagerEnabled = true;
     setObjectName("StatsManager");
     moveToThread(this);
@@ -172,9 +195,9 @@ StatsPipe* StatsManager::getStatsPipeForThread() {
     if (m_threadStatsPipes.hasLocalData()) {
         return m_threadStatsPipes.localData();
     }
-    StatsPipe* pResult = new StatsPipe(this);
-    m_threadStatsPipes.setLocalData(pResult);
     QMutexLocker locker(&m_statsPipeLock);
+    StatsPipe* pResult = new StatsPipe(this, m_nextThreadId++);
+    m_threadStatsPipes.setLocalData(pResult);
     m_statsPipes.push_back(pResult);
     return pResult;
 }
@@ -184,6 +207,7 @@ bool StatsManager::maybeWriteReport(const StatReport& report) {
     if (pStatsPipe == NULL) {
         return false;
     }
+    pStatsPipe->updateThreadName();
     bool success = pStatsPipe->write(&report, 1) == 1;
     int space = pStatsPipe->writeAvailable();
     if (space < kProcessLength) {
@@ -198,11 +222,49 @@ bool StatsManager::maybeWriteReport(const StatReport& report) {
     return success;
 }
 
+void StatsManager::startTraceRecording() {
+    QMutexLocker locker(&m_statsPipeLock);
+    // Reports of the past are not part of the recording
+    processIncomingStatReports();
+    m_trace.clear();
+    m_traceRecording = 1;
+}
+
+bool StatsManager::stopTraceRecording(const QString& fileName) {
+    ChromeTrace trace;
+    {
+        QMutexLocker locker(&m_statsPipeLock);
+        processIncomingStatReports();
+        m_traceRecording = 0;
+        trace = m_trace;
+        m_trace.clear();
+    }
+    if (trace.isEmpty()) {
+        qDebug() << "No trace events recorded.";
+        return false;
+    }
+    return trace.writeFile(fileName);
+}
+
+bool StatsManager::isTraceRecording() const {
+    return load_atomic(m_traceRecording) != 0;
+}
+
 void StatsManager::processIncomingStatReports() {
     StatReport report;
+    const bool traceRecording = isTraceRecording();
     foreach (StatsPipe* pStatsPipe, m_statsPipes) {
+        if (traceRecording) {
+            const QString threadName = pStatsPipe->threadName();
+            m_trace.setThreadName(pStatsPipe->threadId(), threadName.isEmpty() ?
+                    QString("Thread %1").arg(pStatsPipe->threadId()) :
+                    threadName);
+        }
         while (pStatsPipe->read(&report, 1) == 1) {
             QString tag = QString::fromUtf8(report.tag);
+            if (traceRecording) {
+                m_trace.addReport(pStatsPipe->threadId(), tag, report);
+            }
             Stat& info = m_stats[tag];
             info.m_tag = tag;
             info.m_type = report.type;
@@ -12,6 +12,7 @@
 #include <QThreadStorage>
 #include <QList>
 
+#include "util/chrometrace.h"
 #include "util/fifo.h"
 #include "util/singleton.h"
 #include "util/stat.h"
@@ -21,10 +22,26 @@ class StatsManager;
 
 class StatsPipe : public FIFO<StatReport> {
   public:
-    StatsPipe(StatsManager* pManager);
+    StatsPipe(StatsManager* pManager, int threadId);
     virtual ~StatsPipe();
+
+    int threadId() const {
+        return m_threadId;
+    }
+
+    // Called by the thread of the pipe. Threads are often named after
+    // they have started reporting, e.g. the engine callback thread.
+    void updateThreadName();
+    QString threadName();
+
   private:
     StatsManager* m_pManager;
+    const int m_threadId;
+    // Only accessed by the thread of the pipe
+    bool m_threadNamed;
+    // Never locked blocking by the thread of the pipe
+    QMutex m_threadNameMutex;
+    QString m_threadName;
 };
 
 class StatsManager : public QThread, public Singleton<StatsManager> {
@@ -47,6 +64,14 @@ class StatsManager : public QThread, public Singleton<StatsManager> {
         m_statsPipeCondition.wakeAll();
     }
 
+    // Records the timeline of all threads from now on for the export
+    // in the Chrome trace event format, see ChromeTrace.
+    void startTraceRecording();
+    // Stops recording and writes the trace. Returns false if nothing has
+    // been recorded or writing failed.
+    bool stopTraceRecording(const QString& fileName);
+    bool isTraceRecording() const;
+
   signals:
     void statUpdated(const Stat& stat);
 
@@ -61,6 +86,10 @@ class StatsManager : public QThread, public Singleton<StatsManager> {
 
     QAtomicInt m_emitAllStats;
     QAtomicInt m_quit;
+    QAtomicInt m_traceRecording;
+    // Guarded by m_statsPipeLock
+    ChromeTrace m_trace;
+    int m_nextThreadId;
     QMap<QString, Stat> m_stats;
     QMap<QString, Stat> m_baseStats;
     QMap<QString, Stat> m_experimentStats;
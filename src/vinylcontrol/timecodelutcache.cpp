@@ -0,0 +1,179 @@
+#include "vinylcontrol/timecodelutcache.h"
+
+#include <cstring>
+
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("TimecodeLutCache");
+
+const char kMagic[8] = {'M', 'X', 'L', 'U', 'T', 'X', 'W', 'X'};
+// Increment when the layout of the file or of the xwax lookup table changes
+const quint32 kFormatVersion = 1;
+
+// The file starts with this header, followed by the slots and the hash table
+// of the lut exactly as they are laid out in memory. The files are specific
+// to the machine that wrote them.
+struct LutFileHeader {
+    char magic[8];
+    quint32 version;
+    quint32 slotSize;
+    quint32 hashBits;
+    quint32 bits;
+    quint32 seed;
+    quint32 taps;
+    quint32 length;
+    quint32 reserved;
+};
+
+const int kHashes = 1 << HASH_BITS;
+// NO_SLOT of lut.c, terminates the chains of slots with the same hash
+const slot_no_t kNoSlot = static_cast<slot_no_t>(-1);
+
+LutFileHeader makeHeader(const timecode_def& def) {
+    LutFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.slotSize = sizeof(struct slot);
+    header.hashBits = HASH_BITS;
+    header.bits = def.bits;
+    header.seed = def.seed;
+    header.taps = def.taps;
+    header.length = def.length;
+    return header;
+}
+
+qint64 fileSize(const timecode_def& def) {
+    return sizeof(LutFileHeader) +
+            static_cast<qint64>(sizeof(struct slot)) * def.length +
+            static_cast<qint64>(sizeof(slot_no_t)) * kHashes;
+}
+
+// xwax follows the slot numbers of a lookup table without any checks, so
+// a corrupt file must not be used. lut_push() links every slot to one that
+// was pushed before it, which also rules out endless chains.
+bool hasValidSlotNumbers(const struct slot* pSlots, const slot_no_t* pTable,
+                         slot_no_t length) {
+    for (slot_no_t slotNo = 0; slotNo < length; ++slotNo) {
+        if (pSlots[slotNo].next != kNoSlot && pSlots[slotNo].next >= slotNo) {
+            return false;
+        }
+    }
+    for (int hash = 0; hash < kHashes; ++hash) {
+        if (pTable[hash] != kNoSlot && pTable[hash] >= length) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+QList<QFile*> TimecodeLutCache::s_mappedFiles;
+
+// static
+timecode_def* TimecodeLutCache::findDefinition(const QDir& cacheDir,
+                                               const char* timecode) {
+    timecode_def* pDef = timecoder_find_definition_no_lookup(timecode);
+    if (pDef == NULL || pDef->lookup) {
+        return pDef;
+    }
+
+    const QString filePath = cacheDir.absoluteFilePath(
+            QString("%1.lut").arg(timecode));
+    if (mapLookupTable(pDef, filePath)) {
+        return pDef;
+    }
+
+    // Not cached yet or stale, build it and store it for the next time
+    pDef = timecoder_find_definition(timecode);
+    if (pDef != NULL) {
+        writeLookupTable(*pDef, cacheDir, filePath);
+    }
+    return pDef;
+}
+
+// static
+void TimecodeLutCache::freeLookupTables() {
+    timecoder_free_lookup();
+    qDeleteAll(s_mappedFiles);
+    s_mappedFiles.clear();
+}
+
+// static
+bool TimecodeLutCache::mapLookupTable(timecode_def* pDef,
+                                      const QString& filePath) {
+    QFile* pFile = new QFile(filePath);
+    if (!pFile->open(QIODevice::ReadOnly)) {
+        delete pFile;
+        return false;
+    }
+    const qint64 size = fileSize(*pDef);
+    uchar* pData = pFile->size() == size ? pFile->map(0, size) : NULL;
+    if (pData == NULL) {
+        kLogger.warning() << "Ignoring invalid cache file" << filePath;
+        delete pFile;
+        return false;
+    }
+    const LutFileHeader expectedHeader = makeHeader(*pDef);
+    if (memcmp(pData, &expectedHeader, sizeof(expectedHeader)) != 0) {
+        kLogger.info() << "Ignoring outdated cache file" << filePath;
+        delete pFile;
+        return false;
+    }
+
+    struct slot* pSlots =
+            reinterpret_cast<struct slot*>(pData + sizeof(LutFileHeader));
+    slot_no_t* pTable =
+            reinterpret_cast<slot_no_t*>(pSlots + pDef->length);
+    if (!hasValidSlotNumbers(pSlots, pTable, pDef->length)) {
+        kLogger.warning() << "Ignoring corrupt cache file" << filePath;
+        delete pFile;
+        return false;
+    }
+    timecoder_use_lookup(pDef, pSlots, pTable);
+    s_mappedFiles.append(pFile);
+    kLogger.debug() << "Mapped lookup table for" << pDef->desc
+                    << "from" << filePath;
+    return true;
+}
+
+// static
+void TimecodeLutCache::writeLookupTable(const timecode_def& def,
+                                        const QDir& cacheDir,
+                                        const QString& filePath) {
+    if (!cacheDir.exists() && !QDir().mkpath(cacheDir.absolutePath())) {
+        kLogger.warning() << "Failed to create directory"
+                          << cacheDir.absolutePath();
+        return;
+    }
+
+    // Written under a temporary name, so a concurrently starting instance
+    // never maps a partial file
+    const QString tempFilePath = filePath + ".tmp";
+    QFile file(tempFilePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        kLogger.warning() << "Failed to open" << tempFilePath
+                          << "for writing:" << file.errorString();
+        return;
+    }
+    const LutFileHeader header = makeHeader(def);
+    const qint64 slotsSize = sizeof(struct slot) * def.length;
+    const qint64 tableSize = sizeof(slot_no_t) * kHashes;
+    bool success =
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ==
+                    static_cast<qint64>(sizeof(header)) &&
+            file.write(reinterpret_cast<const char*>(def.lut.slot), slotsSize) ==
+                    slotsSize &&
+            file.write(reinterpret_cast<const char*>(def.lut.table), tableSize) ==
+                    tableSize;
+    file.close();
+
+    QFile::remove(filePath);
+    if (!success || !QFile::rename(tempFilePath, filePath)) {
+        kLogger.warning() << "Failed to write" << filePath;
+        QFile::remove(tempFilePath);
+    }
+}
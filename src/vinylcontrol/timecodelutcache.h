@@ -0,0 +1,44 @@
+#ifndef TIMECODELUTCACHE_H
+#define TIMECODELUTCACHE_H
+
+#include <QDir>
+#include <QFile>
+#include <QList>
+
+#ifdef _MSC_VER
+#include "timecoder.h"
+#else
+extern "C" {
+#include "timecoder.h"
+}
+#endif
+
+// Provides the xwax timecode definitions together with the lookup table that
+// maps the timecode bitstream to the position on the record. Building the
+// table takes a while for the long timecodes, so it is written to a cache
+// file once and mapped from there on the following starts. The lookup tables
+// are global in xwax, so all decks share the same mapped pages.
+//
+// Not thread-safe, the callers serialize access with the LUT mutex of
+// VinylControlXwax.
+class TimecodeLutCache {
+  public:
+    // Returns the definition with its lookup table or NULL if the timecode
+    // is unknown or the table could not be built.
+    static timecode_def* findDefinition(const QDir& cacheDir,
+                                        const char* timecode);
+
+    // Frees the lookup tables in xwax and unmaps the cache files
+    static void freeLookupTables();
+
+  private:
+    static bool mapLookupTable(timecode_def* pDef, const QString& filePath);
+    static void writeLookupTable(const timecode_def& def,
+                                 const QDir& cacheDir,
+                                 const QString& filePath);
+
+    // Kept open, closing them would invalidate the mappings
+    static QList<QFile*> s_mappedFiles;
+};
+
+#endif /* TIMECODELUTCACHE_H */
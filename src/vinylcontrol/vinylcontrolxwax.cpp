@@ -23,6 +23,7 @@
 #include <limits.h>
 
 #include "vinylcontrol/vinylcontrolxwax.h"
+#include "vinylcontrol/timecodelutcache.h"
 #include "util/timer.h"
 #include "control/controlproxy.h"
 #include "control/controlobject.h"
@@ -122,13 +123,6 @@ VinylControlXwax::VinylControlXwax(UserSettingsPointer pConfig, QString group)
     }
 
 
-    timecode_def* tc_def = timecoder_find_definition(timecode);
-    if (tc_def == NULL) {
-        qDebug() << "Error finding timecode definition for " << timecode << ", defaulting to serato_2a";
-        timecode = (char*)"serato_2a";
-        tc_def = timecoder_find_definition(timecode);
-    }
-
     double speed = 1.0;
     double rpm = 100.0 / 3.0;
     if (strVinylSpeed == MIXXX_VINYL_SPEED_45) {
@@ -152,12 +146,21 @@ VinylControlXwax::VinylControlXwax(UserSettingsPointer pConfig, QString group)
     m_pPitchRing = new double[m_iPitchRingSize];
 
     qDebug() << "Xwax Vinyl control starting with a sample rate of:" << iSampleRate;
-    qDebug() << "Building timecode lookup tables for" << strVinylType << "with speed" << strVinylSpeed;
+    qDebug() << "Loading timecode lookup tables for" << strVinylType << "with speed" << strVinylSpeed;
 
     // Initialize the timecoder structure. Use the static mutex so that we only
     // do this once across the VinylControlXwax instances.
     s_xwaxLUTMutex.lock();
 
+    // The lookup tables are built once and then mapped from the cache
+    const QDir lutCacheDir(m_pConfig->getSettingsPath() + "/vinylcontrol/");
+    timecode_def* tc_def = TimecodeLutCache::findDefinition(lutCacheDir, timecode);
+    if (tc_def == NULL) {
+        qDebug() << "Error finding timecode definition for " << timecode << ", defaulting to serato_2a";
+        timecode = (char*)"serato_2a";
+        tc_def = TimecodeLutCache::findDefinition(lutCacheDir, timecode);
+    }
+
     timecoder_init(&timecoder, tc_def, speed, iSampleRate, /* phono */ false);
     timecoder_monitor_init(&timecoder, MIXXX_VINYL_SCOPE_SIZE);
     //Note that timecoder_init will not double-malloc the LUTs, and after this we are guaranteed
@@ -191,7 +194,7 @@ VinylControlXwax::~VinylControlXwax() {
 void VinylControlXwax::freeLUTs() {
     s_xwaxLUTMutex.lock(); //Static mutex! We don't want two threads doing this!
     if (s_bLUTInitialized) {
-        timecoder_free_lookup(); //Frees all the LUTs in xwax.
+        TimecodeLutCache::freeLookupTables(); //Frees all the LUTs in xwax.
         s_bLUTInitialized = false;
     }
     s_xwaxLUTMutex.unlock();
@@ -2,9 +2,11 @@
 
 #include "guitick.h"
 #include "control/controlobject.h"
+#include "control/controlupdatecoalescer.h"
 
 GuiTick::GuiTick(QObject* pParent)
-        : QObject(pParent) {
+        : QObject(pParent),
+          m_coalescedDeliveryPending(0) {
      m_pCOGuiTickTime = new ControlObject(ConfigKey("[Master]", "guiTickTime"));
      m_pCOGuiTick50ms = new ControlObject(ConfigKey("[Master]", "guiTick50ms"));
      m_cpuTimer.start();
@@ -26,4 +28,15 @@ void GuiTick::process() {
         m_lastUpdateTime = m_cpuTimeLastTick;
         m_pCOGuiTick50ms->set(cpuTimeLastTickSeconds);
     }
+
+    // Deliver the coalesced control updates of this frame on the GUI thread
+    if (m_coalescedDeliveryPending.testAndSetRelaxed(0, 1)) {
+        QMetaObject::invokeMethod(this, "slotDeliverCoalescedUpdates",
+                Qt::QueuedConnection);
+    }
+}
+
+void GuiTick::slotDeliverCoalescedUpdates() {
+    m_coalescedDeliveryPending = 0;
+    ControlUpdateCoalescer::deliverUpdates();
 }
@@ -1,6 +1,7 @@
 #ifndef GUITICK_H
 #define GUITICK_H
 
+#include <QAtomicInt>
 #include <QObject>
 
 #include "util/duration.h"
@@ -15,12 +16,17 @@ class GuiTick : public QObject {
     ~GuiTick();
     void process();
 
+  private slots:
+    void slotDeliverCoalescedUpdates();
+
   private:
     ControlObject* m_pCOGuiTickTime;
     ControlObject* m_pCOGuiTick50ms;
     PerformanceTimer m_cpuTimer;
     mixxx::Duration m_lastUpdateTime;
     mixxx::Duration m_cpuTimeLastTick;
+    // At most one coalesced delivery is queued for the GUI thread
+    QAtomicInt m_coalescedDeliveryPending;
 };
 
 #endif // GUITICK_H
@@ -0,0 +1,183 @@
+#include "waveform/overviewcache.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QRunnable>
+#include <QStringList>
+#include <QThreadPool>
+
+#include "util/assert.h"
+#include "util/logger.h"
+
+namespace {
+
+mixxx::Logger kLogger("OverviewCache");
+
+const char* const kImageFormat = "PNG";
+const QString kImageSuffix = ".png";
+const QString kTemporarySuffix = ".tmp";
+const QString kPeakTextKey = "peak";
+const QString kKeyTextKey = "key";
+
+// Identifies the colors and the waveform summary an image was rendered from
+QString imageKey(uint colorsHash, const Waveform& waveformSummary) {
+    // The checksum changes when the track is analyzed again
+    const uint dataChecksum = qHash(QByteArray::fromRawData(
+            reinterpret_cast<const char*>(waveformSummary.data()),
+            waveformSummary.getDataSize() * sizeof(WaveformData)));
+    return QString("%1_%2_%3").arg(
+            QString::number(colorsHash, 16),
+            QString::number(waveformSummary.getDataSize()),
+            QString::number(dataChecksum, 16));
+}
+
+// All images are written one after another by a single thread, so writes
+// of the same file never overlap
+QThreadPool* newWriteThreadPool() {
+    QThreadPool* pThreadPool = new QThreadPool;
+    pThreadPool->setMaxThreadCount(1);
+    return pThreadPool;
+}
+
+QThreadPool* writeThreadPool() {
+    // Never deleted, all writes are joined in waitForPendingWrites()
+    static QThreadPool* const s_pThreadPool = newWriteThreadPool();
+    return s_pThreadPool;
+}
+
+class WriteImageTask : public QRunnable {
+  public:
+    WriteImageTask(const QString& filePath, const QImage& image)
+            : m_filePath(filePath),
+              m_image(image) {
+    }
+
+    void run() override {
+        // Write into a temporary file first so that another deck loading
+        // the same track never reads a partially written image.
+        const QString tempPath = m_filePath + kTemporarySuffix;
+        if (!m_image.save(tempPath, kImageFormat)) {
+            kLogger.warning()
+                    << "Failed to store overview image"
+                    << tempPath;
+            QFile::remove(tempPath);
+            return;
+        }
+        // QFile::rename() does not overwrite existing files
+        QFile::remove(m_filePath);
+        if (!QFile::rename(tempPath, m_filePath)) {
+            kLogger.warning()
+                    << "Failed to store overview image"
+                    << m_filePath;
+            QFile::remove(tempPath);
+        }
+    }
+
+  private:
+    const QString m_filePath;
+    const QImage m_image;
+};
+
+} // anonymous namespace
+
+OverviewCache::OverviewCache(UserSettingsPointer pConfig)
+        : m_storageDir(pConfig->getSettingsPath() + "/analysis/overviews/") {
+}
+
+//static
+const QStringList& OverviewCache::overviewTypes() {
+    static const QStringList s_overviewTypes =
+            QStringList() << "hsv" << "lmh" << "rgb";
+    return s_overviewTypes;
+}
+
+//static
+void OverviewCache::waitForPendingWrites() {
+    writeThreadPool()->waitForDone();
+}
+
+QString OverviewCache::imageFilePath(TrackId trackId,
+                                     const QString& overviewType) const {
+    return m_storageDir.absoluteFilePath(QString("%1_%2%3").arg(
+            trackId.toString(), overviewType, kImageSuffix));
+}
+
+QImage OverviewCache::loadImage(TrackId trackId,
+                                const QString& overviewType,
+                                uint colorsHash,
+                                const Waveform& waveformSummary,
+                                float* pWaveformPeak) const {
+    if (!trackId.isValid() || waveformSummary.getDataSize() == 0) {
+        return QImage();
+    }
+    const QString filePath = imageFilePath(trackId, overviewType);
+    if (!QFile::exists(filePath)) {
+        return QImage();
+    }
+    QImage image(filePath, kImageFormat);
+    bool peakValid = false;
+    const float waveformPeak = image.text(kPeakTextKey).toFloat(&peakValid);
+    if (image.isNull() || !peakValid) {
+        kLogger.warning()
+                << "Ignoring corrupt overview image"
+                << filePath;
+        return QImage();
+    }
+    // Rendered with other colors or from a previous analysis. It is
+    // replaced when the overview has been rendered again.
+    if (image.text(kKeyTextKey) != imageKey(colorsHash, waveformSummary)) {
+        return QImage();
+    }
+    *pWaveformPeak = waveformPeak;
+    // Painted into by the progressive renderers
+    return image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+void OverviewCache::storeImage(TrackId trackId,
+                               const QString& overviewType,
+                               uint colorsHash,
+                               const Waveform& waveformSummary,
+                               const QImage& image,
+                               float waveformPeak) const {
+    // Otherwise the image would not be deleted with the track
+    DEBUG_ASSERT(overviewTypes().contains(overviewType));
+    if (!trackId.isValid() || image.isNull()) {
+        return;
+    }
+    if (!QDir().mkpath(m_storageDir.absolutePath())) {
+        kLogger.warning()
+                << "Failed to create directory"
+                << m_storageDir.absolutePath();
+        return;
+    }
+    QImage imageWithText(image);
+    imageWithText.setText(kPeakTextKey, QString::number(waveformPeak));
+    imageWithText.setText(kKeyTextKey, imageKey(colorsHash, waveformSummary));
+    // Deleted by the thread pool
+    writeThreadPool()->start(new WriteImageTask(
+            imageFilePath(trackId, overviewType), imageWithText));
+}
+
+void OverviewCache::deleteImages(const QList<TrackId>& trackIds) const {
+    if (trackIds.isEmpty()) {
+        return;
+    }
+    // A pending write would restore a deleted image
+    waitForPendingWrites();
+    for (const auto& trackId: trackIds) {
+        for (const auto& overviewType: overviewTypes()) {
+            QFile::remove(imageFilePath(trackId, overviewType));
+        }
+    }
+}
+
+void OverviewCache::deleteAllImages() const {
+    waitForPendingWrites();
+    const QStringList fileNames = m_storageDir.entryList(
+            QStringList() << ("*" + kImageSuffix)
+                    << ("*" + kImageSuffix + kTemporarySuffix),
+            QDir::Files);
+    for (const auto& fileName: fileNames) {
+        QFile::remove(m_storageDir.absoluteFilePath(fileName));
+    }
+}
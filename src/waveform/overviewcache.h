@@ -0,0 +1,61 @@
+#ifndef OVERVIEWCACHE_H
+#define OVERVIEWCACHE_H
+
+#include <QDir>
+#include <QImage>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include "preferences/usersettings.h"
+#include "track/trackid.h"
+#include "waveform/waveform.h"
+
+// Stores rendered waveform overview images next to the analysis data. A
+// track loaded into a deck then only needs a single image decode instead
+// of rendering the overview from the waveform summary again.
+//
+// Each track has a single image per overview type, so the images of a
+// track can be deleted without listing the directory. The image is only
+// used if it has been rendered with the same colors from the same waveform
+// summary, which is checked with a key that is stored along with it. Images
+// of previous analyses or colors are replaced when storing a new one.
+class OverviewCache {
+  public:
+    explicit OverviewCache(UserSettingsPointer pConfig);
+
+    // The types of the WOverview subclasses, see WOverview::overviewType()
+    static const QStringList& overviewTypes();
+
+    // Waits until all images that are written in the background have
+    // been written. Called at shutdown after the skin has been deleted.
+    static void waitForPendingWrites();
+
+    // Returns a null image if nothing has been stored for the complete
+    // waveform summary yet. The peak of the waveform is stored along
+    // with the image.
+    QImage loadImage(TrackId trackId,
+                     const QString& overviewType,
+                     uint colorsHash,
+                     const Waveform& waveformSummary,
+                     float* pWaveformPeak) const;
+
+    // Encodes and writes the image in the background
+    void storeImage(TrackId trackId,
+                    const QString& overviewType,
+                    uint colorsHash,
+                    const Waveform& waveformSummary,
+                    const QImage& image,
+                    float waveformPeak) const;
+
+    void deleteImages(const QList<TrackId>& trackIds) const;
+    void deleteAllImages() const;
+
+  private:
+    QString imageFilePath(TrackId trackId,
+                          const QString& overviewType) const;
+
+    const QDir m_storageDir;
+};
+
+#endif // OVERVIEWCACHE_H
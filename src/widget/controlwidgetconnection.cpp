@@ -9,11 +9,17 @@
 ControlWidgetConnection::ControlWidgetConnection(
         WBaseWidget* pBaseWidget,
         const ConfigKey& key,
-        ValueTransformer* pTransformer)
+        ValueTransformer* pTransformer,
+        bool coalesceUpdates)
         : m_pWidget(pBaseWidget),
           m_pValueTransformer(pTransformer) {
     m_pControl = new ControlProxy(key, this);
-    m_pControl->connectValueChanged(SLOT(slotControlValueChanged(double)));
+    if (coalesceUpdates) {
+        m_pControl->connectValueChangedCoalesced(
+                this, SLOT(slotControlValueChanged(double)));
+    } else {
+        m_pControl->connectValueChanged(SLOT(slotControlValueChanged(double)));
+    }
 }
 
 void ControlWidgetConnection::setControlParameter(double parameter) {
@@ -42,8 +48,9 @@ double ControlWidgetConnection::getControlParameterForValue(double value) const
 ControlParameterWidgetConnection::ControlParameterWidgetConnection(
         WBaseWidget* pBaseWidget, const ConfigKey& key,
         ValueTransformer* pTransformer, DirectionOption directionOption,
-        EmitOption emitOption)
-        : ControlWidgetConnection(pBaseWidget, key, pTransformer),
+        EmitOption emitOption, bool coalesceUpdates)
+        : ControlWidgetConnection(pBaseWidget, key, pTransformer,
+                                  coalesceUpdates),
           m_directionOption(directionOption),
           m_emitOption(emitOption) {
 }
@@ -95,8 +102,10 @@ void ControlParameterWidgetConnection::setControlParameterUp(double v) {
 
 ControlWidgetPropertyConnection::ControlWidgetPropertyConnection(
         WBaseWidget* pBaseWidget, const ConfigKey& key,
-        ValueTransformer* pTransformer, const QString& propertyName)
-        : ControlWidgetConnection(pBaseWidget, key, pTransformer),
+        ValueTransformer* pTransformer, const QString& propertyName,
+        bool coalesceUpdates)
+        : ControlWidgetConnection(pBaseWidget, key, pTransformer,
+                                  coalesceUpdates),
           m_propertyName(propertyName.toAscii()) {
     slotControlValueChanged(m_pControl->get());
 }
@@ -15,10 +15,13 @@ class ValueTransformer;
 class ControlWidgetConnection : public QObject {
     Q_OBJECT
   public:
-    // Takes ownership of pControl and pTransformer.
+    // Takes ownership of pControl and pTransformer. With coalesceUpdates the
+    // widget receives at most one update per GUI frame with the latest value,
+    // see ControlProxy::connectValueChangedCoalesced().
     ControlWidgetConnection(WBaseWidget* pBaseWidget,
                             const ConfigKey& key,
-                            ValueTransformer* pTransformer);
+                            ValueTransformer* pTransformer,
+                            bool coalesceUpdates = false);
 
     double getControlParameter() const;
     double getControlParameterForValue(double value) const;
@@ -99,7 +102,8 @@ class ControlParameterWidgetConnection : public ControlWidgetConnection {
                                      const ConfigKey& key,
                                      ValueTransformer* pTransformer,
                                      DirectionOption directionOption,
-                                     EmitOption emitOption);
+                                     EmitOption emitOption,
+                                     bool coalesceUpdates = false);
 
     void Init();
 
@@ -130,7 +134,8 @@ class ControlWidgetPropertyConnection : public ControlWidgetConnection {
     ControlWidgetPropertyConnection(WBaseWidget* pBaseWidget,
                                     const ConfigKey& key,
                                     ValueTransformer* pTransformer,
-                                    const QString& propertyName);
+                                    const QString& propertyName,
+                                    bool coalesceUpdates = false);
 
     QString toDebugString() const override;
 
@@ -8,6 +8,7 @@
 #include "util/math.h"
 #include "util/memory.h"
 #include "skin/imgloader.h"
+#include "skin/skinimagecache.h"
 
 // static
 Paintable::DrawMode Paintable::DrawModeFromString(const QString& str) {
@@ -51,6 +52,30 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
     if (!source.isSVG()) {
         m_pPixmap.reset(WPixmapStore::getPixmapNoCache(source.getPath(), scaleFactor));
     } else {
+#ifdef __APPLE__
+        // Apple does Retina scaling behind the sceens, so we also pass a
+        // Paintable::FIXED image. On the other targets, it is better to
+        // cache the pixmap. We do not do this for TILE and color schemas.
+        // which can result in a correct but possibly blurry picture at a
+        // Retina display. This can be fixed when switching to QT5
+        const bool rasterize = mode == TILE || WPixmapStore::willCorrectColors();
+#else
+        const bool rasterize = mode == TILE || mode == Paintable::FIXED ||
+                WPixmapStore::willCorrectColors();
+#endif
+        if (rasterize && source.getSvgSourceData().isEmpty() &&
+                !source.getPath().isEmpty()) {
+            // SVG files are usually rasterized ahead of time while the skin
+            // is loading.
+            QImage image = SkinImageCache::getImage(source.getPath(),
+                    scaleFactor, SkinImageCache::Rendering::SvgColorCorrected,
+                    WPixmapStore::getLoader());
+            if (!image.isNull()) {
+                m_pPixmap.reset(new QPixmap(QPixmap::fromImage(image)));
+            }
+            return;
+        }
+
         auto pSvg = std::make_unique<QSvgRenderer>();
         if (!source.getSvgSourceData().isEmpty()) {
             // Call here the different overload for svg content
@@ -67,16 +92,7 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
             return;
         }
         m_pSvg.reset(pSvg.release());
-#ifdef __APPLE__
-        // Apple does Retina scaling behind the sceens, so we also pass a
-        // Paintable::FIXED image. On the other targets, it is better to
-        // cache the pixmap. We do not do this for TILE and color schemas.
-        // which can result in a correct but possibly blurry picture at a
-        // Retina display. This can be fixed when switching to QT5
-        if (mode == TILE || WPixmapStore::willCorrectColors()) {
-#else
-        if (mode == TILE || mode == Paintable::FIXED || WPixmapStore::willCorrectColors()) {
-#endif
+        if (rasterize) {
             // The SVG renderer doesn't directly support tiling, so we render
             // it to a pixmap which will then get tiled.
             QImage copy_buffer(m_pSvg->defaultSize() * scaleFactor, QImage::Format_ARGB32);
@@ -5,6 +5,7 @@
 #include <QPainter>
 
 #include "skin/imgloader.h"
+#include "skin/skinimagecache.h"
 #include "util/assert.h"
 
 
@@ -57,7 +58,15 @@ std::shared_ptr<QImage> WImageStore::getImage(const PixmapSource& source, double
 
 // static
 QImage* WImageStore::getImageNoCache(const PixmapSource& source, double scaleFactor) {
-    if (source.isSVG()) {
+    if (source.isSVG() && source.getSvgSourceData().isEmpty() &&
+            !source.getPath().isEmpty()) {
+        const QImage image = SkinImageCache::getImage(source.getPath(),
+                scaleFactor, SkinImageCache::Rendering::Svg, m_loader);
+        if (image.isNull()) {
+            return nullptr;
+        }
+        return new QImage(image);
+    } else if (source.isSVG()) {
         QSvgRenderer renderer;
 
         if (!source.getSvgSourceData().isEmpty()) {
@@ -66,11 +75,6 @@ QImage* WImageStore::getImageNoCache(const PixmapSource& source, double scaleFac
                 // The above line already logs a warning
                 return nullptr;
             }
-        } else if (!source.getPath().isEmpty()) {
-            if (!renderer.load(source.getPath())) {
-                // The above line already logs a warning
-                return nullptr;
-            }
         } else {
             return nullptr;
         }
@@ -82,7 +86,8 @@ QImage* WImageStore::getImageNoCache(const PixmapSource& source, double scaleFac
         renderer.render(&painter);
         return pImage;
     } else {
-        return m_loader->getImage(source.getPath(), scaleFactor);
+        return new QImage(SkinImageCache::getImage(source.getPath(),
+                scaleFactor, SkinImageCache::Rendering::Loader, m_loader));
     }
 }
 
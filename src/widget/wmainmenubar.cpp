@@ -1,5 +1,6 @@
 #include "widget/wmainmenubar.h"
 
+#include <QDateTime>
 #include <QDesktopServices>
 #include <QUrl>
 
@@ -8,6 +9,7 @@
 #include "mixer/playermanager.h"
 #include "util/cmdlineargs.h"
 #include "util/experiment.h"
+#include "util/statsmanager.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
 
 namespace {
@@ -479,6 +481,20 @@ void WMainMenuBar::initialize() {
                 this, SLOT(slotDeveloperStatsBase(bool)));
         pDeveloperMenu->addAction(pDeveloperStatsBase);
 
+        QString recordTraceTitle = tr("Stats: &Record Trace");
+        QString recordTraceText = tr(
+            "Records the timeline of all threads. Unchecking writes it to a "
+            "Chrome trace file in the settings directory.");
+        auto pDeveloperStatsTrace = new QAction(recordTraceTitle, this);
+        pDeveloperStatsTrace->setStatusTip(recordTraceText);
+        pDeveloperStatsTrace->setWhatsThis(buildWhatsThis(
+            recordTraceTitle, recordTraceText));
+        pDeveloperStatsTrace->setCheckable(true);
+        pDeveloperStatsTrace->setChecked(false);
+        connect(pDeveloperStatsTrace, SIGNAL(triggered(bool)),
+                this, SLOT(slotDeveloperStatsTrace(bool)));
+        pDeveloperMenu->addAction(pDeveloperStatsTrace);
+
         // "D" cannont be used with Alt here as it is already by the Developer menu
         QString scriptDebuggerTitle = tr("Deb&ugger Enabled");
         QString scriptDebuggerText = tr("Enables the debugger during skin parsing");
@@ -650,6 +666,23 @@ void WMainMenuBar::slotDeveloperStatsExperiment(bool enable) {
     }
 }
 
+void WMainMenuBar::slotDeveloperStatsTrace(bool enable) {
+    StatsManager* pStatsManager = StatsManager::instance();
+    if (pStatsManager == nullptr) {
+        return;
+    }
+    if (enable) {
+        pStatsManager->startTraceRecording();
+        return;
+    }
+    const QString fileName = QDir(m_pConfig->getSettingsPath()).filePath(
+            QString("trace-%1.json").arg(
+                    QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss")));
+    if (pStatsManager->stopTraceRecording(fileName)) {
+        qDebug() << "Wrote trace to" << fileName;
+    }
+}
+
 void WMainMenuBar::slotDeveloperDebugger(bool toggle) {
     m_pConfig->set(ConfigKey("[ScriptDebugger]","Enabled"),
                    ConfigValue(toggle ? 1 : 0));
@@ -77,6 +77,7 @@ class WMainMenuBar : public QMenuBar {
   private slots:
     void slotDeveloperStatsExperiment(bool enable);
     void slotDeveloperStatsBase(bool enable);
+    void slotDeveloperStatsTrace(bool enable);
     void slotDeveloperDebugger(bool toggle);
     void slotVisitUrl(const QString& url);
 
@@ -41,6 +41,8 @@ WOverview::WOverview(const char *pGroup, UserSettingsPointer pConfig, QWidget* p
         m_diffGain(0),
         m_group(pGroup),
         m_pConfig(pConfig),
+        m_overviewCache(pConfig),
+        m_signalColorsHash(0),
         m_endOfTrack(false),
         m_bDrag(false),
         m_iPos(0),
@@ -67,6 +69,15 @@ void WOverview::setup(const QDomNode& node, const SkinContext& context) {
 
     m_qColorBackground = m_signalColors.getBgColor();
 
+    m_signalColorsHash = qHash(QString("%1 %2 %3 %4 %5 %6 %7").arg(
+            QString::number(m_signalColors.getSignalColor().rgba(), 16),
+            QString::number(m_signalColors.getLowColor().rgba(), 16),
+            QString::number(m_signalColors.getMidColor().rgba(), 16),
+            QString::number(m_signalColors.getHighColor().rgba(), 16),
+            QString::number(m_signalColors.getRgbLowColor().rgba(), 16),
+            QString::number(m_signalColors.getRgbMidColor().rgba(), 16),
+            QString::number(m_signalColors.getRgbHighColor().rgba(), 16)));
+
     // Clear the background pixmap, if it exists.
     m_backgroundPixmap = QPixmap();
     m_backgroundPixmapPath = context.selectString(node, "BgPixmap");
@@ -165,7 +176,7 @@ void WOverview::slotWaveformSummaryUpdated() {
         // If the waveform is already complete, just draw it.
         if (m_pWaveform->getCompletion() == m_pWaveform->getDataSize()) {
             m_actualCompletion = 0;
-            if (drawNextPixmapPart()) {
+            if (drawWaveformImage()) {
                 update();
             }
         }
@@ -189,7 +200,7 @@ void WOverview::slotAnalyzerProgress(int progress) {
     double analyzerProgress = progress / 1000.0;
     bool finalizing = progress == 999;
 
-    bool updateNeeded = drawNextPixmapPart();
+    bool updateNeeded = drawWaveformImage();
     // progress 0 .. 1000
     if (updateNeeded || (m_dAnalyzerProgress != analyzerProgress)) {
         m_dAnalyzerProgress = analyzerProgress;
@@ -198,6 +209,46 @@ void WOverview::slotAnalyzerProgress(int progress) {
     }
 }
 
+bool WOverview::drawWaveformImage() {
+    if (m_actualCompletion == 0 && loadCachedWaveformImage()) {
+        return true;
+    }
+    const bool wasDone = m_pixmapDone;
+    if (!drawNextPixmapPart()) {
+        return false;
+    }
+    if (m_pixmapDone && !wasDone && m_pCurrentTrack && m_pWaveform) {
+        m_overviewCache.storeImage(m_pCurrentTrack->getId(), overviewType(),
+                m_signalColorsHash, *m_pWaveform, m_waveformSourceImage,
+                m_waveformPeak);
+    }
+    return true;
+}
+
+bool WOverview::loadCachedWaveformImage() {
+    // Only complete overviews are cached. While the track is analyzed
+    // the overview is drawn progressively.
+    if (!m_pCurrentTrack || !m_pWaveform ||
+            m_pWaveform->getDataSize() == 0 ||
+            m_pWaveform->getCompletion() != m_pWaveform->getDataSize()) {
+        return false;
+    }
+    ScopedTimer t("WOverview::loadCachedWaveformImage");
+    float waveformPeak = -1.0;
+    QImage image = m_overviewCache.loadImage(m_pCurrentTrack->getId(),
+            overviewType(), m_signalColorsHash, *m_pWaveform, &waveformPeak);
+    if (image.isNull()) {
+        return false;
+    }
+    m_waveformSourceImage = image;
+    m_waveformPeak = waveformPeak;
+    m_actualCompletion = m_pWaveform->getDataSize();
+    m_pixmapDone = true;
+    m_waveformImageScaled = QImage();
+    m_diffGain = 0;
+    return true;
+}
+
 void WOverview::slotTrackLoaded(TrackPointer pTrack) {
     DEBUG_ASSERT(m_pCurrentTrack == pTrack);
     m_trackLoaded = true;
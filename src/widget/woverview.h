@@ -24,6 +24,7 @@
 #include "waveform/renderers/waveformsignalcolors.h"
 #include "waveform/renderers/waveformmarkset.h"
 #include "waveform/renderers/waveformmarkrange.h"
+#include "waveform/overviewcache.h"
 #include "skin/skincontext.h"
 
 // Waveform overview display
@@ -91,6 +92,12 @@ class WOverview : public WWidget {
   private:
     // Append the waveform overview pixmap according to available data in waveform
     virtual bool drawNextPixmapPart() = 0;
+    // Identifies the images of the overview type in the OverviewCache
+    virtual QString overviewType() const = 0;
+    // Loads the complete overview from the OverviewCache or falls back
+    // to drawNextPixmapPart(). A completed overview is stored in the cache.
+    bool drawWaveformImage();
+    bool loadCachedWaveformImage();
     void paintText(const QString &text, QPainter *painter);
     inline int valueToPosition(double value) const {
         return static_cast<int>(m_a * value - m_b);
@@ -101,6 +108,9 @@ class WOverview : public WWidget {
 
     const QString m_group;
     UserSettingsPointer m_pConfig;
+    OverviewCache m_overviewCache;
+    // Distinguishes the cached images of different skin colors
+    uint m_signalColorsHash;
     ControlProxy* m_endOfTrackControl;
     bool m_endOfTrack;
     ControlProxy* m_trackSamplesControl;
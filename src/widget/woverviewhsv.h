@@ -9,6 +9,9 @@ class WOverviewHSV : public WOverview {
 
   private:
     bool drawNextPixmapPart() override;
+    QString overviewType() const override {
+        return "hsv";
+    }
 };
 
 #endif // WOVERVIEWHSV_H
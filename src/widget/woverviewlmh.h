@@ -9,6 +9,9 @@ class WOverviewLMH : public WOverview {
 
   private:
     bool drawNextPixmapPart() override;
+    QString overviewType() const override {
+        return "lmh";
+    }
 };
 
 #endif // WOVERVIEWLMH_H
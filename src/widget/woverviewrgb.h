@@ -9,6 +9,9 @@ class WOverviewRGB : public WOverview {
 
   private:
     bool drawNextPixmapPart() override;
+    QString overviewType() const override {
+        return "rgb";
+    }
 };
 
 #endif // WOVERVIEWRGB_H
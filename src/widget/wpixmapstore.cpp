@@ -6,6 +6,7 @@
 
 #include "util/math.h"
 #include "skin/imgloader.h"
+#include "skin/skinimagecache.h"
 
 // static
 QHash<QString, WeakPaintablePointer> WPixmapStore::m_paintableCache;
@@ -40,14 +41,14 @@ QPixmap* WPixmapStore::getPixmapNoCache(
         const QString& fileName,
         double scaleFactor) {
     QPixmap* pPixmap = nullptr;
-    QImage* img = m_loader->getImage(fileName, scaleFactor);
+    const QImage img = SkinImageCache::getImage(fileName, scaleFactor,
+            SkinImageCache::Rendering::Loader, m_loader);
 #if QT_VERSION >= 0x040700
     pPixmap = new QPixmap();
-    pPixmap->convertFromImage(*img);
+    pPixmap->convertFromImage(img);
 #else
-    pPixmap = new QPixmap(QPixmap::fromImage(*img));
+    pPixmap = new QPixmap(QPixmap::fromImage(img));
 #endif
-    delete img;
     return pPixmap;
 }
 
@@ -60,6 +61,11 @@ bool WPixmapStore::willCorrectColors() {
     return m_loader->willCorrectColors();
 };
 
+// static
+QSharedPointer<ImgSource> WPixmapStore::getLoader() {
+    return m_loader;
+}
+
 void WPixmapStore::setLoader(QSharedPointer<ImgSource> ld) {
     m_loader = ld;
 
@@ -44,6 +44,7 @@ class WPixmapStore {
             double scaleFactor);
     static QPixmap* getPixmapNoCache(const QString& fileName, double scaleFactor);
     static void setLoader(QSharedPointer<ImgSource> ld);
+    static QSharedPointer<ImgSource> getLoader();
     static void correctImageColors(QImage* p);
     static bool willCorrectColors();
 